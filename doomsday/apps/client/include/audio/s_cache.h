@@ -22,6 +22,7 @@
 #define AUDIO_SFXSAMPLECACHE_H
 
 #include "api_audiod_sfx.h"  // sfxsample_t
+#include <de/list.h>
 #include <de/observers.h>
 
 namespace audio {
@@ -29,6 +30,9 @@ namespace audio {
 /**
  * Data cache for sfxsample_t.
  *
+ * The total size of the cache is limited (cvar "sound-cache-size"). When the limit is
+ * exceeded, the least recently used samples that are not playing are removed.
+ *
  * To play a sound:
  *  1) Figure out the ID of the sound.
  *  2) Call @ref cache() to get a sfxsample_t.
@@ -45,6 +49,7 @@ public:
     struct CacheItem
     {
         CacheItem *next, *prev;
+        CacheItem *lruPrev, *lruNext;  ///< Order of use (least recent first).
 
         int hits;            ///< Number of cache hits.
         int lastUsed;        ///< Tic the sample was last hit.
@@ -64,6 +69,17 @@ public:
         void replaceSample(sfxsample_t &newSample);
     };
 
+    /**
+     * Usage statistics.
+     */
+    struct Stats
+    {
+        de::duint64 hits         = 0;  ///< Lookups of cached samples.
+        de::duint64 misses       = 0;  ///< Lookups that had to load the sample.
+        de::duint64 evictions    = 0;  ///< Samples removed to stay within the size limit.
+        de::duint64 evictedBytes = 0;
+    };
+
 public:
     /**
      * Construct a new (empty) sound sample cache.
@@ -76,8 +92,9 @@ public:
     void clear();
 
     /**
-     * Call this periodically to perform a cache purge. If the cache is too large,
-     * stopped samples with the lowest hitcount will be uncached.
+     * Call this periodically to perform a cache purge. Samples that have not been
+     * used in a long time are uncached. If the cache is too large, the least
+     * recently used stopped samples are uncached.
      */
     void maybeRunPurge();
 
@@ -90,11 +107,21 @@ public:
      */
     sfxsample_t *cache(int soundId);
 
+    /**
+     * Cache all the sound samples associated with @a soundIds that are not cached
+     * yet. The samples are loaded in the calling thread and converted to the
+     * format of the cache in parallel, in worker threads. Playing the sounds later
+     * will not require any further processing.
+     *
+     * @param soundIds  Sound sample identifiers.
+     */
+    void cacheAll(const de::List<int> &soundIds);
+
     /**
      * Register a cache hit on the sound sample associated with @a id.
      *
-     * Hits keep count of how many times the cached sound has been played. The purger
-     * will remove samples with the lowest hitcount first.
+     * Hits keep count of how many times the cached sound has been played. The sample
+     * also becomes the most recently used one, so it is the last to be purged.
      *
      * @param soundId  Sound sample identifier.
      */
@@ -108,6 +135,15 @@ public:
      */
     void info(uint *cacheBytes, uint *sampleCount);
 
+    /**
+     * Returns the usage statistics of the cache.
+     */
+    Stats stats() const;
+
+public:
+    /// Register the console commands and variables of this module.
+    static void consoleRegister();
+
 private:
     DE_PRIVATE(d)
 };
@@ -0,0 +1,74 @@
+/** @file s_resample.h  Sample rate and format conversion of sound samples.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef AUDIO_RESAMPLE_H
+#define AUDIO_RESAMPLE_H
+
+#include <de/libcore.h>
+
+namespace audio {
+
+/**
+ * Converts mono PCM samples from one sample rate to another. Any ratio of rates
+ * is supported. The conversion uses a polyphase windowed-sinc filter that also
+ * acts as the low-pass filter required when reducing the rate.
+ *
+ * The filter bank is computed when the resampler is constructed. After that the
+ * resampler is immutable and can be used from several threads at the same time.
+ *
+ * Samples are either unsigned 8-bit (1 byte per sample) or signed 16-bit in
+ * native byte order (2 bytes per sample).
+ */
+class Resampler
+{
+public:
+    Resampler(de::dint sourceRate, de::dint targetRate);
+
+    de::dint sourceRate() const;
+    de::dint targetRate() const;
+
+    /**
+     * Determines the number of samples produced from @a numSamples source samples.
+     */
+    de::dsize outputLength(de::dsize numSamples) const;
+
+    /**
+     * Resamples a waveform.
+     *
+     * @param dst          Output buffer. Must have room for outputLength(@a numSamples)
+     *                     samples.
+     * @param dstBytesPer  Bytes per output sample (1 or 2).
+     * @param src          Source samples.
+     * @param srcBytesPer  Bytes per source sample (1 or 2).
+     * @param numSamples   Number of source samples.
+     */
+    void resample(void *dst, de::dint dstBytesPer,
+                  const void *src, de::dint srcBytesPer, de::dsize numSamples) const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+/**
+ * Converts unsigned 8-bit samples to signed 16-bit samples.
+ */
+void convertU8ToS16(de::dint16 *dst, const de::duint8 *src, de::dsize count);
+
+} // namespace audio
+
+#endif // AUDIO_RESAMPLE_H
@@ -85,7 +85,8 @@ de::gfx::UploadMethod GL_ChooseUploadMethod(const struct texturecontent_s *conte
  * Adds a new deferred texture upload task to the queue.
  *
  * @param content  Texture content to upload. Caller can free its copy of the content;
- *                 a copy is made for the deferred task.
+ *                 an upload-ready copy is made for the deferred task (see
+ *                 GL_ConstructUploadReadyTextureContent()).
  */
 void GL_DeferTextureUpload(const struct texturecontent_s *content);
 
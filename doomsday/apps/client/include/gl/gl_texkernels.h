@@ -0,0 +1,177 @@
+/** @file gl_texkernels.h  Vectorized inner loops of the image manipulation algorithms.
+ *
+ * @ingroup gl
+ *
+ * The kernels have a scalar reference implementation and SSE2, AVX2, and NEON
+ * implementations. The best instruction set supported by the CPU is selected
+ * at runtime. The vectorized kernels produce exactly the same output as the
+ * scalar reference, provided that the compiler does not contract the scalar
+ * floating-point multiply-adds (no FMA in the scalar build).
+ *
+ * This file has no dependencies to the rest of the client so that the kernels
+ * can be benchmarked separately (see test_texkernels).
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef DE_GL_TEXKERNELS_H
+#define DE_GL_TEXKERNELS_H
+
+#include <cstdint>
+
+/**
+ * Instruction sets the kernels are implemented with.
+ */
+typedef enum texkernelisa_e {
+    TKI_SCALAR,
+    TKI_SSE2,
+    TKI_AVX2,
+    TKI_NEON,
+    NUM_TEXKERNEL_ISAS
+} texkernelisa_t;
+
+/**
+ * Returns the best instruction set supported by the CPU.
+ */
+texkernelisa_t TexKernel_BestISA(void);
+
+/**
+ * Returns the instruction set currently used by the kernels.
+ */
+texkernelisa_t TexKernel_ISA(void);
+
+/**
+ * Changes the instruction set used by the kernels. This is meant for testing
+ * and benchmarking; by default the best supported instruction set is used.
+ *
+ * @param isa  Instruction set to use.
+ *
+ * @return  @c true, if @a isa is supported and was selected.
+ */
+bool TexKernel_SetISA(texkernelisa_t isa);
+
+/**
+ * Returns a textual name of an instruction set.
+ */
+const char *TexKernel_ISAName(texkernelisa_t isa);
+
+/**
+ * Averages 2x2 blocks of pixels: writes one row of a mipmap from two rows of
+ * the source. @a out may point to the beginning of @a row0.
+ *
+ * @param row0      First source row (at least 2 * @a outWidth pixels).
+ * @param row1      Second source row.
+ * @param out       Output row (@a outWidth pixels).
+ * @param outWidth  Number of output pixels.
+ * @param comps     Number of components (bytes) per pixel.
+ */
+void TexKernel_DownMipmapRow(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                             int outWidth, int comps);
+
+/**
+ * Sums the red, green, and blue components of pixels.
+ *
+ * @param pixels     Pixels.
+ * @param numPels    Number of pixels.
+ * @param pixelSize  Bytes per pixel (3 or 4).
+ * @param sums       The sums of each component are written here.
+ */
+void TexKernel_SumRGB(const uint8_t *pixels, long numPels, int pixelSize, long sums[3]);
+
+/**
+ * Finds the smallest and largest values and the sum of 8-bit values.
+ */
+void TexKernel_MinMaxSum(const uint8_t *values, long count, uint8_t *min, uint8_t *max,
+                         long *sum);
+
+/**
+ * Finds the largest 8-bit value.
+ *
+ * @param values  Values.
+ * @param mask    If not @c NULL, values whose mask value is zero are ignored.
+ * @param count   Number of values.
+ */
+uint8_t TexKernel_Max(const uint8_t *values, const uint8_t *mask, long count);
+
+/**
+ * Replaces 8-bit values using a lookup table.
+ */
+void TexKernel_Lookup(uint8_t *values, long count, const uint8_t table[256]);
+
+/**
+ * Makes keyed RGBA pixels, (0,255,255) or (255,0,255) regardless of alpha,
+ * fully transparent black. Other pixels are not changed.
+ */
+void TexKernel_ColorKey(uint8_t *rgba, long numPels);
+
+/**
+ * Sharpens a horizontal run of pixels. For each color component @em c of the
+ * pixel at @a pix, the result is
+ * <pre>C*pix[c] - A*(pix[c-width] + pix[c+comps] + pix[c-comps] + pix[c+width])
+ *           - B*(pix[c+comps-width] + pix[c+comps+width] + pix[c-comps-width] + pix[c-comps+width])</pre>
+ * evaluated from left to right, clamped to 0...255. Alpha is copied.
+ *
+ * @param pix    First source pixel.
+ * @param out    First output pixel.
+ * @param count  Number of pixels.
+ * @param comps  Bytes per pixel (3 or 4).
+ * @param width  Offset in bytes to the "vertical" neighbors.
+ */
+void TexKernel_SharpenRun(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                          float A, float B, float C);
+
+/**
+ * Converts 8-bit values to floating point.
+ */
+void TexKernel_BytesToFloats(const uint8_t *in, float *out, long count);
+
+/**
+ * Converts floating-point values in the range 0...255 to 8-bit values
+ * (truncated).
+ */
+void TexKernel_FloatsToBytes(const float *in, uint8_t *out, long count);
+
+/**
+ * Magnifies a row with a weighted sample of 4 pixels (bilinear). The weights
+ * are applied in double precision.
+ *
+ * @param src0     Upper source row.
+ * @param src1     Lower source row.
+ * @param alpha    Vertical weight of the lower row.
+ * @param dst      Output row.
+ * @param widthIn  Width of the source rows.
+ * @param widthOut Width of the output row.
+ * @param sx       Horizontal step in source pixels per output pixel.
+ * @param comps    Components per pixel.
+ */
+void TexKernel_MagnifyRow(const float *src0, const float *src1, float alpha, float *dst,
+                          int widthIn, int widthOut, float sx, int comps);
+
+/**
+ * Minifies a row with an unweighted box filter of (at most) 2x2 source pixels.
+ *
+ * @param src0     Upper source row.
+ * @param src1     Lower source row, or @c NULL if only @a src0 is sampled.
+ * @param dst      Output row.
+ * @param widthIn  Width of the source rows.
+ * @param widthOut Width of the output row.
+ * @param sx       Horizontal step in source pixels per output pixel.
+ * @param comps    Components per pixel.
+ */
+void TexKernel_MinifyRow(const float *src0, const float *src1, float *dst,
+                         int widthIn, int widthOut, float sx, int comps);
+
+#endif // DE_GL_TEXKERNELS_H
@@ -38,6 +38,7 @@
 #define TXCF_UPLOAD_ARG_NOSTRETCH       0x20
 #define TXCF_UPLOAD_ARG_NOSMARTFILTER   0x40
 #define TXCF_NEVER_DEFER                0x80
+#define TXCF_UPLOAD_READY               0x100 ///< Pixels already converted for upload (internal).
 /*@}*/
 
 /**
@@ -68,6 +69,17 @@ texturecontent_t *GL_ConstructTextureContentCopy(const texturecontent_t *other);
 
 void GL_DestroyTextureContent(texturecontent_t *content);
 
+/**
+ * Constructs a copy of @a content whose pixels have been converted to the final
+ * format and dimensions of the GL texture (palette lookup, gamma, smart filtering,
+ * scaling to the optimal size). Only the GL calls remain to be done when the
+ * returned content is uploaded, so the conversion can be done in any thread.
+ *
+ * @return  New content with @ref TXCF_UPLOAD_READY set. Destroy with
+ * GL_DestroyTextureContent().
+ */
+texturecontent_t *GL_ConstructUploadReadyTextureContent(const texturecontent_t &content);
+
 /**
  * Prepare the texture content @a c, using the given image in accordance with
  * the supplied specification. The image data will be transformed in-place.
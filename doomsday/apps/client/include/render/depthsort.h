@@ -0,0 +1,85 @@
+/** @file depthsort.h  Back-to-front ordering of projected objects.
+ *
+ * @ingroup render
+ *
+ * This file has no dependencies to the rest of the client so that the sort can
+ * be benchmarked separately (see test_vissort).
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_DEPTHSORT_H
+#define DE_CLIENT_RENDER_DEPTHSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Orders items by decreasing distance from the viewer, so that they can be drawn
+ * back to front. The distances are converted to integer keys that preserve their
+ * order and sorted with an LSD radix sort, so the time is linear in the number
+ * of items.
+ *
+ * Items at equal distances are ordered in reverse order of addition. This is the
+ * same order that the classic Doom vissprite selection sort produces.
+ *
+ * The working memory is retained, so a sorter that is reused every frame does
+ * not allocate memory once it has seen the largest frame.
+ *
+ * @ingroup render
+ */
+class DepthSorter
+{
+public:
+    /**
+     * Removes all items.
+     */
+    void clear();
+
+    /**
+     * Adds an item. Items are identified by their order of addition (starting at 0).
+     *
+     * @param distance  Distance of the item from the viewer.
+     */
+    void add(double distance);
+
+    /**
+     * Returns the number of items added since the last clear().
+     */
+    size_t size() const;
+
+    /**
+     * Sorts the items.
+     *
+     * @return  Indices of the items from the farthest to the nearest. The array has
+     * size() elements and remains valid until the sorter is modified.
+     */
+    const uint32_t *sortBackToFront();
+
+private:
+    struct Item
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+    std::vector<Item> _items;
+    std::vector<Item> _temp;
+    std::vector<uint32_t> _order;
+};
+
+#endif // DE_CLIENT_RENDER_DEPTHSORT_H
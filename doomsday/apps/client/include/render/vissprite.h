@@ -27,8 +27,6 @@
 #include "render/billboard.h"
 #include "rend_model.h"
 
-#define MAXVISSPRITES   8192
-
 namespace world { class BspLeaf; }
 class ClientMaterial;
 
@@ -198,15 +196,26 @@ struct vispsprite_t
     } data;
 };
 
-DE_EXTERN_C vissprite_t visSprites[MAXVISSPRITES], *visSpriteP;
 DE_EXTERN_C vissprite_t visSprSortedHead;
 DE_EXTERN_C vispsprite_t visPSprites[DDMAXPSPRITES];
 
 /// To be called at the start of the current render frame to clear the vissprite list.
 void R_ClearVisSprites();
 
+/**
+ * Allocates a new vissprite for the current render frame. The pool grows as
+ * needed; the returned vissprite remains valid until R_ClearVisSprites().
+ */
 vissprite_t *R_NewVisSprite(visspritetype_t type);
 
+/// Returns the number of vissprites in the current render frame.
+int R_VisSpriteCount();
+
+/**
+ * Links all the vissprites of the current frame in visSprSortedHead, ordered
+ * back to front (farthest first). Vissprites at equal distances are ordered in
+ * reverse order of creation.
+ */
 void R_SortVisSprites();
 
 #endif  // DE_CLIENT_RENDER_VISSPRITE_H
@@ -50,6 +50,7 @@
 #include "rawtexture.h"
 
 class ClientMaterial;
+class TextureCache;
 
 /**
  * Subsystem for managing client-side resources.
@@ -373,6 +374,11 @@ public:
      */
     TextureVariantSpec &detailTextureSpec(float contrast);
 
+    /**
+     * Returns the persistent cache of prepared texture content.
+     */
+    TextureCache &textureCache();
+
     AbstractFont *newFontFromDef(const ded_compositefont_t &def);
     AbstractFont *newFontFromFile(const res::Uri &uri, const de::String& filePath);
 
@@ -25,6 +25,7 @@
 #include "texturevariantspec.h"
 
 #include <doomsday/res/texture.h>
+#include <functional>
 
 /**
  * Logical texture resource.
@@ -141,6 +142,50 @@ public:
     /// A list of variants.
     typedef de::List<Variant *> Variants;
 
+    /**
+     * Scope during which variants are prepared in parallel. While a batch exists,
+     * Variant::prepare() in the thread that created it only loads the source image
+     * and reserves a GL name; the rest of the content preparation (translation,
+     * filtering, conversion and scaling for upload) is done in background tasks.
+     * The variants are finalized (coordinates, flags, immediate uploads) in the
+     * owning thread when the batch is waited on or destroyed.
+     *
+     * Until then the prepared variants have a GL name but their other properties
+     * are not yet valid.
+     */
+    class PreparationBatch
+    {
+    public:
+        PreparationBatch();
+
+        /// Waits for the batch to complete.
+        ~PreparationBatch();
+
+        /**
+         * Starts a background task.
+         *
+         * @param work        Called in a worker thread.
+         * @param completion  Called in the owning thread after all the work of the
+         *                    batch has been done.
+         */
+        void start(const std::function<void ()> &work,
+                   const std::function<void ()> &completion);
+
+        /**
+         * Waits until all started tasks are done and calls their completion
+         * callbacks in order.
+         */
+        void wait();
+
+        /**
+         * Returns the batch created in the calling thread, or @c nullptr.
+         */
+        static PreparationBatch *current();
+
+    private:
+        DE_PRIVATE(d)
+    };
+
     /**
      * Logics for selecting a texture variant instance from the candidates.
      *
@@ -0,0 +1,127 @@
+/** @file texturecache.h  Persistent cache of prepared texture content.
+ * @ingroup resource
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef DE_CLIENT_RESOURCE_TEXTURECACHE_H
+#define DE_CLIENT_RESOURCE_TEXTURECACHE_H
+
+#include "gl/texturecontent.h"
+#include "image.h"
+
+#include <de/block.h>
+#include <de/nativepath.h>
+
+/**
+ * Content-addressed disk cache of texture content that has been fully prepared
+ * for uploading (see GL_ConstructUploadReadyTextureContent()). Each item is kept
+ * in its own file and memory-mapped when read, so that the pixels can be
+ * uploaded without any further processing. When the total size of the items
+ * exceeds the configured maximum, the least recently used items are removed.
+ *
+ * The key of an item must identify all the inputs of the preparation; the cache
+ * itself does not know what the key contains.
+ *
+ * All methods can be called from any thread.
+ *
+ * @ingroup resource
+ */
+class TextureCache
+{
+public:
+    /**
+     * Texture content read from the cache. The pixels remain valid until the
+     * object is deleted.
+     */
+    class MappedContent
+    {
+    public:
+        ~MappedContent();
+
+        /// Upload-ready texture content (@ref TXCF_UPLOAD_READY is set).
+        const texturecontent_t &content() const;
+
+        /// Dimensions of the prepared source image.
+        image_t::Size imageSize() const;
+
+        /// @ref imageFlags of the prepared source image.
+        int imageFlags() const;
+
+    private:
+        MappedContent();
+        friend class TextureCache;
+        DE_PRIVATE(d)
+    };
+
+public:
+    /**
+     * @param location  Native folder where the cached items are kept.
+     */
+    TextureCache(const de::NativePath &location);
+
+    /**
+     * Waits for the queued items to be written and saves the index of cached items.
+     */
+    ~TextureCache();
+
+    /**
+     * Returns @c true if the cache is enabled (cvar "rend-tex-cache").
+     */
+    bool isEnabled() const;
+
+    /**
+     * Finds a cached item.
+     *
+     * @param key  Key of the item.
+     *
+     * @return  Mapped content, or @c nullptr if the item is not in the cache.
+     * Caller gets ownership.
+     */
+    MappedContent *find(const de::Block &key);
+
+    /**
+     * Adds an item to the cache, replacing any existing item with the same key.
+     * The content is copied and written to disk in a background task; the item can
+     * be found after it has been written. The item is not added if too much data
+     * is already waiting to be written.
+     *
+     * @param key      Key of the item.
+     * @param content  Upload-ready texture content.
+     * @param image    Prepared source image (only the metadata is stored).
+     */
+    void insert(const de::Block &key, const texturecontent_t &content, const image_t &image);
+
+    /**
+     * Removes all items from the cache. Waits for the queued items to be written
+     * first.
+     */
+    void clear();
+
+    /**
+     * Total size of the cached items in bytes.
+     */
+    de::dint64 size() const;
+
+public:
+    /// Register the console commands and variables of this module.
+    static void consoleRegister();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // DE_CLIENT_RESOURCE_TEXTURECACHE_H
@@ -23,20 +23,25 @@
 #include <de/vector.h>
 #include <doomsday/defs/dedtypes.h>
 #include "map.h"
+#include "particlemotion.h"
 
 class Line;
 class Plane;
 struct mobj_s;
+struct ParticlePlanes;
+struct ParticleTouch;
 
 /**
  * POD structure used when querying the current state of a particle.
+ *
+ * The origin and momentum are stored separately; see Generator::particleOrigin()
+ * and Generator::particleMomentum().
  */
 struct ParticleInfo
 {
     int             stage;      // -1 => particle doesn't exist
     int16_t         tics;
-    fixed_t         origin[3];  // Coordinates.
-    fixed_t         mov[3];     // Momentum.
+    int8_t          onPlane;    // Stuck to a plane: -1 = floor, 1 = ceiling.
     world::BspLeaf *bspLeaf;    // Updated when needed.
     Line *          contact;    // Updated when lines hit/avoided.
     uint16_t        yaw, pitch; // Rotation angles (0-65536 => 0-360).
@@ -146,6 +151,25 @@ public:
      */
     void runTick();
 
+    /**
+     * Generate new particles and advance the stages of the existing ones. This is the
+     * first part of runTick(); the particles are moved afterwards with moveParticles().
+     */
+    void think();
+
+    /**
+     * Move the particles that were advanced by think(). The map is only read, so the
+     * particles of different generators can be moved concurrently. finishMove() must
+     * be called afterwards.
+     */
+    void moveParticles();
+
+    /**
+     * Play the sounds of the particles that touched something in moveParticles().
+     * Must be called in the main thread.
+     */
+    void finishMove();
+
     /**
      * Run the generator's thinker for the given number of @a tics.
      */
@@ -211,19 +235,32 @@ public: /// @todo make private:
     int newParticle();
 
     /**
-     * The movement is done in two steps:
+     * Apply the collisions of a particle that has been integrated to its new
+     * position. The movement is done in two steps:
      * Z movement is done first. Skyflat kills the particle.
      * XY movement checks for hits with solid walls (no backsector).
      * This is supposed to be fast and simple (but not too simple).
+     *
+     * @param index   Particle to move.
+     * @param planes  Floor and ceiling of the particle's BSP leaf.
+     * @param lines   Lines that the movement may cross.
      */
-    void moveParticle(int index);
+    void moveParticle(int index, const ParticlePlanes &planes,
+                      const de::List<world::Line *> &lines);
+
+    void spinParticle(int index);
 
-    void spinParticle(ParticleInfo &pt);
+    void killParticle(int index);
+
+    /**
+     * Apply the forces of the particle's current stage to its movement.
+     */
+    void updateParticleForces(int index);
 
-    float particleZ(const ParticleInfo &pt) const;
+    float particleZ(int index) const;
 
-    de::Vec3f particleOrigin(const ParticleInfo &pt) const;
-    de::Vec3f particleMomentum(const ParticleInfo &pt) const;
+    de::Vec3f particleOrigin(int index) const;
+    de::Vec3f particleMomentum(int index) const;
 
 public:
     /**
@@ -239,6 +276,11 @@ private:
     bool          _untriggered; // @c true= consider this as not yet triggered.
     int           _spawnCP;     // Particle spawn cursor.
     ParticleInfo *_pinfo;       // Info about each generated particle.
+    ParticleMotion _motion;     // Origins and momentums of the particles.
+    int *         _moveOrder;   // Particles in the order of collision checks.
+    ParticleTouch *_touches;    // Touch sounds to play after moving.
+    int           _touchCount;
+    bool          _movePending; // think() has advanced the particles.
 };
 
 typedef Generator::ParticleStage GeneratorParticleStage;
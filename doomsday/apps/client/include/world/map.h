@@ -205,6 +205,14 @@ public:  //- Particle generators -----------------------------------------------
 
     void unlinkGenerator(Generator &generator);
 
+    /**
+     * Move the particles of the generators that have thought since the previous call
+     * (see Generator::think()). To be called after the thinkers of a tic have been run.
+     * The generators are independent of each other, so they are moved in parallel
+     * when there are enough particles to make it worthwhile.
+     */
+    void moveGeneratorParticles();
+
 //- Skies -------------------------------------------------------------------------------
 
     SkyDrawable::Animator &skyAnimator() const;
@@ -0,0 +1,98 @@
+/** @file particlemotion.h  Batched integration of particle movement.
+ *
+ * @ingroup world
+ *
+ * This file has no dependencies to the rest of the client so that the integration
+ * can be benchmarked separately (see test_particles).
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_WORLD_PARTICLEMOTION_H
+#define DE_CLIENT_WORLD_PARTICLEMOTION_H
+
+#include <cstddef>
+
+/**
+ * Movement state of a set of particles, stored as separate arrays for each
+ * component (structure of arrays) so that the particles can be integrated in
+ * SIMD batches.
+ *
+ * The arrays are not owned: they are laid out in a block of memory provided by
+ * the user (see storageSize() and setStorage()). Each array has room for
+ * paddedCount() particles.
+ *
+ * @ingroup world
+ */
+struct ParticleMotion
+{
+    float *pos[3];    ///< Current position.
+    float *mov[3];    ///< Momentum (map units per tic).
+    float *force[3];  ///< Constant acceleration (vector force).
+    float *weight;    ///< Multiplier of the map's gravity.
+    float *drag;      ///< Momentum multiplier (one minus resistance).
+    float *next[3];   ///< Position after the latest integration step.
+
+    /**
+     * Number of elements in each array for @a count particles. Batches are four
+     * particles wide.
+     */
+    static int paddedCount(int count);
+
+    /**
+     * Size of the memory block (in bytes) needed for @a count particles.
+     */
+    static size_t storageSize(int count);
+
+    /**
+     * Points the arrays into @a storage, which must be at least storageSize(count)
+     * bytes and zero-filled. Particles with no forces and zero drag stay at rest.
+     */
+    void setStorage(void *storage, int count);
+
+    /**
+     * Sets the forces acting on a particle. Called when a particle changes stage.
+     */
+    void setForces(int index, const float vectorForce[3], float weight, float drag);
+
+    /**
+     * Removes all forces from a particle and stops it, so that an unused particle
+     * does not drift in subsequent integration steps.
+     */
+    void stop(int index);
+};
+
+/**
+ * Momentum below this is considered zero. This is the resolution of the fixed-point
+ * momentum that particles used to have, so they still come to rest in finite time.
+ */
+#define PARTICLE_MIN_MOMENTUM   (1.f / 65536.f)
+
+/**
+ * Advances all particles by one tic. The vector force is added to the momentum
+ * and the gravity is subtracted from the Z momentum, after which the momentum is
+ * multiplied by the drag. The new positions are written to ParticleMotion::next;
+ * the current positions are not modified so that collisions can be checked
+ * against the original positions.
+ *
+ * @param motion   Particles.
+ * @param count    Number of particles (padded to a multiple of the batch size).
+ * @param gravity  Gravity of the map.
+ */
+void integrateParticles(ParticleMotion &motion, int count, float gravity);
+
+#endif // DE_CLIENT_WORLD_PARTICLEMOTION_H
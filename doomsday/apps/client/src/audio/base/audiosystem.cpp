@@ -35,6 +35,7 @@
 #  include "audio/sfxchannel.h"
 #  include "audio/sys_audiod_dummy.h"
 #  include "world/audioenvironment.h"
+#  include "world/p_object.h"
 #  include "world/subsector.h"
 #  include <doomsday/defs/music.h>
 #  include <doomsday/filesys/fs_main.h>
@@ -64,6 +65,7 @@
 #include <de/legacy/memory.h>
 
 #include <de/hash.h>
+#include <de/set.h>
 
 using namespace de;
 using namespace res;
@@ -102,8 +104,9 @@ static volatile bool allowRefresh, refreshing;
 static bool sfxNoRndPitch;  ///< @todo should be a cvar.
 
 // Console variables:
-//static dint sfx16Bit;
-//static dint sfxSampleRate = 11025;
+static dint sfx16Bit;
+static dint sfxSampleRate = 11025;
+static byte sfxPrecache = true;
 static dint sfx3D;
 static dfloat sfxReverbStrength = 0.5f;
 static char *musMidiFontPath = (char *) "";
@@ -1411,14 +1414,13 @@ DE_PIMPL(AudioSystem)
         old3DMode = sfx3D;
     }
 
-#if 0
     void updateSfxSampleRateIfChanged()
     {
         static dint old16Bit = false;
         static dint oldRate  = 11025;
 
-        // Ensure the rate is valid.
-        if (sfxSampleRate != 11025 && sfxSampleRate != 22050 && sfxSampleRate != 44100)
+        // Ensure the rate is valid. Samples are resampled using any ratio.
+        if (sfxSampleRate < 11025 || sfxSampleRate > 96000)
         {
             LOG_AUDIO_WARNING("\"sound-rate\" corrected to 11025 from invalid value (%i)") << sfxSampleRate;
             sfxSampleRate = 11025;
@@ -1445,7 +1447,37 @@ DE_PIMPL(AudioSystem)
             oldRate  = sfxSampleRate;
         }
     }
-#endif
+
+    /**
+     * Convert the sound samples used by the things of the current map beforehand,
+     * so that there is no delay when they are played for the first time.
+     */
+    void cacheSfxForCurrentMap()
+    {
+        if (!sfxAvail || !sfxPrecache) return;
+        if (!world::World::get().hasMap()) return;
+
+        Set<dint> used;
+        world::World::get().map().thinkers().forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker),
+                                                    0x1/*public*/, [&used] (thinker_t *th)
+        {
+            const auto &mob = *reinterpret_cast<mobj_t *>(th);
+            if (mob.type >= 0 && mob.type < ::runtimeDefs.mobjInfo.size())
+            {
+                const mobjinfo_t &info = ::runtimeDefs.mobjInfo[mob.type];
+                for (dint soundId : { info.seeSound, info.attackSound, info.painSound,
+                                      info.deathSound, info.activeSound })
+                {
+                    if (soundId > 0) used << soundId;
+                }
+            }
+            return LoopContinue;
+        });
+
+        List<dint> soundIds;
+        for (dint soundId : used) soundIds << soundId;
+        sfxSampleCache.cacheAll(soundIds);
+    }
 
     void sfxSampleCacheAboutToRemove(const sfxsample_t &sample)
     {
@@ -1583,7 +1615,7 @@ void AudioSystem::startFrame()
 
         // Have there been changes to the cvar settings?
         d->updateSfx3DModeIfChanged();
-        //d->updateSfxSampleRateIfChanged();
+        d->updateSfxSampleRateIfChanged();
 
         // Should we purge the cache (to conserve memory)?
         d->sfxSampleCache.maybeRunPurge();
@@ -2500,6 +2532,8 @@ void AudioSystem::worldMapChanged()
 {
     // Update who is listening now.
     setSfxListener(S_GetListenerMobj());
+
+    d->cacheSfxForCurrentMap();
 }
 #endif
 
@@ -2678,12 +2712,15 @@ void AudioSystem::consoleRegister()  // static
 {
     // Sound effects:
 #ifdef __CLIENT__
-    //C_VAR_INT     ("sound-16bit",         &sfx16Bit,              0, 0, 1);
+    C_VAR_INT     ("sound-16bit",         &sfx16Bit,              0, 0, 1);
     C_VAR_INT     ("sound-3d",            &sfx3D,                 0, 0, 1);
 #endif
     C_VAR_BYTE    ("sound-overlap-stop",  &sfxOneSoundPerEmitter, 0, 0, 1);
+
+    audio::SfxSampleCache::consoleRegister();
 #ifdef __CLIENT__
-    //C_VAR_INT     ("sound-rate",          &sfxSampleRate,         0, 11025, 44100);
+    C_VAR_BYTE    ("sound-precache",      &sfxPrecache,           0, 0, 1);
+    C_VAR_INT     ("sound-rate",          &sfxSampleRate,         0, 11025, 96000);
     C_VAR_FLOAT2  ("sound-reverb-volume", &sfxReverbStrength,     0, 0, 1.5f, sfxReverbStrengthChanged);
     C_VAR_INT     ("sound-volume",        &sfxVolume,             0, 0, 255);
 
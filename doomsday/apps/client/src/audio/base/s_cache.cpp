@@ -23,11 +23,18 @@
 #include "dd_main.h"  // App_AudioSystem()
 #include "def_main.h"  // Def_Get*()
 #include "audio/audiosystem.h"
+#include "audio/s_resample.h"
 
+#include <doomsday/console/cmd.h>
+#include <doomsday/console/var.h>
 #include <doomsday/filesys/fs_main.h>
 #include <doomsday/wav.h>
 #include <de/legacy/timer.h>
+#include <de/hash.h>
+#include <de/set.h>
+#include <de/taskpool.h>
 #include <cstring>
+#include <memory>
 
 using namespace de;
 using namespace res;
@@ -46,239 +53,36 @@ static const dint CACHE_HASH_SIZE  = 64;
 static const timespan_t PURGE_TIME = 10 * TICSPERSEC;
 
 // 1 Mb = about 12 sec of 44KHz 16bit sound in the cache.
-static const dint MAX_CACHE_KB     = 4096;
+static dint maxCacheKB = 4096;  // cvar: 0 = no limit
 
 // Even one minute of silence is quite a long time during gameplay.
 static const dint MAX_CACHE_TICS   = TICSPERSEC * 60 * 4;  // 4 minutes.
 
-#if 0
 /**
- * Determines the necessary upsample factor for the given sample @a rate.
+ * Waveform of a sound as loaded from its resource, before conversion to the
+ * format of the cache.
  */
-static dint upsampleFactor(dint rate)
+struct SourceSample
 {
-    dint factor = 1;
-#ifdef __CLIENT__
-    // The (up)sampling factor.
-    if (App_AudioSystem().mustUpsampleToSfxRate())
-    {
-        factor = de::max(1, ::sfxRate / rate);
-    }
-#else
-    DE_UNUSED(rate);
-#endif
-    return factor;
-}
-
-// Utility for converting an unsigned byte to signed short (for resampling).
-static dshort inline U8_S16(duchar b)
-{
-    return (b - 0x80) << 8;
-}
-
-/**
- * Simple linear resampling with possible conversion to 16 bits. The destination sample
- * must be initialized and it must have a large enough buffer. We won't reduce rate or
- * bits here.
- *
- * @note This is not a clean way to resample a sound. If you read about DSP a bit, you'll
- * find out that interpolation adds a lot of extra frequencies in the sample. It should
- * be low-pass filtered after the interpolation.
- */
-static void resample(void *dst, dint dstBytesPer, dint dstRate, const void *src,
-    dint srcBytesPer, dint srcRate, dint srcNumSamples, duint srcSize)
-{
-    DE_ASSERT(src && dst);
-
-    // Let's first check for the easy cases.
-    if (dstRate == srcRate)
-    {
-        if (srcBytesPer == dstBytesPer)
-        {
-            // A simple copy will suffice.
-            std::memcpy(dst, src, srcSize);
-        }
-        else if (srcBytesPer == 1 && dstBytesPer == 2)
-        {
-            // Just changing the bytes won't do much good...
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples; ++i)
-            {
-                *dp++ = (*sp++ - 0x80) << 8;
-            }
-        }
-        return;
-    }
-
-    // 2x resampling.
-    if (dstRate == 2 * srcRate)
-    {
-        if (dstBytesPer == 1)
-        {
-            // The source has a byte per sample as well.
-            const duchar *sp = (const duchar *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
-
-            // Fill in the last two as well.
-            dp[0] = dp[1] = *sp;
-        }
-        else if (srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const dshort first = U8_S16(*sp);
-
-                *dp++ = first;
-                *dp++ = (first + U8_S16(sp[1])) >> 1;
-            }
-
-            // Fill in the last two as well.
-            dp[0] = dp[1] = U8_S16(*sp);
-        }
-        else if (srcBytesPer == 2)
-        {
-            // Destination is signed 16bit. Source is 16bit.
-            const dshort *sp = (const dshort *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
-
-            dp[0] = dp[1] = *sp;
-        }
-        return;
-    }
-
-    // 4x resampling (11Khz => 44KHz only).
-    if (dstRate == 4 * srcRate)
+    const void *data = nullptr;
+    dint bytesPer    = 0;
+    dint rate        = 0;
+    dint numSamples  = 0;
+    void *loaded     = nullptr;  ///< Data loaded by WAV_Load() (owned).
+    File1 *lump      = nullptr;  ///< Lump whose cached content @a data points to.
+
+    ~SourceSample()
     {
-        if (dstBytesPer == 1)
-        {
-            // The source has a byte per sample as well.
-            const duchar *sp = (const duchar *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const duchar mid = (*sp + sp[1]) >> 1;
-
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
-
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
-        else if (srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const dshort first = U8_S16(*sp);
-                const dshort last  = U8_S16(sp[1]);
-                const dshort mid   = (first + last) >> 1;
-
-                *dp++ = first;
-                *dp++ = (first + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + last) >> 1;
-            }
-
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = U8_S16(*sp);
-        }
-        else if (srcBytesPer == 2)
-        {
-            // Destination is signed 16bit. Source is 16bit.
-            const dshort *sp = (const dshort *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const dshort mid = (*sp + sp[1]) >> 1;
-
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
-
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
+        if (loaded) Z_Free(loaded);
+        if (lump) lump->unlock();
     }
-}
-#endif
-
-/**
- * Prepare the given sound sample @a smp for caching.
- *
- * If the sample @a data is already in the right format, just make a copy of it.
- *
- * If necessary, resample the sound @a data upwards to the minimum resolution and
- * bits (specified in the user Config). (You can play higher resolution sounds
- * than the current setting, but not lower resolution ones.)
- *
- * Converts the sample @a data and writes it to the (M_Malloc() allocated) buffer in @a smp
- * (ownership is given to the sfxsample_t).
- *
- * @param data        Actual sample data.
- * @param size        Size in bytes.
- * @param numSamples  Number of samples.
- * @param bytesPer    Bytes per sample (1 or 2).
- * @param rate        Samples per second.
- */
-void configureSample(sfxsample_t &smp, const void *data, duint size,
-                     dint numSamples, dint bytesPer, dint rate)
-{
-    DE_UNUSED(data);
-    DE_UNUSED(size);
-
-    zap(smp);
-    smp.bytesPer   = bytesPer;
-    smp.size       = numSamples * bytesPer;
-    smp.rate       = rate;
-    smp.numSamples = numSamples;
-
-#if 0
-    // Apply the upsample factor.
-    const dint rsfactor = upsampleFactor(rate);
-    smp.rate       *= rsfactor;
-    smp.numSamples *= rsfactor;
-    smp.size       *= rsfactor;
-
-    // Resample to 16bit?
-    if (::sfxBits == 16 && smp.bytesPer == 1)
-    {
-        smp.bytesPer = 2;
-        smp.size     *= 2;
-    }
-#endif
-}
+};
 
 SfxSampleCache::CacheItem::CacheItem()
     : next(nullptr)
     , prev(nullptr)
+    , lruPrev(nullptr)
+    , lruNext(nullptr)
     , hits(0)
     , lastUsed(0)
 {
@@ -321,8 +125,21 @@ DE_PIMPL(SfxSampleCache)
 
     dint lastPurge = 0;  ///< Time of the last purge (in game ticks).
 
+    /// All items in the order of use, least recently used first.
+    CacheItem *lruFirst = nullptr;
+    CacheItem *lruLast  = nullptr;
+    dsize totalSize     = 0;  ///< Size of all items and their sample data, in bytes.
+    Stats stats;
+
+    de::Hash<duint64, Resampler *> resamplers;  ///< Key: source and target rates.
+
     Impl(Public *i) : Base(i) {}
-    ~Impl() { removeAll(); }
+
+    ~Impl()
+    {
+        removeAll();
+        resamplers.deleteAll();
+    }
 
     /**
      * Find the appropriate hash for the given @a soundId.
@@ -350,6 +167,83 @@ DE_PIMPL(SfxSampleCache)
         return nullptr;  // Not found.
     }
 
+    static dsize sizeOf(const CacheItem &item)
+    {
+        return item.sample.size + sizeof(item);
+    }
+
+    static dsize maxSize()
+    {
+        return dsize(de::max(0, maxCacheKB)) * 1024;
+    }
+
+    /**
+     * Determines whether the sample of the cache @a item is being played.
+     */
+    static bool isPlaying(const CacheItem &item)
+    {
+#ifdef __CLIENT__
+        return App_AudioSystem().sfxChannels().isPlaying(item.sample.id);
+#else
+        DE_UNUSED(item);
+        return false;
+#endif
+    }
+
+    void lruLink(CacheItem &item)
+    {
+        item.lruPrev = lruLast;
+        item.lruNext = nullptr;
+        if (lruLast) lruLast->lruNext = &item;
+        else         lruFirst = &item;
+        lruLast = &item;
+    }
+
+    void lruUnlink(CacheItem &item)
+    {
+        if (item.lruPrev) item.lruPrev->lruNext = item.lruNext;
+        else              lruFirst = item.lruNext;
+        if (item.lruNext) item.lruNext->lruPrev = item.lruPrev;
+        else              lruLast = item.lruPrev;
+        item.lruPrev = item.lruNext = nullptr;
+    }
+
+    /**
+     * Make @a item the most recently used one.
+     */
+    void touch(CacheItem &item)
+    {
+        if (lruLast != &item)
+        {
+            lruUnlink(item);
+            lruLink(item);
+        }
+        item.lastUsed = Timer_Ticks();
+    }
+
+    /**
+     * Remove the least recently used items until the cache is within the size limit.
+     * Samples that are playing are never removed.
+     *
+     * @param keep  Item that must not be removed.
+     */
+    void evictToMaxSize(const CacheItem *keep = nullptr)
+    {
+        const dsize limit = maxSize();
+        if (!limit) return;
+
+        CacheItem *next = nullptr;
+        for (CacheItem *it = lruFirst; it && totalSize > limit; it = next)
+        {
+            next = it->lruNext;
+            if (it == keep || isPlaying(*it)) continue;
+
+            stats.evictions    += 1;
+            stats.evictedBytes += sizeOf(*it);
+            removeCacheItem(*it);
+        }
+    }
+
     /**
      * Add a new CacheItem with the given @a soundId to the hash and return
      * it (ownership is retained).
@@ -357,6 +251,8 @@ DE_PIMPL(SfxSampleCache)
     CacheItem &insertCacheItem(dint soundId)
     {
         auto *item = new CacheItem;
+        lruLink(*item);
+        totalSize += sizeOf(*item);
 
         Hash &hash = hashFor(soundId);
         if (hash.last)
@@ -393,6 +289,9 @@ DE_PIMPL(SfxSampleCache)
         if (item.prev)
             item.prev->next = item.next;
 
+        lruUnlink(item);
+        totalSize -= sizeOf(item);
+
 #ifdef __CLIENT__
         App_AudioSystem().allowSfxRefresh(true);
 #endif
@@ -400,58 +299,230 @@ DE_PIMPL(SfxSampleCache)
         // Free all memory allocated for the item.
         delete &item;
     }
+
     /**
-     * Caches a copy of the given sample. If it's already in the cache and has the
-     * same format, nothing is done.
+     * Returns a resampler for converting from @a sourceRate to @a targetRate.
+     * Resamplers are kept for reuse (ownership is retained).
+     */
+    const Resampler &resamplerFor(dint sourceRate, dint targetRate)
+    {
+        const duint64 key = (duint64(sourceRate) << 32) | duint32(targetRate);
+        auto found = resamplers.find(key);
+        if (found != resamplers.end())
+        {
+            return *found->second;
+        }
+        auto *resampler = new Resampler(sourceRate, targetRate);
+        resamplers.insert(key, resampler);
+        return *resampler;
+    }
+
+    /**
+     * Locate and load the waveform of a sound. It might be from a data file such as
+     * a WAD or external sound resources. The definition and the configuration
+     * settings will help us in making the decision.
      *
-     * @param soundId       Id number of the sound sample.
-     * @param data          Actual sample data.
-     * @param size          Size in bytes.
-     * @param numSamples    Number of samples.
-     * @param bytesPer      Bytes per sample (1 or 2).
-     * @param rate          Samples per second.
-     * @param group         Exclusion group (0, if none).
+     * @param info    Sound definition.
+     * @param source  The loaded waveform is written here.
      *
-     * @returns             Ptr to the cached sample. Always valid.
+     * @return  @c true if the waveform was loaded.
      */
-    CacheItem &insert(dint soundId, const void *data, duint size, dint numSamples,
-        dint bytesPer, dint rate, dint group)
+    bool loadSource(sfxinfo_t &info, SourceSample &source)
     {
-        sfxsample_t cached;
-        configureSample(cached, data, size, numSamples, bytesPer, rate);
+        /// Has an external sound file been defined?
+        /// @note Path is relative to the base path.
+        if (!Str_IsEmpty(&info.external))
+        {
+            String searchPath = App_BasePath() / String(Str_Text(&info.external));
+            // Try loading.
+            source.loaded = WAV_Load(searchPath, &source.bytesPer, &source.rate, &source.numSamples);
+        }
 
-        // Have we already cached a comparable sample?
-        CacheItem *item = tryFind(soundId);
-        if (item)
+        // If external didn't succeed, let's try the default resource dir.
+        if (!source.loaded)
         {
-            // A sample is already in the cache.
-            // If the existing sample is in the same format - use it.
-            if (cached.bytesPer * 8 == ::sfxBits && cached.rate == ::sfxRate)
-                return *item;
+            /**
+             * If the sound has an invalid lumpname, search external anyway. If the
+             * original sound is from a PWAD, we won't look for an external resource
+             * (probably a custom sound).
+             *
+             * @todo should be a cvar.
+             */
+            if (info.lumpNum < 0 || !App_FileSystem().lump(info.lumpNum).container().hasCustom())
+            {
+                try
+                {
+                    String foundPath = App_FileSystem().findPath(res::Uri(info.lumpName, RC_SOUND),
+                                                                 RLF_DEFAULT, App_ResourceClass(RC_SOUND));
+                    foundPath = App_BasePath() / foundPath;  // Ensure the path is absolute.
 
-            // Sample format differs - uncache it (we'll reuse this CacheItem).
-            notifyRemove(*item);
+                    source.loaded = WAV_Load(foundPath, &source.bytesPer, &source.rate, &source.numSamples);
+                }
+                catch (const FS1::NotFoundError &)
+                {}  // Ignore this error.
+            }
         }
-        else
+
+        // No sample loaded yet?
+        if (!source.loaded)
         {
-            // Add a new CacheItem for the sample.
-            item = &insertCacheItem(soundId);
+            // Try loading from the lump.
+            if (info.lumpNum < 0)
+            {
+                LOG_AUDIO_WARNING("Failed to locate lump resource '%s' for sample '%s'")
+                    << info.lumpName << info.id;
+                return false;
+            }
+
+            File1 &lump = App_FileSystem().lump(info.lumpNum);
+            if (lump.size() <= 8) return false;
+
+            char hdr[12];
+            lump.read((duint8 *)hdr, 0, 12);
+
+            // Is this perhaps a WAV sound?
+            if (WAV_CheckFormat(hdr))
+            {
+                // Load as WAV, then.
+                const duint8 *sp = lump.cache();
+                source.loaded = WAV_MemoryLoad((const byte *) sp, lump.size(), &source.bytesPer,
+                                               &source.rate, &source.numSamples);
+                lump.unlock();
+
+                if (!source.loaded)
+                {
+                    // Abort...
+                    LOG_AUDIO_WARNING("Unknown WAV format in lump '%s'") << info.lumpName;
+                    return false;
+                }
+            }
         }
 
-        // Attribute the sample with tracking identifiers.
-        cached.id    = soundId;
-        cached.group = group;
+        if (source.loaded)  // Loaded!
+        {
+            source.data      = source.loaded;
+            source.bytesPer /= 8;  // Was returned as bits.
+        }
+        else if (info.lumpNum >= 0)
+        {
+            // Probably an old-fashioned DOOM sample.
+            File1 &lump = App_FileSystem().lump(info.lumpNum);
+
+            duint8 hdr[8];
+            lump.read(hdr, 0, 8);
+            dint head         = DD_SHORT(*(const dshort *) (hdr));
+            source.rate       = DD_SHORT(*(const dshort *) (hdr + 2));
+            source.numSamples = de::max(0, DD_LONG(*(const dint *) (hdr + 4)));
+            source.bytesPer   = 1; // 8-bit.
+
+            if (head == 3 && source.numSamples > 0 && dsize(source.numSamples) <= lump.size() - 8)
+            {
+                // The sample data can be used as-is - load directly from the lump cache.
+                source.data = lump.cache() + 8;  // Skip the header.
+                source.lump = &lump;
+            }
+        }
 
-#if 0
-        // Perform resampling if necessary.
-        resample(cached.data = M_Malloc(cached.size), cached.bytesPer, cached.rate,
-                 data, bytesPer, rate, numSamples, size);
+        if (!source.data)
+        {
+            LOG_AUDIO_WARNING("Unknown lump '%s' sound format") << info.lumpName;
+            return false;
+        }
+        if (source.rate <= 0)
+        {
+            LOG_AUDIO_WARNING("Invalid sample rate %i in sound '%s'") << source.rate << info.id;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Prepare a cached copy of the given @a source waveform. The format of the copy
+     * is determined and a buffer for it is allocated (M_Malloc(); ownership is given
+     * to the sfxsample_t).
+     *
+     * If necessary, the sound is resampled upwards to the rate and bits of the sound
+     * buffers (specified in the user Config). (You can play higher resolution sounds
+     * than the current setting, but not lower resolution ones.)
+     *
+     * @param smp      Sample to configure.
+     * @param source   Source waveform.
+     * @param soundId  Id number of the sound sample.
+     * @param group    Exclusion group (0, if none).
+     *
+     * @return  Resampler for converting @a source to the format of @a smp.
+     */
+    const Resampler &configureSample(sfxsample_t &smp, const SourceSample &source,
+                                     dint soundId, dint group)
+    {
+        zap(smp);
+        smp.id         = soundId;
+        smp.group      = group;
+        smp.bytesPer   = source.bytesPer;
+        smp.rate       = source.rate;
+        smp.numSamples = source.numSamples;
+
+#ifdef __CLIENT__
+        // The driver may require all samples to have the rate of the buffers.
+        if (App_AudioSystem().mustUpsampleToSfxRate() && smp.rate < ::sfxRate)
+        {
+            smp.rate = ::sfxRate;
+        }
 #endif
-        cached.data = M_Malloc(cached.size);
-        std::memcpy(cached.data, data, size);
+        const Resampler &resampler = resamplerFor(source.rate, smp.rate);
+        smp.numSamples = dint(resampler.outputLength(dsize(source.numSamples)));
+
+        // Resample to 16bit?
+        if (::sfxBits == 16 && smp.bytesPer == 1)
+        {
+            smp.bytesPer = 2;
+        }
+
+        smp.size = duint(smp.numSamples * smp.bytesPer);
+        smp.data = M_Malloc(smp.size);
+        return resampler;
+    }
+
+    /**
+     * Convert the @a source waveform to the format of the sample @a smp (see
+     * configureSample()). Can be called from any thread.
+     */
+    static void convertSample(sfxsample_t &smp, const SourceSample &source,
+                              const Resampler &resampler)
+    {
+        resampler.resample(smp.data, smp.bytesPer, source.data, source.bytesPer,
+                           dsize(source.numSamples));
+    }
+
+    /**
+     * Place the prepared sample @a cached in the cache. If the sound is already
+     * in the cache, the existing sample is replaced. The new sample becomes the
+     * most recently used one, and older samples are removed if the cache would
+     * exceed its size limit.
+     *
+     * @returns  The CacheItem of the sample. Always valid.
+     */
+    CacheItem &insert(sfxsample_t &cached)
+    {
+        CacheItem *item = tryFind(cached.id);
+        if (item)
+        {
+            // Uncache the existing sample (we'll reuse this CacheItem).
+            notifyRemove(*item);
+        }
+        else
+        {
+            // Add a new CacheItem for the sample.
+            item = &insertCacheItem(cached.id);
+        }
 
         // Replace the cached sample.
+        totalSize -= item->sample.size;
         item->replaceSample(cached);
+        totalSize += item->sample.size;
+
+        touch(*item);
+        evictToMaxSize(item);
 
         return *item;
     }
@@ -511,69 +582,29 @@ void SfxSampleCache::maybeRunPurge()
 
     d->lastPurge = nowTime;
 
-    // Count the total size of the cache.
-    // Also get rid of all sounds that have timed out.
-    dint totalSize  = 0;
+    // Get rid of all sounds that have timed out. The least recently used ones
+    // are first in the list.
     CacheItem *next = nullptr;
-    for (Impl::Hash &hash : d->hash)
-    for (CacheItem *it = hash.first; it; it = next)
-    {
-        next = it->next;
-        if (nowTime - it->lastUsed > MAX_CACHE_TICS)
-        {
-            // This sound hasn't been used in a looong time.
-            d->removeCacheItem(*it);
-            continue;
-        }
-
-        totalSize += it->sample.size + sizeof(*it);
-    }
-
-    const dint maxSize = MAX_CACHE_KB * 1024;
-    dint lowHits = 0;
-    CacheItem *lowest;
-    while(totalSize > maxSize)
+    for (CacheItem *it = d->lruFirst; it && nowTime - it->lastUsed > MAX_CACHE_TICS; it = next)
     {
-        /*
-         * The cache is too large! Find the stopped sample with the lowest hitcount
-         * and get rid of it. Repeat until cache size is within limits or there are
-         * no more stopped sounds.
-         */
-        lowest = 0;
-        for (Impl::Hash &hash : d->hash)
-        {
-            for (CacheItem *it = hash.first; it; it = it->next)
-            {
-#ifdef __CLIENT__
-                // If the sample is playing we won't remove it now.
-                if (App_AudioSystem().sfxChannels().isPlaying(it->sample.id))
-                    continue;
-#endif
-
-                // This sample could be removed, let's check the hits.
-                if (!lowest || it->hits < lowHits)
-                {
-                    lowest  = it;
-                    lowHits = it->hits;
-                }
-            }
-        }
+        next = it->lruNext;
 
-        // No more samples to remove?
-        if (!lowest) break;
+        // If the sample is playing we won't remove it now.
+        if (Impl::isPlaying(*it)) continue;
 
-        // Stop and uncache this cached sample.
-        totalSize -= lowest->sample.size + sizeof(*lowest);
-        d->removeCacheItem(*lowest);
+        // This sound hasn't been used in a looong time.
+        d->removeCacheItem(*it);
     }
+
+    // The size limit may have been changed.
+    d->evictToMaxSize();
 }
 
 void SfxSampleCache::info(duint *cacheBytes, duint *sampleCount)
 {
     duint size  = 0;
     duint count = 0;
-    for (Impl::Hash &hash : d->hash)
-    for (CacheItem *it = hash.first; it; it = it->next)
+    for (CacheItem *it = d->lruFirst; it; it = it->lruNext)
     {
         size  += it->sample.size;
         count += 1;
@@ -588,9 +619,15 @@ void SfxSampleCache::hit(dint soundId)
     if (CacheItem *found = d->tryFind(soundId))
     {
         found->hit();
+        d->touch(*found);
     }
 }
 
+SfxSampleCache::Stats SfxSampleCache::stats() const
+{
+    return d->stats;
+}
+
 sfxsample_t *SfxSampleCache::cache(dint soundId)
 {
     LOG_AS("SfxSampleCache");
@@ -607,7 +644,11 @@ sfxsample_t *SfxSampleCache::cache(dint soundId)
 
     // Have we already cached this?
     if (CacheItem *existing = d->tryFind(soundId))
+    {
+        d->stats.hits += 1;
         return &existing->sample;
+    }
+    d->stats.misses += 1;
 
     // Lookup info for this sound.
     sfxinfo_t *info = Def_GetSoundInfo(soundId, 0, 0);
@@ -620,138 +661,102 @@ sfxsample_t *SfxSampleCache::cache(dint soundId)
     // Attempt to cache this now.
     LOG_AUDIO_VERBOSE("Caching sample '%s' (id:%i)...") << info->id << soundId;
 
-    dint bytesPer = 0;
-    dint rate = 0;
-    dint numSamples = 0;
+    SourceSample source;
+    if (!d->loadSource(*info, source)) return nullptr;
 
-    /**
-     * Figure out where to get the sample data for this sound. It might be from a
-     * data file such as a WAD or external sound resources. The definition and the
-     * configuration settings will help us in making the decision.
-     */
-    void *data = nullptr;
-
-    /// Has an external sound file been defined?
-    /// @note Path is relative to the base path.
-    if (!Str_IsEmpty(&info->external))
-    {
-        String searchPath = App_BasePath() / String(Str_Text(&info->external));
-        // Try loading.
-        data = WAV_Load(searchPath, &bytesPer, &rate, &numSamples);
-        if (data)
-        {
-            bytesPer /= 8; // Was returned as bits.
-        }
-    }
+    // Insert a copy of this into the cache.
+    sfxsample_t cached;
+    const Resampler &resampler = d->configureSample(cached, source, soundId, info->group);
+    Impl::convertSample(cached, source, resampler);
+    return &d->insert(cached).sample;
+}
 
-    // If external didn't succeed, let's try the default resource dir.
-    if (!data)
-    {
-        /**
-         * If the sound has an invalid lumpname, search external anyway. If the
-         * original sound is from a PWAD, we won't look for an external resource
-         * (probably a custom sound).
-         *
-         * @todo should be a cvar.
-         */
-        if (info->lumpNum < 0 || !App_FileSystem().lump(info->lumpNum).container().hasCustom())
-        {
-            try
-            {
-                String foundPath = App_FileSystem().findPath(res::Uri(info->lumpName, RC_SOUND),
-                                                             RLF_DEFAULT, App_ResourceClass(RC_SOUND));
-                foundPath = App_BasePath() / foundPath;  // Ensure the path is absolute.
+void SfxSampleCache::cacheAll(const List<dint> &soundIds)
+{
+    LOG_AS("SfxSampleCache");
 
-                data = WAV_Load(foundPath, &bytesPer, &rate, &numSamples);
-                if (data)
-                {
-                    // Loading was successful.
-                    bytesPer /= 8;  // Was returned as bits.
-                }
-            }
-            catch (const FS1::NotFoundError &)
-            {}  // Ignore this error.
-        }
-    }
+#ifdef __CLIENT__
+    if (!App_AudioSystem().sfxIsAvailable()) return;
+#endif
 
-    // No sample loaded yet?
-    if (!data)
+    struct Work
     {
-        // Try loading from the lump.
-        if (info->lumpNum < 0)
-        {
-            LOG_AUDIO_WARNING("Failed to locate lump resource '%s' for sample '%s'")
-                << info->lumpName << info->id;
-            return nullptr;
-        }
+        SourceSample source;
+        sfxsample_t sample;
+        const Resampler *resampler;
+    };
+    List<Work *> batch;
+
+    // Files are accessed in this thread.
+    Set<dint> pending;
+    for (dint soundId : soundIds)
+    {
+        if (soundId <= 0 || pending.contains(soundId) || d->tryFind(soundId)) continue;
 
-        File1 &lump = App_FileSystem().lump(info->lumpNum);
-        if (lump.size() <= 8) return nullptr;
+        sfxinfo_t *info = Def_GetSoundInfo(soundId, 0, 0);
+        if (!info) continue;
 
-        char hdr[12];
-        lump.read((duint8 *)hdr, 0, 12);
+        std::unique_ptr<Work> work(new Work);
+        if (!d->loadSource(*info, work->source)) continue;
 
-        // Is this perhaps a WAV sound?
-        if (WAV_CheckFormat(hdr))
-        {
-            // Load as WAV, then.
-            const duint8 *sp = lump.cache();
-            data = WAV_MemoryLoad((const byte *) sp, lump.size(), &bytesPer, &rate, &numSamples);
-            lump.unlock();
+        work->resampler = &d->configureSample(work->sample, work->source, soundId, info->group);
+        pending << soundId;
+        batch << work.release();
+    }
+    if (batch.isEmpty()) return;
 
-            if (!data)
+    // The conversions are independent of each other.
+    {
+        TaskPool tasks;
+        for (Work *work : batch)
+        {
+            tasks.start([work] ()
             {
-                // Abort...
-                LOG_AUDIO_WARNING("Unknown WAV format in lump '%s'") << info->lumpName;
-                return nullptr;
-            }
-
-            bytesPer /= 8;
+                Impl::convertSample(work->sample, work->source, *work->resampler);
+            });
         }
+        tasks.waitForDone();
     }
 
-    if (data)  // Loaded!
+    for (Work *work : batch)
     {
-        // Insert a copy of this into the cache.
-        CacheItem &item = d->insert(soundId, data, bytesPer * numSamples, numSamples,
-                                    bytesPer, rate, info->group);
-        Z_Free(data);
-        return &item.sample;
+        d->insert(work->sample);
     }
+    LOG_AUDIO_VERBOSE("Cached %i samples") << batch.size();
+    deleteAll(batch);
+}
 
-    // Probably an old-fashioned DOOM sample.
-    dsize lumpLength = 0;
-    if (info->lumpNum >= 0)
-    {
-        File1 &lump = App_FileSystem().lump(info->lumpNum);
-
-        if (lump.size() > 8)
-        {
-            duint8 hdr[8];
-            lump.read(hdr, 0, 8);
-            dint head  = DD_SHORT(*(const dshort *) (hdr));
-            rate       = DD_SHORT(*(const dshort *) (hdr + 2));
-            numSamples = de::max(0, DD_LONG(*(const dint *) (hdr + 4)));
-            bytesPer   = 1; // 8-bit.
-
-            if (head == 3 && numSamples > 0 && (unsigned) numSamples <= lumpLength - 8)
-            {
-                // The sample data can be used as-is - load directly from the lump cache.
-                const duint8 *data = lump.cache() + 8;  // Skip the header.
-
-                // Insert a copy of this into the cache.
-                CacheItem &item = d->insert(soundId, data, bytesPer * numSamples, numSamples,
-                                            bytesPer, rate, info->group);
-
-                lump.unlock();
+/**
+ * Console command for printing the usage statistics of the sample cache.
+ */
+D_CMD(SoundCacheInfo)
+{
+    DE_UNUSED(src, argc, argv);
+
+    SfxSampleCache &cache = App_AudioSystem().sfxSampleCache();
+    const SfxSampleCache::Stats stats = cache.stats();
+
+    duint cacheBytes = 0, sampleCount = 0;
+    cache.info(&cacheBytes, &sampleCount);
+
+    const duint64 lookups = stats.hits + stats.misses;
+    LOG_SCR_MSG(_E(b) "Sound sample cache:");
+    LOG_SCR_MSG("  %i samples, %.1f KB (limit: %s)")
+        << sampleCount << cacheBytes / 1024.0
+        << (maxCacheKB > 0 ? Stringf("%i KB", maxCacheKB) : String("none"));
+    LOG_SCR_MSG("  Hits: %i  Misses: %i  (%.1f%% hit rate)")
+        << stats.hits << stats.misses
+        << (lookups ? 100.0 * stats.hits / lookups : 0.0);
+    LOG_SCR_MSG("  Evicted: %i samples, %.1f KB")
+        << stats.evictions << stats.evictedBytes / 1024.0;
+    return true;
+}
 
-                return &item.sample;
-            }
-        }
-    }
+void SfxSampleCache::consoleRegister()  // static
+{
+    C_VAR_INT("sound-cache-size", &maxCacheKB, CVF_NO_MAX, 0, 0);
 
-    LOG_AUDIO_WARNING("Unknown lump '%s' sound format") << info->lumpName;
-    return nullptr;
+    C_CMD("soundcacheinfo", "", SoundCacheInfo);
 }
 
 }  // namespace audio
@@ -0,0 +1,314 @@
+/** @file s_resample.cpp  Sample rate and format conversion of sound samples.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "audio/s_resample.h"
+
+#include <de/list.h>
+#include <de/math.h>
+#include <cmath>
+#include <cstring>
+
+// SSE2 and NEON are part of the baseline of the 64-bit targets, so there is no
+// need for runtime detection.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define RESAMPLE_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#  define RESAMPLE_NEON
+#  include <arm_neon.h>
+#endif
+
+using namespace de;
+
+namespace audio {
+
+/// Maximum number of filter phases. If the ratio of the rates needs more, the
+/// nearest phase is used (off by at most 1/512th of a source sample).
+static const dint MAX_PHASES = 256;
+
+/// Number of zero crossings of the sinc function on each side of the center.
+static const dint ZERO_CROSSINGS = 8;
+
+/// Cutoff frequency relative to the Nyquist frequency of the lower rate.
+static const ddouble ROLLOFF = 0.9;
+
+static dint greatestCommonDivisor(dint a, dint b)
+{
+    while (b)
+    {
+        const dint r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/**
+ * Multiplies and sums @a count values (a multiple of 4).
+ */
+static inline dfloat dotProduct(const dfloat *a, const dfloat *b, dint count)
+{
+#if defined(RESAMPLE_SSE2)
+    __m128 sum = _mm_setzero_ps();
+    for (dint i = 0; i < count; i += 4)
+    {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+#elif defined(RESAMPLE_NEON)
+    float32x4_t sum = vdupq_n_f32(0);
+    for (dint i = 0; i < count; i += 4)
+    {
+        sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    const float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#else
+    dfloat sum[4] = { 0, 0, 0, 0 };
+    for (dint i = 0; i < count; i += 4)
+    {
+        sum[0] += a[i]     * b[i];
+        sum[1] += a[i + 1] * b[i + 1];
+        sum[2] += a[i + 2] * b[i + 2];
+        sum[3] += a[i + 3] * b[i + 3];
+    }
+    return (sum[0] + sum[2]) + (sum[1] + sum[3]);
+#endif
+}
+
+static inline dint16 toS16(dfloat value)
+{
+    if (value <= -32768.f) return -32768;
+    if (value >=  32767.f) return  32767;
+    return dint16(std::lrint(value));
+}
+
+static inline duint8 s16ToU8(dint16 value)
+{
+    return duint8((dint(value) + 32768) >> 8);
+}
+
+void convertU8ToS16(dint16 *dst, const duint8 *src, dsize count)
+{
+    dsize i = 0;
+#if defined(RESAMPLE_SSE2)
+    const __m128i bias = _mm_set1_epi8(char(0x80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        // With the sign bit flipped, the byte is the high half of the result.
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)), bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),     _mm_unpacklo_epi8(zero, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(zero, v));
+    }
+#elif defined(RESAMPLE_NEON)
+    const uint8x16_t bias = vdupq_n_u8(0x80);
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16_t v = veorq_u8(vld1q_u8(src + i), bias);
+        vst1q_s16(dst + i,     vreinterpretq_s16_u16(vshll_n_u8(vget_low_u8(v), 8)));
+        vst1q_s16(dst + i + 8, vreinterpretq_s16_u16(vshll_n_u8(vget_high_u8(v), 8)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        dst[i] = dint16((dint(src[i]) - 0x80) * 256);
+    }
+}
+
+DE_PIMPL_NOREF(Resampler)
+{
+    dint sourceRate;
+    dint targetRate;
+    duint64 step;    ///< Source samples per output sample, in units of 1/denom.
+    duint64 denom;
+    dint phases;
+    dint taps;       ///< Length of the filter of each phase (multiple of 4).
+    List<dfloat> bank;
+
+    Impl(dint sourceRate, dint targetRate)
+        : sourceRate(sourceRate)
+        , targetRate(targetRate)
+    {
+        DE_ASSERT(sourceRate > 0 && targetRate > 0);
+
+        const dint gcd = greatestCommonDivisor(sourceRate, targetRate);
+        step   = duint64(sourceRate / gcd);
+        denom  = duint64(targetRate / gcd);
+        phases = dint(de::min(denom, duint64(MAX_PHASES)));
+
+        // When reducing the rate, the cutoff follows the target's Nyquist frequency.
+        const ddouble cutoff = 0.5 * ROLLOFF * de::min(1.0, ddouble(targetRate) / sourceRate);
+        const dint halfTaps = dint(std::ceil(ZERO_CROSSINGS / (2 * cutoff)));
+        taps = (2 * halfTaps + 3) & ~3;
+
+        bank.resize(dsize(phases) * taps);
+        for (dint p = 0; p < phases; ++p)
+        {
+            dfloat *coef = &bank[dsize(p) * taps];
+            ddouble sum = 0;
+            for (dint k = 0; k < taps; ++k)
+            {
+                // Distance from the output position, in source samples.
+                const ddouble dist = k - (taps/2 - 1) - ddouble(p) / phases;
+                const ddouble x    = 2 * cutoff * dist;
+                const ddouble sinc = (std::abs(x) < 1.0e-9? 1.0 : std::sin(PI * x) / (PI * x));
+                const ddouble w    = dist / (taps/2); // Blackman window
+                const ddouble win  = 0.42 + 0.5 * std::cos(PI * w) + 0.08 * std::cos(2 * PI * w);
+                coef[k] = dfloat(sinc * win);
+                sum += coef[k];
+            }
+            // Unity gain for each phase.
+            for (dint k = 0; k < taps; ++k)
+            {
+                coef[k] = dfloat(coef[k] / sum);
+            }
+        }
+    }
+
+    inline const dfloat *filter(dint phase) const
+    {
+        return &bank[dsize(phase) * taps];
+    }
+
+    void convertFormat(void *dst, dint dstBytesPer, const void *src, dint srcBytesPer,
+                       dsize count) const
+    {
+        if (srcBytesPer == dstBytesPer)
+        {
+            std::memcpy(dst, src, count * srcBytesPer);
+        }
+        else if (srcBytesPer == 1)
+        {
+            convertU8ToS16(reinterpret_cast<dint16 *>(dst),
+                           reinterpret_cast<const duint8 *>(src), count);
+        }
+        else
+        {
+            const auto *in = reinterpret_cast<const dint16 *>(src);
+            auto *out      = reinterpret_cast<duint8 *>(dst);
+            for (dsize i = 0; i < count; ++i)
+            {
+                out[i] = s16ToU8(in[i]);
+            }
+        }
+    }
+};
+
+Resampler::Resampler(dint sourceRate, dint targetRate)
+    : d(new Impl(sourceRate, targetRate))
+{}
+
+dint Resampler::sourceRate() const
+{
+    return d->sourceRate;
+}
+
+dint Resampler::targetRate() const
+{
+    return d->targetRate;
+}
+
+dsize Resampler::outputLength(dsize numSamples) const
+{
+    return dsize((duint64(numSamples) * d->denom + d->step - 1) / d->step);
+}
+
+void Resampler::resample(void *dst, dint dstBytesPer,
+                         const void *src, dint srcBytesPer, dsize numSamples) const
+{
+    DE_ASSERT(dst && src);
+    DE_ASSERT(srcBytesPer == 1 || srcBytesPer == 2);
+    DE_ASSERT(dstBytesPer == 1 || dstBytesPer == 2);
+
+    if (d->step == d->denom)
+    {
+        d->convertFormat(dst, dstBytesPer, src, srcBytesPer, numSamples);
+        return;
+    }
+
+    // The source is filtered in the 16-bit range, with silence on both sides.
+    const dint before = d->taps/2 - 1;
+    List<dfloat> input(numSamples + d->taps, 0.f);
+    dfloat *in = input.data() + before;
+    if (srcBytesPer == 1)
+    {
+        const auto *s8 = reinterpret_cast<const duint8 *>(src);
+        for (dsize i = 0; i < numSamples; ++i)
+        {
+            in[i] = dfloat(s8[i]) * 256.f - 32768.f;
+        }
+    }
+    else
+    {
+        const auto *s16 = reinterpret_cast<const dint16 *>(src);
+        for (dsize i = 0; i < numSamples; ++i)
+        {
+            in[i] = s16[i];
+        }
+    }
+
+    const dsize   outCount  = outputLength(numSamples);
+    const duint64 stepWhole = d->step / d->denom;
+    const duint64 stepFrac  = d->step % d->denom;
+    const bool    exact     = (duint64(d->phases) == d->denom);
+
+    dsize pos    = 0;  // Index of the first filter tap in the input.
+    duint64 frac = 0;
+    for (dsize j = 0; j < outCount; ++j)
+    {
+        dsize at  = pos;
+        dint phase;
+        if (exact)
+        {
+            phase = dint(frac);
+        }
+        else
+        {
+            // Round to the nearest phase.
+            phase = dint((2 * frac * d->phases + d->denom) / (2 * d->denom));
+            if (phase == d->phases)
+            {
+                phase = 0;
+                at++;
+            }
+        }
+
+        const dfloat value = dotProduct(d->filter(phase), input.data() + at, d->taps);
+        if (dstBytesPer == 2)
+        {
+            reinterpret_cast<dint16 *>(dst)[j] = toS16(value);
+        }
+        else
+        {
+            reinterpret_cast<duint8 *>(dst)[j] = s16ToU8(toS16(value));
+        }
+
+        pos  += stepWhole;
+        frac += stepFrac;
+        if (frac >= d->denom)
+        {
+            frac -= d->denom;
+            pos++;
+        }
+    }
+}
+
+} // namespace audio
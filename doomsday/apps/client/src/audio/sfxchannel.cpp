@@ -475,7 +475,9 @@ void Sfx_ChannelDrawer()
     // Sample cache information.
     duint cachesize, ccnt;
     App_AudioSystem().sfxSampleCache().info(&cachesize, &ccnt);
-    char buf[200]; sprintf(buf, "Cached:%i (%i)", cachesize, ccnt);
+    const auto cacheStats = App_AudioSystem().sfxSampleCache().stats();
+    char buf[200]; sprintf(buf, "Cached:%i (%i) Hits:%i Misses:%i Evicted:%i", cachesize, ccnt,
+                           dint(cacheStats.hits), dint(cacheStats.misses), dint(cacheStats.evictions));
 
     FR_SetColor(1, 1, 1);
     FR_DrawTextXY(buf, 10, 0);
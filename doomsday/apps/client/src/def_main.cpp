@@ -34,6 +34,7 @@
 #endif
 
 #include <doomsday/console/cmd.h>
+#include <doomsday/defs/dedcache.h>
 #include <doomsday/defs/decoration.h>
 #include <doomsday/defs/dedfile.h>
 #include <doomsday/defs/dedparser.h>
@@ -60,6 +61,7 @@
 #include <de/c_wrapper.h>
 #include <de/app.h>
 #include <de/packageloader.h>
+#include <de/writer.h>
 #include <de/dscript.h>
 #include <de/nativepath.h>
 
@@ -76,11 +78,20 @@ static bool defsInited;
 static mobjinfo_t *gettingFor;
 static Binder *defsBinder;
 
+static byte defCacheEnabled = true;   ///< cvar: Read definitions from the cache if possible.
+static char defCacheStatusText[128];
+static char *defCacheStatus = defCacheStatusText; ///< cvar (read-only): Outcome of the cache.
+
 static inline FS1 &fileSys()
 {
     return App_FileSystem();
 }
 
+static void setDefCacheStatus(const String &status)
+{
+    strncpy(defCacheStatusText, status, sizeof(defCacheStatusText) - 1);
+}
+
 static Value *Function_Defs_GetSoundNum(Context &, const Function::ArgumentValues &args)
 {
     return new NumberValue(DED_Definitions()->getSoundNum(args.at(0)->asText()));
@@ -530,55 +541,33 @@ static void translateMapInfos(const StringList &mapInfoUrns, String &xlat, Strin
     Str_Free(&parm.paths);
 }
 
-static void readAllDefinitions()
+/**
+ * Top-level definition files, in the order they are read.
+ */
+struct DefinitionFiles
+{
+    String engine;        ///< The engine's own definitions.
+    StringList game;      ///< Required by the game, and found in the game's "auto" folder.
+    StringList bundles;   ///< From loaded data bundles.
+    StringList packages;  ///< From loaded packages.
+};
+
+static DefinitionFiles locateAllDefinitionFiles()
 {
-    Time begunAt;
+    DefinitionFiles files;
 
     // Start with engine's own top-level definition file.
-    readDefinitionFile(App::packageLoader().package("net.dengine.base").root()
-                       .locate<File const>("defs/doomsday.ded").path());
+    files.engine = App::packageLoader().package("net.dengine.base").root()
+                   .locate<File const>("defs/doomsday.ded").path();
 
     if (App_GameLoaded())
     {
         const Game &game = App_CurrentGame();
 
-        // Some games use definitions (MAPINFO lumps) that are translated to DED.
-        StringList mapInfoUrns = allMapInfoUrns();
-        if (!mapInfoUrns.isEmpty())
-        {
-            String xlat, xlatCustom;
-            translateMapInfos(mapInfoUrns, xlat, xlatCustom);
-
-            if (!xlat.isEmpty())
-            {
-                LOG_AS("Non-custom translated");
-                LOGDEV_MAP_VERBOSE("MAPINFO definitions:\n") << xlat;
-
-                if (!DED_ReadData(DED_Definitions(), xlat,
-                                 "[TranslatedMapInfos]", false /*not custom*/))
-                {
-                    LOG_RES_ERROR("DED parse error: %s") << DED_Error();
-                }
-            }
-
-            if (!xlatCustom.isEmpty())
-            {
-                LOG_AS("Custom translated");
-                LOGDEV_MAP_VERBOSE("MAPINFO definitions:\n") << xlatCustom;
-
-                if (!DED_ReadData(DED_Definitions(), xlatCustom,
-                                 "[TranslatedMapInfos]", true /*custom*/))
-                {
-                    LOG_RES_ERROR("DED parse error: %s") << DED_Error();
-                }
-            }
-        }
-
         // Now any startup definition files required by the game.
         const Game::Manifests &gameResources = game.manifests();
-        int packageIdx = 0;
         const auto foundRes = gameResources.equal_range(RC_DEFINITION);
-        for (auto i = foundRes.first; i != foundRes.second; ++i, ++packageIdx)
+        for (auto i = foundRes.first; i != foundRes.second; ++i)
         {
             ResourceManifest &record = *i->second;
             /// Try to locate this resource now.
@@ -587,8 +576,9 @@ static void readAllDefinitions()
             {
                 const auto names = String::join(record.names(), ";");
                 LOG_RES_ERROR("Failed to locate required game definition \"%s\"") << names;
+                continue;
             }
-            readDefinitionFile(path);
+            files.game << path;
         }
 
         // Next are definition files in the games' /auto directory.
@@ -602,7 +592,7 @@ static void readAllDefinitions()
                     // Ignore directories.
                     if (found.attrib & A_SUBDIR) continue;
 
-                    readDefinitionFile(found.path);
+                    files.game << found.path;
                 }
             }
         }
@@ -616,7 +606,7 @@ static void readAllDefinitions()
             const String bundleRoot = bundle->rootPath();
             for (const Value *path : bundle->packageMetadata().geta("dataFiles").elements())
             {
-                readDefinitionFile(bundleRoot / path->asText());
+                files.bundles << bundleRoot / path->asText();
             }
         }
     }
@@ -633,17 +623,65 @@ static void readAllDefinitions()
             // Read all the DED files found in this folder, in alphabetical order.
             // Subfolders are not checked -- the DED files need to manually `Include`
             // any files from subfolders.
-            defsFolder.forContents([] (String name, File &file)
+            defsFolder.forContents([&files] (String name, File &file)
             {
                 if (!name.fileNameExtension().compare(".ded", CaseInsensitive))
                 {
-                    readDefinitionFile(file.path());
+                    files.packages << file.path();
                 }
                 return LoopContinue;
             });
         }
     }
 
+    return files;
+}
+
+static void readAllDefinitions(const DefinitionFiles &files)
+{
+    Time begunAt;
+
+    readDefinitionFile(files.engine);
+
+    if (App_GameLoaded())
+    {
+        // Some games use definitions (MAPINFO lumps) that are translated to DED.
+        StringList mapInfoUrns = allMapInfoUrns();
+        if (!mapInfoUrns.isEmpty())
+        {
+            String xlat, xlatCustom;
+            translateMapInfos(mapInfoUrns, xlat, xlatCustom);
+
+            if (!xlat.isEmpty())
+            {
+                LOG_AS("Non-custom translated");
+                LOGDEV_MAP_VERBOSE("MAPINFO definitions:\n") << xlat;
+
+                if (!DED_ReadData(DED_Definitions(), xlat,
+                                 "[TranslatedMapInfos]", false /*not custom*/))
+                {
+                    LOG_RES_ERROR("DED parse error: %s") << DED_Error();
+                }
+            }
+
+            if (!xlatCustom.isEmpty())
+            {
+                LOG_AS("Custom translated");
+                LOGDEV_MAP_VERBOSE("MAPINFO definitions:\n") << xlatCustom;
+
+                if (!DED_ReadData(DED_Definitions(), xlatCustom,
+                                 "[TranslatedMapInfos]", true /*custom*/))
+                {
+                    LOG_RES_ERROR("DED parse error: %s") << DED_Error();
+                }
+            }
+        }
+    }
+
+    for (const String &path : files.game)     readDefinitionFile(path);
+    for (const String &path : files.bundles)  readDefinitionFile(path);
+    for (const String &path : files.packages) readDefinitionFile(path);
+
     // Last are DD_DEFNS definition lumps from loaded add-ons.
     /// @todo Shouldn't these be processed before definitions on the command line?
     Def_ReadLumpDefs();
@@ -651,6 +689,58 @@ static void readAllDefinitions()
     LOG_RES_VERBOSE("readAllDefinitions: Completed in %.2f seconds") << begunAt.since();
 }
 
+/**
+ * Composes the key of the definition cache. It covers everything that affects the
+ * definitions besides the contents of the definition files (which the cache tracks
+ * itself): the build, the game, the loaded files and packages (DD_DEFNS, MAPINFO and
+ * DEHACKED lumps, DeHackEd patches, textures for generated materials), and the
+ * top-level definition files.
+ */
+static Block definitionCacheKey(const DefinitionFiles &files)
+{
+    Block key;
+    Writer writer(key);
+
+    writer << String(DOOMSDAY_VERSION_FULLTEXT)
+           << (App_GameLoaded()? App_CurrentGame().id() : String("none"))
+           << duint8(CommandLine_Exists("-noauto")? 1 : 0)
+           << duint8(CommandLine_Exists("-alldehs")? 1 : 0);
+
+    const FileList &loadedFiles = fileSys().loadedFiles();
+    writer << duint32(loadedFiles.size());
+    for (const FileHandle *hndl : loadedFiles)
+    {
+        const File1 &file = hndl->file();
+        writer << file.composePath() << duint32(file.size()) << duint32(file.lastModified());
+    }
+
+    auto writeSourceFile = [&writer] (const File &file)
+    {
+        const File::Status &status = file.status();
+        writer << file.path() << duint64(status.size) << dint64(status.modifiedAt.toTime_t());
+    };
+    const auto packages = App::packageLoader().loadedPackagesInOrder();
+    writer << duint32(packages.size());
+    for (const Package *pkg : packages)
+    {
+        writer << pkg->identifier();
+        writeSourceFile(pkg->sourceFile());
+    }
+    const auto bundles = DataBundle::loadedBundles();
+    writer << duint32(bundles.size());
+    for (const DataBundle *bundle : bundles)
+    {
+        writeSourceFile(bundle->sourceFile());
+    }
+
+    writer << files.engine;
+    writer.writeElements(files.game);
+    writer.writeElements(files.bundles);
+    writer.writeElements(files.packages);
+
+    return key.md5Hash();
+}
+
 static void defineFlaremap(const res::Uri &resourceUri)
 {
     if (resourceUri.isEmpty()) return;
@@ -1185,6 +1275,77 @@ static void clearFontDefinitionLinks()
 }
 #endif // __CLIENT__
 
+/**
+ * Reads all the definitions, either from the definition cache or by generating and
+ * parsing them. In the latter case, the cache is updated.
+ */
+static void readDefinitionsUsingCache(ded_t &defs)
+{
+    FS1::Scheme &modelScheme = fileSys().scheme(App_ResourceClass("RC_MODEL").defaultScheme());
+    DEDCache cache(App::app().nativeHomePath() / "cache/definitions.dedc");
+    const DefinitionFiles files = locateAllDefinitionFiles();
+    Block key;
+    Time begunAt;
+
+    if (defCacheEnabled)
+    {
+        key = definitionCacheKey(files);
+
+        StringList modelPaths;
+        const auto result = cache.load(defs, key, modelPaths);
+        if (result == DEDCache::Loaded)
+        {
+            // Search paths added with "ModelPath" during parsing.
+            for (const String &path : modelPaths)
+            {
+                modelScheme.addSearchPath(SearchPath(res::Uri(path, RC_NULL)), FS1::ExtraPaths);
+            }
+            setDefCacheStatus(Stringf("hit: loaded in %.3f s", ddouble(begunAt.since())));
+            LOG_RES_MSG("Loaded cached definitions in %.2f seconds") << begunAt.since();
+            return;
+        }
+
+        LOG_RES_VERBOSE("Definition cache not used: %s") << DEDCache::resultText(result);
+        setDefCacheStatus(Stringf("miss (%s)", DEDCache::resultText(result)));
+        cache.beginRecording();
+    }
+    else
+    {
+        setDefCacheStatus("disabled");
+    }
+
+    const auto extraPathsBefore = modelScheme.allSearchPaths().count(FS1::ExtraPaths);
+
+    // Generate definitions.
+    generateMaterialDefs();
+
+    // Read all definitions files and lumps.
+    LOG_RES_MSG("Parsing definition files...");
+    readAllDefinitions(files);
+
+    // Any definition hooks?
+    DoomsdayApp::plugins().callAllHooks(HOOK_DEFS, 0, &defs);
+
+    if (defCacheEnabled)
+    {
+        const TimeSpan readTime = begunAt.since();
+
+        StringList modelPaths;
+        const auto extraPaths = modelScheme.allSearchPaths().equal_range(FS1::ExtraPaths);
+        dsize index = 0;
+        for (auto i = extraPaths.first; i != extraPaths.second; ++i, ++index)
+        {
+            if (index >= extraPathsBefore) modelPaths << i->second.compose();
+        }
+
+        Time savedAt;
+        const bool saved = cache.save(defs, key, modelPaths);
+        setDefCacheStatus(Stringf("%s: read in %.3f s, %s in %.3f s",
+                                  defCacheStatus, ddouble(readTime),
+                                  saved? "saved" : "save failed", ddouble(savedAt.since())));
+    }
+}
+
 void Def_Read()
 {
     LOG_AS("Def_Read");
@@ -1209,15 +1370,7 @@ void Def_Read()
     defs.clear();
     runtimeDefs.clear();
 
-    // Generate definitions.
-    generateMaterialDefs();
-
-    // Read all definitions files and lumps.
-    LOG_RES_MSG("Parsing definition files...");
-    readAllDefinitions();
-
-    // Any definition hooks?
-    DoomsdayApp::plugins().callAllHooks(HOOK_DEFS, 0, &defs);
+    readDefinitionsUsingCache(defs);
 
 #ifdef __CLIENT__
     // Composite fonts.
@@ -2008,8 +2161,27 @@ D_CMD(ListMobjs)
     return true;
 }
 
+/**
+ * Prints the number of lookups made in each definition category.
+ */
+D_CMD(DefLookups)
+{
+    DE_UNUSED(src, argc, argv);
+
+    LOG_RES_MSG(_E(b) "Definition lookups (Category | Count):");
+    for (const auto &count : DED_Definitions()->lookupCounts())
+    {
+        LOG_RES_MSG(" %s | %i") << count.first << count.second;
+    }
+    return true;
+}
+
 void Def_ConsoleRegister()
 {
+    C_VAR_BYTE   ("def-cache",        &defCacheEnabled, 0, 0, 1);
+    C_VAR_CHARPTR("def-cache-status", &defCacheStatus,  CVF_READ_ONLY | CVF_NO_ARCHIVE, 0, 0);
+
+    C_CMD("deflookups",    "", DefLookups);
     C_CMD("listmobjtypes", "", ListMobjs);
 }
 
@@ -467,8 +467,9 @@ void GL_DeferTextureUpload(const struct texturecontent_s *content)
 {
     if(novideo) return;
 
-    // Defer this operation. Need to make a copy.
-    enqueueTask(DTT_UPLOAD_TEXTURECONTENT, GL_ConstructTextureContentCopy(content));
+    // Defer this operation. Need to make a copy. The pixels are converted here
+    // so that the main thread only needs to do the GL calls.
+    enqueueTask(DTT_UPLOAD_TEXTURECONTENT, GL_ConstructUploadReadyTextureContent(*content));
 }
 
 void GL_DeferSetVSync(dd_bool enableVSync)
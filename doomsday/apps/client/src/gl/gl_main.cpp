@@ -436,14 +436,14 @@ void GL_SetupFogFromMapInfo(const Record *mapInfo)
     if(!fadeTable.isEmpty())
     {
         const LumpIndex &lumps = App_FileSystem().nameIndex();
-        dint lumpNum = lumps.findLast(fadeTable + ".lmp");
-        if(lumpNum == lumps.findLast("COLORMAP.lmp"))
+        dint lumpNum = lumps.findLastByName(fadeTable + ".lmp");
+        if(lumpNum == lumps.findLastByName("COLORMAP.lmp"))
         {
             // We don't want fog in this case.
             GL_UseFog(false);
         }
         // Probably fog ... don't use fullbright sprites.
-        else if(lumpNum == lumps.findLast("FOGMAP.lmp"))
+        else if(lumpNum == lumps.findLastByName("FOGMAP.lmp"))
         {
             GL_UseFog(true);
         }
@@ -19,6 +19,7 @@
 
 #include "de_platform.h"
 #include "gl/gl_tex.h"
+#include "gl/gl_texkernels.h"
 #include "dd_main.h"
 #include "render/r_main.h"
 #include "resource/clientresources.h"
@@ -27,31 +28,12 @@
 #include <doomsday/color.h>
 #include <doomsday/res/colorpalette.h>
 #include <de/legacy/memory.h>
-#include <de/legacy/memoryzone.h>
 #include <de/legacy/vector1.h>
 #include <de/legacy/texgamma.h>
 #include <cstdlib>
 #include <cmath>
 #include <cctype>
 
-static uint8_t *scratchBuffer;
-static size_t scratchBufferSize;
-
-/**
- * Provides a persistent scratch buffer for use by texture manipulation
- * routines e.g. scaleLine().
- */
-static uint8_t *GetScratchBuffer(size_t size)
-{
-    // Need to enlarge?
-    if(size > scratchBufferSize)
-    {
-        scratchBuffer = (uint8_t *) Z_Realloc(scratchBuffer, size, PU_APPSTATIC);
-        scratchBufferSize = size;
-    }
-    return scratchBuffer;
-}
-
 /**
  * Len is measured in out units. Comps is the number of components per
  * pixel, or rather the number of bytes per pixel (3 or 4). The strides must
@@ -149,7 +131,8 @@ uint8_t* GL_ScaleBuffer(const uint8_t* in, int width, int height, int comps,
     if(width <= 0 || height <= 0)
         return (uint8_t*)in;
 
-    buffer = GetScratchBuffer(comps * outWidth * height);
+    // A buffer of our own, so that images can be scaled in several threads.
+    buffer = (uint8_t *) M_Malloc(comps * outWidth * height);
 
     out = (uint8_t *) M_Malloc(comps * outWidth * outHeight);
 
@@ -175,6 +158,7 @@ uint8_t* GL_ScaleBuffer(const uint8_t* in, int width, int height, int comps,
     {
         scaleLine(inOff, stride, outOff, stride, outHeight, height, comps);
     }}
+    M_Free(buffer);
     return out;
     }
 }
@@ -217,16 +201,13 @@ static void *packImage(int          components,
     switch (typeOut)
     {
     case GL_UNSIGNED_BYTE: {
-        int i, j, k = 0;
-        for(i = 0; i < heightOut; ++i)
+        int i, k = 0;
+        for(i = 0; i < heightOut; ++i, k += widthOut * components)
         {
             GLubyte* ubptr = (GLubyte*) dataOut
                 + i * rowStride
                 + packSkipRows * rowStride + packSkipPixels * components;
-            for(j = 0; j < widthOut * components; ++j)
-            {
-                *ubptr++ = (GLubyte) tempOut[k++];
-            }
+            TexKernel_FloatsToBytes(tempOut + k, ubptr, widthOut * components);
         }
         break;
       }
@@ -428,15 +409,12 @@ void* GL_ScaleBufferEx(const void* dataIn, int widthIn, int heightIn, int bpp,
     {
     case GL_UNSIGNED_BYTE:
         k = 0;
-        for(i = 0; i < heightIn; ++i)
+        for(i = 0; i < heightIn; ++i, k += widthIn * bpp)
         {
-            GLubyte* ubptr = (GLubyte*) dataIn
+            const GLubyte* ubptr = (const GLubyte*) dataIn
                 + i * rowStride
                 + unpackSkipRows * rowStride + unpackSkipPixels * bpp;
-            for(j = 0; j < widthIn * bpp; ++j)
-            {
-                tempIn[k++] = (float) *ubptr++;
-            }
+            TexKernel_BytesToFloats(ubptr, tempIn + k, widthIn * bpp);
         }
         break;
     case GL_BYTE:
@@ -537,11 +515,8 @@ void* GL_ScaleBufferEx(const void* dataIn, int widthIn, int heightIn, int bpp,
     if(sx < 1.0 && sy < 1.0)
     {
         // Magnify both width and height: use weighted sample of 4 pixels.
-        int i0, i1, j0, j1;
-        float alpha, beta;
-        float* src00, *src01, *src10, *src11;
-        float s1, s2;
-        float* dst;
+        int i0, i1;
+        float alpha;
 
         for(i = 0; i < heightOut; ++i)
         {
@@ -550,38 +525,15 @@ void* GL_ScaleBufferEx(const void* dataIn, int widthIn, int heightIn, int bpp,
             if(i1 >= heightIn)
                 i1 = heightIn - 1;
             alpha = i * sy - i0;
-            for(j = 0; j < widthOut; ++j)
-            {
-                j0 = j * sx;
-                j1 = j0 + 1;
-                if(j1 >= widthIn)
-                    j1 = widthIn - 1;
-                beta = j * sx - j0;
-
-                // Compute weighted average of pixels in rect (i0,j0)-(i1,j1)
-                src00 = tempIn + (i0 * widthIn + j0) * bpp;
-                src01 = tempIn + (i0 * widthIn + j1) * bpp;
-                src10 = tempIn + (i1 * widthIn + j0) * bpp;
-                src11 = tempIn + (i1 * widthIn + j1) * bpp;
-
-                dst = tempOut + (i * widthOut + j) * bpp;
 
-                for (k = 0; k < bpp; ++k)
-                {
-                    s1 = *src00++ * (1.0 - beta) + *src01++ * beta;
-                    s2 = *src10++ * (1.0 - beta) + *src11++ * beta;
-                    *dst++ = s1 * (1.0 - alpha) + s2 * alpha;
-                }
-            }
+            TexKernel_MagnifyRow(tempIn + i0 * widthIn * bpp, tempIn + i1 * widthIn * bpp,
+                                 alpha, tempOut + i * widthOut * bpp, widthIn, widthOut, sx, bpp);
         }
     }
     else
     {
         // Shrink width and/or height:  use an unweighted box filter.
         int i0, i1;
-        int j0, j1;
-        int ii, jj;
-        float sum, *dst;
 
         for(i = 0; i < heightOut; ++i)
         {
@@ -590,30 +542,10 @@ void* GL_ScaleBufferEx(const void* dataIn, int widthIn, int heightIn, int bpp,
             if(i1 >= heightIn)
                 i1 = heightIn - 1;
 
-            for(j = 0; j < widthOut; ++j)
-            {
-                j0 = j * sx;
-                j1 = j0 + 1;
-                if(j1 >= widthIn)
-                    j1 = widthIn - 1;
-
-                dst = tempOut + (i * widthOut + j) * bpp;
-
-                // Compute average of pixels in the rectangle (i0,j0)-(i1,j1)
-                for(k = 0; k < bpp; ++k)
-                {
-                    sum = 0.0;
-                    for(ii = i0; ii <= i1; ++ii)
-                    {
-                        for(jj = j0; jj <= j1; ++jj)
-                        {
-                            sum += *(tempIn + (ii * widthIn + jj) * bpp + k);
-                        }
-                    }
-                    sum /= (j1 - j0 + 1) * (i1 - i0 + 1);
-                    *dst++ = sum;
-                }
-            }
+            // Compute average of pixels in the rectangles (i0,j0)-(i1,j1)
+            TexKernel_MinifyRow(tempIn + i0 * widthIn * bpp,
+                                i1 != i0? tempIn + i1 * widthIn * bpp : nullptr,
+                                tempOut + i * widthOut * bpp, widthIn, widthOut, sx, bpp);
         }
     }
 
@@ -697,11 +629,8 @@ void GL_DownMipmap32(uint8_t* in, int width, int height, int comps)
 
     // Unconstrained, 2x2 -> 1x1 reduction?
     out = in;
-    for(y = 0; y < outH; ++y, in += width * comps)
-        for(x = 0; x < outW; ++x, in += comps * 2)
-            for(c = 0; c < comps; ++c, out++)
-                *out = (uint8_t)((in[c] + in[comps + c] + in[comps * width + c] +
-                              in[comps * (width + 1) + c]) >> 2);
+    for(y = 0; y < outH; ++y, in += (outW * 2 + width) * comps, out += outW * comps)
+        TexKernel_DownMipmapRow(in, in + comps * width, out, outW, comps);
     }
 }
 
@@ -947,8 +876,7 @@ void FindAverageLineColor(const uint8_t* pixels, int width, int height,
 void FindAverageColor(const uint8_t* pixels, int width, int height,
     int pixelSize, ColorRawf* color)
 {
-    long i, numpels, avg[3] = { 0, 0, 0 };
-    const uint8_t* src;
+    long numpels, avg[3];
     assert(pixels && color);
 
     if(width <= 0 || height <= 0)
@@ -967,13 +895,7 @@ void FindAverageColor(const uint8_t* pixels, int width, int height,
     }
 
     numpels = width * height;
-    src = pixels;
-    for(i = 0; i < numpels; ++i, src += pixelSize)
-    {
-        avg[0] += src[0];
-        avg[1] += src[1];
-        avg[2] += src[2];
-    }
+    TexKernel_SumRGB(pixels, numpels, pixelSize, avg);
 
     V3f_Set(color->rgb, avg[0] / numpels * reciprocal255,
                         avg[1] / numpels * reciprocal255,
@@ -1323,23 +1245,12 @@ void EqualizeLuma(uint8_t* pixels, int width, int height, float* rBaMul,
     float hiMul, loMul, baMul;
     long wideAvg, numpels;
     uint8_t min, max, avg;
-    uint8_t* pix;
 
     if(width <= 0 || height <= 0)
         return;
 
     numpels = width * height;
-    min = 255;
-    max = 0;
-    wideAvg = 0;
-
-    { long i;
-    for(i = 0, pix = pixels; i < numpels; ++i, pix += 1)
-    {
-        if(*pix < min) min = *pix;
-        if(*pix > max) max = *pix;
-        wideAvg += *pix;
-    }}
+    TexKernel_MinMaxSum(pixels, numpels, &min, &max, &wideAvg);
 
     if(max <= min || max == 0 || min == 255)
     {
@@ -1366,17 +1277,20 @@ void EqualizeLuma(uint8_t* pixels, int width, int height, float* rBaMul,
 
     if(!(baMul == 1 && hiMul == 1 && loMul == 1))
     {
-        long i;
-        for(i = 0, pix = pixels; i < numpels; ++i, pix += 1)
+        // The mapping only depends on the original value.
+        uint8_t table[256];
+        int v;
+        for(v = 0; v < 256; ++v)
         {
             // First balance.
-            float val = baMul * (*pix);
+            float val = baMul * v;
             // Now amplify.
             if(val > 127) val *= hiMul;
             else          val *= loMul;
 
-            *pix = (uint8_t) MINMAX_OF(0, val, 255);
+            table[v] = (uint8_t) MINMAX_OF(0, val, 255);
         }
+        TexKernel_Lookup(pixels, numpels, table);
     }
 
     if(rBaMul) *rBaMul = baMul;
@@ -1416,41 +1330,20 @@ void AmplifyLuma(uint8_t* pixels, int width, int height, dd_bool hasAlpha)
         return;
 
     numPels = width * height;
-    if(hasAlpha)
-    {
-        uint8_t* pix = pixels;
-        uint8_t* apix = pixels + numPels;
-        long i;
-        for(i = 0; i < numPels; ++i, pix++, apix++)
-        {
-            // Only non-masked pixels count.
-            if(!(*apix > 0))
-                continue;
-
-            if(*pix > max)
-                max = *pix;
-        }
-    }
-    else
-    {
-        uint8_t* pix = pixels;
-        long i;
-        for(i = 0; i < numPels; ++i, pix++)
-        {
-            if(*pix > max)
-                max = *pix;
-        }
-    }
+    // Only non-masked pixels count.
+    max = TexKernel_Max(pixels, hasAlpha? pixels + numPels : NULL, numPels);
 
     if(0 == max || 255 == max)
         return;
 
-    { uint8_t* pix = pixels;
-    long i;
-    for(i = 0; i < numPels; ++i, pix++)
+    { uint8_t table[256];
+    int v;
+    for(v = 0; v < 256; ++v)
     {
-        *pix = (uint8_t) MINMAX_OF(0, (float)*pix / max * 255, 255);
-    }}
+        table[v] = (uint8_t) MINMAX_OF(0, (float)v / max * 255, 255);
+    }
+    TexKernel_Lookup(pixels, numPels, table);
+    }
     }
 }
 
@@ -1499,7 +1392,7 @@ void SharpenPixels(uint8_t* pixels, int width, int height, int comps)
     const float strength = .05f;
     uint8_t* result;
     float A, B, C;
-    int x, y;
+    int y;
 
     if(width <= 0 || height <= 0)
         return;
@@ -1518,22 +1411,10 @@ void SharpenPixels(uint8_t* pixels, int width, int height, int comps)
     C = 1 + 4*A + 4*B;
 
     for(y = 1; y < height - 1; ++y)
-        for(x = 1; x < width -1; ++x)
-        {
-            const uint8_t* pix = pixels + (x + y*width) * comps;
-            uint8_t* out = result + (x + y*width) * comps;
-            int c;
-            for(c = 0; c < 3; ++c)
-            {
-                int r = (C*pix[c] - A*pix[c - width] - A*pix[c + comps] - A*pix[c - comps] -
-                         A*pix[c + width] - B*pix[c + comps - width] - B*pix[c + comps + width] -
-                         B*pix[c - comps - width] - B*pix[c - comps + width]);
-                out[c] = MINMAX_OF(0, r, 255);
-            }
-
-            if(comps == 4)
-                out[3] = pix[3];
-        }
+    {
+        const int first = (1 + y*width) * comps;
+        TexKernel_SharpenRun(pixels + first, result + first, width - 2, comps, width, A, B, C);
+    }
 
     memcpy(pixels, result, comps * width * height);
     free(result);
@@ -1550,21 +1431,6 @@ static inline bool isKeyedColor(uint8_t *color)
                                  (color[0] == 0 && color[1] == 0xff));
 }
 
-/**
- * Buffer must be RGBA. Doesn't touch the non-keyed pixels.
- */
-static void doColorKeying(uint8_t *rgbaBuf, int width)
-{
-    DE_ASSERT(rgbaBuf);
-
-    for(int i = 0; i < width; ++i, rgbaBuf += 4)
-    {
-        if(!isKeyedColor(rgbaBuf)) continue;
-
-        rgbaBuf[3] = rgbaBuf[2] = rgbaBuf[1] = rgbaBuf[0] = 0;
-    }
-}
-
 uint8_t *ApplyColorKeying(uint8_t *buf, int width, int height, int pixelSize)
 {
     DE_ASSERT(buf);
@@ -1597,9 +1463,6 @@ uint8_t *ApplyColorKeying(uint8_t *buf, int width, int height, int pixelSize)
 
     // We can do the keying in-buffer.
     // This preserves the alpha values of non-keyed pixels.
-    for(int i = 0; i < height; ++i)
-    {
-        doColorKeying(buf + 4 * i * width, height);
-    }
+    TexKernel_ColorKey(buf, long(width) * height);
     return buf;
 }
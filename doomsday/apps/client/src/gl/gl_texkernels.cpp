@@ -0,0 +1,1228 @@
+/** @file gl_texkernels.cpp  Vectorized inner loops of the image manipulation algorithms.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "gl/gl_texkernels.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define TEXKERNELS_X86
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define TK_SSE2
+#    define TK_AVX2
+#  else
+#    define TK_SSE2 __attribute__((target("sse2")))
+#    define TK_AVX2 __attribute__((target("avx2")))
+#  endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define TEXKERNELS_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace {
+
+/**
+ * Kernel implementations for one instruction set.
+ */
+struct TexKernels
+{
+    void (*downMipmapRow)(const uint8_t *, const uint8_t *, uint8_t *, int, int);
+    void (*sumRGB)(const uint8_t *, long, int, long *);
+    void (*minMaxSum)(const uint8_t *, long, uint8_t *, uint8_t *, long *);
+    uint8_t (*max)(const uint8_t *, const uint8_t *, long);
+    void (*colorKey)(uint8_t *, long);
+    void (*sharpenRun)(const uint8_t *, uint8_t *, int, int, int, float, float, float);
+    void (*bytesToFloats)(const uint8_t *, float *, long);
+    void (*floatsToBytes)(const float *, uint8_t *, long);
+    void (*magnifyRow)(const float *, const float *, float, float *, int, int, float, int);
+    void (*minifyRow)(const float *, const float *, float *, int, int, float, int);
+};
+
+inline uint8_t clampByte(int value)
+{
+    return uint8_t(value < 0? 0 : value > 255? 255 : value);
+}
+
+/// RGB of the keyed colors (0,255,255) and (255,0,255) as little-endian 32-bit values.
+const uint32_t KEY_RGB_MASK  = 0x00ffffff;
+const uint32_t KEY_MAGENTA   = 0x00ff00ff;
+const uint32_t KEY_CYAN      = 0x00ffff00;
+
+//---------------------------------------------------------------------------------------
+// Scalar reference implementations
+//---------------------------------------------------------------------------------------
+
+void downMipmapRowScalar(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                         int outWidth, int comps)
+{
+    for (int x = 0; x < outWidth; ++x, row0 += comps * 2, row1 += comps * 2)
+    {
+        for (int c = 0; c < comps; ++c)
+        {
+            *out++ = uint8_t((row0[c] + row0[comps + c] + row1[c] + row1[comps + c]) >> 2);
+        }
+    }
+}
+
+void sumRGBScalar(const uint8_t *pixels, long numPels, int pixelSize, long *sums)
+{
+    long r = 0, g = 0, b = 0;
+    for (long i = 0; i < numPels; ++i, pixels += pixelSize)
+    {
+        r += pixels[0];
+        g += pixels[1];
+        b += pixels[2];
+    }
+    sums[0] += r;
+    sums[1] += g;
+    sums[2] += b;
+}
+
+void minMaxSumScalar(const uint8_t *values, long count, uint8_t *min, uint8_t *max, long *sum)
+{
+    uint8_t lo = *min, hi = *max;
+    long total = 0;
+    for (long i = 0; i < count; ++i)
+    {
+        const uint8_t v = values[i];
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+        total += v;
+    }
+    *min = lo;
+    *max = hi;
+    *sum += total;
+}
+
+uint8_t maxScalar(const uint8_t *values, const uint8_t *mask, long count)
+{
+    uint8_t hi = 0;
+    for (long i = 0; i < count; ++i)
+    {
+        if (mask && !mask[i]) continue;
+        if (values[i] > hi) hi = values[i];
+    }
+    return hi;
+}
+
+void colorKeyScalar(uint8_t *rgba, long numPels)
+{
+    for (long i = 0; i < numPels; ++i, rgba += 4)
+    {
+        if (rgba[2] == 0xff && ((rgba[0] == 0xff && rgba[1] == 0) ||
+                                (rgba[0] == 0 && rgba[1] == 0xff)))
+        {
+            rgba[0] = rgba[1] = rgba[2] = rgba[3] = 0;
+        }
+    }
+}
+
+void sharpenRunScalar(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                      float A, float B, float C)
+{
+    for (int x = 0; x < count; ++x, pix += comps, out += comps)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            int r = (C*pix[c] - A*pix[c - width] - A*pix[c + comps] - A*pix[c - comps] -
+                     A*pix[c + width] - B*pix[c + comps - width] - B*pix[c + comps + width] -
+                     B*pix[c - comps - width] - B*pix[c - comps + width]);
+            out[c] = clampByte(r);
+        }
+        if (comps == 4)
+        {
+            out[3] = pix[3];
+        }
+    }
+}
+
+void bytesToFloatsScalar(const uint8_t *in, float *out, long count)
+{
+    for (long i = 0; i < count; ++i)
+    {
+        out[i] = float(in[i]);
+    }
+}
+
+void floatsToBytesScalar(const float *in, uint8_t *out, long count)
+{
+    for (long i = 0; i < count; ++i)
+    {
+        out[i] = uint8_t(in[i]);
+    }
+}
+
+/// Source pixel and weight of an output pixel along a magnified row.
+inline void magnifySample(int j, float sx, int widthIn, int &j0, int &j1, float &beta)
+{
+    j0 = j * sx;
+    j1 = j0 + 1;
+    if (j1 >= widthIn) j1 = widthIn - 1;
+    beta = j * sx - j0;
+}
+
+void magnifyRowScalar(const float *src0, const float *src1, float alpha, float *dst,
+                      int widthIn, int widthOut, float sx, int comps)
+{
+    for (int j = 0; j < widthOut; ++j)
+    {
+        int j0, j1;
+        float beta;
+        magnifySample(j, sx, widthIn, j0, j1, beta);
+
+        const float *src00 = src0 + j0 * comps;
+        const float *src01 = src0 + j1 * comps;
+        const float *src10 = src1 + j0 * comps;
+        const float *src11 = src1 + j1 * comps;
+        for (int k = 0; k < comps; ++k)
+        {
+            float s1 = *src00++ * (1.0 - beta) + *src01++ * beta;
+            float s2 = *src10++ * (1.0 - beta) + *src11++ * beta;
+            *dst++ = s1 * (1.0 - alpha) + s2 * alpha;
+        }
+    }
+}
+
+/// Range of source pixels covered by an output pixel along a minified row.
+inline void minifySample(int j, float sx, int widthIn, int &j0, int &j1)
+{
+    j0 = j * sx;
+    j1 = j0 + 1;
+    if (j1 >= widthIn) j1 = widthIn - 1;
+}
+
+void minifyRowScalar(const float *src0, const float *src1, float *dst,
+                     int widthIn, int widthOut, float sx, int comps)
+{
+    const int rows = (src1? 2 : 1);
+    for (int j = 0; j < widthOut; ++j)
+    {
+        int j0, j1;
+        minifySample(j, sx, widthIn, j0, j1);
+        for (int k = 0; k < comps; ++k)
+        {
+            float sum = 0.0;
+            for (int ii = 0; ii < rows; ++ii)
+            {
+                const float *row = (ii? src1 : src0);
+                for (int jj = j0; jj <= j1; ++jj)
+                {
+                    sum += row[jj * comps + k];
+                }
+            }
+            sum /= (j1 - j0 + 1) * rows;
+            *dst++ = sum;
+        }
+    }
+}
+
+const TexKernels scalarKernels = {
+    downMipmapRowScalar,
+    sumRGBScalar,
+    minMaxSumScalar,
+    maxScalar,
+    colorKeyScalar,
+    sharpenRunScalar,
+    bytesToFloatsScalar,
+    floatsToBytesScalar,
+    magnifyRowScalar,
+    minifyRowScalar,
+};
+
+#ifdef TEXKERNELS_X86
+
+//---------------------------------------------------------------------------------------
+// SSE2
+//---------------------------------------------------------------------------------------
+
+TK_SSE2 inline uint64_t sumLanes(__m128i v)
+{
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), v);
+    return lanes[0] + lanes[1];
+}
+
+TK_SSE2 void downMipmapRowSSE2(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                               int outWidth, int comps)
+{
+    if (comps != 4) return downMipmapRowScalar(row0, row1, out, outWidth, comps);
+
+    const __m128i zero = _mm_setzero_si128();
+    int x = 0;
+    for (; x + 4 <= outWidth; x += 4, row0 += 32, row1 += 32, out += 16)
+    {
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 16));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 16));
+
+        // Vertical sums of source pixels 0-1, 2-3, 4-5, and 6-7.
+        const __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        const __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Add horizontal neighbors together.
+        __m128i h0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+        __m128i h1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+        h0 = _mm_srli_epi16(h0, 2);
+        h1 = _mm_srli_epi16(h1, 2);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(h0, h1));
+    }
+    downMipmapRowScalar(row0, row1, out, outWidth - x, comps);
+}
+
+TK_SSE2 void sumRGBSSE2(const uint8_t *pixels, long numPels, int pixelSize, long *sums)
+{
+    if (pixelSize != 4) return sumRGBScalar(pixels, numPels, pixelSize, sums);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32(0xff);
+    __m128i r = zero, g = zero, b = zero;
+    long i = 0;
+    for (; i + 4 <= numPels; i += 4, pixels += 16)
+    {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels));
+        r = _mm_add_epi64(r, _mm_sad_epu8(_mm_and_si128(p, mask), zero));
+        g = _mm_add_epi64(g, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(p, 8), mask), zero));
+        b = _mm_add_epi64(b, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(p, 16), mask), zero));
+    }
+    sums[0] += long(sumLanes(r));
+    sums[1] += long(sumLanes(g));
+    sums[2] += long(sumLanes(b));
+    sumRGBScalar(pixels, numPels - i, pixelSize, sums);
+}
+
+TK_SSE2 void minMaxSumSSE2(const uint8_t *values, long count, uint8_t *min, uint8_t *max,
+                           long *sum)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_set1_epi8(char(*min));
+    __m128i hi = _mm_set1_epi8(char(*max));
+    __m128i total = zero;
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        lo = _mm_min_epu8(lo, v);
+        hi = _mm_max_epu8(hi, v);
+        total = _mm_add_epi64(total, _mm_sad_epu8(v, zero));
+    }
+    uint8_t los[16], his[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(los), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(his), hi);
+    for (int k = 0; k < 16; ++k)
+    {
+        if (los[k] < *min) *min = los[k];
+        if (his[k] > *max) *max = his[k];
+    }
+    *sum += long(sumLanes(total));
+    minMaxSumScalar(values + i, count - i, min, max, sum);
+}
+
+TK_SSE2 uint8_t maxSSE2(const uint8_t *values, const uint8_t *mask, long count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i hi = zero;
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        if (mask)
+        {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + i));
+            v = _mm_andnot_si128(_mm_cmpeq_epi8(m, zero), v);
+        }
+        hi = _mm_max_epu8(hi, v);
+    }
+    uint8_t his[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(his), hi);
+    uint8_t result = maxScalar(values + i, mask? mask + i : nullptr, count - i);
+    for (uint8_t h : his)
+    {
+        if (h > result) result = h;
+    }
+    return result;
+}
+
+TK_SSE2 void colorKeySSE2(uint8_t *rgba, long numPels)
+{
+    const __m128i rgbMask = _mm_set1_epi32(int(KEY_RGB_MASK));
+    const __m128i magenta = _mm_set1_epi32(int(KEY_MAGENTA));
+    const __m128i cyan    = _mm_set1_epi32(int(KEY_CYAN));
+    long i = 0;
+    for (; i + 4 <= numPels; i += 4, rgba += 16)
+    {
+        __m128i *ptr = reinterpret_cast<__m128i *>(rgba);
+        const __m128i p = _mm_loadu_si128(ptr);
+        const __m128i rgb = _mm_and_si128(p, rgbMask);
+        const __m128i keyed = _mm_or_si128(_mm_cmpeq_epi32(rgb, magenta),
+                                           _mm_cmpeq_epi32(rgb, cyan));
+        _mm_storeu_si128(ptr, _mm_andnot_si128(keyed, p));
+    }
+    colorKeyScalar(rgba, numPels - i);
+}
+
+/// Loads 4 bytes as floats.
+TK_SSE2 inline __m128 loadBytes4(const uint8_t *ptr)
+{
+    int32_t bytes;
+    std::memcpy(&bytes, ptr, 4);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+    return _mm_cvtepi32_ps(v);
+}
+
+TK_SSE2 void sharpenPixelSSE2(const uint8_t *pix, uint8_t *out, int width,
+                              __m128 A, __m128 B, __m128 C)
+{
+    __m128 r = _mm_mul_ps(C, loadBytes4(pix));
+    r = _mm_sub_ps(r, _mm_mul_ps(A, loadBytes4(pix - width)));
+    r = _mm_sub_ps(r, _mm_mul_ps(A, loadBytes4(pix + 4)));
+    r = _mm_sub_ps(r, _mm_mul_ps(A, loadBytes4(pix - 4)));
+    r = _mm_sub_ps(r, _mm_mul_ps(A, loadBytes4(pix + width)));
+    r = _mm_sub_ps(r, _mm_mul_ps(B, loadBytes4(pix + 4 - width)));
+    r = _mm_sub_ps(r, _mm_mul_ps(B, loadBytes4(pix + 4 + width)));
+    r = _mm_sub_ps(r, _mm_mul_ps(B, loadBytes4(pix - 4 - width)));
+    r = _mm_sub_ps(r, _mm_mul_ps(B, loadBytes4(pix - 4 + width)));
+
+    // Truncate and clamp to 0...255.
+    __m128i v = _mm_cvttps_epi32(r);
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    uint8_t result[4];
+    const int32_t bytes = _mm_cvtsi128_si32(v);
+    std::memcpy(result, &bytes, 4);
+    out[0] = result[0];
+    out[1] = result[1];
+    out[2] = result[2];
+    out[3] = pix[3];
+}
+
+TK_SSE2 void sharpenRunSSE2(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                            float A, float B, float C)
+{
+    if (comps != 4) return sharpenRunScalar(pix, out, count, comps, width, A, B, C);
+
+    const __m128 a = _mm_set1_ps(A);
+    const __m128 b = _mm_set1_ps(B);
+    const __m128 c = _mm_set1_ps(C);
+    for (int x = 0; x < count; ++x, pix += 4, out += 4)
+    {
+        sharpenPixelSSE2(pix, out, width, a, b, c);
+    }
+}
+
+TK_SSE2 void bytesToFloatsSSE2(const uint8_t *in, float *out, long count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_ps(out + i,      _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_ps(out + i + 4,  _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_ps(out + i + 8,  _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_ps(out + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+    }
+    bytesToFloatsScalar(in + i, out + i, count - i);
+}
+
+TK_SSE2 void floatsToBytesSSE2(const float *in, uint8_t *out, long count)
+{
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = _mm_cvttps_epi32(_mm_loadu_ps(in + i));
+        const __m128i v1 = _mm_cvttps_epi32(_mm_loadu_ps(in + i + 4));
+        const __m128i v2 = _mm_cvttps_epi32(_mm_loadu_ps(in + i + 8));
+        const __m128i v3 = _mm_cvttps_epi32(_mm_loadu_ps(in + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+    }
+    floatsToBytesScalar(in + i, out + i, count - i);
+}
+
+/**
+ * Computes <code>a * (1.0 - w) + b * w</code> like the scalar code does: the
+ * first product in double precision, the second in single precision.
+ */
+TK_SSE2 inline __m128 blendSSE2(__m128 a, __m128 b, __m128d oneMinusW, __m128 w)
+{
+    const __m128 bw = _mm_mul_ps(b, w);
+    const __m128d lo = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(a), oneMinusW), _mm_cvtps_pd(bw));
+    const __m128d hi = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), oneMinusW),
+                                  _mm_cvtps_pd(_mm_movehl_ps(bw, bw)));
+    return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+
+TK_SSE2 void magnifyRowSSE2(const float *src0, const float *src1, float alpha, float *dst,
+                            int widthIn, int widthOut, float sx, int comps)
+{
+    if (comps != 4) return magnifyRowScalar(src0, src1, alpha, dst, widthIn, widthOut, sx, comps);
+
+    const __m128d oneMinusAlpha = _mm_set1_pd(1.0 - alpha);
+    const __m128 alphas = _mm_set1_ps(alpha);
+    for (int j = 0; j < widthOut; ++j, dst += 4)
+    {
+        int j0, j1;
+        float beta;
+        magnifySample(j, sx, widthIn, j0, j1, beta);
+
+        const __m128d oneMinusBeta = _mm_set1_pd(1.0 - beta);
+        const __m128 betas = _mm_set1_ps(beta);
+        const __m128 s1 = blendSSE2(_mm_loadu_ps(src0 + j0 * 4), _mm_loadu_ps(src0 + j1 * 4),
+                                    oneMinusBeta, betas);
+        const __m128 s2 = blendSSE2(_mm_loadu_ps(src1 + j0 * 4), _mm_loadu_ps(src1 + j1 * 4),
+                                    oneMinusBeta, betas);
+        _mm_storeu_ps(dst, blendSSE2(s1, s2, oneMinusAlpha, alphas));
+    }
+}
+
+TK_SSE2 void minifyRowSSE2(const float *src0, const float *src1, float *dst,
+                           int widthIn, int widthOut, float sx, int comps)
+{
+    if (comps != 4) return minifyRowScalar(src0, src1, dst, widthIn, widthOut, sx, comps);
+
+    const int rows = (src1? 2 : 1);
+    for (int j = 0; j < widthOut; ++j, dst += 4)
+    {
+        int j0, j1;
+        minifySample(j, sx, widthIn, j0, j1);
+        __m128 sum = _mm_setzero_ps();
+        for (int ii = 0; ii < rows; ++ii)
+        {
+            const float *row = (ii? src1 : src0);
+            for (int jj = j0; jj <= j1; ++jj)
+            {
+                sum = _mm_add_ps(sum, _mm_loadu_ps(row + jj * 4));
+            }
+        }
+        _mm_storeu_ps(dst, _mm_div_ps(sum, _mm_set1_ps(float((j1 - j0 + 1) * rows))));
+    }
+}
+
+const TexKernels sse2Kernels = {
+    downMipmapRowSSE2,
+    sumRGBSSE2,
+    minMaxSumSSE2,
+    maxSSE2,
+    colorKeySSE2,
+    sharpenRunSSE2,
+    bytesToFloatsSSE2,
+    floatsToBytesSSE2,
+    magnifyRowSSE2,
+    minifyRowSSE2,
+};
+
+//---------------------------------------------------------------------------------------
+// AVX2
+//---------------------------------------------------------------------------------------
+
+TK_AVX2 inline uint64_t sumLanes256(__m256i v)
+{
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+TK_AVX2 void downMipmapRowAVX2(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                               int outWidth, int comps)
+{
+    if (comps != 4) return downMipmapRowScalar(row0, row1, out, outWidth, comps);
+
+    // The pack instruction works within 128-bit lanes, so the output pixels
+    // come out in the order 0 2 4 6 1 3 5 7.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int x = 0;
+    for (; x + 8 <= outWidth; x += 8, row0 += 64, row1 += 64, out += 32)
+    {
+        __m256i s[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            // Vertical sums of four source pixels.
+            const __m256i a = _mm256_cvtepu8_epi16(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 16 * k)));
+            const __m256i b = _mm256_cvtepu8_epi16(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 16 * k)));
+            s[k] = _mm256_add_epi16(a, b);
+        }
+        __m256i h0 = _mm256_add_epi16(_mm256_unpacklo_epi64(s[0], s[1]),
+                                      _mm256_unpackhi_epi64(s[0], s[1]));
+        __m256i h1 = _mm256_add_epi16(_mm256_unpacklo_epi64(s[2], s[3]),
+                                      _mm256_unpackhi_epi64(s[2], s[3]));
+        h0 = _mm256_srli_epi16(h0, 2);
+        h1 = _mm256_srli_epi16(h1, 2);
+        const __m256i packed = _mm256_packus_epi16(h0, h1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                            _mm256_permutevar8x32_epi32(packed, order));
+    }
+    downMipmapRowSSE2(row0, row1, out, outWidth - x, comps);
+}
+
+TK_AVX2 void sumRGBAVX2(const uint8_t *pixels, long numPels, int pixelSize, long *sums)
+{
+    if (pixelSize != 4) return sumRGBScalar(pixels, numPels, pixelSize, sums);
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    __m256i r = zero, g = zero, b = zero;
+    long i = 0;
+    for (; i + 8 <= numPels; i += 8, pixels += 32)
+    {
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels));
+        r = _mm256_add_epi64(r, _mm256_sad_epu8(_mm256_and_si256(p, mask), zero));
+        g = _mm256_add_epi64(g, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(p, 8), mask), zero));
+        b = _mm256_add_epi64(b, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(p, 16), mask), zero));
+    }
+    sums[0] += long(sumLanes256(r));
+    sums[1] += long(sumLanes256(g));
+    sums[2] += long(sumLanes256(b));
+    sumRGBSSE2(pixels, numPels - i, pixelSize, sums);
+}
+
+TK_AVX2 void minMaxSumAVX2(const uint8_t *values, long count, uint8_t *min, uint8_t *max,
+                           long *sum)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_set1_epi8(char(*min));
+    __m256i hi = _mm256_set1_epi8(char(*max));
+    __m256i total = zero;
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+        lo = _mm256_min_epu8(lo, v);
+        hi = _mm256_max_epu8(hi, v);
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(v, zero));
+    }
+    uint8_t los[32], his[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(los), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(his), hi);
+    for (int k = 0; k < 32; ++k)
+    {
+        if (los[k] < *min) *min = los[k];
+        if (his[k] > *max) *max = his[k];
+    }
+    *sum += long(sumLanes256(total));
+    minMaxSumSSE2(values + i, count - i, min, max, sum);
+}
+
+TK_AVX2 uint8_t maxAVX2(const uint8_t *values, const uint8_t *mask, long count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i hi = zero;
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+        if (mask)
+        {
+            const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + i));
+            v = _mm256_andnot_si256(_mm256_cmpeq_epi8(m, zero), v);
+        }
+        hi = _mm256_max_epu8(hi, v);
+    }
+    uint8_t his[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(his), hi);
+    uint8_t result = maxSSE2(values + i, mask? mask + i : nullptr, count - i);
+    for (uint8_t h : his)
+    {
+        if (h > result) result = h;
+    }
+    return result;
+}
+
+TK_AVX2 void colorKeyAVX2(uint8_t *rgba, long numPels)
+{
+    const __m256i rgbMask = _mm256_set1_epi32(int(KEY_RGB_MASK));
+    const __m256i magenta = _mm256_set1_epi32(int(KEY_MAGENTA));
+    const __m256i cyan    = _mm256_set1_epi32(int(KEY_CYAN));
+    long i = 0;
+    for (; i + 8 <= numPels; i += 8, rgba += 32)
+    {
+        __m256i *ptr = reinterpret_cast<__m256i *>(rgba);
+        const __m256i p = _mm256_loadu_si256(ptr);
+        const __m256i rgb = _mm256_and_si256(p, rgbMask);
+        const __m256i keyed = _mm256_or_si256(_mm256_cmpeq_epi32(rgb, magenta),
+                                              _mm256_cmpeq_epi32(rgb, cyan));
+        _mm256_storeu_si256(ptr, _mm256_andnot_si256(keyed, p));
+    }
+    colorKeySSE2(rgba, numPels - i);
+}
+
+/// Loads 8 bytes as floats.
+TK_AVX2 inline __m256 loadBytes8(const uint8_t *ptr)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr))));
+}
+
+TK_AVX2 void sharpenRunAVX2(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                            float A, float B, float C)
+{
+    if (comps != 4) return sharpenRunScalar(pix, out, count, comps, width, A, B, C);
+
+    const __m256 a = _mm256_set1_ps(A);
+    const __m256 b = _mm256_set1_ps(B);
+    const __m256 c = _mm256_set1_ps(C);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+    int x = 0;
+    for (; x + 2 <= count; x += 2, pix += 8, out += 8)
+    {
+        __m256 r = _mm256_mul_ps(c, loadBytes8(pix));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(a, loadBytes8(pix - width)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(a, loadBytes8(pix + 4)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(a, loadBytes8(pix - 4)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(a, loadBytes8(pix + width)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(b, loadBytes8(pix + 4 - width)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(b, loadBytes8(pix + 4 + width)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(b, loadBytes8(pix - 4 - width)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(b, loadBytes8(pix - 4 + width)));
+
+        const __m256i v = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvttps_epi32(r), zero), max);
+        int32_t result[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(result), v);
+        out[0] = uint8_t(result[0]);
+        out[1] = uint8_t(result[1]);
+        out[2] = uint8_t(result[2]);
+        out[3] = pix[3];
+        out[4] = uint8_t(result[4]);
+        out[5] = uint8_t(result[5]);
+        out[6] = uint8_t(result[6]);
+        out[7] = pix[7];
+    }
+    sharpenRunSSE2(pix, out, count - x, comps, width, A, B, C);
+}
+
+TK_AVX2 void bytesToFloatsAVX2(const uint8_t *in, float *out, long count)
+{
+    long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(out + i, loadBytes8(in + i));
+    }
+    bytesToFloatsScalar(in + i, out + i, count - i);
+}
+
+TK_AVX2 void floatsToBytesAVX2(const float *in, uint8_t *out, long count)
+{
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v0 = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i));
+        const __m256i v1 = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i + 8));
+        const __m256i v2 = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i + 16));
+        const __m256i v3 = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i + 24));
+        // Packing works within 128-bit lanes; restore the original order.
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(v0, v1),
+                                                   _mm256_packs_epi32(v2, v3));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_permutevar8x32_epi32(packed, order));
+    }
+    floatsToBytesSSE2(in + i, out + i, count - i);
+}
+
+/// @copydoc blendSSE2
+TK_AVX2 inline __m128 blendAVX2(__m128 a, __m128 b, __m256d oneMinusW, __m128 w)
+{
+    const __m256d sum = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(a), oneMinusW),
+                                      _mm256_cvtps_pd(_mm_mul_ps(b, w)));
+    return _mm256_cvtpd_ps(sum);
+}
+
+TK_AVX2 void magnifyRowAVX2(const float *src0, const float *src1, float alpha, float *dst,
+                            int widthIn, int widthOut, float sx, int comps)
+{
+    if (comps != 4) return magnifyRowScalar(src0, src1, alpha, dst, widthIn, widthOut, sx, comps);
+
+    const __m256d oneMinusAlpha = _mm256_set1_pd(1.0 - alpha);
+    const __m128 alphas = _mm_set1_ps(alpha);
+    for (int j = 0; j < widthOut; ++j, dst += 4)
+    {
+        int j0, j1;
+        float beta;
+        magnifySample(j, sx, widthIn, j0, j1, beta);
+
+        const __m256d oneMinusBeta = _mm256_set1_pd(1.0 - beta);
+        const __m128 betas = _mm_set1_ps(beta);
+        const __m128 s1 = blendAVX2(_mm_loadu_ps(src0 + j0 * 4), _mm_loadu_ps(src0 + j1 * 4),
+                                    oneMinusBeta, betas);
+        const __m128 s2 = blendAVX2(_mm_loadu_ps(src1 + j0 * 4), _mm_loadu_ps(src1 + j1 * 4),
+                                    oneMinusBeta, betas);
+        _mm_storeu_ps(dst, blendAVX2(s1, s2, oneMinusAlpha, alphas));
+    }
+}
+
+const TexKernels avx2Kernels = {
+    downMipmapRowAVX2,
+    sumRGBAVX2,
+    minMaxSumAVX2,
+    maxAVX2,
+    colorKeyAVX2,
+    sharpenRunAVX2,
+    bytesToFloatsAVX2,
+    floatsToBytesAVX2,
+    magnifyRowAVX2,
+    minifyRowSSE2, // At most 2x2 pixels per output pixel; no benefit from wider vectors.
+};
+
+bool cpuHasSSE2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true; // Part of the x86-64 baseline.
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    // The OS must save the YMM registers.
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // TEXKERNELS_X86
+
+#ifdef TEXKERNELS_NEON
+
+//---------------------------------------------------------------------------------------
+// NEON
+//---------------------------------------------------------------------------------------
+
+void downMipmapRowNEON(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                       int outWidth, int comps)
+{
+    if (comps != 4) return downMipmapRowScalar(row0, row1, out, outWidth, comps);
+
+    int x = 0;
+    for (; x + 4 <= outWidth; x += 4, row0 += 32, row1 += 32, out += 16)
+    {
+        // De-interleave even and odd pixels.
+        const uint32x4x2_t a = vld2q_u32(reinterpret_cast<const uint32_t *>(row0));
+        const uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t *>(row1));
+        const uint8x16_t a0 = vreinterpretq_u8_u32(a.val[0]);
+        const uint8x16_t a1 = vreinterpretq_u8_u32(a.val[1]);
+        const uint8x16_t b0 = vreinterpretq_u8_u32(b.val[0]);
+        const uint8x16_t b1 = vreinterpretq_u8_u32(b.val[1]);
+
+        uint16x8_t lo = vaddl_u8(vget_low_u8(a0), vget_low_u8(a1));
+        lo = vaddq_u16(lo, vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+        uint16x8_t hi = vaddl_u8(vget_high_u8(a0), vget_high_u8(a1));
+        hi = vaddq_u16(hi, vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+
+        vst1q_u8(out, vcombine_u8(vshrn_n_u16(lo, 2), vshrn_n_u16(hi, 2)));
+    }
+    downMipmapRowScalar(row0, row1, out, outWidth - x, comps);
+}
+
+void sumRGBNEON(const uint8_t *pixels, long numPels, int pixelSize, long *sums)
+{
+    if (pixelSize != 4) return sumRGBScalar(pixels, numPels, pixelSize, sums);
+
+    uint64x2_t r = vdupq_n_u64(0), g = r, b = r;
+    long i = 0;
+    for (; i + 16 <= numPels; i += 16, pixels += 64)
+    {
+        const uint8x16x4_t p = vld4q_u8(pixels);
+        r = vpadalq_u32(r, vpaddlq_u16(vpaddlq_u8(p.val[0])));
+        g = vpadalq_u32(g, vpaddlq_u16(vpaddlq_u8(p.val[1])));
+        b = vpadalq_u32(b, vpaddlq_u16(vpaddlq_u8(p.val[2])));
+    }
+    sums[0] += long(vaddvq_u64(r));
+    sums[1] += long(vaddvq_u64(g));
+    sums[2] += long(vaddvq_u64(b));
+    sumRGBScalar(pixels, numPels - i, pixelSize, sums);
+}
+
+void minMaxSumNEON(const uint8_t *values, long count, uint8_t *min, uint8_t *max, long *sum)
+{
+    uint8x16_t lo = vdupq_n_u8(*min);
+    uint8x16_t hi = vdupq_n_u8(*max);
+    uint64x2_t total = vdupq_n_u64(0);
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16_t v = vld1q_u8(values + i);
+        lo = vminq_u8(lo, v);
+        hi = vmaxq_u8(hi, v);
+        total = vpadalq_u32(total, vpaddlq_u16(vpaddlq_u8(v)));
+    }
+    *min = vminvq_u8(lo);
+    *max = vmaxvq_u8(hi);
+    *sum += long(vaddvq_u64(total));
+    minMaxSumScalar(values + i, count - i, min, max, sum);
+}
+
+uint8_t maxNEON(const uint8_t *values, const uint8_t *mask, long count)
+{
+    uint8x16_t hi = vdupq_n_u8(0);
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t v = vld1q_u8(values + i);
+        if (mask)
+        {
+            // Nonzero mask bytes become all ones.
+            v = vandq_u8(v, vtstq_u8(vld1q_u8(mask + i), vld1q_u8(mask + i)));
+        }
+        hi = vmaxq_u8(hi, v);
+    }
+    const uint8_t result = maxScalar(values + i, mask? mask + i : nullptr, count - i);
+    const uint8_t vecMax = vmaxvq_u8(hi);
+    return vecMax > result? vecMax : result;
+}
+
+void colorKeyNEON(uint8_t *rgba, long numPels)
+{
+    const uint32x4_t rgbMask = vdupq_n_u32(KEY_RGB_MASK);
+    const uint32x4_t magenta = vdupq_n_u32(KEY_MAGENTA);
+    const uint32x4_t cyan    = vdupq_n_u32(KEY_CYAN);
+    long i = 0;
+    for (; i + 4 <= numPels; i += 4, rgba += 16)
+    {
+        uint32_t *ptr = reinterpret_cast<uint32_t *>(rgba);
+        const uint32x4_t p = vld1q_u32(ptr);
+        const uint32x4_t rgb = vandq_u32(p, rgbMask);
+        const uint32x4_t keyed = vorrq_u32(vceqq_u32(rgb, magenta), vceqq_u32(rgb, cyan));
+        vst1q_u32(ptr, vbicq_u32(p, keyed));
+    }
+    colorKeyScalar(rgba, numPels - i);
+}
+
+/// Loads 4 bytes as floats.
+inline float32x4_t loadBytes4(const uint8_t *ptr)
+{
+    uint32_t bytes;
+    std::memcpy(&bytes, ptr, 4);
+    const uint16x8_t v = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes)));
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+}
+
+void sharpenRunNEON(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                    float A, float B, float C)
+{
+    if (comps != 4) return sharpenRunScalar(pix, out, count, comps, width, A, B, C);
+
+    const float32x4_t a = vdupq_n_f32(A);
+    const float32x4_t b = vdupq_n_f32(B);
+    const float32x4_t c = vdupq_n_f32(C);
+    for (int x = 0; x < count; ++x, pix += 4, out += 4)
+    {
+        // Separate multiply and subtract (no fused multiply-add), like the scalar code.
+        float32x4_t r = vmulq_f32(c, loadBytes4(pix));
+        r = vsubq_f32(r, vmulq_f32(a, loadBytes4(pix - width)));
+        r = vsubq_f32(r, vmulq_f32(a, loadBytes4(pix + 4)));
+        r = vsubq_f32(r, vmulq_f32(a, loadBytes4(pix - 4)));
+        r = vsubq_f32(r, vmulq_f32(a, loadBytes4(pix + width)));
+        r = vsubq_f32(r, vmulq_f32(b, loadBytes4(pix + 4 - width)));
+        r = vsubq_f32(r, vmulq_f32(b, loadBytes4(pix + 4 + width)));
+        r = vsubq_f32(r, vmulq_f32(b, loadBytes4(pix - 4 - width)));
+        r = vsubq_f32(r, vmulq_f32(b, loadBytes4(pix - 4 + width)));
+
+        // Truncate and clamp to 0...255.
+        const int32x4_t v = vminq_s32(vmaxq_s32(vcvtq_s32_f32(r), vdupq_n_s32(0)),
+                                      vdupq_n_s32(255));
+        out[0] = uint8_t(vgetq_lane_s32(v, 0));
+        out[1] = uint8_t(vgetq_lane_s32(v, 1));
+        out[2] = uint8_t(vgetq_lane_s32(v, 2));
+        out[3] = pix[3];
+    }
+}
+
+void bytesToFloatsNEON(const uint8_t *in, float *out, long count)
+{
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16_t v = vld1q_u8(in + i);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        vst1q_f32(out + i,      vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))));
+        vst1q_f32(out + i + 4,  vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))));
+        vst1q_f32(out + i + 8,  vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))));
+        vst1q_f32(out + i + 12, vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))));
+    }
+    bytesToFloatsScalar(in + i, out + i, count - i);
+}
+
+void floatsToBytesNEON(const float *in, uint8_t *out, long count)
+{
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // Conversion truncates toward zero.
+        const uint16x8_t lo = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(vld1q_f32(in + i))),
+                                           vqmovn_u32(vcvtq_u32_f32(vld1q_f32(in + i + 4))));
+        const uint16x8_t hi = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(vld1q_f32(in + i + 8))),
+                                           vqmovn_u32(vcvtq_u32_f32(vld1q_f32(in + i + 12))));
+        vst1q_u8(out + i, vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+    }
+    floatsToBytesScalar(in + i, out + i, count - i);
+}
+
+/// Computes <code>a * (1.0 - w) + b * w</code> like the scalar code does.
+inline float32x4_t blendNEON(float32x4_t a, float32x4_t b, float64x2_t oneMinusW, float32x4_t w)
+{
+    const float32x4_t bw = vmulq_f32(b, w);
+    const float64x2_t lo = vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(a)), oneMinusW),
+                                     vcvt_f64_f32(vget_low_f32(bw)));
+    const float64x2_t hi = vaddq_f64(vmulq_f64(vcvt_high_f64_f32(a), oneMinusW),
+                                     vcvt_high_f64_f32(bw));
+    return vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+}
+
+void magnifyRowNEON(const float *src0, const float *src1, float alpha, float *dst,
+                    int widthIn, int widthOut, float sx, int comps)
+{
+    if (comps != 4) return magnifyRowScalar(src0, src1, alpha, dst, widthIn, widthOut, sx, comps);
+
+    const float64x2_t oneMinusAlpha = vdupq_n_f64(1.0 - alpha);
+    const float32x4_t alphas = vdupq_n_f32(alpha);
+    for (int j = 0; j < widthOut; ++j, dst += 4)
+    {
+        int j0, j1;
+        float beta;
+        magnifySample(j, sx, widthIn, j0, j1, beta);
+
+        const float64x2_t oneMinusBeta = vdupq_n_f64(1.0 - beta);
+        const float32x4_t betas = vdupq_n_f32(beta);
+        const float32x4_t s1 = blendNEON(vld1q_f32(src0 + j0 * 4), vld1q_f32(src0 + j1 * 4),
+                                         oneMinusBeta, betas);
+        const float32x4_t s2 = blendNEON(vld1q_f32(src1 + j0 * 4), vld1q_f32(src1 + j1 * 4),
+                                         oneMinusBeta, betas);
+        vst1q_f32(dst, blendNEON(s1, s2, oneMinusAlpha, alphas));
+    }
+}
+
+void minifyRowNEON(const float *src0, const float *src1, float *dst,
+                   int widthIn, int widthOut, float sx, int comps)
+{
+    if (comps != 4) return minifyRowScalar(src0, src1, dst, widthIn, widthOut, sx, comps);
+
+    const int rows = (src1? 2 : 1);
+    for (int j = 0; j < widthOut; ++j, dst += 4)
+    {
+        int j0, j1;
+        minifySample(j, sx, widthIn, j0, j1);
+        float32x4_t sum = vdupq_n_f32(0);
+        for (int ii = 0; ii < rows; ++ii)
+        {
+            const float *row = (ii? src1 : src0);
+            for (int jj = j0; jj <= j1; ++jj)
+            {
+                sum = vaddq_f32(sum, vld1q_f32(row + jj * 4));
+            }
+        }
+        vst1q_f32(dst, vdivq_f32(sum, vdupq_n_f32(float((j1 - j0 + 1) * rows))));
+    }
+}
+
+const TexKernels neonKernels = {
+    downMipmapRowNEON,
+    sumRGBNEON,
+    minMaxSumNEON,
+    maxNEON,
+    colorKeyNEON,
+    sharpenRunNEON,
+    bytesToFloatsNEON,
+    floatsToBytesNEON,
+    magnifyRowNEON,
+    minifyRowNEON,
+};
+
+#endif // TEXKERNELS_NEON
+
+bool isSupported(texkernelisa_t isa)
+{
+    switch (isa)
+    {
+    case TKI_SCALAR: return true;
+#ifdef TEXKERNELS_X86
+    case TKI_SSE2:   return cpuHasSSE2();
+    case TKI_AVX2:   return cpuHasSSE2() && cpuHasAVX2();
+#endif
+#ifdef TEXKERNELS_NEON
+    case TKI_NEON:   return true; // Part of the AArch64 baseline.
+#endif
+    default:         return false;
+    }
+}
+
+const TexKernels &kernelsFor(texkernelisa_t isa)
+{
+    switch (isa)
+    {
+#ifdef TEXKERNELS_X86
+    case TKI_SSE2: return sse2Kernels;
+    case TKI_AVX2: return avx2Kernels;
+#endif
+#ifdef TEXKERNELS_NEON
+    case TKI_NEON: return neonKernels;
+#endif
+    default:       return scalarKernels;
+    }
+}
+
+std::atomic<texkernelisa_t> &selectedISA()
+{
+    static std::atomic<texkernelisa_t> isa(TexKernel_BestISA());
+    return isa;
+}
+
+inline const TexKernels &kernels()
+{
+    return kernelsFor(selectedISA().load(std::memory_order_relaxed));
+}
+
+} // namespace
+
+texkernelisa_t TexKernel_BestISA(void)
+{
+    static const texkernelisa_t best = []()
+    {
+        for (int isa = NUM_TEXKERNEL_ISAS - 1; isa > TKI_SCALAR; --isa)
+        {
+            if (isSupported(texkernelisa_t(isa))) return texkernelisa_t(isa);
+        }
+        return TKI_SCALAR;
+    }();
+    return best;
+}
+
+texkernelisa_t TexKernel_ISA(void)
+{
+    return selectedISA();
+}
+
+bool TexKernel_SetISA(texkernelisa_t isa)
+{
+    if (isa < TKI_SCALAR || isa >= NUM_TEXKERNEL_ISAS || !isSupported(isa))
+    {
+        return false;
+    }
+    selectedISA() = isa;
+    return true;
+}
+
+const char *TexKernel_ISAName(texkernelisa_t isa)
+{
+    switch (isa)
+    {
+    case TKI_SCALAR: return "scalar";
+    case TKI_SSE2:   return "SSE2";
+    case TKI_AVX2:   return "AVX2";
+    case TKI_NEON:   return "NEON";
+    default:         return "unknown";
+    }
+}
+
+void TexKernel_DownMipmapRow(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                             int outWidth, int comps)
+{
+    kernels().downMipmapRow(row0, row1, out, outWidth, comps);
+}
+
+void TexKernel_SumRGB(const uint8_t *pixels, long numPels, int pixelSize, long sums[3])
+{
+    sums[0] = sums[1] = sums[2] = 0;
+    kernels().sumRGB(pixels, numPels, pixelSize, sums);
+}
+
+void TexKernel_MinMaxSum(const uint8_t *values, long count, uint8_t *min, uint8_t *max,
+                         long *sum)
+{
+    *min = 255;
+    *max = 0;
+    *sum = 0;
+    kernels().minMaxSum(values, count, min, max, sum);
+}
+
+uint8_t TexKernel_Max(const uint8_t *values, const uint8_t *mask, long count)
+{
+    return kernels().max(values, mask, count);
+}
+
+void TexKernel_Lookup(uint8_t *values, long count, const uint8_t table[256])
+{
+    // A table lookup does not vectorize without gather instructions, and a gather
+    // of 32-bit elements is not faster than this.
+    for (long i = 0; i < count; ++i)
+    {
+        values[i] = table[values[i]];
+    }
+}
+
+void TexKernel_ColorKey(uint8_t *rgba, long numPels)
+{
+    kernels().colorKey(rgba, numPels);
+}
+
+void TexKernel_SharpenRun(const uint8_t *pix, uint8_t *out, int count, int comps, int width,
+                          float A, float B, float C)
+{
+    kernels().sharpenRun(pix, out, count, comps, width, A, B, C);
+}
+
+void TexKernel_BytesToFloats(const uint8_t *in, float *out, long count)
+{
+    kernels().bytesToFloats(in, out, count);
+}
+
+void TexKernel_FloatsToBytes(const float *in, uint8_t *out, long count)
+{
+    kernels().floatsToBytes(in, out, count);
+}
+
+void TexKernel_MagnifyRow(const float *src0, const float *src1, float alpha, float *dst,
+                          int widthIn, int widthOut, float sx, int comps)
+{
+    kernels().magnifyRow(src0, src1, alpha, dst, widthIn, widthOut, sx, comps);
+}
+
+void TexKernel_MinifyRow(const float *src0, const float *src1, float *dst,
+                         int widthIn, int widthOut, float sx, int comps)
+{
+    kernels().minifyRow(src0, src1, dst, widthIn, widthOut, sx, comps);
+}
@@ -743,27 +743,32 @@ static dd_bool uploadTextureGrayMipmap(GLenum         glFormat,
 }
 
 /// @note Texture parameters will NOT be set here!
-void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod method)
+/**
+ * Converts the pixels of @a content to the truecolor format and the dimensions
+ * they will be uploaded with. Only the CPU is used, so this can be done in any
+ * thread.
+ *
+ * @param content     Texture content to convert.
+ * @param dglFormat   The final format (DGL_RGB or DGL_RGBA) is written here.
+ * @param loadWidth   The final width is written here.
+ * @param loadHeight  The final height is written here.
+ *
+ * @return  Converted pixels. If these are not the same as @c content.pixels,
+ * the caller gets ownership of the buffer (free with M_Free).
+ */
+static const uint8_t *convertTextureContentForUpload(const texturecontent_t &content,
+                                                     dgltexformat_t &dglFormat,
+                                                     int &loadWidth, int &loadHeight)
 {
-    if (method == gfx::Deferred)
-    {
-        GL_DeferTextureUpload(&content);
-        return;
-    }
-
-    if (novideo) return;
-
-    // Do this right away. No need to take a copy.
     bool generateMipmaps = (content.flags & (TXCF_MIPMAP|TXCF_GRAY_MIPMAP)) != 0;
     bool applyTexGamma   = (content.flags & TXCF_APPLY_GAMMACORRECTION)     != 0;
-    bool noCompression   = (content.flags & TXCF_NO_COMPRESSION)            != 0;
     bool noSmartFilter   = (content.flags & TXCF_UPLOAD_ARG_NOSMARTFILTER)  != 0;
     bool noStretch       = (content.flags & TXCF_UPLOAD_ARG_NOSTRETCH)      != 0;
 
-    int loadWidth             = content.width;
-    int loadHeight            = content.height;
+    loadWidth                 = content.width;
+    loadHeight                = content.height;
     const uint8_t *loadPixels = content.pixels;
-    dgltexformat_t dglFormat  = content.format;
+    dglFormat                 = content.format;
 
     // Convert a paletted source image to truecolor.
     if (dglFormat == DGL_COLOR_INDEX_8 || dglFormat == DGL_COLOR_INDEX_8_PLUS_A8)
@@ -964,6 +969,59 @@ void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod
         }
     }
 
+    return loadPixels;
+}
+
+texturecontent_t *GL_ConstructUploadReadyTextureContent(const texturecontent_t &content)
+{
+    if (content.flags & TXCF_UPLOAD_READY)
+    {
+        return GL_ConstructTextureContentCopy(&content);
+    }
+
+    texturecontent_t *c = (texturecontent_t *) M_Malloc(sizeof(*c));
+    std::memcpy(c, &content, sizeof(*c));
+
+    const uint8_t *pixels = convertTextureContentForUpload(content, c->format,
+                                                           c->width, c->height);
+    if (pixels == content.pixels)
+    {
+        // Nothing was converted; the copy needs a buffer of its own.
+        const size_t bufferSize = BytesPerPixelFmt(c->format) * c->width * c->height;
+        uint8_t *copied = (uint8_t *) M_Malloc(bufferSize);
+        std::memcpy(copied, pixels, bufferSize);
+        pixels = copied;
+    }
+    c->pixels    = pixels;
+    c->paletteId = 0;
+    c->flags    |= TXCF_UPLOAD_READY;
+    return c;
+}
+
+void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod method)
+{
+    if (method == gfx::Deferred)
+    {
+        GL_DeferTextureUpload(&content);
+        return;
+    }
+
+    if (novideo) return;
+
+    // Do this right away. No need to take a copy.
+    const bool generateMipmaps = (content.flags & (TXCF_MIPMAP|TXCF_GRAY_MIPMAP)) != 0;
+    const bool noCompression   = (content.flags & TXCF_NO_COMPRESSION)            != 0;
+
+    int loadWidth             = content.width;
+    int loadHeight            = content.height;
+    const uint8_t *loadPixels = content.pixels;
+    dgltexformat_t dglFormat  = content.format;
+
+    if (!(content.flags & TXCF_UPLOAD_READY))
+    {
+        loadPixels = convertTextureContentForUpload(content, dglFormat, loadWidth, loadHeight);
+    }
+
     //DE_ASSERT_IN_MAIN_THREAD();
     DE_ASSERT_GL_CONTEXT_ACTIVE();
 
@@ -0,0 +1,123 @@
+/** @file depthsort.cpp  Back-to-front ordering of projected objects.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/depthsort.h"
+
+#include <cstring>
+#include <utility>
+
+/// Below this many items an insertion sort is faster than the radix passes.
+static const size_t DEPTHSORT_INSERTION_MAX = 32;
+
+/**
+ * Converts a distance to an unsigned integer with the same ordering: positive
+ * values get the sign bit set, negative values are inverted.
+ */
+static inline uint64_t depthSortKey(double distance)
+{
+    distance += 0.0; // -0 equals +0.
+
+    uint64_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return (bits & 0x8000000000000000ull)? ~bits : (bits | 0x8000000000000000ull);
+}
+
+void DepthSorter::clear()
+{
+    _items.clear();
+}
+
+void DepthSorter::add(double distance)
+{
+    _items.push_back(Item{ depthSortKey(distance), uint32_t(_items.size()) });
+}
+
+size_t DepthSorter::size() const
+{
+    return _items.size();
+}
+
+const uint32_t *DepthSorter::sortBackToFront()
+{
+    const size_t count = _items.size();
+
+    // The items are first sorted by increasing distance, keeping the order of
+    // addition for equal keys. Reversing that gives the drawing order.
+    if (count <= DEPTHSORT_INSERTION_MAX)
+    {
+        for (size_t i = 1; i < count; ++i)
+        {
+            const Item item = _items[i];
+            size_t k = i;
+            for (; k > 0 && _items[k - 1].key > item.key; --k)
+            {
+                _items[k] = _items[k - 1];
+            }
+            _items[k] = item;
+        }
+    }
+    else
+    {
+        // Histograms of all the bytes are computed in one go.
+        size_t counts[8][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (const Item &item : _items)
+        {
+            for (int b = 0; b < 8; ++b)
+            {
+                counts[b][(item.key >> (8 * b)) & 0xff]++;
+            }
+        }
+
+        _temp.resize(count);
+        Item *src = _items.data();
+        Item *dst = _temp.data();
+        for (int b = 0; b < 8; ++b)
+        {
+            const int shift = 8 * b;
+
+            // If all keys have the same byte, the pass would not change anything.
+            if (counts[b][(src[0].key >> shift) & 0xff] == count) continue;
+
+            size_t offsets[256];
+            size_t sum = 0;
+            for (int i = 0; i < 256; ++i)
+            {
+                offsets[i] = sum;
+                sum += counts[b][i];
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        if (src != _items.data())
+        {
+            _items.swap(_temp);
+        }
+    }
+
+    _order.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        _order[i] = _items[count - 1 - i].index;
+    }
+    return _order.data();
+}
@@ -4505,7 +4505,7 @@ static void drawMasked()
 
     R_SortVisSprites();
 
-    if (::visSpriteP && ::visSpriteP > ::visSprites)
+    if (R_VisSpriteCount() > 0)
     {
         bool primaryHaloDrawn = false;
 
@@ -84,11 +84,11 @@ static int maxParticles;           ///< @c 0= Unlimited.
 static int particleNearLimit;
 static float particleDiffuse = 4;
 
-static float pointDist(fixed_t const c[3])
+static float pointDist(const Vec3f &c)
 {
     const viewdata_t *viewData = &viewPlayer->viewport();
-    float dist = ((viewData->current.origin.y - FIX2FLT(c[1])) * -viewData->viewSin)
-                - ((viewData->current.origin.x - FIX2FLT(c[0])) * viewData->viewCos);
+    float dist = ((viewData->current.origin.y - c.y) * -viewData->viewSin)
+                - ((viewData->current.origin.x - c.x) * viewData->viewCos);
 
     return de::abs(dist);  // Always return positive.
 }
@@ -339,7 +339,7 @@ static int listVisibleParticles(Map &map)
             if(!particlePVisible(pinfo)) continue;  // Skip.
 
             // Skip particles too far from, or near to, the viewer.
-            const float dist = de::max(pointDist(pinfo.origin), 1.f);
+            const float dist = de::max(pointDist(gen.particleOrigin(i)), 1.f);
             if(gen.def->maxDist != 0 && dist > gen.def->maxDist) continue;
             if(dist < float( ::particleNearLimit )) continue;
 
@@ -402,7 +402,7 @@ static int listVisibleParticles(Map &map)
 
 static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pinfo,
     const GeneratorParticleStage *st, const ded_ptcstage_t *dst, const Vec3f &origin,
-    float dist, float size, float mark, float alpha)
+    const Vec3f &momentum, float dist, float size, float mark, float alpha)
 {
     drawmodelparams_t &parm = *VS_MODEL(&spr);
 
@@ -429,7 +429,7 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
     // Set the correct orientation for the particle.
     if(parm.mf->testSubFlag(0, MFF_MOVEMENT_YAW))
     {
-        spr.pose.yaw = R_MovementXYYaw(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1]));
+        spr.pose.yaw = R_MovementXYYaw(momentum.x, momentum.y);
     }
     else
     {
@@ -438,7 +438,7 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
 
     if(parm.mf->testSubFlag(0, MFF_MOVEMENT_PITCH))
     {
-        spr.pose.pitch = R_MovementXYZPitch(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1]), FIX2FLT(pinfo->mov[2]));
+        spr.pose.pitch = R_MovementXYZPitch(momentum.x, momentum.y, momentum.z);
     }
     else
     {
@@ -677,14 +677,17 @@ static void drawParticles(int rtype, bool withBlend)
 
         DGL_Color4f(color.x, color.y, color.z, color.w);
 
-        const bool nearWall = (pinfo.contact && !pinfo.mov[0] && !pinfo.mov[1]);
+        const Vec3f origin   = gen->particleOrigin(slot->particleId);
+        const Vec3f momentum = gen->particleMomentum(slot->particleId);
+
+        const bool nearWall = (pinfo.contact && !momentum.x && !momentum.y);
 
         bool nearPlane = false;
         if (world::ConvexSubspace *space = pinfo.bspLeaf->subspacePtr())
         {
             auto &subsec = space->subsector().as<Subsector>();
-            if (   FLT2FIX(subsec.  visFloor().heightSmoothed()) + 2 * FRACUNIT >= pinfo.origin[2]
-                || FLT2FIX(subsec.visCeiling().heightSmoothed()) - 2 * FRACUNIT <= pinfo.origin[2])
+            if (   subsec.  visFloor().heightSmoothed() + 2 >= origin.z
+                || subsec.visCeiling().heightSmoothed() - 2 <= origin.z)
             {
                 nearPlane = true;
             }
@@ -700,19 +703,19 @@ static void drawParticles(int rtype, bool withBlend)
                 flatOnWall = true;
         }
 
-        Vec3f center = gen->particleOrigin(pinfo).xzy();
+        Vec3f center = origin.xzy();
 
         if(!flatOnPlane && !flatOnWall)
         {
             Vec3f offset(frameTimePos, nearPlane ? 0 : frameTimePos, frameTimePos);
-            center += offset * gen->particleMomentum(pinfo).xzy();
+            center += offset * momentum.xzy();
         }
 
         // Model particles are rendered using the normal model rendering routine.
         if(rtype == PTC_MODEL && stDef->model >= 0)
         {
             vissprite_t temp;
-            setupModelParamsForParticle(temp, &pinfo, st, stDef, center, dist, size, inter, color.w);
+            setupModelParamsForParticle(temp, &pinfo, st, stDef, center, momentum, dist, size, inter, color.w);
             Rend_DrawModel(temp);
             continue;
         }
@@ -746,18 +749,18 @@ static void drawParticles(int rtype, bool withBlend)
                 // collisions.
 
                 // Calculate a new center point (project onto the wall).
-                vec2d_t origin;
-                V2d_Set(origin, FIX2FLT(pinfo.origin[0]), FIX2FLT(pinfo.origin[1]));
+                vec2d_t pos;
+                V2d_Set(pos, origin.x, origin.y);
 
                 vec2d_t projected;
-                V2d_ProjectOnLine(projected, origin,
+                V2d_ProjectOnLine(projected, pos,
                                   contact.from().origin().data().baseAs<double>(),
                                   contact.direction().data().baseAs<double>());
 
                 // Move away from the wall to avoid the worst Z-fighting.
                 const double gap = -1;  // 1 map unit.
                 double diff[2], dist;
-                V2d_Subtract(diff, projected, origin);
+                V2d_Subtract(diff, projected, pos);
                 if((dist = V2d_Length(diff)) != 0)
                 {
                     projected[0] += diff[0] / dist * gap;
@@ -808,9 +811,9 @@ static void drawParticles(int rtype, bool withBlend)
         else  // It's a line.
         {
             DGL_Vertex3f(center.x, center.y, center.z);
-            DGL_Vertex3f(center.x - FIX2FLT(pinfo.mov[0]),
-                         center.y - FIX2FLT(pinfo.mov[2]),
-                         center.z - FIX2FLT(pinfo.mov[1]));
+            DGL_Vertex3f(center.x - momentum.x,
+                         center.y - momentum.z,
+                         center.z - momentum.y);
         }
     }
 
@@ -519,6 +519,9 @@ void R_NewSharpWorld()
 
     if (auto *map = maybeAs<Map>(ClientApp::world().mapPtr()))
     {
+        // The generators have thought during the tic.
+        map->moveGeneratorParticles();
+
         map->updateTrackedPlanes();
         map->updateScrollingSurfaces();
     }
@@ -21,6 +21,7 @@
  */
 
 #include "render/vissprite.h"
+#include "render/depthsort.h"
 
 #include "clientapp.h"
 
@@ -32,32 +33,42 @@
 
 using namespace de;
 
-/// @todo This should not be a fixed-size array. -jk
-vissprite_t visSprites[MAXVISSPRITES], *visSpriteP;
 vispsprite_t visPSprites[DDMAXPSPRITES];
 
 vissprite_t visSprSortedHead;
 
-static vissprite_t overflowVisSprite;
+/// Vissprites are allocated from blocks of this many. The blocks are kept from frame
+/// to frame, so the pool only allocates memory when a frame has more vissprites than
+/// any frame before it. Vissprites never move, so pointers to them remain valid
+/// until the end of the frame.
+static const dint VISSPRITE_BLOCK_SIZE = 1024;
+
+static List<vissprite_t *> visSpriteBlocks;
+static dint visSpriteCount;
+static DepthSorter visSpriteSorter;
+
+static inline vissprite_t *visSprite(dint index)
+{
+    return &visSpriteBlocks[index / VISSPRITE_BLOCK_SIZE][index % VISSPRITE_BLOCK_SIZE];
+}
 
 void R_ClearVisSprites()
 {
-    visSpriteP = visSprites;
+    visSpriteCount = 0;
 }
 
-vissprite_t *R_NewVisSprite(visspritetype_t type)
+dint R_VisSpriteCount()
 {
-    vissprite_t *spr;
+    return visSpriteCount;
+}
 
-    if (visSpriteP == &visSprites[MAXVISSPRITES])
-    {
-        spr = &overflowVisSprite;
-    }
-    else
+vissprite_t *R_NewVisSprite(visspritetype_t type)
+{
+    if (visSpriteCount == dint(visSpriteBlocks.size()) * VISSPRITE_BLOCK_SIZE)
     {
-        visSpriteP++;
-        spr = visSpriteP - 1;
+        visSpriteBlocks << new vissprite_t[VISSPRITE_BLOCK_SIZE];
     }
+    vissprite_t *spr = visSprite(visSpriteCount++);
 
     *spr = {};
     spr->type = type;
@@ -117,56 +128,27 @@ void VisSprite_SetupModel(vissprite_t *spr, const VisEntityPose &pose, const Vis
 
 void R_SortVisSprites()
 {
-    if(!visSpriteP) return;
-
-    const dint count = visSpriteP - visSprites;
-    if(count <= 0) return;
-
-    vissprite_t unsorted;
-    unsorted.next = unsorted.prev = &unsorted;
+    visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
+    if (!visSpriteCount) return;
 
-    for(vissprite_t *ds = visSprites; ds < visSpriteP; ds++)
+    visSpriteSorter.clear();
+    for (dint i = 0; i < visSpriteCount; ++i)
     {
-        ds->next = ds + 1;
-        ds->prev = ds - 1;
+        visSpriteSorter.add(visSprite(i)->pose.distance);
     }
-    visSprites[0].prev = &unsorted;
-    unsorted.next = &visSprites[0];
-    (visSpriteP - 1)->next = &unsorted;
-    unsorted.prev = visSpriteP - 1;
 
-    // Pull the vissprites out by distance.
-    visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
-
-    /// @todo Optimize:
-    /// Profile results from nuts.wad show over 25% of total execution time
-    /// was spent sorting vissprites (nuts.wad map01 is a perfect pathological
-    /// test case).
-    ///
-    /// Rather than try to speed up the sort, it would make more sense to
-    /// actually construct the vissprites in z order if it can be done in
-    /// linear time.
-
-    vissprite_t *best = nullptr;
-    for(dint i = 0; i < count; ++i)
+    // Link the vissprites in the order they will be drawn (back to front).
+    const duint32 *order = visSpriteSorter.sortBackToFront();
+    vissprite_t *last = &visSprSortedHead;
+    for (dint i = 0; i < visSpriteCount; ++i)
     {
-        ddouble bestdist = 0;
-        for(vissprite_t *ds = unsorted.next; ds != &unsorted; ds = ds->next)
-        {
-            if(ds->pose.distance >= bestdist)
-            {
-                bestdist = ds->pose.distance;
-                best = ds;
-            }
-        }
-
-        best->next->prev = best->prev;
-        best->prev->next = best->next;
-        best->next = &visSprSortedHead;
-        best->prev = visSprSortedHead.prev;
-        visSprSortedHead.prev->next = best;
-        visSprSortedHead.prev = best;
+        vissprite_t *spr = visSprite(dint(order[i]));
+        spr->prev  = last;
+        last->next = spr;
+        last = spr;
     }
+    last->next = &visSprSortedHead;
+    visSprSortedHead.prev = last;
 }
 
 void VisEntityLighting::setupLighting(const Vec3d &origin, ddouble distance,
@@ -68,6 +68,7 @@
 #include "gl/gl_texmanager.h"
 #include "gl/svg.h"
 #include "resource/clienttexture.h"
+#include "resource/texturecache.h"
 #include "render/rend_model.h"
 #include "render/rend_particle.h"  // Rend_ParticleReleaseSystemTextures
 #include "render/rendersystem.h"
@@ -142,6 +143,9 @@ DE_PIMPL(ClientResources)
     {
         virtual ~CacheTask() {}
         virtual void run() = 0;
+
+        /// Called after the texture content prepared during run() is complete.
+        virtual void finish() {}
     };
 
     /**
@@ -163,6 +167,12 @@ DE_PIMPL(ClientResources)
             // Cache all dependent assets and upload GL textures if necessary.
             material->getAnimator(*spec).cacheAssets();
         }
+
+        void finish()
+        {
+            // The snapshot was taken while the textures were still being prepared.
+            material->getAnimator(*spec).prepare(true);
+        }
     };
 
     /// A FIFO queue of material variant caching tasks.
@@ -171,12 +181,15 @@ DE_PIMPL(ClientResources)
     typedef List<CacheTask *> CacheQueue;
     CacheQueue cacheQueue;
 
+    TextureCache textureCache;
+
     Impl(Public *i)
         : Base(i)
         , fontManifestCount        (0)
         , fontManifestIdMapSize    (0)
         , fontManifestIdMap        (0)
         , modelRepository          (0)
+        , textureCache             (App::app().nativeHomePath() / "cache/textures")
     {
         LOG_AS("ClientResources");
 
@@ -523,11 +536,23 @@ DE_PIMPL(ClientResources)
 
     void processCacheQueue()
     {
-        while (!cacheQueue.isEmpty())
+        // Texture content is prepared in background tasks while the queue is
+        // processed; the tasks are finished once all the content is ready.
+        CacheQueue processed;
+        {
+            ClientTexture::PreparationBatch batch;
+            while (!cacheQueue.isEmpty())
+            {
+                CacheTask *task = cacheQueue.takeFirst();
+                processed << task;
+                task->run();
+            }
+        }
+        for (CacheTask *task : processed)
         {
-            std::unique_ptr<CacheTask> task(cacheQueue.takeFirst());
-            task->run();
+            task->finish();
         }
+        deleteAll(processed);
     }
 
     void queueCacheTasksForMaterial(ClientMaterial &material,
@@ -1485,6 +1510,11 @@ TextureVariantSpec &ClientResources::detailTextureSpec(dfloat contrast)
     return *d->detailTextureSpec(contrast);
 }
 
+TextureCache &ClientResources::textureCache()
+{
+    return d->textureCache;
+}
+
 FontScheme &ClientResources::fontScheme(const String& name) const
 {
     LOG_AS("ClientResources::fontScheme");
@@ -2211,10 +2241,23 @@ D_CMD(PrintFontStats)
 }
 #endif // DE_DEBUG
 
+D_CMD(ClearTextureCache)
+{
+    DE_UNUSED(src, argc, argv);
+
+    TextureCache &cache = App_Resources().textureCache();
+    const dint64 sizeBefore = cache.size();
+    cache.clear();
+    LOG_RES_MSG("Cleared the texture cache (%.1f MB)") << sizeBefore / 1.0e6;
+    return true;
+}
+
 void ClientResources::consoleRegister() // static
 {
     Resources::consoleRegister();
+    TextureCache::consoleRegister();
 
+    C_CMD("cleartexturecache", "", ClearTextureCache)
     C_CMD("listfonts",      "ss",   ListFonts)
     C_CMD("listfonts",      "s",    ListFonts)
     C_CMD("listfonts",      "",     ListFonts)
@@ -151,53 +151,38 @@
 #define PIXEL11_100     Interp10(pOut+BpL+4, w[5], w[6], w[8]);
 
 static uint32_t lutBGR888toYUV888[32*64*32];
-static uint32_t YUV1, YUV2;
 
-void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t f1,
-    uint32_t f2, uint32_t f3)
+/**
+ * Blends three colors with integer weights that sum up to (1 << Shift). Two
+ * components at a time are processed in the 16-bit halves of a 32-bit word;
+ * the weighted sums are at most 16 * 255, so the halves never overflow.
+ */
+template <uint32_t F1, uint32_t F2, uint32_t F3, int Shift>
+static inline void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    uint32_t out[4] = { 0, 0, 0, 0 }, total = f1 + f2 + f3;
-    if(0 != f1)
-    {
-        out[0] += f1 * ABGR8888_COMP(0, c1);
-        out[1] += f1 * ABGR8888_COMP(1, c1);
-        out[2] += f1 * ABGR8888_COMP(2, c1);
-        out[3] += f1 * ABGR8888_COMP(3, c1);
-    }
-    if(0 != f2)
-    {
-        out[0] += f2 * ABGR8888_COMP(0, c2);
-        out[1] += f2 * ABGR8888_COMP(1, c2);
-        out[2] += f2 * ABGR8888_COMP(2, c2);
-        out[3] += f2 * ABGR8888_COMP(3, c2);
-    }
-    if(0 != f3)
-    {
-        out[0] += f3 * ABGR8888_COMP(0, c3);
-        out[1] += f3 * ABGR8888_COMP(1, c3);
-        out[2] += f3 * ABGR8888_COMP(2, c3);
-        out[3] += f3 * ABGR8888_COMP(3, c3);
-    }
-    if(0 != total)
-    {
-        out[0] /= total;
-        out[1] /= total;
-        out[2] /= total;
-        out[3] /= total;
-    }
-    *((uint32_t*)pc) = ABGR8888_PACK(out[3], out[2], out[1], out[0]);
+    static_assert(F1 + F2 + F3 == (1u << Shift), "LerpColor: Weights must sum to a power of two");
+
+    const uint32_t mask = 0x00FF00FF;
+    const uint32_t even = ((F1 * (c1 & mask) + F2 * (c2 & mask) + F3 * (c3 & mask)) >> Shift) & mask;
+    const uint32_t odd  = ((F1 * ((c1 >> 8) & mask) + F2 * ((c2 >> 8) & mask) +
+                            F3 * ((c3 >> 8) & mask)) >> Shift) & mask;
+    *((uint32_t*)pc) = even | (odd << 8);
 }
 
-static __inline int Diff(uint32_t c1, uint32_t c2)
+/**
+ * @param yuv1  YUV of @a c1 (see ABGR8888toYUV888).
+ * @param yuv2  YUV of @a c2.
+ */
+static __inline int Diff(uint32_t c1, uint32_t c2, uint32_t yuv1, uint32_t yuv2)
 {
-    YUV1 = ABGR8888toYUV888(c1);
-    YUV2 = ABGR8888toYUV888(c2);
     return ( ((ABGR8888_COMP(3, c1) != 0) != ((ABGR8888_COMP(3, c2) != 0))) ||
-             (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-             (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-             (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
+             (abs(int(yuv1 & YUV888_Ymask) - int(yuv2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
+             (abs(int(yuv1 & YUV888_Umask) - int(yuv2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
+             (abs(int(yuv1 & YUV888_Vmask) - int(yuv2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
 }
 
+#define DIFF(a, b)      Diff(w[a], w[b], yuv[a], yuv[b])
+
 static __inline void Transl(uint8_t* pc, uint32_t c)
 {
     pc[0] = ABGR8888_COMP(0, c);
@@ -213,32 +198,32 @@ static __inline void Interp1(uint8_t* pc, uint32_t c1, uint32_t c2)
         Transl(pc, c1);
         return;
     }
-    LerpColor(pc, c1, c2, 0, 3, 1, 0);
+    LerpColor<3, 1, 0, 2>(pc, c1, c2, 0);
 }
 
 static __inline void Interp2(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 2, 1, 1);
+    LerpColor<2, 1, 1, 2>(pc, c1, c2, c3);
 }
 
 static __inline void Interp6(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 5, 2, 1);
+    LerpColor<5, 2, 1, 3>(pc, c1, c2, c3);
 }
 
 static __inline void Interp7(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 6, 1, 1);
+    LerpColor<6, 1, 1, 3>(pc, c1, c2, c3);
 }
 
 static __inline void Interp9(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 2, 3, 3);
+    LerpColor<2, 3, 3, 3>(pc, c1, c2, c3);
 }
 
 static __inline void Interp10(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 14, 1, 1);
+    LerpColor<14, 1, 1, 4>(pc, c1, c2, c3);
 }
 
 void GL_InitSmartFilterHQ2x(void)
@@ -263,7 +248,6 @@ void GL_InitSmartFilterHQ2x(void)
 uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags)
 {
 #define BPP             (4) // Bytes Per Pixel.
-#define OFFSET(x, y)    (BPP*(y)*width + BPP*(x))
 
     assert(src);
     {
@@ -271,7 +255,8 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
     dd_bool wrapV = (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0;
     int pattern, flag, BpL, xA, xB, yA, yB;
     uint8_t* pOut, *dst;
-    uint32_t w[10];
+    uint32_t* yuvPlane;
+    uint32_t w[10], yuv[10];
 
     if(width <= 0 || height <= 0)
         return 0;
@@ -288,6 +273,15 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
         App_Error("GL_SmartFilterHQ2x: Failed on allocation of %lu bytes for "
                   "output buffer.", (unsigned long) (BPP * 2 * width * height * 2));
 
+    // The YUV of each source pixel is needed up to 9 times.
+    yuvPlane = (uint32_t *) M_Malloc(sizeof(uint32_t) * width * height);
+    { int i;
+    for(i = 0; i < width * height; ++i)
+    {
+        const uint32_t c = DD_ULONG( *( (uint32_t*)(src + BPP * i) ) );
+        yuvPlane[i] = ABGR8888toYUV888(c);
+    }}
+
     pOut = dst;
     BpL = BPP * 2 * width; // (Out) Bytes per Line.
     { int y;
@@ -296,60 +290,26 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
         { int x;
         for(x = 0; x < width; ++x)
         {
-            w[5] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y)) ) );
-
-            // Horizontal neighbors.
-            if(wrapH)
-            {
-                w[4] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x == 0? width-1 : x-1, y)) ) );
-                w[6] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x == width-1? 0 : x+1, y)) ) );
-            }
-            else
-            {
-                if(x != 0)
-                    w[4] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x-1, y)) ) );
-                else
-                    w[4] = w[5];
-
-                if(x != width-1)
-                    w[6] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x+1, y)) ) );
-                else
-                    w[6] = w[5];
-            }
-
-            // Vertical neighbors.
-            if(wrapV)
-            {
-                w[2] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y == 0? height-1 : y-1)) ) );
-                w[8] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y == height-1? 0 : y+1)) ) );
-            }
-            else
-            {
-                if(y != 0)
-                    w[2] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y-1)) ) );
-                else
-                    w[2] = w[5];
-
-                if(y != height-1)
-                    w[8] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y+1)) ) );
-                else
-                    w[8] = w[5];
-            }
-
-            // Corners.
+            // Neighbor coordinates.
             xA =        x == 0? ( wrapH?  width-1 : 0) : x-1;
             xB =  x == width-1? (!wrapH?  width-1 : 0) : x+1;
             yA =        y == 0? ( wrapV? height-1 : 0) : y-1;
             yB = y == height-1? (!wrapV? height-1 : 0) : y+1;
 
-            w[1] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xA, yA)) ) );
-            w[7] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xA, yB)) ) );
-            w[3] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yA)) ) );
-            w[9] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yB)) ) );
+            // Without wrapping, the neighbors beyond the edges are the center
+            // pixel itself.
+            { const int cols[3] = { xA, x, xB };
+            const int rows[3] = { yA, y, yB };
+            int k;
+            for(k = 1; k <= 9; ++k)
+            {
+                const int idx = rows[(k - 1) / 3] * width + cols[(k - 1) % 3];
+                w[k]   = DD_ULONG( *( (uint32_t*)(src + BPP * idx) ) );
+                yuv[k] = yuvPlane[idx];
+            }}
 
             pattern = 0;
             flag = 1;
-            YUV1 = ABGR8888toYUV888(w[5]);
 
             { int k;
             for(k = 1; k <= 9; ++k)
@@ -359,11 +319,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
 
                 if(w[k] != w[5])
                 {
-                    YUV2 = ABGR8888toYUV888(w[k]);
-                    if(((ABGR8888_COMP(3, w[5]) != 0) != (ABGR8888_COMP(3, w[k]) != 0)) ||
-                       (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-                       (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-                       (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF) )) )
+                    if(Diff(w[5], w[k], yuv[5], yuv[k]))
                         pattern |= flag;
                 }
                 flag <<= 1;
@@ -463,7 +419,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 18:
             case 50: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -473,7 +429,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 80:
             case 81: {
-                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -483,7 +439,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 72:
             case 76: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -493,7 +449,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 10:
             case 138: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
@@ -529,7 +485,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 22:
             case 54: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -539,7 +495,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 208:
             case 209: {
-                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -549,7 +505,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 104:
             case 108: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -559,7 +515,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 11:
             case 139: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -569,7 +525,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 19:
             case 51: {
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL00_11 PIXEL01_10}
                     else {
@@ -578,7 +534,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 146:
             case 178: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_10 PIXEL11_12}
                     else {
@@ -587,7 +543,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 84:
             case 85: {
-                    PIXEL00_20 if(Diff(w[6], w[8]))
+                    PIXEL00_20 if(DIFF(6, 8))
                     {
                     PIXEL01_11 PIXEL11_10}
                     else {
@@ -596,7 +552,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 112:
             case 113: {
-                    PIXEL00_20 PIXEL01_22 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 if(DIFF(6, 8))
                     {
                     PIXEL10_12 PIXEL11_10}
                     else {
@@ -605,7 +561,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 200:
             case 204: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_10 PIXEL11_11}
                     else {
@@ -614,7 +570,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 73:
             case 77: {
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL00_12 PIXEL10_10}
                     else {
@@ -623,7 +579,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 42:
             case 170: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10 PIXEL10_11}
                     else {
@@ -632,7 +588,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 14:
             case 142: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10 PIXEL01_12}
                     else {
@@ -665,13 +621,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 26:
             case 31: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -681,13 +637,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 82:
             case 214: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -697,13 +653,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 88:
             case 248: {
-                    PIXEL00_21 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_22 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -713,13 +669,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 74:
             case 107: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -728,7 +684,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 27: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -737,7 +693,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_10 PIXEL10_22 PIXEL11_21 break;
               }
             case 86: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -746,7 +702,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_21 PIXEL11_10 break;
               }
             case 216: {
-                    PIXEL00_21 PIXEL01_22 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL00_21 PIXEL01_22 PIXEL10_10 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -755,7 +711,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 106: {
-                    PIXEL00_10 PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_21 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -764,7 +720,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 30: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -773,7 +729,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_21 break;
               }
             case 210: {
-                    PIXEL00_22 PIXEL01_10 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_22 PIXEL01_10 PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -782,7 +738,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 120: {
-                    PIXEL00_21 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_22 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -791,7 +747,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 75: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -836,13 +792,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_12 PIXEL01_22 PIXEL10_22 PIXEL11_12 break;
               }
             case 58: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -851,13 +807,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 83: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -866,13 +822,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 92: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -881,13 +837,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 202: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -896,13 +852,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 78: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -911,13 +867,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 154: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -926,13 +882,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 114: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -941,13 +897,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 89: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -956,25 +912,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 90: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -984,7 +940,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 55:
             case 23: {
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL00_11 PIXEL01_0}
                     else {
@@ -993,7 +949,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 182:
             case 150: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0 PIXEL11_12}
                     else {
@@ -1002,7 +958,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 213:
             case 212: {
-                    PIXEL00_20 if(Diff(w[6], w[8]))
+                    PIXEL00_20 if(DIFF(6, 8))
                     {
                     PIXEL01_11 PIXEL11_0}
                     else {
@@ -1011,7 +967,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 241:
             case 240: {
-                    PIXEL00_20 PIXEL01_22 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 if(DIFF(6, 8))
                     {
                     PIXEL10_12 PIXEL11_0}
                     else {
@@ -1020,7 +976,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 236:
             case 232: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_0 PIXEL11_11}
                     else {
@@ -1029,7 +985,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 109:
             case 105: {
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL00_12 PIXEL10_0}
                     else {
@@ -1038,7 +994,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 171:
             case 43: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0 PIXEL10_11}
                     else {
@@ -1047,7 +1003,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 143:
             case 15: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0 PIXEL01_12}
                     else {
@@ -1055,7 +1011,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_20 break;
               }
             case 124: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1064,7 +1020,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 203: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -1073,7 +1029,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_21 PIXEL10_10 PIXEL11_11 break;
               }
             case 62: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1082,7 +1038,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 211: {
-                    PIXEL00_11 PIXEL01_10 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_11 PIXEL01_10 PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1091,7 +1047,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 118: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1100,7 +1056,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_12 PIXEL11_10 break;
               }
             case 217: {
-                    PIXEL00_12 PIXEL01_22 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL00_12 PIXEL01_22 PIXEL10_10 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1109,7 +1065,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 110: {
-                    PIXEL00_10 PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1118,7 +1074,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 155: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -1151,13 +1107,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_11 PIXEL01_12 PIXEL10_21 PIXEL11_11 break;
               }
             case 220: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1166,13 +1122,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 158: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1181,13 +1137,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 234: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1196,13 +1152,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 242: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1211,13 +1167,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 59: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -1226,13 +1182,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 121: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1241,13 +1197,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 87: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1256,13 +1212,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 79: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -1271,25 +1227,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 122: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1298,25 +1254,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 94: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1325,25 +1281,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 218: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1352,25 +1308,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 91: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1391,13 +1347,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_20 PIXEL01_11 PIXEL10_20 PIXEL11_12 break;
               }
             case 186: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -1406,13 +1362,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_12 break;
               }
             case 115: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1421,13 +1377,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 93: {
-                    PIXEL00_12 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1436,13 +1392,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 206: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -1452,7 +1408,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 205:
             case 201: {
-                    PIXEL00_12 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_10}
                     else
@@ -1462,7 +1418,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 174:
             case 46: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_10}
                     else
@@ -1472,7 +1428,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 179:
             case 147: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_10}
                     else
@@ -1482,7 +1438,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 117:
             case 116: {
-                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_10}
                     else
@@ -1497,13 +1453,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_11 PIXEL01_12 PIXEL10_12 PIXEL11_11 break;
               }
             case 126: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1512,13 +1468,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 219: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL01_10 PIXEL10_10 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1527,7 +1483,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 125: {
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL00_12 PIXEL10_0}
                     else {
@@ -1535,7 +1491,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_11 PIXEL11_10 break;
               }
             case 221: {
-                    PIXEL00_12 if(Diff(w[6], w[8]))
+                    PIXEL00_12 if(DIFF(6, 8))
                     {
                     PIXEL01_11 PIXEL11_0}
                     else {
@@ -1543,7 +1499,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 break;
               }
             case 207: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0 PIXEL01_12}
                     else {
@@ -1551,7 +1507,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 PIXEL11_11 break;
               }
             case 238: {
-                    PIXEL00_10 PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_0 PIXEL11_11}
                     else {
@@ -1559,7 +1515,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 190: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0 PIXEL11_12}
                     else {
@@ -1567,7 +1523,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 break;
               }
             case 187: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0 PIXEL10_11}
                     else {
@@ -1575,7 +1531,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_10 PIXEL11_12 break;
               }
             case 243: {
-                    PIXEL00_11 PIXEL01_10 if(Diff(w[6], w[8]))
+                    PIXEL00_11 PIXEL01_10 if(DIFF(6, 8))
                     {
                     PIXEL10_12 PIXEL11_0}
                     else {
@@ -1583,7 +1539,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 119: {
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL00_11 PIXEL01_0}
                     else {
@@ -1592,7 +1548,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 237:
             case 233: {
-                    PIXEL00_12 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_20 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1602,7 +1558,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 175:
             case 47: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
@@ -1612,7 +1568,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 183:
             case 151: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1622,7 +1578,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 245:
             case 244: {
-                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1631,13 +1587,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 250: {
-                    PIXEL00_10 PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_10 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1646,13 +1602,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 123: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL01_10 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1661,13 +1617,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 95: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1676,13 +1632,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 PIXEL11_10 break;
               }
             case 222: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL10_10 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1691,13 +1647,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 252: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1706,13 +1662,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 249: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1721,13 +1677,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 235: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1736,13 +1692,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 111: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1751,13 +1707,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 63: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1766,13 +1722,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 159: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1781,13 +1737,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 215: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1796,13 +1752,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 246: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1811,19 +1767,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 254: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1832,13 +1788,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 253: {
-                    PIXEL00_12 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_11 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1847,19 +1803,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 251: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL01_10 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1868,13 +1824,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 239: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1883,19 +1839,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 127: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
@@ -1904,13 +1860,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 191: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
@@ -1919,19 +1875,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_12 break;
               }
             case 223: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL10_10 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1940,13 +1896,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 247: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1955,25 +1911,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 255: {
-                    if(Diff(w[4], w[2]))
+                    if(DIFF(4, 2))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(DIFF(2, 6))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    if(Diff(w[8], w[4]))
+                    if(DIFF(8, 4))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(DIFF(6, 8))
                     {
                     PIXEL11_0}
                     else
@@ -1990,9 +1946,9 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
         pOut += BpL;
     }}
 
+    M_Free(yuvPlane);
     return dst;
     }
 
-#undef OFFSET
 #undef BPP
 }
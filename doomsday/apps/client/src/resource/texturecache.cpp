@@ -0,0 +1,519 @@
+/** @file texturecache.cpp  Persistent cache of prepared texture content.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "resource/texturecache.h"
+
+#include <doomsday/console/var.h>
+#include <de/byterefarray.h>
+#include <de/guard.h>
+#include <de/hash.h>
+#include <de/logbuffer.h>
+#include <de/reader.h>
+#include <de/set.h>
+#include <de/taskpool.h>
+#include <de/writer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <sys/stat.h>
+#ifdef WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#  include <io.h>
+#else
+#  include <sys/mman.h>
+#endif
+
+using namespace de;
+
+static byte texCacheEnabled = true;
+static int  texCacheSizeMB  = 512;
+
+/*
+ * Each cached item is a file named after the hexadecimal key, consisting of a
+ * header of TEXCACHE_HEADER_SIZE bytes followed by the pixels. The header is:
+ * magic, version, key (Block), image width, image height, image flags, and the
+ * texturecontent_t fields (format, width, height, minFilter, magFilter,
+ * anisoFilter, wrap[0], wrap[1], grayMipmap, flags).
+ *
+ * The index file contains the use counter and the size and last use of each
+ * item, for choosing the items to remove when the cache is full.
+ */
+static const duint32 TEXCACHE_ITEM_MAGIC   = 0x43585444; // "DTXC"
+static const duint32 TEXCACHE_INDEX_MAGIC  = 0x49585444; // "DTXI"
+static const duint32 TEXCACHE_VERSION      = 1;
+static const dsize   TEXCACHE_HEADER_SIZE  = 128;
+static const char   *TEXCACHE_INDEX_NAME   = "index";
+static const int     TEXCACHE_INDEX_SAVE_INTERVAL = 64; ///< Insertions between index saves.
+static const dint64  TEXCACHE_MAX_PENDING_BYTES = 64 * 1024 * 1024; ///< Queued for writing.
+
+static int bytesPerPixel(dgltexformat_t format)
+{
+    return format == DGL_RGBA? 4 : 3;
+}
+
+/**
+ * Reads an entire native file.
+ */
+static bool readNativeFile(const NativePath &path, Block &data)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    bool ok = false;
+    if (std::fseek(file, 0, SEEK_END) == 0)
+    {
+        const long size = std::ftell(file);
+        if (size >= 0 && std::fseek(file, 0, SEEK_SET) == 0)
+        {
+            data.resize(dsize(size));
+            ok = (std::fread(data.data(), 1, data.size(), file) == data.size());
+        }
+    }
+    std::fclose(file);
+    return ok;
+}
+
+/**
+ * Writes @a head and @a body to a temporary file that then replaces the file at
+ * @a path, so that a partially written file is never seen by readers.
+ */
+static bool writeNativeFile(const NativePath &path, const NativePath &tempPath,
+                            const Block &head, const void *body = nullptr, dsize bodySize = 0)
+{
+    std::FILE *file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = (std::fwrite(head.data(), 1, head.size(), file) == head.size());
+    if (ok && bodySize)
+    {
+        ok = (std::fwrite(body, 1, bodySize, file) == bodySize);
+    }
+    ok = (std::fclose(file) == 0) && ok;
+    if (ok)
+    {
+#ifdef WIN32
+        path.remove(); // rename() does not replace an existing file.
+#endif
+        ok = (std::rename(tempPath.c_str(), path.c_str()) == 0);
+    }
+    if (!ok) tempPath.remove();
+    return ok;
+}
+
+DE_PIMPL_NOREF(TextureCache::MappedContent)
+{
+    const duint8 *mapped = nullptr;
+    dsize mappedSize = 0;
+    texturecontent_t content;
+    image_t::Size imageSize;
+    int imageFlags = 0;
+
+    ~Impl()
+    {
+        unmap();
+    }
+
+    /**
+     * Map the entire native file into memory (read-only).
+     */
+    bool map(const NativePath &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+
+#ifdef WIN32
+        HANDLE fileHandle = HANDLE(_get_osfhandle(_fileno(file)));
+        LARGE_INTEGER fileSize;
+        if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize) &&
+            fileSize.QuadPart > 0)
+        {
+            if (HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr))
+            {
+                // The view keeps the mapping object alive.
+                mapped = reinterpret_cast<const duint8 *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                mappedSize = dsize(fileSize.QuadPart);
+                CloseHandle(mapping);
+            }
+        }
+#else
+        struct stat st;
+        const int fd = fileno(file);
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *ptr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                mapped = reinterpret_cast<const duint8 *>(ptr);
+                mappedSize = dsize(st.st_size);
+            }
+        }
+#endif
+        std::fclose(file);
+        if (!mapped) mappedSize = 0;
+        return mapped != nullptr;
+    }
+
+    void unmap()
+    {
+        if (!mapped) return;
+#ifdef WIN32
+        UnmapViewOfFile(mapped);
+#else
+        munmap(const_cast<duint8 *>(mapped), mappedSize);
+#endif
+        mapped = nullptr;
+        mappedSize = 0;
+    }
+
+    /**
+     * Checks the header of the mapped item and reads the content parameters.
+     */
+    bool parse(const Block &key)
+    {
+        if (mappedSize < TEXCACHE_HEADER_SIZE) return false;
+
+        const ByteRefArray header(mapped, TEXCACHE_HEADER_SIZE);
+        Reader reader(header);
+        duint32 magic, version;
+        Block storedKey;
+        dint32 format, wrapS, wrapT, minFilter, magFilter;
+        reader >> magic >> version;
+        if (magic != TEXCACHE_ITEM_MAGIC || version != TEXCACHE_VERSION) return false;
+        reader >> storedKey;
+        if (storedKey != key) return false;
+
+        zap(content);
+        reader >> imageSize.x >> imageSize.y >> imageFlags
+               >> format >> content.width >> content.height >> minFilter >> magFilter
+               >> content.anisoFilter >> wrapS >> wrapT >> content.grayMipmap
+               >> content.flags;
+        content.format    = dgltexformat_t(format);
+        content.minFilter = GLenum(minFilter);
+        content.magFilter = GLenum(magFilter);
+        content.wrap[0]   = GLenum(wrapS);
+        content.wrap[1]   = GLenum(wrapT);
+        content.pixels    = mapped + TEXCACHE_HEADER_SIZE;
+
+        const dsize pixelBytes = dsize(bytesPerPixel(content.format)) * content.width * content.height;
+        return (content.flags & TXCF_UPLOAD_READY) && content.width > 0 && content.height > 0 &&
+               mappedSize == TEXCACHE_HEADER_SIZE + pixelBytes;
+    }
+};
+
+TextureCache::MappedContent::MappedContent()
+    : d(new Impl)
+{}
+
+TextureCache::MappedContent::~MappedContent()
+{}
+
+const texturecontent_t &TextureCache::MappedContent::content() const
+{
+    return d->content;
+}
+
+image_t::Size TextureCache::MappedContent::imageSize() const
+{
+    return d->imageSize;
+}
+
+int TextureCache::MappedContent::imageFlags() const
+{
+    return d->imageFlags;
+}
+
+//---------------------------------------------------------------------------------------
+
+DE_PIMPL_NOREF(TextureCache), public Lockable
+{
+    struct Item
+    {
+        dint64 size;
+        duint64 lastUsed;
+    };
+
+    NativePath location;
+    bool indexLoaded = false;
+    bool indexChanged = false;
+    Hash<String, Item> items; ///< Keyed by hexadecimal key.
+    dint64 totalSize = 0;
+    duint64 useCounter = 0;
+    int insertionsSinceSave = 0;
+    std::atomic_uint tempCounter{0};
+    TaskPool writer;        ///< Writes the inserted items.
+    Set<String> pending;    ///< Items queued for writing.
+    dint64 pendingBytes = 0;
+
+    NativePath itemPath(const String &name) const
+    {
+        return location / (name + ".dtex");
+    }
+
+    NativePath indexPath() const
+    {
+        return location / TEXCACHE_INDEX_NAME;
+    }
+
+    /// Reads the index of cached items (if not already done). Caller must hold the lock.
+    void loadIndex()
+    {
+        if (indexLoaded) return;
+        indexLoaded = true;
+
+        Block data;
+        if (!readNativeFile(indexPath(), data)) return;
+        try
+        {
+            Reader reader(data);
+            duint32 magic, version, count;
+            reader >> magic >> version;
+            if (magic != TEXCACHE_INDEX_MAGIC || version != TEXCACHE_VERSION) return;
+            reader >> useCounter >> count;
+            for (duint32 i = 0; i < count; ++i)
+            {
+                String name;
+                Item item;
+                reader >> name >> item.size >> item.lastUsed;
+                items.insert(name, item);
+                totalSize += item.size;
+            }
+        }
+        catch (const Error &er)
+        {
+            LOG_RES_WARNING("Texture cache index is corrupt: %s") << er.asText();
+            items.clear();
+            totalSize = 0;
+        }
+    }
+
+    /// Caller must hold the lock.
+    void saveIndex()
+    {
+        if (!indexChanged) return;
+
+        Block data;
+        Writer writer(data);
+        writer << TEXCACHE_INDEX_MAGIC << TEXCACHE_VERSION << useCounter << duint32(items.size());
+        for (const auto &item : items)
+        {
+            writer << item.first << item.second.size << item.second.lastUsed;
+        }
+        location.create();
+        if (writeNativeFile(indexPath(), location / "index.tmp", data))
+        {
+            indexChanged = false;
+            insertionsSinceSave = 0;
+        }
+    }
+
+    /// Caller must hold the lock.
+    void remove(const String &name)
+    {
+        auto found = items.find(name);
+        if (found == items.end()) return;
+        totalSize -= found->second.size;
+        items.erase(found);
+        itemPath(name).remove();
+        indexChanged = true;
+    }
+
+    /**
+     * Removes the least recently used items until the total size of the items is
+     * below the maximum. Caller must hold the lock.
+     */
+    void evict(dint64 maxBytes)
+    {
+        if (totalSize <= maxBytes) return;
+
+        List<std::pair<duint64, String>> byAge;
+        for (const auto &item : items)
+        {
+            byAge << std::make_pair(item.second.lastUsed, item.first);
+        }
+        std::sort(byAge.begin(), byAge.end());
+
+        const dint64 sizeBefore = totalSize;
+        int count = 0;
+        for (const auto &oldest : byAge)
+        {
+            if (totalSize <= maxBytes) break;
+            remove(oldest.second);
+            ++count;
+        }
+        LOG_RES_VERBOSE("Removed %i least recently used items (%.1f MB) from the texture cache")
+            << count << (sizeBefore - totalSize) / 1.0e6;
+    }
+
+    static dint64 maxBytes()
+    {
+        return dint64(de::max(0, texCacheSizeMB)) * 1024 * 1024;
+    }
+
+    /**
+     * Writes a queued item and adds it to the index. Called in a background task.
+     */
+    void write(const String &name, const Block &data)
+    {
+        const NativePath tempPath = location / Stringf("%s.%u.tmp", name.c_str(), tempCounter++);
+        location.create();
+        const bool written = writeNativeFile(itemPath(name), tempPath, data);
+
+        DE_GUARD(this);
+        pending.remove(name);
+        pendingBytes -= dint64(data.size());
+        if (!written)
+        {
+            LOG_RES_WARNING("Failed to write \"%s\" to the texture cache")
+                << itemPath(name).pretty();
+            return;
+        }
+        loadIndex();
+        auto found = items.find(name);
+        if (found != items.end())
+        {
+            totalSize -= found->second.size;
+        }
+        items[name] = Item{dint64(data.size()), ++useCounter};
+        totalSize += dint64(data.size());
+        indexChanged = true;
+
+        evict(maxBytes());
+        if (++insertionsSinceSave >= TEXCACHE_INDEX_SAVE_INTERVAL)
+        {
+            saveIndex();
+        }
+    }
+};
+
+TextureCache::TextureCache(const NativePath &location)
+    : d(new Impl)
+{
+    d->location = location;
+}
+
+TextureCache::~TextureCache()
+{
+    d->writer.waitForDone();
+    DE_GUARD(d);
+    d->saveIndex();
+}
+
+bool TextureCache::isEnabled() const
+{
+    return texCacheEnabled && texCacheSizeMB > 0;
+}
+
+TextureCache::MappedContent *TextureCache::find(const Block &key)
+{
+    const String name = key.asHexadecimalText();
+    {
+        DE_GUARD(d);
+        d->loadIndex();
+        auto found = d->items.find(name);
+        if (found == d->items.end()) return nullptr;
+        found->second.lastUsed = ++d->useCounter;
+        d->indexChanged = true;
+    }
+
+    std::unique_ptr<MappedContent> mapped(new MappedContent);
+    if (mapped->d->map(d->itemPath(name)) && mapped->d->parse(key))
+    {
+        return mapped.release();
+    }
+
+    // The item is missing or invalid.
+    LOGDEV_RES_WARNING("Texture cache item %s is invalid") << name;
+    mapped.reset();
+    DE_GUARD(d);
+    d->remove(name);
+    return nullptr;
+}
+
+void TextureCache::insert(const Block &key, const texturecontent_t &content, const image_t &image)
+{
+    DE_ASSERT(content.flags & TXCF_UPLOAD_READY);
+    DE_ASSERT(content.format == DGL_RGB || content.format == DGL_RGBA);
+
+    const dint64 maxBytes = Impl::maxBytes();
+    const dsize pixelBytes = dsize(bytesPerPixel(content.format)) * content.width * content.height;
+    if (!content.pixels || !pixelBytes || dint64(TEXCACHE_HEADER_SIZE + pixelBytes) > maxBytes)
+    {
+        return;
+    }
+
+    const String name = key.asHexadecimalText();
+    const dint64 size = dint64(TEXCACHE_HEADER_SIZE + pixelBytes);
+    {
+        DE_GUARD(d);
+        if (d->pending.contains(name)) return;
+        if (d->pendingBytes + size > TEXCACHE_MAX_PENDING_BYTES)
+        {
+            // The writer is not keeping up; this one can be cached some other time.
+            LOGDEV_RES_XVERBOSE("Texture cache write queue is full, skipping %s", name);
+            return;
+        }
+        d->pending.insert(name);
+        d->pendingBytes += size;
+    }
+
+    // The caller may reuse the content, so the pixels are copied for the writer.
+    Block data;
+    Writer(data) << TEXCACHE_ITEM_MAGIC << TEXCACHE_VERSION << key
+                 << image.size.x << image.size.y << dint32(image.flags)
+                 << dint32(content.format) << dint32(content.width) << dint32(content.height)
+                 << dint32(content.minFilter) << dint32(content.magFilter)
+                 << dint32(content.anisoFilter)
+                 << dint32(content.wrap[0]) << dint32(content.wrap[1])
+                 << dint32(content.grayMipmap) << dint32(content.flags);
+    DE_ASSERT(data.size() <= TEXCACHE_HEADER_SIZE);
+    data.resize(TEXCACHE_HEADER_SIZE);
+    data.append(content.pixels, int(pixelBytes));
+
+    Impl *impl = d.get();
+    d->writer.start([impl, name, data = std::move(data)]() { impl->write(name, data); });
+}
+
+void TextureCache::clear()
+{
+    d->writer.waitForDone();
+    DE_GUARD(d);
+    d->loadIndex();
+    const auto names = d->items.keys();
+    for (const String &name : names)
+    {
+        d->remove(name);
+    }
+    d->useCounter = 0;
+    d->saveIndex();
+}
+
+dint64 TextureCache::size() const
+{
+    DE_GUARD(d);
+    d->loadIndex();
+    return d->totalSize;
+}
+
+void TextureCache::consoleRegister() // static
+{
+    C_VAR_BYTE("rend-tex-cache",      &texCacheEnabled, 0, 0, 1);
+    C_VAR_INT ("rend-tex-cache-size", &texCacheSizeMB,  CVF_NO_MAX, 0, 0);
+}
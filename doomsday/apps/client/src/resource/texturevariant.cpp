@@ -19,20 +19,29 @@
  */
 
 #include "de_base.h"
+#include "dd_def.h" // texGamma, DOOMSDAY_VERSION_FULLTEXT
 
 #include "gl/gl_defer.h"
 #include "gl/gl_main.h"
 #include "gl/gl_tex.h"
 #include "gl/texturecontent.h"
+#include "sys_system.h" // novideo
 
+#include "resource/clientresources.h"
 #include "resource/image.h" // GL_LoadSourceImage
+#include "resource/texturecache.h"
 
 #include "render/rend_main.h" // misc global vars awaiting new home
 
 #include <doomsday/res/colorpalettes.h>
 #include <doomsday/res/texture.h>
 #include <doomsday/r_util.h>
+#include <de/byterefarray.h>
+#include <de/fixedbytearray.h>
+#include <de/glinfo.h>
 #include <de/logbuffer.h>
+#include <de/taskpool.h>
+#include <de/writer.h>
 #include <de/legacy/mathutil.h> // M_CeilPow
 
 using namespace de;
@@ -293,6 +302,171 @@ DE_PIMPL(ClientTexture::Variant)
         // Release any GL texture we may have prepared.
         self().release();
     }
+
+    /// Source image and the texture content prepared from it.
+    struct PreparedContent
+    {
+        image_t image;
+        texturecontent_t content;
+        gfx::UploadMethod uploadMethod = gfx::Immediate;
+        texturecontent_t *uploadReady = nullptr; ///< Converted for an immediate upload.
+        bool submitted = false;                  ///< Already queued for a deferred upload.
+        std::unique_ptr<TextureCache::MappedContent> cached;
+
+        ~PreparedContent()
+        {
+            if (uploadReady) GL_DestroyTextureContent(uploadReady);
+            Image_ClearPixelData(image);
+        }
+    };
+
+    /**
+     * Prepares the texture content from the source image. Only the CPU is used, so
+     * this can be called in any thread.
+     */
+    void prepareContent(PreparedContent &prep) const
+    {
+        TextureCache &cache = App_Resources().textureCache();
+        Block key;
+        if (cache.isEnabled() && !novideo)
+        {
+            key = cacheKey(prep.image);
+            prep.cached.reset(cache.find(key));
+            if (prep.cached)
+            {
+                // Prepared earlier; the source image is no longer needed.
+                prep.content      = prep.cached->content();
+                prep.content.name = glTexName;
+                prep.image.size   = prep.cached->imageSize();
+                prep.image.flags  = prep.cached->imageFlags();
+                Image_ClearPixelData(prep.image);
+                prep.uploadMethod = GL_ChooseUploadMethod(&prep.content);
+                return;
+            }
+        }
+
+        GL_PrepareTextureContent(prep.content, glTexName, prep.image, spec, texture.manifest());
+        prep.uploadMethod = GL_ChooseUploadMethod(&prep.content);
+
+        if (!key.isEmpty())
+        {
+            prep.uploadReady = GL_ConstructUploadReadyTextureContent(prep.content);
+            cache.insert(key, *prep.uploadReady, prep.image);
+        }
+    }
+
+    /**
+     * Composes the texture cache key for preparing @a image: the source pixels and
+     * everything else that affects the prepared content.
+     */
+    Block cacheKey(const image_t &image) const
+    {
+        Block input;
+        Writer writer(input);
+        writer << image.size.x << image.size.y << dint32(image.pixelSize) << dint32(image.flags);
+
+        dsize pixelBytes = dsize(image.size.x) * image.size.y * image.pixelSize;
+        if (image.pixelSize == 1 && (image.flags & IMGF_IS_MASKED))
+        {
+            pixelBytes *= 2; // Followed by the mask.
+        }
+        writer << FixedByteArray(ByteRefArray(image.pixels, pixelBytes));
+
+        if (image.paletteId)
+        {
+            const res::ColorPalette &palette =
+                App_Resources().colorPalettes().colorPalette(image.paletteId);
+            writer << dint32(palette.colorCount());
+            for (int i = 0; i < palette.colorCount(); ++i)
+            {
+                const Vec3ub color = palette.color(i);
+                writer << color.x << color.y << color.z;
+            }
+        }
+
+        writer << dint32(spec.type);
+        if (spec.type == TST_GENERAL)
+        {
+            const variantspecification_t &vspec = spec.variant;
+            writer << dint32(vspec.context) << dint32(vspec.flags) << dint32(vspec.border)
+                   << dint32(vspec.wrapS) << dint32(vspec.wrapT)
+                   << dbyte(vspec.mipmapped) << dbyte(vspec.gammaCorrection)
+                   << dbyte(vspec.noStretch) << dbyte(vspec.toAlpha)
+                   << dint32(vspec.tClass) << dint32(vspec.tMap)
+                   << dint32(vspec.glMinFilter()) << dint32(vspec.glMagFilter())
+                   << dint32(vspec.logicalAnisoLevel());
+        }
+        else
+        {
+            writer << dint32(spec.detailVariant.contrast) << dint32(texAniso) << dint32(texMagMode);
+        }
+
+        // The preparation algorithms may change in any build.
+        writer << String(DOOMSDAY_VERSION_FULLTEXT);
+
+        // Configuration used in the preparation.
+        writer << texGamma << dint32(useSmartFilter) << dbyte(fillOutlines)
+               << dint32(texQuality) << dint32(ratioLimit) << dint32(GLInfo::limits().maxTexSize);
+
+        return input.md5Hash();
+    }
+
+    /**
+     * Updates the variant according to the prepared content and submits the
+     * content for uploading (unless already submitted).
+     */
+    void applyPreparedContent(PreparedContent &prep)
+    {
+        const texturecontent_t &c = prep.content;
+        const image_t &image = prep.image;
+
+        /**
+         * Calculate GL texture coordinates based on the image dimensions. The
+         * coordinates are calculated as width / CeilPow2(width), or 1 if larger
+         * than the maximum texture size.
+         *
+         * @todo fixme: Image dimensions may not be the same as the uploaded
+         * texture - defer this logic until all processing has been completed.
+         */
+        if ((c.flags & TXCF_UPLOAD_ARG_NOSTRETCH) &&
+            (c.flags & TXCF_MIPMAP))
+        {
+            s = image.size.x / float( de::ceilPow2(image.size.x) );
+            t = image.size.y / float( de::ceilPow2(image.size.y) );
+        }
+        else
+        {
+            s = 1;
+            t = 1;
+        }
+
+        if(image.flags & IMGF_IS_MASKED)
+        {
+            flags |= TextureVariant::Masked;
+        }
+
+        // Submit the content for uploading (possibly deferred).
+        if (!prep.submitted)
+        {
+            GL_UploadTextureContent(prep.uploadReady? *prep.uploadReady : c, prep.uploadMethod);
+        }
+
+        LOGDEV_RES_XVERBOSE("Prepared \"%s\" variant (glName:%u)%s",
+                            texture.manifest().composeUri() << uint(glTexName) <<
+                            (prep.uploadMethod == gfx::Immediate? " while not busy!" : ""));
+        LOGDEV_RES_XVERBOSE("  Content: %s", Image_Description(image));
+        LOGDEV_RES_XVERBOSE("  Specification %p: %s", &spec << spec.asText());
+
+        // Are we setting the logical dimensions to the pixel dimensions
+        // of the source image?
+        if(texture.width() == 0 && texture.height() == 0)
+        {
+            LOG_RES_XVERBOSE("World dimensions for \"%s\" taken from image pixels %s",
+                             texture.manifest().composeUri() << image.size.asText());
+
+            texture.setDimensions(image.size);
+        }
+    }
 };
 
 ClientTexture::Variant::Variant(ClientTexture &generalCase, const TextureVariantSpec &spec)
@@ -512,7 +686,8 @@ uint ClientTexture::Variant::prepare()
     LOG_AS("TextureVariant::prepare");
 
     // Load the source image data.
-    image_t image;
+    std::shared_ptr<Impl::PreparedContent> prep(new Impl::PreparedContent);
+    image_t &image = prep->image;
     res::Source source = GL_LoadSourceImage(image, d->texture, d->spec);
     if(source == res::None)
         return 0;
@@ -534,57 +709,36 @@ uint ClientTexture::Variant::prepare()
         d->texSource = source;
     }
 
-    // Prepare texture content for uploading.
-    texturecontent_t c;
-    GL_PrepareTextureContent(c, d->glTexName, image, d->spec, d->texture.manifest());
-
-    /**
-     * Calculate GL texture coordinates based on the image dimensions. The
-     * coordinates are calculated as width / CeilPow2(width), or 1 if larger
-     * than the maximum texture size.
-     *
-     * @todo fixme: Image dimensions may not be the same as the uploaded
-     * texture - defer this logic until all processing has been completed.
-     */
-    if ((c.flags & TXCF_UPLOAD_ARG_NOSTRETCH) &&
-        (c.flags & TXCF_MIPMAP))
+    if (PreparationBatch *batch = PreparationBatch::current())
     {
-        d->s = image.size.x / float( de::ceilPow2(image.size.x) );
-        d->t = image.size.y / float( de::ceilPow2(image.size.y) );
-    }
-    else
-    {
-        d->s = 1;
-        d->t = 1;
-    }
-
-    if(image.flags & IMGF_IS_MASKED)
-    {
-        d->flags |= TextureVariant::Masked;
-    }
-
-    // Submit the content for uploading (possibly deferred).
-    gfx::UploadMethod uploadMethod = GL_ChooseUploadMethod(&c);
-    GL_UploadTextureContent(c, uploadMethod);
-
-    LOGDEV_RES_XVERBOSE("Prepared \"%s\" variant (glName:%u)%s",
-                        d->texture.manifest().composeUri() << uint(d->glTexName) <<
-                        (uploadMethod == gfx::Immediate? " while not busy!" : ""));
-    LOGDEV_RES_XVERBOSE("  Content: %s", Image_Description(image));
-    LOGDEV_RES_XVERBOSE("  Specification %p: %s", &d->spec << d->spec.asText());
-
-    // Are we setting the logical dimensions to the pixel dimensions
-    // of the source image?
-    if(d->texture.width() == 0 && d->texture.height() == 0)
-    {
-        LOG_RES_XVERBOSE("World dimensions for \"%s\" taken from image pixels %s",
-                         d->texture.manifest().composeUri() << image.size.asText());
-
-        d->texture.setDimensions(image.size);
+        // Finish the preparation in the background.
+        batch->start([this, prep] ()
+        {
+            d->prepareContent(*prep);
+            if (prep->uploadMethod == gfx::Deferred)
+            {
+                GL_UploadTextureContent(prep->uploadReady? *prep->uploadReady : prep->content,
+                                        gfx::Deferred);
+                prep->submitted = true;
+            }
+            else if (!novideo && !prep->uploadReady &&
+                     !(prep->content.flags & TXCF_UPLOAD_READY))
+            {
+                prep->uploadReady = GL_ConstructUploadReadyTextureContent(prep->content);
+            }
+            // Only the converted copy is needed from now on.
+            Image_ClearPixelData(prep->image);
+        },
+        [this, prep] ()
+        {
+            d->applyPreparedContent(*prep);
+        });
+        return d->glTexName;
     }
 
-    // We're done with the image data.
-    Image_ClearPixelData(image);
+    // Prepare texture content for uploading.
+    d->prepareContent(*prep);
+    d->applyPreparedContent(*prep);
 
     return d->glTexName;
 }
@@ -635,3 +789,51 @@ uint ClientTexture::Variant::glName() const
 {
     return d->glTexName;
 }
+
+//---------------------------------------------------------------------------------------
+
+static thread_local ClientTexture::PreparationBatch *currentBatch = nullptr;
+
+DE_PIMPL_NOREF(ClientTexture::PreparationBatch)
+{
+    PreparationBatch *previous = nullptr;
+    TaskPool tasks;
+    List<std::function<void ()>> completions;
+};
+
+ClientTexture::PreparationBatch::PreparationBatch()
+    : d(new Impl)
+{
+    d->previous = currentBatch;
+    currentBatch = this;
+}
+
+ClientTexture::PreparationBatch::~PreparationBatch()
+{
+    wait();
+    currentBatch = d->previous;
+}
+
+void ClientTexture::PreparationBatch::start(const std::function<void ()> &work,
+                                            const std::function<void ()> &completion)
+{
+    d->completions << completion;
+    d->tasks.start(work);
+}
+
+void ClientTexture::PreparationBatch::wait()
+{
+    d->tasks.waitForDone();
+
+    const auto completions = std::move(d->completions);
+    d->completions.clear();
+    for (const auto &completion : completions)
+    {
+        completion();
+    }
+}
+
+ClientTexture::PreparationBatch *ClientTexture::PreparationBatch::current()
+{
+    return currentBatch;
+}
@@ -35,6 +35,8 @@
 #include <doomsday/mesh/face.h>
 #include <doomsday/net.h>
 #include <doomsday/world/bspleaf.h>
+#include <doomsday/world/lineblockmap.h>
+#include <doomsday/world/polyobj.h>
 #include <doomsday/world/thinkers.h>
 #include <doomsday/tab_tables.h>
 #include <de/string.h>
@@ -43,20 +45,54 @@
 #include <de/legacy/memoryzone.h>
 #include <de/legacy/timer.h>
 #include <de/legacy/vector1.h>
+#include <algorithm>
 #include <cmath>
+#include <functional>
 
 using namespace de;
 using world::World;
 
-#define DOT2F(a,b)          ( FIX2FLT(a[0]) * FIX2FLT(b[0]) + FIX2FLT(a[1]) * FIX2FLT(b[1]) )
-#define VECMUL(a,scalar)    ( a[0] = FixedMul(a[0], scalar), a[1] = FixedMul(a[1], scalar) )
-#define VECADD(a,b)         ( a[0] += b[0], a[1] += b[1] )
-#define VECMULADD(a,scal,b) ( a[0] += FixedMul(scal, b[0]), a[1] += FixedMul(scal, b[1]) )
-#define VECSUB(a,b)         ( a[0] -= b[0], a[1] -= b[1] )
-#define VECCPY(a,b)         ( a[0] = b[0], a[1] = b[1] )
-
 static float particleSpawnRate = 1; // Unmodified (cvar).
 
+/**
+ * Floor and ceiling of a BSP leaf. These are looked up once for all the particles
+ * in the leaf.
+ */
+struct ParticlePlanes
+{
+    bool  valid;
+    float floor;
+    float ceiling;
+    bool  floorSky;
+    bool  ceilingSky;
+
+    ParticlePlanes(world::BspLeaf *bspLeaf)
+        : valid(bspLeaf && bspLeaf->hasSubspace())
+        , floor(0)
+        , ceiling(0)
+        , floorSky(false)
+        , ceilingSky(false)
+    {
+        if(!valid) return;
+
+        auto &subsec = bspLeaf->subspace().subsector().as<Subsector>();
+        floor      = float(subsec.visFloor().heightSmoothed());
+        ceiling    = float(subsec.visCeiling().heightSmoothed());
+        floorSky   = subsec.visFloor().surface().hasSkyMaskedMaterial();
+        ceilingSky = subsec.visCeiling().surface().hasSkyMaskedMaterial();
+    }
+};
+
+/**
+ * Sound of a particle touching something. Sounds are played in the main thread
+ * after the particles have been moved.
+ */
+struct ParticleTouch
+{
+    Vec3f origin;
+    const ded_embsound_t *sound;
+};
+
 /**
  * The offset is spherical and random.
  * Low and High should be positive.
@@ -129,6 +165,14 @@ void Generator::clearParticles()
 {
     Z_Free(_pinfo);
     _pinfo = nullptr;
+    Z_Free(_motion.pos[0]); // Start of the storage block.
+    zap(_motion);
+    Z_Free(_moveOrder);
+    _moveOrder = nullptr;
+    Z_Free(_touches);
+    _touches = nullptr;
+    _touchCount = 0;
+    _movePending = false;
 }
 
 void Generator::configureFromDef(const ded_ptcgen_t *newDef)
@@ -144,6 +188,11 @@ void Generator::configureFromDef(const ded_ptcgen_t *newDef)
     def    = newDef;
     _flags = Flags(def->flags);
     _pinfo = (ParticleInfo *) Z_Calloc(sizeof(ParticleInfo) * count, PU_MAP, 0);
+    _motion.setStorage(Z_Calloc(ParticleMotion::storageSize(count), PU_MAP, 0), count);
+    _moveOrder = (int *) Z_Malloc(sizeof(int) * count, PU_MAP, 0);
+    _touches = (ParticleTouch *) Z_Malloc(sizeof(ParticleTouch) * count, PU_MAP, 0);
+    _touchCount = 0;
+    _movePending = false;
     stages = (ParticleStage *) Z_Calloc(sizeof(ParticleStage) * def->stages.size(), PU_MAP, 0);
 
     for(int i = 0; i < def->stages.size(); ++i)
@@ -249,19 +298,14 @@ static void setParticleAngles(ParticleInfo *pinfo, int flags)
         pinfo->pitch = RNG_RandFloat() * 65536;
 }
 
-static void particleSound(fixed_t pos[3], ded_embsound_t *sound)
+static void particleSound(const Vec3f &pos, const ded_embsound_t *sound)
 {
-    DE_ASSERT(pos && sound);
+    DE_ASSERT(sound);
 
     // Is there any sound to play?
     if(!sound->id || sound->volume <= 0) return;
 
-    double orig[3];
-    for (int i = 0; i < 3; ++i)
-    {
-        orig[i] = FIX2FLT(pos[i]);
-    }
-
+    coord_t orig[3] = { pos.x, pos.y, pos.z };
     S_LocalSoundAtVolumeFrom(sound->id, nullptr, orig, sound->volume);
 }
 
@@ -289,6 +333,8 @@ int Generator::newParticle()
 
     // Set the particle's data.
     ParticleInfo *pinfo = &_pinfo[_spawnCP];
+    fixed_t origin[3] = { 0, 0, 0 };
+    fixed_t mov[3];
     pinfo->stage = 0;
     if(RNG_RandFloat() < def->altStartVariance)
     {
@@ -299,32 +345,32 @@ int Generator::newParticle()
         (1 - def->stages[pinfo->stage].variance * RNG_RandFloat());
 
     // Launch vector.
-    pinfo->mov[0] = vector[0];
-    pinfo->mov[1] = vector[1];
-    pinfo->mov[2] = vector[2];
+    mov[0] = vector[0];
+    mov[1] = vector[1];
+    mov[2] = vector[2];
 
     // Apply some random variance.
-    pinfo->mov[0] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
-    pinfo->mov[1] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
-    pinfo->mov[2] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
+    mov[0] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
+    mov[1] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
+    mov[2] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
 
     // Apply some aspect ratio scaling to the momentum vector.
     // This counters the 200/240 difference nearly completely.
-    pinfo->mov[0] = FixedMul(pinfo->mov[0], FLT2FIX(1.1f));
-    pinfo->mov[1] = FixedMul(pinfo->mov[1], FLT2FIX(0.95f));
-    pinfo->mov[2] = FixedMul(pinfo->mov[2], FLT2FIX(1.1f));
+    mov[0] = FixedMul(mov[0], FLT2FIX(1.1f));
+    mov[1] = FixedMul(mov[1], FLT2FIX(0.95f));
+    mov[2] = FixedMul(mov[2], FLT2FIX(1.1f));
 
     // Set proper speed.
     fixed_t uncertain = FLT2FIX(def->speed * (1 - def->speedVariance * RNG_RandFloat()));
 
     fixed_t len = FLT2FIX(M_ApproxDistancef(
-        M_ApproxDistancef(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1])), FIX2FLT(pinfo->mov[2])));
+        M_ApproxDistancef(FIX2FLT(mov[0]), FIX2FLT(mov[1])), FIX2FLT(mov[2])));
     if(!len) len = FRACUNIT;
     len = FixedDiv(uncertain, len);
 
-    pinfo->mov[0] = FixedMul(pinfo->mov[0], len);
-    pinfo->mov[1] = FixedMul(pinfo->mov[1], len);
-    pinfo->mov[2] = FixedMul(pinfo->mov[2], len);
+    mov[0] = FixedMul(mov[0], len);
+    mov[1] = FixedMul(mov[1], len);
+    mov[2] = FixedMul(mov[2], len);
 
     // The source is a mobj?
     if(source)
@@ -334,44 +380,44 @@ int Generator::newParticle()
             // Rotate the vector using the source angle.
             float temp[3];
 
-            temp[0] = FIX2FLT(pinfo->mov[0]);
-            temp[1] = FIX2FLT(pinfo->mov[1]);
+            temp[0] = FIX2FLT(mov[0]);
+            temp[1] = FIX2FLT(mov[1]);
             temp[2] = 0;
 
             // Player visangles have some problems, let's not use them.
             M_RotateVector(temp, source->angle / (float) ANG180 * -180 + 90, 0);
 
-            pinfo->mov[0] = FLT2FIX(temp[0]);
-            pinfo->mov[1] = FLT2FIX(temp[1]);
+            mov[0] = FLT2FIX(temp[0]);
+            mov[1] = FLT2FIX(temp[1]);
         }
 
         if(_flags & RelativeVelocity)
         {
-            pinfo->mov[0] += FLT2FIX(source->mom[MX]);
-            pinfo->mov[1] += FLT2FIX(source->mom[MY]);
-            pinfo->mov[2] += FLT2FIX(source->mom[MZ]);
+            mov[0] += FLT2FIX(source->mom[MX]);
+            mov[1] += FLT2FIX(source->mom[MY]);
+            mov[2] += FLT2FIX(source->mom[MZ]);
         }
 
         // Origin.
-        pinfo->origin[0] = FLT2FIX(source->origin[0]);
-        pinfo->origin[1] = FLT2FIX(source->origin[1]);
-        pinfo->origin[2] = FLT2FIX(source->origin[2] - source->floorClip);
+        origin[0] = FLT2FIX(source->origin[0]);
+        origin[1] = FLT2FIX(source->origin[1]);
+        origin[2] = FLT2FIX(source->origin[2] - source->floorClip);
 
-        uncertainPosition(pinfo->origin, FLT2FIX(def->spawnRadiusMin), FLT2FIX(def->spawnRadius));
+        uncertainPosition(origin, FLT2FIX(def->spawnRadiusMin), FLT2FIX(def->spawnRadius));
 
         // Offset to the real center.
-        pinfo->origin[2] += originAtSpawn[2];
+        origin[2] += originAtSpawn[2];
 
         // Include bobbing in the spawn height.
-        pinfo->origin[2] -= FLT2FIX(Mobj_BobOffset(*source));
+        origin[2] -= FLT2FIX(Mobj_BobOffset(*source));
 
         // Calculate XY center with mobj angle.
         const angle_t angle = Mobj_AngleSmoothed(source) + (fixed_t) (FIX2FLT(originAtSpawn[1]) / 180.0f * ANG180);
         const duint an      = angle >> ANGLETOFINESHIFT;
         const duint an2     = (angle + ANG90) >> ANGLETOFINESHIFT;
 
-        pinfo->origin[0] += FixedMul(finecosine[an], originAtSpawn[0]);
-        pinfo->origin[1] += FixedMul(finesine[an], originAtSpawn[0]);
+        origin[0] += FixedMul(finecosine[an], originAtSpawn[0]);
+        origin[1] += FixedMul(finesine[an], originAtSpawn[0]);
 
         // There might be an offset from the model of the mobj.
         if(mf && (mf->testSubFlag(0, MFF_PARTICLE_SUB1) || def->subModel >= 0))
@@ -402,11 +448,11 @@ int Generator::newParticle()
             off[2] += mf->particleOffset(subidx)[2];
 
             // Apply it to the particle coords.
-            pinfo->origin[0] += FixedMul(finecosine[an],  FLT2FIX(off[0]));
-            pinfo->origin[0] += FixedMul(finecosine[an2], FLT2FIX(off[2]));
-            pinfo->origin[1] += FixedMul(finesine[an],    FLT2FIX(off[0]));
-            pinfo->origin[1] += FixedMul(finesine[an2],   FLT2FIX(off[2]));
-            pinfo->origin[2] += FLT2FIX(off[1]);
+            origin[0] += FixedMul(finecosine[an],  FLT2FIX(off[0]));
+            origin[0] += FixedMul(finecosine[an2], FLT2FIX(off[2]));
+            origin[1] += FixedMul(finesine[an],    FLT2FIX(off[0]));
+            origin[1] += FixedMul(finesine[an2],   FLT2FIX(off[2]));
+            origin[2] += FLT2FIX(off[1]);
         }
     }
     else if(plane)
@@ -418,7 +464,7 @@ int Generator::newParticle()
         // Choose a random spot inside the sector, on the spawn plane.
         if(_flags & SpawnSpace)
         {
-            pinfo->origin[2] =
+            origin[2] =
                 FLT2FIX(sector->floor().height()) + radius +
                 FixedMul(RNG_RandByte() << 8,
                          FLT2FIX(sector->ceiling().height() -
@@ -429,12 +475,12 @@ int Generator::newParticle()
                  plane->isSectorFloor()))
         {
             // Spawn on the floor.
-            pinfo->origin[2] = FLT2FIX(plane->height()) + radius;
+            origin[2] = FLT2FIX(plane->height()) + radius;
         }
         else
         {
             // Spawn on the ceiling.
-            pinfo->origin[2] = FLT2FIX(plane->height()) - radius;
+            origin[2] = FLT2FIX(plane->height()) - radius;
         }
 
         /**
@@ -461,7 +507,7 @@ int Generator::newParticle()
 
         if(!subspace)
         {
-            pinfo->stage = -1;
+            killParticle(newParticleIdx);
             return -1;
         }
 
@@ -476,8 +522,8 @@ int Generator::newParticle()
             float y = subBounds.minY +
                 RNG_RandFloat() * (subBounds.maxY - subBounds.minY);
 
-            pinfo->origin[0] = FLT2FIX(x);
-            pinfo->origin[1] = FLT2FIX(y);
+            origin[0] = FLT2FIX(x);
+            origin[1] = FLT2FIX(y);
 
             if(subspace == map().bspLeafAt(Vec2d(x, y)).subspacePtr())
                 break; // This is a good place.
@@ -485,17 +531,17 @@ int Generator::newParticle()
 
         if(tries == 10) // No good place found?
         {
-            pinfo->stage = -1; // Damn.
+            killParticle(newParticleIdx); // Damn.
             return -1;
         }
     }
     else if(isUntriggered())
     {
         // The center position is the spawn origin.
-        pinfo->origin[0] = originAtSpawn[0];
-        pinfo->origin[1] = originAtSpawn[1];
-        pinfo->origin[2] = originAtSpawn[2];
-        uncertainPosition(pinfo->origin, FLT2FIX(def->spawnRadiusMin),
+        origin[0] = originAtSpawn[0];
+        origin[1] = originAtSpawn[1];
+        origin[2] = originAtSpawn[2];
+        uncertainPosition(origin, FLT2FIX(def->spawnRadiusMin),
                           FLT2FIX(def->spawnRadius));
     }
 
@@ -510,19 +556,28 @@ int Generator::newParticle()
     }
     else*/
     {
-        Vec2d ptOrigin(FIX2FLT(pinfo->origin[0]), FIX2FLT(pinfo->origin[1]));
+        Vec2d ptOrigin(FIX2FLT(origin[0]), FIX2FLT(origin[1]));
         pinfo->bspLeaf = &map().bspLeafAt(ptOrigin);
 
         // A BSP leaf with no geometry is not a suitable place for a particle.
         if(!pinfo->bspLeaf->hasSubspace())
         {
-            pinfo->stage = -1;
+            killParticle(newParticleIdx);
             return -1;
         }
     }
 
+    // The movement is simulated in floating point.
+    for(int i = 0; i < 3; ++i)
+    {
+        _motion.pos[i][newParticleIdx] = FIX2FLT(origin[i]);
+        _motion.mov[i][newParticleIdx] = FIX2FLT(mov[i]);
+    }
+    pinfo->onPlane = 0;
+    updateParticleForces(newParticleIdx);
+
     // Play a stage sound?
-    particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
+    particleSound(particleOrigin(newParticleIdx), &def->stages[pinfo->stage].sound);
 
     return newParticleIdx;
 #else  // !__CLIENT__
@@ -559,65 +614,39 @@ static int newGeneratorParticlesWorker(mobj_t *cmo, void *context)
 
 #endif
 
-/**
- * Particle touches something solid. Returns false iff the particle dies.
- */
-static int touchParticle(ParticleInfo *pinfo, Generator::ParticleStage *stage,
-    ded_ptcstage_t *stageDef, bool touchWall)
-{
-    // Play a hit sound.
-    particleSound(pinfo->origin, &stageDef->hitSound);
-
-    if(stage->flags.testFlag(Generator::ParticleStage::DieTouch))
-    {
-        // Particle dies from touch.
-        pinfo->stage = -1;
-        return false;
-    }
-
-    if(stage->flags.testFlag(Generator::ParticleStage::StageTouch) ||
-       (touchWall && stage->flags.testFlag(Generator::ParticleStage::StageWallTouch)) ||
-       (!touchWall && stage->flags.testFlag(Generator::ParticleStage::StageFlatTouch)))
-    {
-        // Particle advances to the next stage.
-        pinfo->tics = 0;
-    }
-
-    // Particle survives the touch.
-    return true;
-}
-
-float Generator::particleZ(const ParticleInfo &pinfo) const
+float Generator::particleZ(int index) const
 {
-    const auto &subsec = pinfo.bspLeaf->subspace().subsector().as<Subsector>();
-    if(pinfo.origin[2] == DDMAXINT)
-    {
-        return subsec.visCeiling().heightSmoothed() - 2;
-    }
-    if(pinfo.origin[2] == DDMININT)
+    const ParticleInfo &pinfo = _pinfo[index];
+    if(pinfo.onPlane)
     {
-        return (subsec.visFloor().heightSmoothed() + 2);
+        const auto &subsec = pinfo.bspLeaf->subspace().subsector().as<Subsector>();
+        if(pinfo.onPlane > 0)
+        {
+            return subsec.visCeiling().heightSmoothed() - 2;
+        }
+        return subsec.visFloor().heightSmoothed() + 2;
     }
-    return FIX2FLT(pinfo.origin[2]);
+    return _motion.pos[2][index];
 }
 
-Vec3f Generator::particleOrigin(const ParticleInfo &pt) const
+Vec3f Generator::particleOrigin(int index) const
 {
-    return Vec3f(FIX2FLT(pt.origin[0]), FIX2FLT(pt.origin[1]), particleZ(pt));
+    return Vec3f(_motion.pos[0][index], _motion.pos[1][index], particleZ(index));
 }
 
-Vec3f Generator::particleMomentum(const ParticleInfo &pt) const
+Vec3f Generator::particleMomentum(int index) const
 {
-    return Vec3f(FIX2FLT(pt.mov[0]), FIX2FLT(pt.mov[1]), FIX2FLT(pt.mov[2]));
+    return Vec3f(_motion.mov[0][index], _motion.mov[1][index], _motion.mov[2][index]);
 }
 
-void Generator::spinParticle(ParticleInfo &pinfo)
+void Generator::spinParticle(int index)
 {
     static int const yawSigns[4]   = { 1,  1, -1, -1 };
     static int const pitchSigns[4] = { 1, -1,  1, -1 };
 
-    const ded_ptcstage_t *stDef = &def->stages[pinfo.stage];
-    const duint spinIndex        = uint(&pinfo - &_pinfo[id() / 8]) % 4;
+    ParticleInfo &pinfo          = _pinfo[index];
+    const ded_ptcstage_t *stDef  = &def->stages[pinfo.stage];
+    const duint spinIndex        = uint(index - id() / 8) % 4;
 
     DE_ASSERT(spinIndex < 4);
 
@@ -637,7 +666,21 @@ void Generator::spinParticle(ParticleInfo &pinfo)
     pinfo.pitch *= 1 - stDef->spinResistance[1];
 }
 
-void Generator::moveParticle(int index)
+void Generator::killParticle(int index)
+{
+    _pinfo[index].stage = -1;
+    _motion.stop(index);
+}
+
+void Generator::updateParticleForces(int index)
+{
+    const int stage = _pinfo[index].stage;
+    _motion.setForces(index, def->stages[stage].vectorForce,
+                      FIX2FLT(stages[stage].gravity), FIX2FLT(stages[stage].resistance));
+}
+
+void Generator::moveParticle(int index, const ParticlePlanes &planes,
+                             const List<world::Line *> &lines)
 {
     DE_ASSERT(index >= 0 && index < count);
 
@@ -645,183 +688,123 @@ void Generator::moveParticle(int index)
     ParticleStage *st     = &stages[pinfo->stage];
     ded_ptcstage_t *stDef = &def->stages[pinfo->stage];
 
-    // Particle rotates according to spin speed.
-    spinParticle(*pinfo);
-
-    // Changes to momentum.
-    /// @todo Do not assume generator is from the CURRENT map.
-    pinfo->mov[2] -= FixedMul(FLT2FIX(map().gravity()), st->gravity);
+    float &posX = _motion.pos[0][index];
+    float &posY = _motion.pos[1][index];
+    float &posZ = _motion.pos[2][index];
+    float &movX = _motion.mov[0][index];
+    float &movY = _motion.mov[1][index];
+    float &movZ = _motion.mov[2][index];
 
-    // Vector force.
-    if(stDef->vectorForce[0] != 0 || stDef->vectorForce[1] != 0 ||
-       stDef->vectorForce[2] != 0)
+    /// Particle touches something solid. Returns false iff the particle dies.
+    auto touchParticle = [this, index, pinfo, st, stDef] (bool touchWall)
     {
-        for(int i = 0; i < 3; ++i)
+        // Play a hit sound.
+        const ded_embsound_t &sound = stDef->hitSound;
+        if(sound.id && sound.volume > 0 && _touchCount < count)
         {
-            pinfo->mov[i] += FLT2FIX(stDef->vectorForce[i]);
+            _touches[_touchCount++] = ParticleTouch{ particleOrigin(index), &sound };
         }
-    }
-
-    // Sphere force pull and turn.
-    // Only applicable to sourced or untriggered generators. For other
-    // types it's difficult to define the center coordinates.
-    if(st->flags.testFlag(ParticleStage::SphereForce) &&
-       (source || isUntriggered()))
-    {
-        float delta[3];
 
-        if(source)
+        if(st->flags.testFlag(ParticleStage::DieTouch))
         {
-            delta[0] = FIX2FLT(pinfo->origin[0]) - source->origin[0];
-            delta[1] = FIX2FLT(pinfo->origin[1]) - source->origin[1];
-            delta[2] = particleZ(*pinfo) - (source->origin[2] + FIX2FLT(originAtSpawn[2]));
-        }
-        else
-        {
-            for(int i = 0; i < 3; ++i)
-            {
-                delta[i] = FIX2FLT(pinfo->origin[i] - originAtSpawn[i]);
-            }
+            // Particle dies from touch.
+            killParticle(index);
+            return false;
         }
 
-        // Apply the offset (to source coords).
-        for(int i = 0; i < 3; ++i)
+        if(st->flags.testFlag(ParticleStage::StageTouch) ||
+           (touchWall && st->flags.testFlag(ParticleStage::StageWallTouch)) ||
+           (!touchWall && st->flags.testFlag(ParticleStage::StageFlatTouch)))
         {
-            delta[i] -= def->forceOrigin[i];
+            // Particle advances to the next stage.
+            pinfo->tics = 0;
         }
 
-        // Counter the aspect ratio of old times.
-        delta[2] *= 1.2f;
-
-        float dist = M_ApproxDistancef(M_ApproxDistancef(delta[0], delta[1]), delta[2]);
-        if(dist != 0)
-        {
-            // Radial force pushes the particles on the surface of a sphere.
-            if(def->force)
-            {
-                // Normalize delta vector, multiply with (dist - forceRadius),
-                // multiply with radial force strength.
-                for(int i = 0; i < 3; ++i)
-                {
-                    pinfo->mov[i] -= FLT2FIX(
-                        ((delta[i] / dist) * (dist - def->forceRadius)) * def->force);
-                }
-            }
-
-            // Rotate!
-            if(def->forceAxis[0] || def->forceAxis[1] || def->forceAxis[2])
-            {
-                float cross[3];
-                V3f_CrossProduct(cross, def->forceAxis, delta);
-
-                for(int i = 0; i < 3; ++i)
-                {
-                    pinfo->mov[i] += FLT2FIX(cross[i]) >> 8;
-                }
-            }
-        }
-    }
+        // Particle survives the touch.
+        return true;
+    };
 
-    if(st->resistance != FRACUNIT)
-    {
-        for(int i = 0; i < 3; ++i)
-        {
-            pinfo->mov[i] = FixedMul(pinfo->mov[i], st->resistance);
-        }
-    }
+    const bool planeFlat =
+        (st->type == PTC_POINT || (st->type >= PTC_TEXTURE && st->type < PTC_TEXTURE + MAX_PTC_TEXTURES)) &&
+        st->flags.testFlag(ParticleStage::PlaneFlat);
 
     // The particle is 'soft': half of radius is ignored.
     // The exception is plane flat particles, which are rendered flat
     // against planes. They are almost entirely soft when it comes to plane
     // collisions.
-    fixed_t hardRadius = st->radius / 2;
-    if((st->type == PTC_POINT || (st->type >= PTC_TEXTURE && st->type < PTC_TEXTURE + MAX_PTC_TEXTURES)) &&
-       st->flags.testFlag(ParticleStage::PlaneFlat))
-    {
-        hardRadius = FRACUNIT;
-    }
+    const float hardRadius = (planeFlat? 1.f : FIX2FLT(st->radius) / 2);
 
     // Check the new Z position only if not stuck to a plane.
-    fixed_t z = pinfo->origin[2] + pinfo->mov[2];
+    float z = _motion.next[2][index];
     bool zBounce = false, hitFloor = false;
-    if(pinfo->origin[2] != DDMININT && pinfo->origin[2] != DDMAXINT && pinfo->bspLeaf)
+    if(!pinfo->onPlane && planes.valid)
     {
-        auto &subsec = pinfo->bspLeaf->subspace().subsector().as<Subsector>();
-        if(z > FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius)
+        if(z > planes.ceiling - hardRadius)
         {
             // The Z is through the roof!
-            if(subsec.visCeiling().surface().hasSkyMaskedMaterial())
+            if(planes.ceilingSky)
             {
                 // Special case: particle gets lost in the sky.
-                pinfo->stage = -1;
+                killParticle(index);
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(false))
                 return;
 
-            z = FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius;
+            z = planes.ceiling - hardRadius;
             zBounce = true;
             hitFloor = false;
         }
 
         // Also check the floor.
-        if(z < FLT2FIX(subsec.visFloor().heightSmoothed()) + hardRadius)
+        if(z < planes.floor + hardRadius)
         {
-            if(subsec.visFloor().surface().hasSkyMaskedMaterial())
+            if(planes.floorSky)
             {
-                pinfo->stage = -1;
+                killParticle(index);
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(false))
                 return;
 
-            z = FLT2FIX(subsec.visFloor().heightSmoothed()) + hardRadius;
+            z = planes.floor + hardRadius;
             zBounce = true;
             hitFloor = true;
         }
 
         if(zBounce)
         {
-            pinfo->mov[2] = FixedMul(-pinfo->mov[2], st->bounce);
-            if(!pinfo->mov[2])
+            movZ = -movZ * FIX2FLT(st->bounce);
+            if(de::abs(movZ) < PARTICLE_MIN_MOMENTUM)
             {
                 // The particle has stopped moving. This means its Z-movement
                 // has ceased because of the collision with a plane. Plane-flat
                 // particles will stick to the plane.
-                if((st->type == PTC_POINT || (st->type >= PTC_TEXTURE && st->type < PTC_TEXTURE + MAX_PTC_TEXTURES)) &&
-                   st->flags.testFlag(ParticleStage::PlaneFlat))
+                movZ = 0;
+                if(planeFlat)
                 {
-                    z = hitFloor ? DDMININT : DDMAXINT;
+                    pinfo->onPlane = (hitFloor? -1 : 1);
                 }
             }
         }
 
         // Move to the new Z coordinate.
-        pinfo->origin[2] = z;
+        posZ = z;
     }
 
     // Now check the XY direction.
     // - Check if the movement crosses any solid lines.
     // - If it does, quit when first one contacted and apply appropriate
     //   bounce (result depends on the angle of the contacted wall).
-    fixed_t x = pinfo->origin[0] + pinfo->mov[0];
-    fixed_t y = pinfo->origin[1] + pinfo->mov[1];
-
-    struct checklineworker_params_t
-    {
-        AABoxd box;
-        fixed_t tmpz, tmprad, tmpx1, tmpx2, tmpy1, tmpy2;
-        bool tmcross;
-        Line *ptcHitLine;
-    };
-    checklineworker_params_t clParm; zap(clParm);
-    clParm.tmcross = false; // Has crossed potential sector boundary?
+    float x = _motion.next[0][index];
+    float y = _motion.next[1][index];
+    bool crossed = false; // Has crossed potential sector boundary?
 
     // XY movement can be skipped if the particle is not moving on the
     // XY plane.
-    if(!pinfo->mov[0] && !pinfo->mov[1])
+    if(!movX && !movY)
     {
         // If the particle is contacting a line, there is a chance that the
         // particle should be killed (if it's moving slowly at max).
@@ -830,193 +813,159 @@ void Generator::moveParticle(int index)
             auto *front = pinfo->contact->front().sectorPtr();
             auto *back  = pinfo->contact->back().sectorPtr();
 
-            if (front && back && abs(pinfo->mov[2]) < FRACUNIT / 2)
+            if (front && back && de::abs(movZ) < 0.5f)
             {
-                const coord_t pz = particleZ(*pinfo);
-
-                coord_t fz;
-                if (front->floor().height() > back->floor().height())
-                {
-                    fz = front->floor().height();
-                }
-                else
-                {
-                    fz = back->floor().height();
-                }
-
-                coord_t cz;
-                if (front->ceiling().height() < back->ceiling().height())
-                {
-                    cz = front->ceiling().height();
-                }
-                else
-                {
-                    cz = back->ceiling().height();
-                }
+                const coord_t pz = particleZ(index);
+                const coord_t fz = de::max(front->floor().height(), back->floor().height());
+                const coord_t cz = de::min(front->ceiling().height(), back->ceiling().height());
 
                 // If the particle is in the opening of a 2-sided line, it's
                 // quite likely that it shouldn't be here...
                 if (pz > fz && pz < cz)
                 {
-                    // Kill the particle.
-                    pinfo->stage = -1;
+                    killParticle(index);
                     return;
                 }
             }
         }
-
         // Still not moving on the XY plane...
-        goto quit_iteration;
     }
-
-    // We're moving in XY, so if we don't hit anything there can't be any line contact.
-    pinfo->contact = 0;
-
-    // Bounding box of the movement line.
-    clParm.tmpz = z;
-    clParm.tmprad = hardRadius;
-    clParm.tmpx1 = pinfo->origin[0];
-    clParm.tmpx2 = x;
-    clParm.tmpy1 = pinfo->origin[1];
-    clParm.tmpy2 = y;
-
-    vec2d_t point;
-    V2d_Set(point, FIX2FLT(MIN_OF(x, pinfo->origin[0]) - st->radius),
-                   FIX2FLT(MIN_OF(y, pinfo->origin[1]) - st->radius));
-    V2d_InitBox(clParm.box.arvec2, point);
-    V2d_Set(point, FIX2FLT(MAX_OF(x, pinfo->origin[0]) + st->radius),
-                   FIX2FLT(MAX_OF(y, pinfo->origin[1]) + st->radius));
-    V2d_AddToBox(clParm.box.arvec2, point);
-
-    // Iterate the lines in the contacted blocks.
-
-    World::validCount++;
-    DE_ASSERT(!clParm.ptcHitLine);
-    map().forAllLinesInBox(clParm.box, [&clParm] (world::Line &line)
+    else
     {
-        // Does the bounding box miss the line completely?
-        if (clParm.box.maxX <= line.bounds().minX || clParm.box.minX >= line.bounds().maxX ||
-            clParm.box.maxY <= line.bounds().minY || clParm.box.minY >= line.bounds().maxY)
-        {
-            return LoopContinue;
-        }
+        // We're moving in XY, so if we don't hit anything there can't be any line contact.
+        pinfo->contact = nullptr;
 
-        // Movement must cross the line.
-        if ((line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx1), FIX2FLT(clParm.tmpy1))) < 0) ==
-            (line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx2), FIX2FLT(clParm.tmpy2))) < 0))
-        {
-            return LoopContinue;
-        }
+        // Bounding box of the movement line.
+        const float radius = FIX2FLT(st->radius);
+        AABoxd box;
+        box.minX = de::min(x, posX) - radius;
+        box.minY = de::min(y, posY) - radius;
+        box.maxX = de::max(x, posX) + radius;
+        box.maxY = de::max(y, posY) + radius;
 
-        /*
-         * We are possibly hitting something here.
-         */
+        const Vec2d from(posX, posY);
+        const Vec2d to(x, y);
 
-        // Bounce if we hit a solid wall.
-        /// @todo fixme: What about "one-way" window lines?
-        clParm.ptcHitLine = &line.as<Line>();
-        if (!line.back().hasSector())
+        Line *hitLine = nullptr;
+        for(world::Line *line : lines)
         {
-            return LoopAbort; // Boing!
-        }
+            // Does the bounding box miss the line completely?
+            if (box.maxX <= line->bounds().minX || box.minX >= line->bounds().maxX ||
+                box.maxY <= line->bounds().minY || box.minY >= line->bounds().maxY)
+            {
+                continue;
+            }
 
-        auto *front = line.front().sectorPtr();
-        auto *back  = line.back().sectorPtr();
+            // Movement must cross the line.
+            if ((line->pointOnSide(from) < 0) == (line->pointOnSide(to) < 0))
+            {
+                continue;
+            }
 
-        // Determine the opening we have here.
-        /// @todo Use R_OpenRange()
-        fixed_t ceil;
-        if (front->ceiling().height() < back->ceiling().height())
-        {
-            ceil = FLT2FIX(front->ceiling().height());
-        }
-        else
-        {
-            ceil = FLT2FIX(back->ceiling().height());
-        }
+            /*
+             * We are possibly hitting something here.
+             */
 
-        fixed_t floor;
-        if (front->floor().height() > back->floor().height())
-        {
-            floor = FLT2FIX(front->floor().height());
-        }
-        else
-        {
-            floor = FLT2FIX(back->floor().height());
+            // Bounce if we hit a solid wall.
+            /// @todo fixme: What about "one-way" window lines?
+            if (!line->back().hasSector())
+            {
+                hitLine = &line->as<Line>();
+                break; // Boing!
+            }
+
+            auto *front = line->front().sectorPtr();
+            auto *back  = line->back().sectorPtr();
+
+            // Determine the opening we have here.
+            /// @todo Use R_OpenRange()
+            const float ceil  = float(de::min(front->ceiling().height(), back->ceiling().height()));
+            const float floor = float(de::max(front->floor().height(), back->floor().height()));
+
+            // There is a backsector. We possibly might hit something.
+            // Particles stuck to a plane stay in their sector.
+            if (pinfo->onPlane || z - hardRadius < floor || z + hardRadius > ceil)
+            {
+                hitLine = &line->as<Line>();
+                break; // Boing!
+            }
+
+            // False alarm, continue checking.
+            // There is a possibility that the new position is in a new sector.
+            crossed = true; // Afterwards, update the sector pointer.
         }
 
-        // There is a backsector. We possibly might hit something.
-        if (clParm.tmpz - clParm.tmprad < floor || clParm.tmpz + clParm.tmprad > ceil)
+        if(hitLine)
         {
-            return LoopAbort; // Boing!
-        }
+            // Must survive the touch.
+            if(!touchParticle(true))
+                return;
 
-        // False alarm, continue checking.
-        clParm.ptcHitLine = nullptr;
-        // There is a possibility that the new position is in a new sector.
-        clParm.tmcross    = true; // Afterwards, update the sector pointer.
-        return LoopContinue;
-    });
+            // There was a hit! Calculate bounce vector.
+            // - Project movement vector on the normal of hitline.
+            // - Calculate the difference to the point on the normal.
+            // - Add the difference to movement vector, negate movement.
+            // - Multiply with bounce.
 
-    if(clParm.ptcHitLine)
-    {
-        fixed_t normal[2], dotp;
-
-        // Must survive the touch.
-        if(!touchParticle(pinfo, st, stDef, true))
-            return;
-
-        // There was a hit! Calculate bounce vector.
-        // - Project movement vector on the normal of hitline.
-        // - Calculate the difference to the point on the normal.
-        // - Add the difference to movement vector, negate movement.
-        // - Multiply with bounce.
-
-        // Calculate the normal.
-        normal[0] = -FLT2FIX(clParm.ptcHitLine->direction().x);
-        normal[1] = -FLT2FIX(clParm.ptcHitLine->direction().y);
-
-        if(!normal[0] && !normal[1])
-            goto quit_iteration;
-
-        // Calculate as floating point so we don't overflow.
-        dotp = FRACUNIT * (DOT2F(pinfo->mov, normal) / DOT2F(normal, normal));
-        VECMUL(normal, dotp);
-        VECSUB(normal, pinfo->mov);
-        VECMULADD(pinfo->mov, 2 * FRACUNIT, normal);
-        VECMUL(pinfo->mov, st->bounce);
-
-        // Continue from the old position.
-        x = pinfo->origin[0];
-        y = pinfo->origin[1];
-        clParm.tmcross = false; // Sector can't change if XY doesn't.
-
-        // This line is the latest contacted line.
-        pinfo->contact = clParm.ptcHitLine;
-        goto quit_iteration;
+            // Calculate the normal.
+            const float normalX = -float(hitLine->direction().x);
+            const float normalY = -float(hitLine->direction().y);
+
+            if(normalX || normalY)
+            {
+                const float dotp  = (movX * normalX + movY * normalY) /
+                                    (normalX * normalX + normalY * normalY);
+                const float bounce = FIX2FLT(st->bounce);
+
+                movX = (2 * normalX * dotp - movX) * bounce;
+                movY = (2 * normalY * dotp - movY) * bounce;
+                if(de::abs(movX) < PARTICLE_MIN_MOMENTUM) movX = 0;
+                if(de::abs(movY) < PARTICLE_MIN_MOMENTUM) movY = 0;
+
+                // Continue from the old position.
+                x = posX;
+                y = posY;
+                crossed = false; // Sector can't change if XY doesn't.
+
+                // This line is the latest contacted line.
+                pinfo->contact = hitLine;
+            }
+        }
     }
 
-  quit_iteration:
     // The move is now OK.
-    pinfo->origin[0] = x;
-    pinfo->origin[1] = y;
+    posX = x;
+    posY = y;
 
     // Should we update the sector pointer?
-    if(clParm.tmcross)
+    if(crossed)
     {
-        pinfo->bspLeaf = &map().bspLeafAt(Vec2d(FIX2FLT(x), FIX2FLT(y)));
+        pinfo->bspLeaf = &map().bspLeafAt(Vec2d(x, y));
 
         // A BSP leaf with no geometry is not a suitable place for a particle.
         if(!pinfo->bspLeaf->hasSubspace())
         {
-            // Kill the particle.
-            pinfo->stage = -1;
+            killParticle(index);
         }
     }
 }
 
 void Generator::runTick()
 {
+    think();
+    moveParticles();
+    finishMove();
+}
+
+void Generator::think()
+{
+    // The previous tick has not been moved yet?
+    if(_movePending)
+    {
+        moveParticles();
+        finishMove();
+    }
+
     // Source has been destroyed?
     if(!isUntriggered() && !map().thinkers().isUsedMobjId(srcid))
     {
@@ -1085,7 +1034,7 @@ void Generator::runTick()
         }
     }
 
-    // Move particles.
+    // Advance the particles.
     ParticleInfo *pinfo = _pinfo;
     for(int i = 0; i < count; ++i, pinfo++)
     {
@@ -1098,7 +1047,7 @@ void Generator::runTick()
                stages[pinfo->stage].type == PTC_NONE)
             {
                 // Kill the particle.
-                pinfo->stage = -1;
+                killParticle(i);
                 continue;
             }
 
@@ -1107,13 +1056,186 @@ void Generator::runTick()
             // Change in particle angles?
             setParticleAngles(pinfo, def->stages[pinfo->stage].flags);
 
+            updateParticleForces(i);
+
             // Play a sound?
-            particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
+            particleSound(particleOrigin(i), &def->stages[pinfo->stage].sound);
+        }
+
+        // Particle rotates according to spin speed.
+        spinParticle(i);
+    }
+
+    _movePending = true;
+}
+
+void Generator::moveParticles()
+{
+    if(!_movePending) return;
+    _movePending = false;
+
+    // Sphere force pull and turn.
+    // Only applicable to sourced or untriggered generators. For other
+    // types it's difficult to define the center coordinates.
+    if(source || isUntriggered())
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            if(_pinfo[i].stage < 0 ||
+               !stages[_pinfo[i].stage].flags.testFlag(ParticleStage::SphereForce))
+            {
+                continue;
+            }
+
+            float delta[3];
+            if(source)
+            {
+                delta[0] = _motion.pos[0][i] - source->origin[0];
+                delta[1] = _motion.pos[1][i] - source->origin[1];
+                delta[2] = particleZ(i) - (source->origin[2] + FIX2FLT(originAtSpawn[2]));
+            }
+            else
+            {
+                for(int k = 0; k < 3; ++k)
+                {
+                    delta[k] = _motion.pos[k][i] - FIX2FLT(originAtSpawn[k]);
+                }
+            }
+
+            // Apply the offset (to source coords).
+            for(int k = 0; k < 3; ++k)
+            {
+                delta[k] -= def->forceOrigin[k];
+            }
+
+            // Counter the aspect ratio of old times.
+            delta[2] *= 1.2f;
+
+            const float dist = M_ApproxDistancef(M_ApproxDistancef(delta[0], delta[1]), delta[2]);
+            if(dist == 0) continue;
+
+            // Radial force pushes the particles on the surface of a sphere.
+            if(def->force)
+            {
+                // Normalize delta vector, multiply with (dist - forceRadius),
+                // multiply with radial force strength.
+                for(int k = 0; k < 3; ++k)
+                {
+                    _motion.mov[k][i] -= ((delta[k] / dist) * (dist - def->forceRadius)) * def->force;
+                }
+            }
+
+            // Rotate!
+            if(def->forceAxis[0] || def->forceAxis[1] || def->forceAxis[2])
+            {
+                float cross[3];
+                V3f_CrossProduct(cross, def->forceAxis, delta);
+
+                for(int k = 0; k < 3; ++k)
+                {
+                    _motion.mov[k][i] += cross[k] / 256;
+                }
+            }
         }
+    }
+
+    // The forces of the stages and the momentum are applied to all particles in
+    // batches.
+    integrateParticles(_motion, ParticleMotion::paddedCount(count), float(map().gravity()));
 
-        // Try to move.
-        moveParticle(i);
+    // Collisions are checked for the particles of each BSP leaf together, as they
+    // share the planes and most of the lines they might cross.
+    int numActive = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(_pinfo[i].stage >= 0)
+        {
+            _moveOrder[numActive++] = i;
+        }
+    }
+    const ParticleInfo *pinfo = _pinfo;
+    std::sort(_moveOrder, _moveOrder + numActive, [pinfo] (int a, int b)
+    {
+        if(pinfo[a].bspLeaf != pinfo[b].bspLeaf)
+        {
+            return std::less<const world::BspLeaf *>()(pinfo[a].bspLeaf, pinfo[b].bspLeaf);
+        }
+        return a < b;
+    });
+
+    static thread_local List<world::Line *> lines;
+    for(int begin = 0; begin < numActive; )
+    {
+        world::BspLeaf *bspLeaf = _pinfo[_moveOrder[begin]].bspLeaf;
+        int end = begin + 1;
+        while(end < numActive && _pinfo[_moveOrder[end]].bspLeaf == bspLeaf)
+        {
+            end++;
+        }
+
+        // Bounding box of the movement of all the particles in the leaf.
+        AABoxd box; // Empty.
+        bool moving = false;
+        for(int k = begin; k < end; ++k)
+        {
+            const int i = _moveOrder[k];
+            if(!_motion.mov[0][i] && !_motion.mov[1][i]) continue;
+
+            const float radius = FIX2FLT(stages[_pinfo[i].stage].radius);
+            const float minX = de::min(_motion.pos[0][i], _motion.next[0][i]) - radius;
+            const float minY = de::min(_motion.pos[1][i], _motion.next[1][i]) - radius;
+            const float maxX = de::max(_motion.pos[0][i], _motion.next[0][i]) + radius;
+            const float maxY = de::max(_motion.pos[1][i], _motion.next[1][i]) + radius;
+            box.minX = de::min(box.minX, double(minX));
+            box.minY = de::min(box.minY, double(minY));
+            box.maxX = de::max(box.maxX, double(maxX));
+            box.maxY = de::max(box.maxY, double(maxY));
+            moving = true;
+        }
+
+        // Lines in the contacted blocks. The map is not modified here (no validCount),
+        // so that generators can be moved concurrently.
+        lines.clear();
+        if(moving)
+        {
+            if(map().polyobjCount())
+            {
+                map().polyobjBlockmap().forAllInBox(box, [] (void *object)
+                {
+                    for(world::Line *line : reinterpret_cast<Polyobj *>(object)->lines())
+                    {
+                        lines << line;
+                    }
+                    return LoopContinue;
+                });
+            }
+            map().lineBlockmap().forAllInBox(box, [] (void *object)
+            {
+                lines << reinterpret_cast<world::Line *>(object);
+                return LoopContinue;
+            });
+
+            // A line may be linked in several blocks.
+            std::sort(lines.begin(), lines.end());
+            lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+        }
+
+        const ParticlePlanes planes(bspLeaf);
+        for(int k = begin; k < end; ++k)
+        {
+            moveParticle(_moveOrder[k], planes, lines);
+        }
+        begin = end;
+    }
+}
+
+void Generator::finishMove()
+{
+    for(int i = 0; i < _touchCount; ++i)
+    {
+        particleSound(_touches[i].origin, _touches[i].sound);
     }
+    _touchCount = 0;
 }
 
 void Generator::consoleRegister() //static
@@ -1134,5 +1256,7 @@ void Generator_Delete(Generator *gen)
 void Generator_Thinker(Generator *gen)
 {
     DE_ASSERT(gen != 0);
-    gen->runTick();
+    // The particles are moved later, together with those of the other generators
+    // (see Map::moveGeneratorParticles()).
+    gen->think();
 }
@@ -74,6 +74,7 @@
 #include <de/hash.h>
 #include <de/rectangle.h>
 #include <de/charsymbols.h>
+#include <de/taskpool.h>
 #include <de/legacy/aabox.h>
 #include <de/legacy/nodepile.h>
 #include <de/legacy/vector1.h>
@@ -90,6 +91,10 @@ using world::World;
 /// status should be removed fairly quickly.
 #define CLMOBJ_TIMEOUT  4000
 
+/// With fewer particles than this in total, the generators are moved in the main
+/// thread as the work is too small to be worth distributing.
+#define MIN_PARALLEL_PARTICLES  2048
+
 DE_PIMPL(Map)
 , DE_OBSERVES(ThinkerData, Deletion)
 #ifdef __SERVER__
@@ -1049,6 +1054,44 @@ LoopResult Map::forAllGenerators(const std::function<LoopResult (Generator &)>&
     return LoopContinue;
 }
 
+void Map::moveGeneratorParticles()
+{
+    if (!d->generators) return;
+
+    List<Generator *> gens;
+    int numParticles = 0;
+    for (Generator *gen : d->getGenerators().activeGens)
+    {
+        if (!gen) continue;
+        gens << gen;
+        numParticles += gen->count;
+    }
+
+    if (gens.size() > 1 && numParticles >= MIN_PARALLEL_PARTICLES)
+    {
+        TaskPool::parallelFor(0, gens.size(), [&gens] (dsize begin, dsize end)
+        {
+            for (dsize i = begin; i < end; ++i)
+            {
+                gens[i]->moveParticles();
+            }
+        }, 1);
+    }
+    else
+    {
+        for (Generator *gen : gens)
+        {
+            gen->moveParticles();
+        }
+    }
+
+    // Sounds can only be started in the main thread.
+    for (Generator *gen : gens)
+    {
+        gen->finishMove();
+    }
+}
+
 LoopResult Map::forAllGeneratorsInSector(const world::Sector &sector,
                                          const std::function<LoopResult (Generator &)>& func) const
 {
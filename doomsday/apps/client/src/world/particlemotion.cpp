@@ -0,0 +1,146 @@
+/** @file particlemotion.cpp  Batched integration of particle movement.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "world/particlemotion.h"
+
+#include <cmath>
+
+// SSE2 and NEON are part of the baseline of the 64-bit targets, so there is no
+// need for runtime detection.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define PARTICLEMOTION_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#  define PARTICLEMOTION_NEON
+#  include <arm_neon.h>
+#endif
+
+/// Number of particles integrated at a time.
+static const int PARTICLE_BATCH = 4;
+
+/// Number of arrays in the storage block.
+static const int PARTICLE_ARRAYS = 14;
+
+int ParticleMotion::paddedCount(int count)
+{
+    return (count + PARTICLE_BATCH - 1) & ~(PARTICLE_BATCH - 1);
+}
+
+size_t ParticleMotion::storageSize(int count)
+{
+    return sizeof(float) * PARTICLE_ARRAYS * size_t(paddedCount(count));
+}
+
+void ParticleMotion::setStorage(void *storage, int count)
+{
+    const int stride = paddedCount(count);
+    float *array = reinterpret_cast<float *>(storage);
+    for (int i = 0; i < 3; ++i) { pos[i]   = array; array += stride; }
+    for (int i = 0; i < 3; ++i) { mov[i]   = array; array += stride; }
+    for (int i = 0; i < 3; ++i) { force[i] = array; array += stride; }
+    weight = array; array += stride;
+    drag   = array; array += stride;
+    for (int i = 0; i < 3; ++i) { next[i]  = array; array += stride; }
+}
+
+void ParticleMotion::setForces(int index, const float vectorForce[3], float weight_, float drag_)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        force[i][index] = vectorForce[i];
+    }
+    weight[index] = weight_;
+    drag[index]   = drag_;
+}
+
+void ParticleMotion::stop(int index)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        mov[i][index]   = 0;
+        force[i][index] = 0;
+    }
+    weight[index] = 0;
+    drag[index]   = 0;
+}
+
+static inline float flushMomentum(float value)
+{
+    return (std::fabs(value) < PARTICLE_MIN_MOMENTUM? 0.f : value);
+}
+
+void integrateParticles(ParticleMotion &motion, int count, float gravity)
+{
+    int i = 0;
+#if defined(PARTICLEMOTION_SSE2)
+    const __m128 grav    = _mm_set1_ps(gravity);
+    const __m128 minMom  = _mm_set1_ps(PARTICLE_MIN_MOMENTUM);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    for (; i + PARTICLE_BATCH <= count; i += PARTICLE_BATCH)
+    {
+        const __m128 drag = _mm_loadu_ps(motion.drag + i);
+        for (int c = 0; c < 3; ++c)
+        {
+            __m128 mov = _mm_add_ps(_mm_loadu_ps(motion.mov[c] + i), _mm_loadu_ps(motion.force[c] + i));
+            if (c == 2)
+            {
+                mov = _mm_sub_ps(mov, _mm_mul_ps(grav, _mm_loadu_ps(motion.weight + i)));
+            }
+            mov = _mm_mul_ps(mov, drag);
+            mov = _mm_and_ps(mov, _mm_cmpge_ps(_mm_and_ps(mov, absMask), minMom));
+            _mm_storeu_ps(motion.mov[c] + i, mov);
+            _mm_storeu_ps(motion.next[c] + i, _mm_add_ps(_mm_loadu_ps(motion.pos[c] + i), mov));
+        }
+    }
+#elif defined(PARTICLEMOTION_NEON)
+    const float32x4_t grav   = vdupq_n_f32(gravity);
+    const float32x4_t minMom = vdupq_n_f32(PARTICLE_MIN_MOMENTUM);
+    for (; i + PARTICLE_BATCH <= count; i += PARTICLE_BATCH)
+    {
+        const float32x4_t drag = vld1q_f32(motion.drag + i);
+        for (int c = 0; c < 3; ++c)
+        {
+            float32x4_t mov = vaddq_f32(vld1q_f32(motion.mov[c] + i), vld1q_f32(motion.force[c] + i));
+            if (c == 2)
+            {
+                mov = vmlsq_f32(mov, grav, vld1q_f32(motion.weight + i));
+            }
+            mov = vmulq_f32(mov, drag);
+            mov = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(mov),
+                                                  vcageq_f32(mov, minMom)));
+            vst1q_f32(motion.mov[c] + i, mov);
+            vst1q_f32(motion.next[c] + i, vaddq_f32(vld1q_f32(motion.pos[c] + i), mov));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            float mov = motion.mov[c][i] + motion.force[c][i];
+            if (c == 2)
+            {
+                mov -= gravity * motion.weight[i];
+            }
+            mov = flushMomentum(mov * motion.drag[i]);
+            motion.mov[c][i]  = mov;
+            motion.next[c][i] = motion.pos[c][i] + mov;
+        }
+    }
+}
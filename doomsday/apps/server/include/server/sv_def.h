@@ -49,6 +49,8 @@ struct material_s;
 extern int svMaxPlayers;
 extern int allowFrames;    ///< Allow sending of frames.
 extern int frameInterval;  ///< In tics.
+extern byte parallelFrames; ///< Generate deltas and rate pools using multiple threads.
+extern byte verifyFrames;   ///< Verify in every frame that no world changes are missed by dirty tracking.
 //extern int netRemoteUser;  ///< The client who is currently logged in.
 extern char *netPassword;       ///< Remote login password.
 
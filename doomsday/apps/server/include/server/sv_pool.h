@@ -267,6 +267,7 @@ dd_bool         Sv_IsFrameTarget(uint clientNumber);
 uint            Sv_GetTimeStamp(void);
 pool_t*         Sv_GetPool(uint clientNumber);
 void            Sv_RatePool(pool_t* pool);
+void            Sv_RatePools(pool_t** pools);
 delta_t*        Sv_PoolQueueExtract(pool_t* pool);
 void            Sv_AckDeltaSet(uint clientNumber, int set, byte resent);
 uint            Sv_CountUnackedDeltas(uint clientNumber);
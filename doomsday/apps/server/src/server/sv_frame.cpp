@@ -100,6 +100,11 @@ void Sv_TransmitFrame()
     // How many players currently in the game?
     const dint numInGame = Sv_GetNumPlayers();
 
+    // Players who will be sent a frame this time.
+    dint receivers[DDMAXPLAYERS];
+    pool_t *receiverPools[DDMAXPLAYERS + 1];
+    dint numReceivers = 0;
+
     dint pCount = 0;
     for (dint i = 0; i < DDMAXPLAYERS; ++i)
     {
@@ -133,7 +138,15 @@ void Sv_TransmitFrame()
             // decrease back to zero.
             //::clients[i].updateCount--;
 
-            Sv_SendFrame(i);
+            // Does the send queue allow us to send this packet?
+            // Bandwidth rating is updated during the check.
+            if (Sv_CheckBandwidth(i))
+            {
+                receiverPools[numReceivers] = Sv_GetPool(i);
+                receivers[numReceivers++] = i;
+            }
+            // Otherwise we cannot send anything at this time. This will only
+            // happen if the send queue has too many packets waiting to be sent.
         }
         else
         {
@@ -141,6 +154,16 @@ void Sv_TransmitFrame()
                              ::lastTransmitTic << i << plr.ready);
         }
     }
+    receiverPools[numReceivers] = nullptr;
+
+    // The priority queues of the clients need to be rebuilt before new frames
+    // can be sent. The pools are independent so they can be rated concurrently.
+    Sv_RatePools(receiverPools);
+
+    for (dint i = 0; i < numReceivers; ++i)
+    {
+        Sv_SendFrame(receivers[i]);
+    }
 }
 
 /**
@@ -777,24 +800,13 @@ byte Sv_GetNewResendID(pool_t *pool)
 /**
  * Send a sv_frame packet to the specified player. The amount of data sent
  * depends on the player's bandwidth rating.
+ *
+ * The pool of the player must have been rated (see Sv_RatePools()).
  */
 void Sv_SendFrame(dint plrNum)
 {
     pool_t *pool = Sv_GetPool(plrNum);
 
-    // Does the send queue allow us to send this packet?
-    // Bandwidth rating is updated during the check.
-    if (!Sv_CheckBandwidth(plrNum))
-    {
-        // We cannot send anything at this time. This will only happen if
-        // the send queue has too many packets waiting to be sent.
-        return;
-    }
-
-    // The priority queue of the client needs to be rebuilt before
-    // a new frame can be sent.
-    Sv_RatePool(pool);
-
     // This will be a new set.
     DE_ASSERT(pool);
     pool->setDealer++;
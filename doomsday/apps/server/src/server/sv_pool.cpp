@@ -28,13 +28,18 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include <doomsday/world/line.h>
 #include <doomsday/world/sector.h>
 #include <doomsday/world/thinkers.h>
 #include <de/legacy/mathutil.h>
 #include <de/legacy/timer.h>
 #include <de/legacy/vector1.h>
 #include <de/logbuffer.h>
+#include <de/taskpool.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 using namespace de;
 
@@ -50,6 +55,16 @@ using world::Surface;
 // Maximum difference in plane height where the absolute height doesn't need to be sent.
 #define PLANE_SKIP_LIMIT            ( 40 )
 
+// Minimum number of register entries compared by one worker.
+#define COMPARE_CHUNK_SIZE          ( 256 )
+
+// Seconds between the logged delta generation timings.
+#define PHASE_TIMING_INTERVAL       ( 10 )
+
+// Frames between full comparisons of the world register, which catch changes
+// missed by the dirty tracking.
+#define FULL_COMPARE_INTERVAL       ( 35 )
+
 struct reg_mobj_t
 {
     reg_mobj_t *next;  ///< In the register hash.
@@ -79,6 +94,171 @@ struct cregister_t
     dt_poly_t *polyObjs;
 };
 
+/// Storage for a delta of any type.
+typedef std::aligned_union<0, mobjdelta_t, playerdelta_t, sectordelta_t, sidedelta_t,
+                           polydelta_t, sounddelta_t>::type anydelta_t;
+
+/// Delta of a changed mobj.
+struct mobjchange_t
+{
+    mobjdelta_t delta;
+    const mobj_t *mob;  ///< Source of the delta.
+};
+
+/**
+ * Deltas generated by comparing the world against a register. They are added
+ * to the target pools only after the whole register has been compared, in the
+ * same order as they were generated.
+ */
+struct deltabatch_t
+{
+    List<mobjdelta_t>   nulls;
+    List<mobjchange_t>  mobjs;
+    List<playerdelta_t> players;
+    List<sectordelta_t> sectors;
+    List<sidedelta_t>   sides;
+    List<polydelta_t>   polys;
+
+    dsize size() const
+    {
+        return nulls.size() + mobjs.size() + players.size() + sectors.size() + sides.size()
+             + polys.size();
+    }
+
+    template <typename Func>
+    void forAll(Func func)
+    {
+        for (auto &d : nulls)   func(&d);
+        for (auto &c : mobjs)   func(&c.delta);
+        for (auto &d : players) func(&d);
+        for (auto &d : sectors) func(&d);
+        for (auto &d : sides)   func(&d);
+        for (auto &d : polys)   func(&d);
+    }
+};
+
+/**
+ * Set of map element indices, in the order they were marked.
+ */
+struct dirtyset_t
+{
+    List<dint> indices;
+    List<bool> marked;
+
+    void reset(dint count)
+    {
+        indices.clear();
+        marked.clear();
+        marked.resize(count, false);
+    }
+
+    inline bool isMarked(dint index) const { return marked[index]; }
+
+    void mark(dint index)
+    {
+        if (index >= 0 && index < marked.sizei() && !marked[index])
+        {
+            marked[index] = true;
+            indices << index;
+        }
+    }
+
+    void clear()
+    {
+        for (dint index : indices) marked[index] = false;
+        indices.clear();
+    }
+};
+
+/**
+ * Keeps track of the map elements and objects that the playsim has changed since they
+ * were last compared against the world register. Only these need to be compared when
+ * generating frame deltas.
+ *
+ * Sectors and sides are written via DMU. Mobjs are marked when linked, unlinked or
+ * their state changes, and the game marks the changes that it makes otherwise (e.g.,
+ * damage, Z movement and moving planes). Polyobjs are marked when moved or rotated, and when the game
+ * starts moving them.
+ */
+struct dirtytracker_t
+    : public world::Map::IElementPropertyChangeObserver
+    , public world::Map::IMobjChangeObserver
+    , public world::Map::IPolyobjChangeObserver
+{
+    dirtyset_t sectors;
+    dirtyset_t sides;
+    dirtyset_t mobjs; ///< Indexed by mobj ID.
+    dirtyset_t polys;
+
+    void reset(const world::Map &map)
+    {
+        sectors.reset(map.sectorCount());
+        sides  .reset(map.sideCount());
+        mobjs  .reset(dint(std::numeric_limits<thid_t>::max()) + 1);
+        polys  .reset(map.polyobjCount());
+    }
+
+    void mapElementPropertyChanged(world::MapElement &element, int /*property*/) override
+    {
+        switch (element.type())
+        {
+        case DMU_SECTOR:
+            sectors.mark(element.indexInMap());
+            break;
+
+        case DMU_PLANE:
+            sectors.mark(element.as<Plane>().sector().indexInMap());
+            break;
+
+        case DMU_SIDE:
+            sides.mark(element.indexInMap());
+            break;
+
+        case DMU_LINE: {
+            // Line flags are included in the deltas of both sides.
+            const auto &line = element.as<world::Line>();
+            sides.mark(line.front().indexInMap());
+            sides.mark(line.back ().indexInMap());
+            break; }
+
+        case DMU_SURFACE:
+            if (element.parent().type() == DMU_PLANE)
+            {
+                sectors.mark(element.parent().as<Plane>().sector().indexInMap());
+            }
+            else if (element.parent().type() == DMU_SIDE)
+            {
+                sides.mark(element.parent().indexInMap());
+            }
+            break;
+
+        default: break;
+        }
+    }
+
+    void mapMobjChanged(const mobj_t &mob) override
+    {
+        mobjs.mark(mob.thinker.id);
+    }
+
+    void mapPolyobjChanged(const Polyobj &pob) override
+    {
+        polys.mark(pob.indexInMap());
+    }
+};
+
+/// Time spent in each phase of delta generation (for profiling).
+struct phasetimes_t
+{
+    Time since;           ///< Start of the accumulation period.
+    dint frames     = 0;
+    dint pools      = 0;
+    dsize deltas    = 0;
+    ddouble compare = 0;  ///< Comparing the world against the register.
+    ddouble merge   = 0;  ///< Adding the new deltas to the pools.
+    ddouble rate    = 0;  ///< Rating the pools and building the priority queues.
+};
+
 void Sv_RegisterWorld(cregister_t *reg, dd_bool isInitial);
 void Sv_NewDelta(void *deltaPtr, deltatype_t type, duint id);
 dd_bool Sv_IsVoidDelta(const void *delta);
@@ -97,6 +277,15 @@ static dfloat deltaBaseScores[NUM_DELTA_TYPES];
 // the mobj being compared.
 static ThinkerT<dt_mobj_t> dummyZeroMobj;
 
+static phasetimes_t phaseTimes;
+
+static dirtytracker_t dirtyTracker;
+static duint          frameCount;
+static bool           fullCompare; ///< All elements are compared in the current frame.
+
+byte parallelFrames = 1;  // cvar
+byte verifyFrames   = 0;  // cvar
+
 /**
  * Called once for each map, from R_SetupMap(). Initialize the world
  * register and drain all pools.
@@ -151,6 +340,13 @@ void Sv_InitPools()
     Sv_RegisterWorld(&::worldRegister, false);
     Sv_RegisterWorld(&::initialRegister, true);
 
+    // Begin tracking changes made by the playsim.
+    world::Map &map = ServerWorld::get().map();
+    ::dirtyTracker.reset(map);
+    map.audienceForElementPropertyChange() += ::dirtyTracker;
+    map.audienceForMobjChange()            += ::dirtyTracker;
+    map.audienceForPolyobjChange()         += ::dirtyTracker;
+
     // How much time did we spend?
     LOG_MAP_VERBOSE("World registered in %.2f seconds") << startedAt.since();
 }
@@ -1103,12 +1299,10 @@ dd_bool Sv_IsSameDelta(const void *delta1, const void *delta2)
 }
 
 /**
- * Makes a copy of the delta.
+ * Returns the size of the delta structure in bytes.
  */
-void* Sv_CopyDelta(void* deltaPtr)
+static size_t Sv_DeltaSize(const delta_t *delta)
 {
-    void*               newDelta;
-    delta_t*            delta = (delta_t *) deltaPtr;
     size_t              size =
         ( delta->type == DT_MOBJ ?         sizeof(mobjdelta_t)
         : delta->type == DT_PLAYER ?       sizeof(playerdelta_t)
@@ -1125,10 +1319,19 @@ void* Sv_CopyDelta(void* deltaPtr)
 
     if (size == 0)
     {
-        App_Error("Sv_CopyDelta: Unknown delta type %i.\n", delta->type);
+        App_Error("Sv_DeltaSize: Unknown delta type %i.\n", delta->type);
     }
+    return size;
+}
+
+/**
+ * Makes a copy of the delta.
+ */
+void* Sv_CopyDelta(void* deltaPtr)
+{
+    const size_t        size = Sv_DeltaSize((delta_t *) deltaPtr);
+    void*               newDelta = Z_Malloc(size, PU_MAP, 0);
 
-    newDelta = Z_Malloc(size, PU_MAP, 0);
     memcpy(newDelta, deltaPtr, size);
     return newDelta;
 }
@@ -1830,7 +2033,8 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
     delta_t*            iter, *next = NULL, *existingNew = NULL;
     delta_t*            delta = (delta_t *) deltaPtr;
     deltalink_t*        hash = Sv_PoolHash(pool, delta->id);
-    int                 flags, originalFlags;
+    int                 flags;
+    anydelta_t          excluded;
 
     // Sometimes we can exclude a part of the data, if the client has no
     // use for it.
@@ -1842,9 +2046,14 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
         return;
     }
 
-    // Temporarily use the excluded flags.
-    originalFlags = delta->flags;
-    delta->flags = flags;
+    if (flags != delta->flags)
+    {
+        // Use a private copy with the excluded flags, so the same delta can
+        // be added to several pools at once.
+        memcpy(&excluded, delta, Sv_DeltaSize(delta));
+        delta = (delta_t *) &excluded;
+        delta->flags = flags;
+    }
 
     // While subtracting from old deltas, we'll look for a pointer to
     // an existing NEW delta.
@@ -1907,11 +2116,6 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
             hash->first = iter;
         }
     }
-
-    // This delta may yet be added to other pools. They should use the
-    // original flags, not the ones we might've used (hackish: copying the
-    // whole delta is not really an option, though).
-    delta->flags = originalFlags;
 }
 
 /**
@@ -2046,13 +2250,64 @@ int Sv_GetTargetPools(pool_t** targets, int clientsMask)
     return numTargets;
 }
 
+/**
+ * Compares the register entries [begin, end) against the world, split into
+ * chunks that are processed in parallel (if enabled). The non-void deltas are
+ * appended to @a deltas in index order, exactly as a serial loop would.
+ *
+ * @param compare  Called with an index and the delta to fill in. Returns @c true
+ *                 if the delta is not void. Must only modify the register entry
+ *                 of the index in question.
+ */
+template <typename DeltaType, typename CompareFunc>
+static void Sv_CompareRange(dsize begin, dsize end, List<DeltaType> &deltas,
+                            const CompareFunc &compare)
+{
+    const dsize count = end - begin;
+    const dsize numChunks =
+        (parallelFrames ? de::max(dsize(1), de::min(count / COMPARE_CHUNK_SIZE,
+                                                    dsize(4 * TaskPool::workerCount())))
+                        : 1);
+
+    if (numChunks == 1)
+    {
+        DeltaType delta;
+        for (dsize i = begin; i < end; ++i)
+        {
+            if (compare(i, delta)) deltas << delta;
+        }
+        return;
+    }
+
+    List<List<DeltaType>> chunks(numChunks);
+    TaskPool::parallelFor(0, numChunks, [begin, count, numChunks, &chunks, &compare]
+                          (dsize firstChunk, dsize endChunk)
+    {
+        for (dsize c = firstChunk; c < endChunk; ++c)
+        {
+            DeltaType delta;
+            for (dsize i = begin + count * c / numChunks,
+                     last = begin + count * (c + 1) / numChunks; i < last; ++i)
+            {
+                if (compare(i, delta)) chunks[c] << delta;
+            }
+        }
+    }, 1, TaskPool::HighPriority);
+
+    // Merge the batches in order.
+    for (const auto &chunk : chunks)
+    {
+        deltas << chunk;
+    }
+}
+
 /**
  * Null deltas are generated for mobjs that have been destroyed.
  * The register's mobj hash is scanned to see which mobjs no longer exist.
  *
  * When updating, the destroyed mobjs are removed from the register.
  */
-void Sv_NewNullDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
+void Sv_NewNullDeltas(cregister_t *reg, dd_bool doUpdate, deltabatch_t &batch)
 {
     int i;
     mobjhash_t *hash;
@@ -2076,7 +2331,7 @@ void Sv_NewNullDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
                 // We need all the data for positioning.
                 memcpy(&null.mo, &obj->mo, sizeof(dt_mobj_t));
 
-                Sv_AddDeltaToPools(&null, targets);
+                batch.nulls << null;
 
                 if (doUpdate)
                 {
@@ -2089,39 +2344,100 @@ void Sv_NewNullDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
 }
 
 /**
- * Mobj deltas are generated for all mobjs that have changed.
+ * Mobj deltas are generated for all mobjs that have changed. When comparing against
+ * the world register, only the mobjs changed since the last comparison are checked.
  */
-void Sv_NewMobjDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
+void Sv_NewMobjDeltas(cregister_t *reg, dd_bool doUpdate, deltabatch_t &batch)
 {
-    ServerWorld::get().map().thinkers().forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker),
-                                       0x1 /*public*/, [&reg, &doUpdate, &targets] (thinker_t *th)
+    world::Thinkers &thinkers = ServerWorld::get().map().thinkers();
+    dirtyset_t &dirty = ::dirtyTracker.mobjs;
+    List<const mobj_t *> mobs;
+
+    // When comparing against an initial register, or checking the dirty tracking,
+    // all mobjs are compared.
+    if (reg->isInitial || ::fullCompare)
     {
-        auto &mob = *reinterpret_cast<mobj_t *>(th);
+        thinkers.forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker), 0x1 /*public*/,
+                        [&mobs] (thinker_t *th)
+        {
+            const auto &mob = *reinterpret_cast<mobj_t *>(th);
+
+            // Some objects should not be processed.
+            if (!Sv_IsMobjIgnored(mob))
+            {
+                mobs << &mob;
+            }
+            return LoopContinue;
+        });
+    }
 
-        // Some objects should not be processed.
-        if (!Sv_IsMobjIgnored(mob))
+    if (!reg->isInitial)
+    {
+        // Players turn without the engine noticing, so they are always compared.
+        for (dint i = 0; i < DDMAXPLAYERS; ++i)
         {
-            // Compare to produce a delta.
-            mobjdelta_t delta;
-            if (Sv_RegisterCompareMobj(reg, &mob, &delta))
+            const ddplayer_t &ddpl = DD_Player(i)->publicData();
+            if (ddpl.inGame && ddpl.mo)
             {
-                Sv_AddDeltaToPools(&delta, targets);
+                dirty.mark(ddpl.mo->thinker.id);
+            }
+        }
 
-                if (doUpdate)
+        if (::fullCompare)
+        {
+            for (const mobj_t *mob : mobs)
+            {
+                mobjdelta_t delta;
+                if (!dirty.isMarked(mob->thinker.id) && Sv_RegisterCompareMobj(reg, mob, &delta))
                 {
-                    // This'll add a new register-mobj if it doesn't already exist.
-                    Sv_RegisterMobj(&Sv_RegisterAddMobj(reg, mob.thinker.id)->mo, &mob);
+                    LOG_NET_WARNING("Mobj %i changed but was not marked dirty")
+                        << mob->thinker.id;
+                    dirty.mark(mob->thinker.id);
                 }
             }
         }
-        return LoopContinue;
+
+        // Deltas are generated in ID order.
+        std::sort(dirty.indices.begin(), dirty.indices.end());
+        mobs.clear();
+        for (dint id : dirty.indices)
+        {
+            const mobj_t *mob = thinkers.mobjById(id);
+            if (mob && !Sv_IsMobjIgnored(*mob))
+            {
+                mobs << mob;
+            }
+        }
+    }
+
+    // Compare to produce deltas. The register hash is not modified here.
+    Sv_CompareRange(0, mobs.size(), batch.mobjs, [reg, &mobs] (dsize i, mobjchange_t &change)
+    {
+        change.mob = mobs[i];
+        return Sv_RegisterCompareMobj(reg, mobs[i], &change.delta);
     });
+
+    if (doUpdate)
+    {
+        for (const mobjchange_t &change : batch.mobjs)
+        {
+            // This'll add a new register-mobj if it doesn't already exist.
+            Sv_RegisterMobj(&Sv_RegisterAddMobj(reg, change.mob->thinker.id)->mo, change.mob);
+        }
+
+        if (!reg->isInitial)
+        {
+            // The register is now up to date.
+            dirty.clear();
+        }
+    }
 }
 
 /**
  * Player deltas are generated for changed player data.
  */
-void Sv_NewPlayerDeltas(cregister_t* reg, dd_bool doUpdate, pool_t** targets)
+void Sv_NewPlayerDeltas(cregister_t* reg, dd_bool doUpdate, pool_t** targets,
+                        deltabatch_t &batch)
 {
     playerdelta_t player;
     uint i;
@@ -2144,10 +2460,13 @@ void Sv_NewPlayerDeltas(cregister_t* reg, dd_bool doUpdate, pool_t** targets)
                 if (registered)
                 {
                     Sv_RegisterResetMobj(&registered->mo);
+
+                    // Compare it in full in the next frame.
+                    ::dirtyTracker.mobjs.mark(reg->ddPlayers[i].mobj);
                 }
             }
 
-            Sv_AddDeltaToPools(&player, targets);
+            batch.players << player;
         }
 
         if (doUpdate)
@@ -2200,84 +2519,169 @@ void Sv_NewPlayerDeltas(cregister_t* reg, dd_bool doUpdate, pool_t** targets)
 }
 
 /**
- * Sector deltas are generated for changed sectors.
+ * Checks that none of the elements not in @a dirty differ from the register,
+ * i.e., that no changes went unnoticed by the dirty tracking. Any elements that
+ * do differ are logged and marked dirty.
  */
-void Sv_NewSectorDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
+template <typename CompareFunc>
+static void Sv_VerifyDirtySet(dirtyset_t &dirty, dint count, const char *elementName,
+                              const CompareFunc &compare)
 {
-    sectordelta_t delta;
-
-    for (int i = 0; i < ServerWorld::get().map().sectorCount(); ++i)
+    for (dint i = 0; i < count; ++i)
     {
-        if (Sv_RegisterCompareSector(reg, i, &delta, doUpdate))
+        if (!dirty.isMarked(i) && compare(i))
         {
-            Sv_AddDeltaToPools(&delta, targets);
+            LOG_NET_WARNING("%s %i changed but was not marked dirty") << elementName << i;
+            dirty.mark(i);
         }
     }
 }
 
 /**
- * Side deltas are generated for changed sides (and line flags).
- * Changes in sides (textures) are so rare that all sides need not be
- * checked on every tic.
+ * Sector deltas are generated for changed sectors. When comparing against the
+ * world register, only the sectors written to since the last comparison are
+ * checked.
  */
-void Sv_NewSideDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
+void Sv_NewSectorDeltas(cregister_t *reg, dd_bool doUpdate, deltabatch_t &batch)
 {
-    static uint numShifts = 2, shift = 0;
+    const dint numSectors = ServerWorld::get().map().sectorCount();
+
+    // When comparing against an initial register, always compare all
+    // sectors (since the comparing is only done once, not continuously).
+    if (reg->isInitial)
+    {
+        Sv_CompareRange(0, numSectors, batch.sectors,
+                        [reg, doUpdate] (dsize i, sectordelta_t &delta)
+        {
+            return Sv_RegisterCompareSector(reg, dint(i), &delta, doUpdate);
+        });
+        return;
+    }
 
+    dirtyset_t &dirty = ::dirtyTracker.sectors;
+    if (::fullCompare)
+    {
+        Sv_VerifyDirtySet(dirty, numSectors, "Sector", [reg] (dint i)
+        {
+            sectordelta_t delta;
+            return Sv_RegisterCompareSector(reg, i, &delta, false);
+        });
+    }
+
+    // Deltas are generated in index order.
+    std::sort(dirty.indices.begin(), dirty.indices.end());
+    Sv_CompareRange(0, dirty.indices.size(), batch.sectors,
+                    [reg, doUpdate, &dirty] (dsize i, sectordelta_t &delta)
+    {
+        return Sv_RegisterCompareSector(reg, dirty.indices[i], &delta, doUpdate);
+    });
+
+    if (doUpdate)
+    {
+        // The register is now up to date.
+        dirty.clear();
+    }
+}
+
+/**
+ * Side deltas are generated for changed sides (and line flags). When comparing
+ * against the world register, only the sides written to since the last
+ * comparison are checked.
+ */
+void Sv_NewSideDeltas(cregister_t *reg, dd_bool doUpdate, deltabatch_t &batch)
+{
     /// @todo fixme: Do not assume the current map.
-    world::Map &map = ServerWorld::get().map();
+    const dint numSides = ServerWorld::get().map().sideCount();
 
     // When comparing against an initial register, always compare all
     // sides (since the comparing is only done once, not continuously).
-    uint start, end;
     if (reg->isInitial)
     {
-        start = 0;
-        end = map.sideCount();
+        Sv_CompareRange(0, numSides, batch.sides, [reg, doUpdate] (dsize i, sidedelta_t &delta)
+        {
+            return Sv_RegisterCompareSide(reg, duint(i), &delta, doUpdate);
+        });
+        return;
     }
-    else
+
+    dirtyset_t &dirty = ::dirtyTracker.sides;
+    if (::fullCompare)
     {
-        // Because there are so many sides in a typical map, the number
-        // of compared sides soon accumulates to millions. To reduce the
-        // load, we'll check only a portion of all sides for a frame.
-        start = shift * map.sideCount() / numShifts;
-        end = ++shift * map.sideCount() / numShifts;
-        shift %= numShifts;
+        Sv_VerifyDirtySet(dirty, numSides, "Side", [reg] (dint i)
+        {
+            sidedelta_t delta;
+            return Sv_RegisterCompareSide(reg, duint(i), &delta, false);
+        });
     }
 
-    sidedelta_t delta;
-    for (uint i = start; i < end; ++i)
+    // Deltas are generated in index order.
+    std::sort(dirty.indices.begin(), dirty.indices.end());
+    Sv_CompareRange(0, dirty.indices.size(), batch.sides,
+                    [reg, doUpdate, &dirty] (dsize i, sidedelta_t &delta)
     {
-        if (Sv_RegisterCompareSide(reg, i, &delta, doUpdate))
-        {
-            Sv_AddDeltaToPools(&delta, targets);
-        }
+        return Sv_RegisterCompareSide(reg, duint(dirty.indices[i]), &delta, doUpdate);
+    });
+
+    if (doUpdate)
+    {
+        // The register is now up to date.
+        dirty.clear();
     }
 }
 
 /**
- * Poly deltas are generated for changed polyobjs.
+ * Poly deltas are generated for changed polyobjs. When comparing against the world
+ * register, only the polyobjs moved since the last comparison are checked.
  */
-void Sv_NewPolyDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
+void Sv_NewPolyDeltas(cregister_t *reg, dd_bool doUpdate, deltabatch_t &batch)
 {
     LOG_AS("Sv_NewPolyDeltas");
 
-    polydelta_t delta;
-
     /// @todo fixme: Do not assume the current map.
-    for (int i = 0; i < ServerWorld::get().map().polyobjCount(); ++i)
+    const dint numPolyobjs = ServerWorld::get().map().polyobjCount();
+
+    auto compare = [reg, doUpdate, &batch] (dint i)
     {
+        polydelta_t delta;
         if (Sv_RegisterComparePoly(reg, i, &delta))
         {
             LOGDEV_NET_XVERBOSE_DEBUGONLY("Change in poly %i", i);
 
-            Sv_AddDeltaToPools(&delta, targets);
+            batch.polys << delta;
         }
 
         if (doUpdate)
         {
             Sv_RegisterPoly(&reg->polyObjs[i], i);
         }
+    };
+
+    // When comparing against an initial register, always compare all
+    // polyobjs (since the comparing is only done once, not continuously).
+    if (reg->isInitial)
+    {
+        for (dint i = 0; i < numPolyobjs; ++i) compare(i);
+        return;
+    }
+
+    dirtyset_t &dirty = ::dirtyTracker.polys;
+    if (::fullCompare)
+    {
+        Sv_VerifyDirtySet(dirty, numPolyobjs, "Polyobj", [reg] (dint i)
+        {
+            polydelta_t delta;
+            return Sv_RegisterComparePoly(reg, i, &delta);
+        });
+    }
+
+    // Deltas are generated in index order.
+    std::sort(dirty.indices.begin(), dirty.indices.end());
+    for (dint i : dirty.indices) compare(i);
+
+    if (doUpdate)
+    {
+        // The register is now up to date.
+        dirty.clear();
     }
 }
 
@@ -2404,9 +2808,11 @@ dd_bool Sv_IsFrameTarget(duint plrNum)
 void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, dd_bool doUpdate)
 {
     pool_t* targets[DDMAXPLAYERS + 1], **pool;
+    deltabatch_t batch;
+    Time startedAt;
 
     // Determine the target pools.
-    Sv_GetTargetPools(targets, (clientNumber < 0 ? 0xff : (1 << clientNumber)));
+    const int numTargets = Sv_GetTargetPools(targets, (clientNumber < 0 ? 0xff : (1 << clientNumber)));
 
     // Update the info of the pool owners.
     for (pool = targets; *pool; pool++)
@@ -2415,28 +2821,45 @@ void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, dd_bool doUpdate)
     }
 
     // Generate null deltas (removed mobjs).
-    Sv_NewNullDeltas(reg, doUpdate, targets);
+    Sv_NewNullDeltas(reg, doUpdate, batch);
 
     // Generate mobj deltas.
-    Sv_NewMobjDeltas(reg, doUpdate, targets);
+    Sv_NewMobjDeltas(reg, doUpdate, batch);
 
     // Generate player deltas.
-    Sv_NewPlayerDeltas(reg, doUpdate, targets);
+    Sv_NewPlayerDeltas(reg, doUpdate, targets, batch);
 
     // Generate sector deltas.
-    Sv_NewSectorDeltas(reg, doUpdate, targets);
+    Sv_NewSectorDeltas(reg, doUpdate, batch);
 
     // Generate side deltas.
-    Sv_NewSideDeltas(reg, doUpdate, targets);
+    Sv_NewSideDeltas(reg, doUpdate, batch);
 
     // Generate poly deltas.
-    Sv_NewPolyDeltas(reg, doUpdate, targets);
+    Sv_NewPolyDeltas(reg, doUpdate, batch);
 
     if (doUpdate)
     {
         // The register has now been updated to the current time.
         reg->gametic = SECONDS_TO_TICKS(gameTime);
     }
+
+    ::phaseTimes.compare += startedAt.since();
+    startedAt = Time();
+
+    // Add the new deltas to the pools. Each pool is only accessed by one
+    // worker, and receives the deltas in the order they were generated.
+    TaskPool::parallelFor(0, numTargets, [&targets, &batch] (dsize first, dsize end)
+    {
+        for (dsize i = first; i < end; ++i)
+        {
+            pool_t *pool = targets[i];
+            batch.forAll([pool] (void *delta) { Sv_AddDelta(pool, delta); });
+        }
+    }, (parallelFrames ? 1 : DDMAXPLAYERS), TaskPool::HighPriority);
+
+    ::phaseTimes.merge  += startedAt.since();
+    ::phaseTimes.deltas += batch.size();
 }
 
 /**
@@ -2444,8 +2867,29 @@ void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, dd_bool doUpdate)
  */
 void Sv_GenerateFrameDeltas(void)
 {
+    // Periodically compare everything, in case some changes were not marked dirty.
+    ::fullCompare = (verifyFrames || ++::frameCount % FULL_COMPARE_INTERVAL == 0);
+
     // Generate new deltas for all clients and update the world register.
     Sv_GenerateNewDeltas(&worldRegister, -1, true);
+
+    ::fullCompare = false;
+
+    // Periodically report the time spent in each phase.
+    phasetimes_t &times = ::phaseTimes;
+    times.frames++;
+    if (times.since.since() > PHASE_TIMING_INTERVAL)
+    {
+        LOGDEV_NET_VERBOSE("Average per frame (%i frames, %.1f deltas, %.1f pools): "
+                           "compare %.3f ms, merge %.3f ms, rate %.3f ms")
+            << times.frames
+            << ddouble(times.deltas) / times.frames
+            << ddouble(times.pools) / times.frames
+            << times.compare * 1000 / times.frames
+            << times.merge   * 1000 / times.frames
+            << times.rate    * 1000 / times.frames;
+        times = phasetimes_t();
+    }
 }
 
 /**
@@ -2777,6 +3221,30 @@ void Sv_RatePool(pool_t* pool)
     }
 }
 
+/**
+ * Rates the pools in the NULL-terminated array in parallel (if enabled).
+ *
+ * @see Sv_RatePool()
+ */
+void Sv_RatePools(pool_t** pools)
+{
+    Time startedAt;
+
+    int numPools = 0;
+    while (pools[numPools]) numPools++;
+
+    TaskPool::parallelFor(0, numPools, [pools] (dsize first, dsize end)
+    {
+        for (dsize i = first; i < end; ++i)
+        {
+            Sv_RatePool(pools[i]);
+        }
+    }, (parallelFrames ? 1 : DDMAXPLAYERS), TaskPool::HighPriority);
+
+    ::phaseTimes.rate  += startedAt.since();
+    ::phaseTimes.pools += numPools;
+}
+
 /**
  * Do special things that need to be done when the delta has been acked.
  */
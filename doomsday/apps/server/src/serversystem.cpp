@@ -433,6 +433,8 @@ void Server_Register()
     C_VAR_CHARPTR   ("server-password",         &::netPassword, 0, 0, 0);
     C_VAR_BYTE      ("server-latencies",        &::netShowLatencies, 0, 0, 1);
     C_VAR_INT       ("server-frame-interval",   &::frameInterval, CVF_NO_MAX, 0, 0);
+    C_VAR_BYTE      ("server-frame-parallel",   &::parallelFrames, 0, 0, 1);
+    C_VAR_BYTE      ("server-frame-verify",     &::verifyFrames,   0, 0, 1);
     C_VAR_INT       ("server-player-limit",     &::svMaxPlayers, 0, 0, DDMAXPLAYERS);
 
     C_VAR_CHARPTR   ("net-ip-address", &nptIPAddress, 0, 0, 0);
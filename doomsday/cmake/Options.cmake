@@ -28,6 +28,10 @@ option (DE_FAKE_MEMORY_ZONE
     "(Debug) Replace memory zone allocs with real malloc() calls"
     OFF
 )
+option (DE_ZONE_ARENAS
+    "Allocate from thread-local memory zone arenas by default (-nozonearenas to disable)"
+    OFF
+)
 option (DE_ENABLE_COUNTED_TRACING
     "(Debug) Keep track of where de::Counted objects are allocated"
     OFF
@@ -51,6 +55,10 @@ if (DE_FAKE_MEMORY_ZONE)
     add_definitions (-DDE_FAKE_MEMORY_ZONE=1)
 endif ()
 
+if (DE_ZONE_ARENAS)
+    add_definitions (-DDE_ZONE_ARENAS=1)
+endif ()
+
 if (DE_ENABLE_COUNTED_TRACING)
     add_definitions (-DDE_USE_COUNTED_TRACING=1)
 endif ()
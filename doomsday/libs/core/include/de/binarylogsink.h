@@ -0,0 +1,82 @@
+/** @file binarylogsink.h  Log sink that writes entries in a compact binary format.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBCORE_BINARYLOGSINK_H
+#define LIBCORE_BINARYLOGSINK_H
+
+#include "de/logsink.h"
+#include "de/file.h"
+
+namespace de {
+
+/**
+ * Log sink that writes entries to a File in a compact binary format.
+ *
+ * Entries are not formatted into text. Instead, each entry is written as its
+ * timestamp, metadata bits, and raw arguments. Format strings and sections are
+ * written only once, when first seen, and are afterwards referred to by number.
+ * Use BinaryLogSink::Decoder (or the @em logtool utility) to read the log.
+ *
+ * @ingroup core
+ */
+class DE_PUBLIC BinaryLogSink : public LogSink
+{
+public:
+    /// The data is not a valid binary log. @ingroup errors
+    DE_ERROR(FormatError);
+
+    /**
+     * Reads entries from a binary log.
+     */
+    class DE_PUBLIC Decoder
+    {
+    public:
+        /**
+         * @param log  Contents of a binary log. Must remain valid while the
+         *             decoder is in use.
+         */
+        Decoder(const IByteArray &log);
+
+        /**
+         * Decodes the next entry. Plain text written to the sink is returned as
+         * an entry with a single string argument.
+         *
+         * @return Entry, or @c nullptr if there are no more entries. Caller gets
+         * ownership.
+         */
+        LogEntry *next();
+
+    private:
+        DE_PRIVATE(d)
+    };
+
+public:
+    BinaryLogSink(File &outputFile);
+
+    LogSink &operator << (const LogEntry &entry);
+    LogSink &operator << (const String &plainText);
+
+    void flush();
+
+private:
+    DE_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBCORE_BINARYLOGSINK_H
@@ -1,4 +1,5 @@
 /* Doomsday Script: headers needed to use the scripting engine */
+#include "scripting/bytecode.h"
 #include "scripting/context.h"
 #include "scripting/function.h"
 #include "scripting/process.h"
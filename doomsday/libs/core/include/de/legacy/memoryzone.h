@@ -5,6 +5,8 @@
  * @par Build Options
  * Define the macro @c DE_FAKE_MEMORY_ZONE to force all memory blocks to be
  * allocated from the real heap. Useful when debugging memory-related problems.
+ * Define the macro @c DE_ZONE_ARENAS to allocate from thread-local arenas by
+ * default (see Z_EnableArenas()).
  *
  * @authors Copyright © 1999-2017 Jaakko Keränen <jaakko.keranen@iki.fi>
  * @authors Copyright © 2006-2013 Daniel Swanson <danij@dengine.net>
@@ -63,6 +65,19 @@ extern "C" {
  */
 DE_PUBLIC dd_bool Z_IsInited(void);
 
+/**
+ * Enables or disables the thread-local arenas. When enabled, new allocations are
+ * made from an arena of the calling thread instead of the shared memory volumes,
+ * so threads do not have to wait for each other's allocations. Blocks allocated
+ * in either mode can be used and freed normally after the mode changes.
+ *
+ * The default is set with the "-zonearenas" or "-nozonearenas" option.
+ * Not available when @c DE_FAKE_MEMORY_ZONE is defined.
+ */
+DE_PUBLIC void Z_EnableArenas(dd_bool enable);
+
+DE_PUBLIC dd_bool Z_ArenasEnabled(void);
+
 /**
  * You can pass a NULL user if the tag is < PU_PURGELEVEL.
  */
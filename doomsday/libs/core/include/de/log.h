@@ -613,6 +613,9 @@ public:
 
     const String &format() const { return _format; }
 
+    /// Returns the arguments of the entry, in the order they appear in the format.
+    const Args &args() const { return _args; }
+
     /**
      * Converts the log entry to a string.
      *
@@ -735,8 +738,11 @@ public:
      * @param format     Format template of the entry.
      * @param arguments  List of arguments. The entry is given ownership of
      *                   each Arg instance.
+     *
+     * The entry is given to the log buffer, which may delete it at any time, so no
+     * reference to it is returned.
      */
-    LogEntry &enter(const String &format, LogEntry::Args arguments = LogEntry::Args());
+    void enter(const String &format, LogEntry::Args arguments = LogEntry::Args());
 
     /**
      * Creates a new log entry with the specified log entry level.
@@ -746,7 +752,7 @@ public:
      * @param arguments  List of arguments. The entry is given ownership of
      *                   each Arg instance.
      */
-    LogEntry &enter(duint32 metadata, const String &format, LogEntry::Args arguments = LogEntry::Args());
+    void enter(duint32 metadata, const String &format, LogEntry::Args arguments = LogEntry::Args());
 
 public:
     /**
@@ -36,6 +36,10 @@ class LogSink;
  * central LogBuffer. The buffer is flushed whenever a new entry triggers the
  * flush condition, which means flushing may occur in any thread.
  *
+ * Alternatively, with asynchronous output enabled, new entries are placed in a
+ * bounded lock-free queue and a separate writer thread does all the formatting
+ * and output to sinks. Then adding an entry never blocks.
+ *
  * The application owns an instance of LogBuffer.
  *
  * @ingroup core
@@ -146,6 +150,28 @@ public:
      */
     void enableFlushing(bool yes = true);
 
+    /**
+     * Enables or disables asynchronous output. When enabled, add() places new
+     * entries in a queue without locking the buffer, and a writer thread
+     * periodically flushes them to the sinks. If the queue is full, new entries
+     * are dropped (see droppedEntryCount()). Disabling asynchronous output
+     * stops the writer thread and flushes all queued entries; this is also
+     * done when the buffer is destroyed.
+     *
+     * @param yes            @c true or @c false.
+     * @param queueCapacity  Maximum number of entries waiting to be written.
+     *                       Only used when the queue is first created.
+     */
+    void enableAsyncOutput(bool yes = true, duint queueCapacity = 8192);
+
+    bool isAsyncOutputEnabled() const;
+
+    /**
+     * Returns the total number of entries discarded because the asynchronous
+     * output queue was full.
+     */
+    duint64 droppedEntryCount() const;
+
     /**
      * Sets the interval for autoflushing. Also automatically enables flushing.
      *
@@ -103,6 +103,8 @@ protected:
     String description() const override;
 
 private:
+    friend class RuleGraph;
+
     const Rule *_leftOperand;
     const Rule *_rightOperand;
     const Rule *_condition;
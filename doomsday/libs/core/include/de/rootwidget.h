@@ -25,6 +25,7 @@
 namespace de {
 
 class Rule;
+class RuleGraph;
 class RuleRectangle;
 
 /**
@@ -81,6 +82,30 @@ public:
      */
     Widget *focus() const;
 
+    /**
+     * Enables or disables the rule graph mode. In this mode, the layout rules of the
+     * widget tree are compiled into a RuleGraph and evaluated in a linear pass when
+     * the tree is updated, instead of each rule notifying and updating its
+     * dependents individually. The graph is compiled again whenever the rules have
+     * changed.
+     *
+     * @param enabled  Use the rule graph.
+     */
+    void setRuleGraphEnabled(bool enabled);
+
+    bool isRuleGraphEnabled() const;
+
+    /**
+     * Returns the rule graph, or @c nullptr if the rule graph mode is not enabled.
+     */
+    const RuleGraph *ruleGraph() const;
+
+    /**
+     * Compiles the rule graph if needed, and evaluates the invalid rules. This is
+     * done automatically in update().
+     */
+    void updateRuleGraph();
+
     /**
      * Propagates an event to the full tree of widgets (until it gets eaten).
      *
@@ -103,6 +128,15 @@ public:
      */
     void draw();
 
+protected:
+    /**
+     * Collects the rectangles whose rules are compiled into the rule graph, in
+     * addition to the view rectangle. The default implementation adds nothing.
+     *
+     * @param rects  Rectangles are added here.
+     */
+    virtual void collectRuleRectangles(List<const RuleRectangle *> &rects) const;
+
 private:
     DE_PRIVATE(d)
 };
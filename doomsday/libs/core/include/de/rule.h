@@ -28,6 +28,8 @@
 
 namespace de {
 
+class RuleGraph;
+
 // Declared outside Rule because Rule itself implements the interface.
 DE_DECLARE_AUDIENCE(RuleInvalidation, void ruleInvalidated())
 
@@ -41,6 +43,10 @@ DE_DECLARE_AUDIENCE(RuleInvalidation, void ruleInvalidated())
  * - When a rule is invalid, its current value will be updated (i.e., validated).
  * - Reference counting is used for lifetime management.
  *
+ * A rule may also be evaluated as part of a compiled RuleGraph. In that case, the
+ * graph marks the rule and its dependents invalid and updates their values,
+ * instead of the rules notifying each other.
+ *
  * @ingroup widgets
  */
 class DE_PUBLIC Rule : public Counted, public DE_AUDIENCE_INTERFACE(RuleInvalidation)
@@ -67,11 +73,15 @@ public:
     Rule()
         : _flags(0)
         , _value(0)
+        , _graph(nullptr)
+        , _slot(0)
     {}
 
     explicit Rule(float initialValue)
         : _flags(Valid)
         , _value(initialValue)
+        , _graph(nullptr)
+        , _slot(0)
     {}
 
     /**
@@ -177,8 +187,12 @@ protected:
     int _flags; // Derived rules use this, too.
 
 private:
+    friend class RuleGraph;
+
     PointerSetT<Rule> _dependencies; // ref'd
     float             _value;        // Current value of the rule.
+    RuleGraph *       _graph;        // Compiled graph evaluating the rule (not owned).
+    duint32           _slot;         // Index of the rule in the graph.
 
     static bool _invalidRulesExist;
 };
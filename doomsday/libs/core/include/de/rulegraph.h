@@ -0,0 +1,114 @@
+/** @file rulegraph.h  Compiled graph of layout rules.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBCORE_RULEGRAPH_H
+#define LIBCORE_RULEGRAPH_H
+
+#include "de/rule.h"
+#include "de/list.h"
+
+namespace de {
+
+class RuleRectangle;
+
+/**
+ * Evaluates the rules of a set of RuleRectangles as a flat, compiled graph.
+ *
+ * Compiling collects all the rules that the output rules of the rectangles depend
+ * on, and stores them in a contiguous array in dependency order (dependencies before
+ * dependents). OperatorRule and IndirectRule instances are compiled into simple
+ * instructions that refer to other rules by their index in the array. Other kinds of
+ * rules (ConstantRule, AnimationRule, etc.) are kept as they are; their values are
+ * queried normally when needed.
+ *
+ * When a compiled rule is invalidated, the graph marks it and all the compiled rules
+ * that depend on it as dirty in a bit array, without sending notifications between
+ * rules. Only rules that also have dependents outside the graph notify their
+ * audience. The next time the value of a dirty rule is needed (or update() is
+ * called), the dirty range of the array is evaluated in a single linear pass.
+ *
+ * Compiled rules remain normal Rule instances: their values can be queried and they
+ * can be used in other rules. If the dependencies of a compiled rule change, or a
+ * new rule starts depending on a compiled rule, the graph is discarded and the rules
+ * go back to being evaluated individually until the graph is compiled again.
+ *
+ * The graph holds a reference to each of the rules while compiled.
+ *
+ * @ingroup widgets
+ */
+class DE_PUBLIC RuleGraph
+{
+public:
+    RuleGraph();
+    ~RuleGraph();
+
+    /**
+     * Compiles the rules of a set of rectangles. Any previously compiled rules are
+     * released first. The rules are evaluated immediately.
+     *
+     * @param rects  Rectangles whose output rules are included in the graph.
+     *
+     * @return @c true, if the graph was compiled. Compiling fails if the rules have
+     * circular dependencies.
+     */
+    bool compile(const List<const RuleRectangle *> &rects);
+
+    /**
+     * Releases the compiled rules. The rules are evaluated individually afterwards.
+     */
+    void clear();
+
+    /**
+     * Determines if the graph is compiled. The graph stops being compiled when the
+     * dependencies of the compiled rules change.
+     */
+    bool isCompiled() const;
+
+    /**
+     * Evaluates all the dirty rules. Nothing is done if the graph is not compiled.
+     */
+    void update();
+
+    /**
+     * Returns the total number of rules in the graph.
+     */
+    dsize size() const;
+
+    /**
+     * Returns the number of compiled rules (i.e., rules evaluated by the graph).
+     */
+    dsize compiledCount() const;
+
+    /**
+     * Returns the number of times rules have been evaluated by the graph since it
+     * was last compiled.
+     */
+    duint64 evaluationCount() const;
+
+private:
+    friend class Rule;
+
+    void invalidate(duint32 slot);
+    void structureChanged();
+
+    DE_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBCORE_RULEGRAPH_H
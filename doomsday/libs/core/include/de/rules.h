@@ -23,3 +23,4 @@
 #include "de/operatorrule.h"
 #include "de/animationrule.h"
 #include "de/rulerectangle.h"
+#include "de/rulegraph.h"
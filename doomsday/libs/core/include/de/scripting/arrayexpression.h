@@ -54,6 +54,8 @@ public:
 
     void push(Evaluator &evaluator, Value *scope = 0) const;
 
+    void compile();
+
     /**
      * Returns one of the expressions in the array.
      *
@@ -72,6 +72,8 @@ public:
 
     void push(Evaluator &evaluator, Value *scope = nullptr) const;
 
+    void compile();
+
     Value *evaluate(Evaluator &evaluator) const;
 
     // Implements ISerializable.
@@ -0,0 +1,90 @@
+/** @file bytecode.h  Compiled form of script expressions.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBCORE_BYTECODE_H
+#define LIBCORE_BYTECODE_H
+
+#include "../libcore.h"
+
+namespace de {
+
+class Evaluator;
+class Expression;
+class Value;
+
+/**
+ * Expression compiled into instructions for a register machine.
+ *
+ * Executing bytecode is an alternative to evaluating an expression tree using
+ * the expression and result stacks of Evaluator. Numbers are kept unboxed in
+ * registers, so arithmetic and comparisons do not allocate Values for the
+ * intermediate results, and identifiers are looked up without collecting the
+ * visible namespaces into a list first.
+ *
+ * Only a subset of expressions can be compiled: constants, identifiers that are
+ * evaluated by value, member access, and the arithmetic, comparison, logical,
+ * bitwise, IN and INDEX operators. Everything else (e.g., function calls,
+ * assignments, arrays) is left to the tree interpreter, although their operands
+ * may be compiled separately.
+ *
+ * @see Expression::compile(), Script::compile()
+ *
+ * @ingroup script
+ */
+class DE_PUBLIC Bytecode
+{
+public:
+    ~Bytecode();
+
+    /**
+     * Executes the code.
+     *
+     * @param evaluator  Evaluator whose namespaces are used for looking up
+     *                   identifiers.
+     * @param scope      If the result is a member of another value (the MEMBER
+     *                   operator), the scope value is returned here. Caller gets
+     *                   ownership.
+     *
+     * @return  Result of the expression. Caller gets ownership.
+     */
+    Value *execute(Evaluator &evaluator, Value *&scope) const;
+
+    /**
+     * Returns the number of instructions in the code.
+     */
+    dsize size() const;
+
+    /**
+     * Compiles an expression into bytecode.
+     *
+     * @param expression  Expression to compile.
+     *
+     * @return  Compiled code, or @c nullptr if the expression (or one of its
+     * operands) cannot be compiled. Caller gets ownership.
+     */
+    static Bytecode *compile(const Expression &expression);
+
+private:
+    Bytecode();
+
+    DE_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBCORE_BYTECODE_H
@@ -52,6 +52,8 @@ public:
     /// Skips the catch compound (called only during normal execution).
     void execute(Context &context) const;
 
+    void compile();
+
     bool isFinal() const;
 
     /**
@@ -66,6 +66,11 @@ public:
      */
     void clear();
 
+    /**
+     * Compiles the expressions of all the statements in the compound.
+     */
+    void compile();
+
     // Implements ISerializable.
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
@@ -48,6 +48,9 @@ public:
 
     Value *evaluate(Evaluator &evaluator) const;
 
+    /// Returns the constant value of the expression.
+    const Value &value() const { return *_value; }
+
     // Implements ISerializable.
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
@@ -50,6 +50,8 @@ public:
 
     void push(Evaluator &evaluator, Value *scope = 0) const;
 
+    void compile();
+
     /**
      * Collects the result keys and values of the arguments and puts them
      * into a dictionary.
@@ -28,6 +28,7 @@
 
 namespace de {
 
+class Bytecode;
 class Context;
 class Process;
 class Expression;
@@ -118,6 +119,15 @@ public:
      *                    Evaluator takes ownership of this value.
      */
     void push(const Expression *expression, Value *scope = 0);
+
+    /**
+     * Insert compiled code to the top of the expression stack. The code is
+     * executed as a single step, producing the result of the expression it was
+     * compiled from.
+     *
+     * @param code  Compiled expression.
+     */
+    void push(const Bytecode &code);
     
     /**
      * Push a value onto the result stack.
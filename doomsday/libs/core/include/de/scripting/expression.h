@@ -22,8 +22,11 @@
 
 #include "de/iserializable.h"
 
+#include <memory>
+
 namespace de {
 
+class Bytecode;
 class Evaluator;
 class Value;
 class Record;
@@ -94,6 +97,21 @@ public:
 
     virtual Value *evaluate(Evaluator &evaluator) const = 0;
 
+    /**
+     * Compiles the expression into bytecode, which is then executed instead of
+     * evaluating the expression tree. If the entire expression cannot be
+     * compiled, the operands are compiled individually where possible.
+     *
+     * @see Bytecode
+     */
+    virtual void compile();
+
+    /**
+     * Returns the compiled form of the expression, or @c nullptr if the
+     * expression has not been compiled.
+     */
+    const Bytecode *bytecode() const;
+
     /**
      * Returns the flags of the expression.
      */
@@ -141,6 +159,7 @@ protected:
 
 private:
     Flags _flags;
+    std::unique_ptr<Bytecode> _bytecode;
 };
 
 } // namespace de
@@ -52,6 +52,8 @@ public:
 
     void execute(Context &context) const;
 
+    void compile();
+
     // Implements ISerializable.
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
@@ -25,6 +25,8 @@
 
 namespace de {
 
+class Variable;
+
 /**
  * Responsible for referencing, creating, and deleting variables and record
  * references based an textual identifier.
@@ -55,12 +57,31 @@ public:
     /// Returns the identifier in the name expression.
     const String &identifier() const;
 
+    /// Returns the full identifier sequence. The first element is the scope
+    /// identifier (empty if there is no explicit scope).
+    const StringList &identifierSequence() const;
+
     Value *evaluate(Evaluator &evaluator) const;
 
     // Implements ISerializable.
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
 
+public:
+    /**
+     * Finds a variable in a namespace. If not found directly in @a where, the
+     * records that @a where is derived from (Record::VAR_SUPER) are searched.
+     *
+     * @param name         Name of the variable.
+     * @param where        Namespace to look in.
+     * @param lookInClass  Also look in the super-records.
+     * @param foundIn      The record where the variable was found is returned here.
+     *
+     * @return  Variable, or @c nullptr if not found.
+     */
+    static Variable *findInRecord(const String &name, const Record &where,
+                                  bool lookInClass = true, Record **foundIn = nullptr);
+
 private:
     DE_PRIVATE(d)
 };
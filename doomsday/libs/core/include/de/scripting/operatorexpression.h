@@ -76,8 +76,17 @@ public:
 
     ~OperatorExpression();
 
+    Operator op() const { return _op; }
+
+    /// Returns the left operand, or @c nullptr if the operator is unary.
+    const Expression *leftOperand() const { return _leftOperand; }
+
+    const Expression *rightOperand() const { return _rightOperand; }
+
     void push(Evaluator &evaluator, Value *scope = 0) const;
 
+    void compile();
+
     Value *evaluate(Evaluator &evaluator) const;
 
     /**
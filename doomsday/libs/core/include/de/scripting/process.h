@@ -31,6 +31,7 @@
 #include "../variable.h"
 #include "../recordvalue.h"
 
+#include <functional>
 #include <list>
 
 namespace de {
@@ -305,6 +306,14 @@ public:
      */
     void namespaces(Namespaces &spaces) const;
 
+    /**
+     * Iterates the namespaces currently visible, in the same order as they are
+     * collected by namespaces(), but without allocating a list for them.
+     *
+     * @param func  Called for each namespace.
+     */
+    LoopResult forNamespaces(const std::function<LoopResult (const Evaluator::Namespace &)> &func) const;
+
     /**
      * Returns the global namespace of the process. This is always the bottommost context
      * in the stack.
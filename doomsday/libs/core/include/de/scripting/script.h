@@ -92,6 +92,18 @@ public:
     /// of the script.
     Compound &compound();
 
+    /**
+     * Compiles the expressions of the script into bytecode. This is optional;
+     * compiled expressions are executed by a register machine instead of
+     * being evaluated as expression trees, which is faster but does not change
+     * the results. Expressions that cannot be compiled remain as they are.
+     * The user must ensure that the script is not currently being executed by
+     * a Process.
+     *
+     * @see Bytecode
+     */
+    void compile();
+
 private:
     DE_PRIVATE(d)
 };
@@ -44,6 +44,12 @@ public:
 
     virtual void execute(Context &context) const = 0;
 
+    /**
+     * Compiles the expressions of the statement, including those of any nested
+     * statements. @see Expression::compile()
+     */
+    virtual void compile();
+
     Statement *next() const { return _next; }
 
     void setNext(Statement *statement) { _next = statement; }
@@ -35,6 +35,8 @@ class TryStatement : public Statement
 public:
     void execute(Context &context) const;
 
+    void compile();
+
     Compound &compound() { return _compound; }
 
     // Implements ISerializable.
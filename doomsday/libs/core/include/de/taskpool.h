@@ -19,6 +19,7 @@
 #ifndef LIBCORE_TASKPOOL_H
 #define LIBCORE_TASKPOOL_H
 
+#include "de/list.h"
 #include "de/observers.h"
 #include "de/time.h"
 #include "de/variant.h"
@@ -37,6 +38,13 @@ class Task;
  * TaskPool instance for each group of concurrent tasks whose state needs to be
  * observed as a whole.
  *
+ * The shared pool is a work-stealing scheduler with one worker thread per
+ * available CPU core (minus one for the main thread). Each worker has its own
+ * queue for each priority level; idle workers steal tasks from the other
+ * workers' queues. Higher priority tasks are always picked before lower
+ * priority ones. The number of workers can be set with the "-taskthreads"
+ * command line option.
+ *
  * While TaskPool allows the user to monitor whether all tasks are done and
  * block until that time arrives (TaskPool::waitForDone()), no facilities are
  * provided for interrupting any of the started tasks. If that is required, the
@@ -63,6 +71,15 @@ public:
     };
 
     typedef std::function<void ()> TaskFunction;
+    typedef std::function<void (dsize begin, dsize end)> RangeFunction;
+
+    /// Statistics about one worker thread of the shared pool.
+    struct WorkerStats
+    {
+        dsize   queueDepth; ///< Number of tasks currently queued (all priorities).
+        duint64 executed;   ///< Total number of tasks run by the worker.
+        duint64 steals;     ///< Number of tasks taken from other workers' queues.
+    };
 
     DE_AUDIENCE(Done, void taskPoolDone(TaskPool &))
 
@@ -110,17 +127,42 @@ public:
      */
     bool isDone() const;
 
+    /**
+     * Splits the index range [begin, end) into chunks and calls @a rangeFunc for each
+     * chunk concurrently in the shared pool. Blocks until all chunks have been
+     * processed. The calling thread participates in the work.
+     *
+     * @param begin      First index.
+     * @param end        End of the range (exclusive).
+     * @param rangeFunc  Called with the sub-range [chunkBegin, chunkEnd).
+     * @param grainSize  Minimum number of indices per chunk. Zero means the range is
+     *                   divided evenly according to the number of workers.
+     * @param priority   Priority of the chunk tasks.
+     */
+    static void parallelFor(dsize begin, dsize end, const RangeFunction &rangeFunc,
+                            dsize grainSize = 0, Priority priority = MediumPriority);
+
     /**
      * Use the calling thread to perform queued tasks in any task pool.
      *
      * You should call this instead of sleeping in tasks, so that global thread pool doesn't get
      * blocked by sleeping workers.
      *
-     * @param timeout  How long to wait until queued tasks are available. Zero means to
-     *                 wait indefinitely.
+     * @param timeout  How long to wait until queued tasks are available. Zero means that
+     *                 only an already queued task is run, without waiting.
      */
     static void yield(const TimeSpan timeout);
 
+    /**
+     * Returns the number of worker threads in the shared pool.
+     */
+    static int workerCount();
+
+    /**
+     * Returns current statistics of each worker thread in the shared pool.
+     */
+    static List<WorkerStats> workerStats();
+
     /**
      * Called by de::App at shutdown.
      */
@@ -20,43 +20,295 @@
 #include "de/task.h"
 #include "de/guard.h"
 #include "de/set.h"
+#include "de/string.h"
 #include "de/app.h"
+#include "de/commandline.h"
 #include "de/garbage.h"
 #include "de/lockable.h"
 #include "de/loop.h"
+#include "de/thread.h"
 #include "de/waitable.h"
 
-#include <the_Foundation/threadpool.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace de {
 namespace internal {
 
-static iThreadPool *s_pool = nullptr;
+/**
+ * Work-stealing scheduler that runs the tasks of all TaskPool instances.
+ *
+ * Each worker owns a set of queues, one per priority. A worker pops tasks from the
+ * back of its own queues (most recently queued first, for cache locality) and when
+ * those are empty, steals from the front of the other workers' queues. Priorities
+ * are honored globally: a worker will steal a high priority task from another worker
+ * before running a low priority task of its own.
+ */
+class Scheduler
+{
+public:
+    static constexpr int PRIORITY_COUNT = 3;
+
+    struct Worker : public Thread
+    {
+        Scheduler &      sched;
+        int              index;
+        std::mutex       mutex;
+        std::deque<Task *> queues[PRIORITY_COUNT];
+        std::atomic<duint64> executed{0};
+        std::atomic<duint64> steals{0};
+
+        Worker(Scheduler &s, int i) : sched(s), index(i)
+        {
+            setName(Stringf("TaskWorker%i", i));
+        }
+
+        void push(Task *task, TaskPool::Priority priority)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            queues[priority].push_back(task);
+        }
+
+        Task *popBack(int priority)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            auto &q = queues[priority];
+            if (q.empty()) return nullptr;
+            Task *task = q.back();
+            q.pop_back();
+            return task;
+        }
+
+        Task *popFront(int priority)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            auto &q = queues[priority];
+            if (q.empty()) return nullptr;
+            Task *task = q.front();
+            q.pop_front();
+            return task;
+        }
+
+        dsize queueDepth()
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            dsize depth = 0;
+            for (const auto &q : queues) depth += q.size();
+            return depth;
+        }
+
+        void run() override
+        {
+            sched.workerLoop(*this);
+        }
+    };
+
+    Scheduler()
+    {
+        int count = int(std::thread::hardware_concurrency()) - 1; // main thread
+        if (App::appExists())
+        {
+            const auto &cmdLine = App::commandLine();
+            if (int arg = cmdLine.check("-taskthreads", 1))
+            {
+                count = cmdLine.at(arg + 1).toInt();
+            }
+        }
+        // Always create at least two threads so the pool is useful for running
+        // background tasks.
+        count = de::max(2, count);
+        for (int i = 0; i < count; ++i)
+        {
+            _workers.push_back(new Worker(*this, i));
+        }
+        for (auto *w : _workers) w->start();
+    }
+
+    ~Scheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lk(_idleMutex);
+            _stopping = true;
+        }
+        _idleCond.notify_all();
+        for (auto *w : _workers)
+        {
+            w->join();
+            delete w;
+        }
+    }
+
+    int workerCount() const
+    {
+        return _workers.sizei();
+    }
+
+    List<TaskPool::WorkerStats> stats() const
+    {
+        List<TaskPool::WorkerStats> list;
+        for (auto *w : _workers)
+        {
+            list << TaskPool::WorkerStats{w->queueDepth(), w->executed, w->steals};
+        }
+        return list;
+    }
+
+    void submit(Task *task, TaskPool::Priority priority)
+    {
+        Worker *target;
+        if (s_currentWorker && &s_currentWorker->sched == this)
+        {
+            // Tasks spawned by a worker go to its own queue.
+            target = s_currentWorker;
+        }
+        else
+        {
+            target = _workers.at(int(_nextWorker++ % duint(_workers.size())));
+        }
+        {
+            // The task is counted before it becomes visible to the workers, so that
+            // it cannot be executed (and uncounted) before being counted.
+            std::lock_guard<std::mutex> lk(_idleMutex);
+            _pending++;
+            target->push(task, priority);
+        }
+        _idleCond.notify_one();
+    }
+
+    /**
+     * Finds the next task to run, in priority order. Own queues are checked first
+     * for each priority level, then the other workers' queues.
+     *
+     * @param self  Worker looking for a task. @c nullptr if the calling thread is
+     *              not one of the workers.
+     */
+    Task *take(Worker *self)
+    {
+        const int count = _workers.sizei();
+        const int first = (self ? self->index + 1 : int(_nextVictim++ % duint(count)));
+        for (int prio = TaskPool::HighPriority; prio >= TaskPool::LowPriority; --prio)
+        {
+            if (self)
+            {
+                if (Task *task = self->popBack(prio))
+                {
+                    return task;
+                }
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                Worker *victim = _workers.at((first + i) % count);
+                if (victim == self) continue;
+                if (Task *task = victim->popFront(prio))
+                {
+                    if (self) self->steals++;
+                    return task;
+                }
+            }
+        }
+        return nullptr;
+    }
 
-static iThreadPool *globalThreadPool()
+    void execute(Task *task, Worker *self)
+    {
+        {
+            std::lock_guard<std::mutex> lk(_idleMutex);
+            _pending--;
+        }
+        if (self) self->executed++;
+        task->run();
+    }
+
+    /**
+     * Runs one queued task in the calling thread. If nothing is queued, waits for
+     * at most @a timeout for a task to become available. A zero timeout means that
+     * there is no waiting.
+     *
+     * @return @c true, if a task was run.
+     */
+    bool runPending(TimeSpan timeout)
+    {
+        Worker *self = (s_currentWorker && &s_currentWorker->sched == this ? s_currentWorker
+                                                                           : nullptr);
+        if (Task *task = take(self))
+        {
+            execute(task, self);
+            return true;
+        }
+        if (timeout <= 0.0)
+        {
+            return false;
+        }
+        {
+            std::unique_lock<std::mutex> lk(_idleMutex);
+            _idleCond.wait_for(lk, std::chrono::microseconds(timeout.asMicroSeconds()),
+                               [this]() { return _stopping || _pending > 0; });
+        }
+        if (Task *task = take(self))
+        {
+            execute(task, self);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(Worker &self)
+    {
+        s_currentWorker = &self;
+        for (;;)
+        {
+            if (Task *task = take(&self))
+            {
+                execute(task, &self);
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(_idleMutex);
+            if (_stopping && _pending == 0) break;
+            _idleCond.wait(lk, [this]() { return _stopping || _pending > 0; });
+        }
+        s_currentWorker = nullptr;
+    }
+
+    static bool isWorkerThread()
+    {
+        return s_currentWorker != nullptr;
+    }
+
+private:
+    List<Worker *>          _workers;
+    std::atomic<duint>      _nextWorker{0};
+    std::atomic<duint>      _nextVictim{0};
+    std::mutex              _idleMutex;
+    std::condition_variable _idleCond;
+    dsize                   _pending  = 0;
+    bool                    _stopping = false;
+
+    static thread_local Worker *s_currentWorker;
+};
+
+thread_local Scheduler::Worker *Scheduler::s_currentWorker = nullptr;
+
+static Scheduler *s_scheduler = nullptr;
+static std::mutex s_schedulerMutex;
+
+static Scheduler &globalScheduler()
 {
-    if (!s_pool)
+    std::lock_guard<std::mutex> lk(s_schedulerMutex);
+    if (!s_scheduler)
     {
-        /*
-         * The application is assumed to need a few CPU cores for:
-         *  - rendering/input/UI (main thread; most time-consuming)
-         *  - audio: continuous buffer mixing, streaming
-         *  - timer: triggering timer events
-         *  - networking: receiving and sending data via sockets
-         *
-         * Always create at least two threads so the pool is useful for running background tasks.
-         */
-        s_pool = newLimits_ThreadPool(2, 3);
+        s_scheduler = new Scheduler;
     }
-    return s_pool;
+    return *s_scheduler;
 }
 
 static void deleteThreadPool()
 {
-    if (s_pool)
-    {
-        iRelease(s_pool);
-    }
+    std::lock_guard<std::mutex> lk(s_schedulerMutex);
+    delete s_scheduler;
+    s_scheduler = nullptr;
 }
 
 class CallbackTask : public Task
@@ -225,23 +477,10 @@ TaskPool::~TaskPool()
     }
 }
 
-static iThreadResult runTask(iThread *thd)
-{
-    Task *task = static_cast<Task *>(userData_Thread(thd));
-    task->run();
-    iRelease(thd);
-    return 0;
-}
-
 void TaskPool::start(Task *task, Priority priority)
 {
     d->add(task);
-
-    iThread *thd = new_Thread(runTask);
-    setUserData_Thread(thd, task);
-    run_ThreadPool(internal::globalThreadPool(), thd);
-
-    DE_UNUSED(priority);
+    internal::globalScheduler().submit(task, priority);
 }
 
 void TaskPool::start(TaskFunction taskFunction, Priority priority)
@@ -251,17 +490,9 @@ void TaskPool::start(TaskFunction taskFunction, Priority priority)
 
 void TaskPool::waitForDone()
 {
-    bool allowSleep = true;
-
-    if (const iThread *cur = current_Thread())
-    {
-        if (!cmp_String(name_Thread(cur), "PooledThread"))
-        {
-            // Pooled threads cannot sleep or otherwise the thread pool would likely
-            // block, if too many / all workers are sleeping.
-            allowSleep = false;
-        }
-    }
+    // Pooled threads cannot sleep or otherwise the thread pool would likely
+    // block, if too many / all workers are sleeping.
+    const bool allowSleep = !internal::Scheduler::isWorkerThread();
 
     if (allowSleep)
     {
@@ -273,7 +504,7 @@ void TaskPool::waitForDone()
         // Allow the thread pool to execute other tasks.
         while (!isDone())
         {
-            yield(100_ms);
+            yield(10_ms);
         }
     }
 }
@@ -283,6 +514,54 @@ bool TaskPool::isDone() const
     return d->isEmpty();
 }
 
+void TaskPool::parallelFor(dsize begin, dsize end, const RangeFunction &rangeFunc,
+                           dsize grainSize, Priority priority) // static
+{
+    if (end <= begin) return;
+
+    const dsize total = end - begin;
+    if (!grainSize)
+    {
+        // A few chunks per worker lets idle workers balance the load by stealing.
+        const dsize chunks = dsize(workerCount() + 1) * 4;
+        grainSize = de::max(dsize(1), (total + chunks - 1) / chunks);
+    }
+    if (total <= grainSize)
+    {
+        rangeFunc(begin, end);
+        return;
+    }
+
+    TaskPool pool;
+    for (dsize pos = begin + grainSize; pos < end; pos += grainSize)
+    {
+        const dsize chunkEnd = de::min(end, pos + grainSize);
+        pool.start([&rangeFunc, pos, chunkEnd]() { rangeFunc(pos, chunkEnd); }, priority);
+    }
+    // The calling thread handles the first chunk and then helps with the rest.
+    rangeFunc(begin, begin + grainSize);
+    while (!pool.isDone())
+    {
+        if (!internal::globalScheduler().runPending(1_ms))
+        {
+            if (!internal::Scheduler::isWorkerThread())
+            {
+                pool.waitForDone();
+            }
+        }
+    }
+}
+
+int TaskPool::workerCount() // static
+{
+    return internal::globalScheduler().workerCount();
+}
+
+List<TaskPool::WorkerStats> TaskPool::workerStats() // static
+{
+    return internal::globalScheduler().stats();
+}
+
 void TaskPool::deleteThreadPool() // static
 {
     internal::deleteThreadPool();
@@ -290,7 +569,7 @@ void TaskPool::deleteThreadPool() // static
 
 void TaskPool::yield(const TimeSpan timeout) // static
 {
-    yield_ThreadPool(internal::globalThreadPool(), timeout);
+    internal::globalScheduler().runPending(timeout);
 }
 
 void TaskPool::async(const std::function<Variant()> &work,
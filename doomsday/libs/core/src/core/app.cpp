@@ -21,6 +21,7 @@
 #include "de/app.h"
 #include "de/archivefeed.h"
 #include "de/archivefolder.h"
+#include "de/binarylogsink.h"
 #include "de/block.h"
 #include "de/commandline.h"
 #include "de/config.h"
@@ -134,6 +135,7 @@ DE_PIMPL(App)
     PackageLoader packageLoader;
 
     std::unique_ptr<FileLogSink> errorSink; // Optional sink for warnings/errors (set with "-errors").
+    std::unique_ptr<BinaryLogSink> binaryLogSink; // Optional binary log (set with "-binlog").
 
     Impl(Public *a, const StringList &args)
         : Base(a)
@@ -195,6 +197,11 @@ DE_PIMPL(App)
         {
             logBuffer.removeSink(*errorSink);
         }
+        if (binaryLogSink)
+        {
+            logBuffer.flush();
+            logBuffer.removeSink(*binaryLogSink);
+        }
 
         if (config)
         {
@@ -358,6 +365,12 @@ DE_PIMPL(App)
             errorSink->setMode(LogSink::OnlyWarningEntries);
             logBuffer.addSink(*errorSink);
         }
+        if (CommandLine::ArgWithParams arg = cmdLine.check("-binlog", 1))
+        {
+            File &binlog = self().rootFolder().replaceFile(Path("/home") / arg.params.at(0));
+            binaryLogSink.reset(new BinaryLogSink(binlog));
+            logBuffer.addSink(*binaryLogSink);
+        }
     }
 
     ArchiveFolder &persistPackFolder() const
@@ -843,6 +856,7 @@ void App::initSubsystems(SubsystemInitFlags flags)
 
     // We can start flushing now when the destination is known.
     logBuf.enableFlushing(true);
+    logBuf.enableAsyncOutput(d->config->getb("log.asyncOutput", false));
 
     // Update the wall clock time.
     Time::updateCurrentHighPerformanceTime();
@@ -0,0 +1,240 @@
+/** @file binarylogsink.cpp  Log sink that writes entries in a compact binary format.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/binarylogsink.h"
+#include "de/block.h"
+#include "de/hash.h"
+#include "de/reader.h"
+#include "de/writer.h"
+
+namespace de {
+
+namespace internal {
+
+static const char *BINARYLOG_MAGIC = "DLOG";
+static const duint16 BINARYLOG_VERSION = 1;
+
+/*
+ * Binary log layout (little-endian):
+ *
+ * - Header: magic (4 bytes), version (duint16), start time (Time).
+ * - Records, each starting with a RecordType byte:
+ *   - FormatRecord: String. Defines the next format number.
+ *   - SectionRecord: String. Defines the next section number.
+ *   - EntryRecord: microseconds since start (dint64), metadata (duint32),
+ *     format number (duint32), section number (duint32), section depth (dbyte),
+ *     entry flags (duint32), argument count (dbyte), arguments (LogEntry::Arg).
+ *   - TextRecord: String.
+ */
+enum BinaryLogRecordType : dbyte {
+    FormatRecord,
+    SectionRecord,
+    EntryRecord,
+    TextRecord,
+};
+
+} // namespace internal
+
+using namespace internal;
+
+DE_PIMPL_NOREF(BinaryLogSink)
+{
+    SafePtr<File> file;
+    Block buffer;
+    Time startedAt;
+    Hash<String, duint32> formats;
+    Hash<String, duint32> sections;
+
+    /**
+     * Returns the number of a string, writing its definition first if this
+     * is the first time it is seen.
+     */
+    duint32 intern(Hash<String, duint32> &strings, BinaryLogRecordType defType,
+                   const String &text, Writer &out)
+    {
+        auto found = strings.find(text);
+        if (found != strings.end()) return found->second;
+
+        const duint32 number = duint32(strings.size());
+        strings.insert(text, number);
+        out << dbyte(defType) << text;
+        return number;
+    }
+};
+
+BinaryLogSink::BinaryLogSink(File &outputFile)
+    : d(new Impl)
+{
+    d->file = &outputFile;
+
+    Writer out(d->buffer);
+    out.writeBytes(Block(BINARYLOG_MAGIC, 4))
+       << BINARYLOG_VERSION
+       << d->startedAt;
+}
+
+LogSink &BinaryLogSink::operator << (const LogEntry &entry)
+{
+    Writer out(d->buffer, d->buffer.size());
+
+    const duint32 format  = d->intern(d->formats,  FormatRecord,  entry.format(),  out);
+    const duint32 section = d->intern(d->sections, SectionRecord, entry.section(), out);
+
+    out << dbyte(EntryRecord)
+        << dint64((entry.when() - d->startedAt) * 1.0e6)
+        << entry.metadata()
+        << format
+        << section
+        << dbyte(entry.sectionDepth())
+        << duint32(entry.flags())
+        << dbyte(entry.args().size());
+    for (const LogEntry::Arg *arg : entry.args())
+    {
+        out << *arg;
+    }
+    return *this;
+}
+
+LogSink &BinaryLogSink::operator << (const String &plainText)
+{
+    Writer(d->buffer, d->buffer.size()) << dbyte(TextRecord) << plainText;
+    return *this;
+}
+
+void BinaryLogSink::flush()
+{
+    if (d->file && !d->buffer.isEmpty())
+    {
+        *d->file << d->buffer;
+        d->file->flush();
+    }
+    d->buffer.clear();
+}
+
+//---------------------------------------------------------------------------------------
+
+DE_PIMPL_NOREF(BinaryLogSink::Decoder)
+{
+    Reader reader;
+    Time startedAt;
+    Time latest;
+    StringList formats;
+    StringList sections;
+
+    Impl(const IByteArray &log) : reader(log)
+    {
+        Block magic;
+        duint16 version = 0;
+        if (log.size() >= 4)
+        {
+            reader.readBytes(4, magic);
+            reader >> version;
+        }
+        if (magic != Block(BINARYLOG_MAGIC, 4) || version != BINARYLOG_VERSION)
+        {
+            throw FormatError("BinaryLogSink::Decoder", "Data is not a binary log");
+        }
+        reader >> startedAt;
+        latest = startedAt;
+    }
+
+    const String &lookup(const StringList &strings, duint32 number) const
+    {
+        if (number >= strings.size())
+        {
+            throw FormatError("BinaryLogSink::Decoder",
+                              Stringf("Undefined string %u", number));
+        }
+        return strings.at(number);
+    }
+
+    /// Composes an entry in the serialized form of LogEntry and deserializes it.
+    static LogEntry *makeEntry(const Time &when, const String &section, const String &format,
+                               duint32 metadata, dbyte sectionDepth, duint32 flags,
+                               const LogEntry::Args &args)
+    {
+        Block data;
+        Writer out(data);
+        out << when << section << format << metadata << sectionDepth << flags;
+        out.writeObjects(args);
+
+        std::unique_ptr<LogEntry> entry(new LogEntry);
+        Reader(data) >> *entry;
+        return entry.release();
+    }
+
+    LogEntry *next()
+    {
+        while (!reader.atEnd())
+        {
+            dbyte type;
+            reader >> type;
+            switch (type)
+            {
+            case FormatRecord:
+            case SectionRecord: {
+                String text;
+                reader >> text;
+                (type == FormatRecord ? formats : sections) << text;
+                break; }
+
+            case EntryRecord: {
+                dint64 micros;
+                duint32 metadata, format, section, flags;
+                dbyte depth, argCount;
+                reader >> micros >> metadata >> format >> section >> depth >> flags >> argCount;
+                LogEntry::Args args;
+                for (int i = 0; i < argCount; ++i)
+                {
+                    args << LogEntry::Arg::newFromPool();
+                    reader >> *args.last();
+                }
+                latest = startedAt + TimeSpan(micros / 1.0e6);
+                LogEntry *entry = makeEntry(latest, lookup(sections, section),
+                                            lookup(formats, format), metadata, depth, flags,
+                                            args);
+                for (auto *arg : args) LogEntry::Arg::returnToPool(arg);
+                return entry; }
+
+            case TextRecord: {
+                String text;
+                reader >> text;
+                LogEntry::Arg arg;
+                arg.setValue(text);
+                return makeEntry(latest, "", "%s", LogEntry::Generic | LogEntry::Message, 0,
+                                 LogEntry::Simple, LogEntry::Args({&arg})); }
+
+            default:
+                throw FormatError("BinaryLogSink::Decoder",
+                                  Stringf("Unknown record type %i", type));
+            }
+        }
+        return nullptr;
+    }
+};
+
+BinaryLogSink::Decoder::Decoder(const IByteArray &log)
+    : d(new Impl(log))
+{}
+
+LogEntry *BinaryLogSink::Decoder::next()
+{
+    return d->next();
+}
+
+} // namespace de
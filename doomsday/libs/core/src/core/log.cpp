@@ -608,21 +608,14 @@ DE_PIMPL_NOREF(Log)
 {
     typedef std::vector<const char *> SectionStack;
     SectionStack sectionStack;
-    LogEntry *throwawayEntry;
     duint32 currentEntryMedata; ///< Applies to the current entry being staged in the thread.
     int interactive = 0;
 
     Impl()
-        : throwawayEntry(new LogEntry) ///< A disabled LogEntry, so doesn't accept arguments.
-        , currentEntryMedata(0)
+        : currentEntryMedata(0)
     {
         sectionStack.push_back(MAIN_SECTION);
     }
-
-    ~Impl()
-    {
-        delete throwawayEntry;
-    }
 };
 
 Log::Log() : d(new Impl)
@@ -673,12 +666,12 @@ bool Log::isInteractive() const
     return d->interactive > 0;
 }
 
-LogEntry &Log::enter(const String &format, LogEntry::Args arguments)
+void Log::enter(const String &format, LogEntry::Args arguments)
 {
-    return enter(LogEntry::Message, format, arguments);
+    enter(LogEntry::Message, format, arguments);
 }
 
-LogEntry &Log::enter(duint32 metadata, const String &format, LogEntry::Args arguments)
+void Log::enter(duint32 metadata, const String &format, LogEntry::Args arguments)
 {
     // Staging done.
     d->currentEntryMedata = 0;
@@ -694,7 +687,7 @@ LogEntry &Log::enter(duint32 metadata, const String &format, LogEntry::Args argu
         DE_ASSERT(arguments.isEmpty());
 
         // If the level is disabled, no messages are entered into it.
-        return *d->throwawayEntry;
+        return;
     }
 
     // Collect the sections.
@@ -720,10 +713,9 @@ LogEntry &Log::enter(duint32 metadata, const String &format, LogEntry::Args argu
     // Make a new entry.
     LogEntry *entry = new LogEntry(metadata, context, depth, format, arguments);
 
-    // Add it to the application's buffer. The buffer gets ownership.
+    // Add it to the application's buffer. The buffer gets ownership, and the entry
+    // may be deleted at any time after this (e.g., by the flushing thread).
     LogBuffer::get().add(entry);
-
-    return *entry;
 }
 
 /*static internal::Logs &theLogs()
@@ -27,15 +27,119 @@
 #include "de/logsink.h"
 #include "de/logfilter.h"
 #include "de/textstreamlogsink.h"
+#include "de/thread.h"
 #include "de/timer.h"
 #include "de/writer.h"
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 namespace de {
 
 const TimeSpan FLUSH_INTERVAL = .2; // seconds
 
+namespace internal {
+
+/**
+ * Bounded queue of log entries with any number of producers and a single
+ * consumer. Adding never blocks or allocates: when the queue is full, the entry
+ * is rejected. Each cell has a sequence number that tells whether it is ready
+ * to be written or read on the current lap around the ring.
+ */
+class LogEntryQueue
+{
+public:
+    LogEntryQueue(duint capacity)
+    {
+        dsize size = 2;
+        while (size < capacity) size <<= 1;
+        _cells.reset(new Cell[size]);
+        _mask = size - 1;
+        for (dsize i = 0; i < size; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    dsize capacity() const
+    {
+        return _mask + 1;
+    }
+
+    /**
+     * Attempts to add an entry to the queue. Can be called from any thread.
+     *
+     * @param entry     Entry to add. Ownership is given to the queue if
+     *                  successfully added.
+     * @param position  Running number of the entry is written here.
+     *
+     * @return @c true, if the entry was added; @c false if the queue is full.
+     */
+    bool tryPush(LogEntry *entry, dsize &position)
+    {
+        dsize pos = _tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = _cells[pos & _mask];
+            const dsize seq = cell.sequence.load(std::memory_order_acquire);
+            const dsigsize diff = dsigsize(seq) - dsigsize(pos);
+            if (diff == 0)
+            {
+                // The cell is free on this lap; try to claim it.
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.entry = entry;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    position = pos;
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Full.
+            }
+            else
+            {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Takes the oldest entry from the queue. Only one thread at a time may
+     * call this.
+     *
+     * @return Entry (ownership given to the caller), or @c nullptr if the queue
+     * is empty or the oldest entry is still being added.
+     */
+    LogEntry *tryPop()
+    {
+        Cell &cell = _cells[_head & _mask];
+        const dsize seq = cell.sequence.load(std::memory_order_acquire);
+        if (dsigsize(seq) - dsigsize(_head + 1) < 0)
+        {
+            return nullptr;
+        }
+        LogEntry *entry = cell.entry;
+        cell.sequence.store(_head + _mask + 1, std::memory_order_release);
+        ++_head;
+        return entry;
+    }
+
+private:
+    struct Cell {
+        std::atomic<dsize> sequence;
+        LogEntry *entry = nullptr;
+    };
+    std::unique_ptr<Cell[]> _cells;
+    dsize _mask;
+    alignas(64) std::atomic<dsize> _tail{0};
+    alignas(64) dsize _head = 0;
+};
+
+} // namespace internal
+
 DE_PIMPL(LogBuffer)
 {
     typedef List<LogEntry *> EntryList;
@@ -61,6 +165,46 @@ DE_PIMPL(LogBuffer)
     std::unique_ptr<Timer> autoFlushTimer;
     Sinks sinks;
 
+    /**
+     * Thread that writes queued entries to the sinks when asynchronous output
+     * is enabled.
+     */
+    struct Writer : public Thread
+    {
+        LogBuffer &buffer;
+        const Waitable &wakeUp;
+        std::atomic_bool running{true};
+
+        Writer(LogBuffer &buf, const Waitable &wake) : buffer(buf), wakeUp(wake)
+        {
+            setName("LogBuffer::Writer");
+        }
+
+        void run() override
+        {
+            while (running)
+            {
+                wakeUp.tryWait(FLUSH_INTERVAL);
+                buffer.flush();
+            }
+        }
+
+        void stop()
+        {
+            running = false;
+            wakeUp.post();
+            join();
+        }
+    };
+
+    std::atomic_bool asyncOutput{false};
+    std::atomic_int asyncProducers{0}; ///< Threads currently pushing to the queue.
+    std::unique_ptr<internal::LogEntryQueue> queue; // kept once created
+    std::unique_ptr<Writer> writer;
+    Waitable writerWakeUp;
+    std::atomic<duint64> droppedCount{0};
+    duint64 reportedDroppedCount = 0;
+
     Impl(Public *i, duint maxEntryCount)
         : Base(i)
         , entryFilter(&defaultFilter)
@@ -89,9 +233,38 @@ DE_PIMPL(LogBuffer)
     ~Impl()
     {
         if (autoFlushTimer) autoFlushTimer->stop();
+        asyncOutput = false;
+        stopWriter();
+        if (queue)
+        {
+            while (LogEntry *entry = queue->tryPop()) delete entry;
+        }
         delete fileLogSink;
     }
 
+    void stopWriter()
+    {
+        if (writer)
+        {
+            writer->stop();
+            writer.reset();
+        }
+    }
+
+    /**
+     * Moves entries from the asynchronous queue into the buffer. The buffer
+     * must be locked, which makes the caller the single consumer of the queue.
+     */
+    void takeQueuedEntries()
+    {
+        if (!queue) return;
+        while (LogEntry *entry = queue->tryPop())
+        {
+            entries.push_back(entry);
+            toBeFlushed.push_back(entry);
+        }
+    }
+
     void enableAutoFlush(bool yes)
     {
         DE_ASSERT(App::appExists());
@@ -157,6 +330,9 @@ LogBuffer::LogBuffer(duint maxEntryCount)
 
 LogBuffer::~LogBuffer()
 {
+    // Queued entries are written out below.
+    d->stopWriter();
+
     DE_GUARD(this);
 
     setOutputFile("");
@@ -229,6 +405,35 @@ void LogBuffer::setMaxEntryCount(duint maxEntryCount)
 
 void LogBuffer::add(LogEntry *entry)
 {
+    if (d->asyncOutput)
+    {
+        // Asynchronous output is checked again after announcing the push, so that
+        // switching it off can wait until no more entries are being queued.
+        d->asyncProducers++;
+        if (d->asyncOutput)
+        {
+            // The writer thread takes care of the rest without the producer having
+            // to lock the buffer.
+            dsize position;
+            if (d->queue->tryPush(entry, position))
+            {
+                // Wake up the writer before the queue gets full.
+                if ((position & (d->queue->capacity() / 2 - 1)) == 0)
+                {
+                    d->writerWakeUp.post();
+                }
+            }
+            else
+            {
+                d->droppedCount++;
+                delete entry;
+            }
+            d->asyncProducers--;
+            return;
+        }
+        d->asyncProducers--;
+    }
+
     DE_GUARD(this);
 
     // We will not flush the new entry as it likely has not yet been given
@@ -258,6 +463,52 @@ void LogBuffer::enableFlushing(bool yes)
     d->enableAutoFlush(true);
 }
 
+void LogBuffer::enableAsyncOutput(bool yes, duint queueCapacity)
+{
+    if (yes == d->asyncOutput) return;
+
+    if (yes)
+    {
+        DE_GUARD(this);
+        if (!d->queue)
+        {
+            d->queue.reset(new internal::LogEntryQueue(queueCapacity));
+        }
+        d->writer.reset(new Impl::Writer(*this, d->writerWakeUp));
+        d->writer->start();
+        d->asyncOutput = true;
+    }
+    else
+    {
+        // Entries queued until the switch are taken by the final flush below.
+        d->stopWriter();
+
+        // Producers that are not queueing entries any more will add them directly
+        // to the buffer, which is locked until the queue has been drained. This
+        // keeps the entries in order.
+        DE_GUARD(this);
+        d->asyncOutput = false;
+        while (d->asyncProducers > 0)
+        {
+            std::this_thread::yield();
+        }
+        d->takeQueuedEntries();
+
+        // Write everything that was still queued.
+        flush();
+    }
+}
+
+bool LogBuffer::isAsyncOutputEnabled() const
+{
+    return d->asyncOutput;
+}
+
+duint64 LogBuffer::droppedEntryCount() const
+{
+    return d->droppedCount;
+}
+
 void LogBuffer::setAutoFlushInterval(TimeSpan interval)
 {
     enableFlushing();
@@ -304,6 +555,8 @@ void LogBuffer::flush()
 
     DE_GUARD(this);
 
+    d->takeQueuedEntries();
+
     if (!d->toBeFlushed.isEmpty())
     {
         for (const auto *entry : d->toBeFlushed)
@@ -328,6 +581,17 @@ void LogBuffer::flush()
         }
         d->toBeFlushed.clear();
 
+        const duint64 dropped = d->droppedCount;
+        if (dropped != d->reportedDroppedCount)
+        {
+            for (LogSink *sink : d->sinks)
+            {
+                *sink << Stringf("(%llu log entries were dropped because the output queue was full)",
+                                 (unsigned long long) (dropped - d->reportedDroppedCount));
+            }
+            d->reportedDroppedCount = dropped;
+        }
+
         // Make sure everything really gets written now.
         for (LogSink *sink : d->sinks) sink->flush();
     }
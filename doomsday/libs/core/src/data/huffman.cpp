@@ -5,6 +5,10 @@
  * Uses predetermined, fixed frequencies optimized for short (size < 128)
  * messages.
  *
+ * Encoding appends whole codes to a 64-bit accumulator and writes the output
+ * a word at a time. Decoding uses a lookup table that yields several symbols
+ * per step; only codes longer than the table index are decoded bit by bit.
+ *
  * @authors Copyright © 2003-2017 Jaakko Keränen <jaakko.keranen@iki.fi>
  * @authors Copyright © 2006-2013 Daniel Swanson <danij@dengine.net>
  *
@@ -25,13 +29,18 @@
 #include "de/huffman.h"
 #include "de/app.h"
 #include "de/log.h"
-#include "de/byterefarray.h"
+
+#include <cstring>
 
 // Heap relations.
 #define HEAP_PARENT(i)  (((i) + 1)/2 - 1)
 #define HEAP_LEFT(i)    (2*(i) + 1)
 #define HEAP_RIGHT(i)   (2*(i) + 2)
 
+// Decoding looks up this many bits of input at a time.
+#define DECODE_TABLE_BITS   11
+#define DECODE_MAX_SYMBOLS  4
+
 namespace de {
 
 namespace internal {
@@ -111,6 +120,8 @@ struct HuffNode {
     HuffNode *left, *right;
     double freq;
     dbyte value;              // Only valid for leaves.
+
+    inline bool isLeaf() const { return !left && !right; }
 };
 
 struct HuffQueue {
@@ -123,11 +134,37 @@ struct HuffCode {
     duint length;
 };
 
-struct HuffBuffer {
-    dbyte *data;
-    dsize size;
+/**
+ * Entry of the decoding lookup table. The table is indexed with the next
+ * DECODE_TABLE_BITS bits of input, and each entry tells which whole codes
+ * (up to DECODE_MAX_SYMBOLS of them) those bits contain.
+ */
+struct HuffDecodeEntry {
+    dbyte count;                        // Zero if the first code is longer than the index.
+    dbyte endBit[DECODE_MAX_SYMBOLS];   // Bits consumed after each symbol.
+    dbyte symbols[DECODE_MAX_SYMBOLS];
+    const HuffNode *node;               // Where to continue when @c count is zero.
 };
 
+/**
+ * Returns the bitstream starting at @a bitPos (first bit in the LSB). Bits past
+ * the end of the data are zero. At least 57 bits are valid.
+ */
+static inline duint64 Huff_PeekBits(const dbyte *data, dsize size, dsize bitPos)
+{
+    const dsize at = bitPos >> 3;
+    duint64 word = 0;
+    if (at + 8 <= size)
+    {
+        for (int k = 0; k < 8; ++k) word |= duint64(data[at + k]) << (8 * k);
+    }
+    else
+    {
+        for (int k = 0; at + k < size; ++k) word |= duint64(data[at + k]) << (8 * k);
+    }
+    return word >> (bitPos & 7);
+}
+
 struct Huffman
 {
     // The root of the Huffman tree.
@@ -135,11 +172,16 @@ struct Huffman
 
     // The lookup table for encoding.
     HuffCode huffCodes[256];
+    duint minCodeLength;
+    duint maxCodeLength;
+
+    // The lookup table for decoding.
+    HuffDecodeEntry decodeTable[1 << DECODE_TABLE_BITS];
 
     /**
-     * Builds the Huffman tree and initializes the code lookup.
+     * Builds the Huffman tree and initializes the code lookups.
      */
-    Huffman() : huffRoot(0)
+    Huffman() : huffRoot(0), minCodeLength(32), maxCodeLength(0)
     {
         zap(huffCodes);
 
@@ -171,32 +213,9 @@ struct Huffman
         // The root is the last node left in the queue.
         huffRoot = Huff_QueueExtract(&queue);
 
-        // Fill in the code lookup table.
+        // Fill in the code lookup tables.
         Huff_BuildLookup(huffRoot, 0, 0);
-
-#if 0
-        if (qApp->arguments().contains("-huffcodes"))
-        {
-            double realBits = 0;
-            double huffBits = 0;
-
-            LOG_MSG("Huffman codes:");
-            for (i = 0; i < 256; ++i)
-            {
-                uint k;
-                realBits += freqs[i] * 8;
-                huffBits += freqs[i] * huffCodes[i].length;
-                LOG_MSG("%03i: (%07i) ", i, (int) (6e6 * freqs[i]));
-                for (k = 0; k < huffCodes[i].length; ++k)
-                {
-                    LogBuffer_Printf(0, "%c", huffCodes[i].code & (1 << k) ? '1' : '0');
-                }
-                LogBuffer_Printf(0, "\n");
-            }
-            LOG_MSG("realbits=%f, huffbits=%f (%f%%)")
-                    << realBits <<huffBits << huffBits / realBits * 100;
-        }
-#endif
+        Huff_BuildDecodeTable();
     }
 
     /**
@@ -302,11 +321,13 @@ struct Huffman
      */
     void Huff_BuildLookup(HuffNode *node, uint code, uint length)
     {
-        if (!node->left && !node->right)
+        if (node->isLeaf())
         {
             // This is a leaf.
             huffCodes[node->value].code = code;
             huffCodes[node->value].length = length;
+            minCodeLength = std::min(minCodeLength, length);
+            maxCodeLength = std::max(maxCodeLength, length);
             return;
         }
 
@@ -327,19 +348,37 @@ struct Huffman
     }
 
     /**
-     * Checks if the encoding/decoding buffer can hold the given number of
-     * bytes. If not, reallocates the buffer.
+     * Fills in the decoding table by walking the tree for every possible
+     * DECODE_TABLE_BITS-bit input.
      */
-    static void Huff_ResizeBuffer(HuffBuffer *buffer, dsize neededSize)
+    void Huff_BuildDecodeTable()
     {
-        while (neededSize > buffer->size)
+        for (duint index = 0; index < (1u << DECODE_TABLE_BITS); ++index)
         {
-            if (!buffer->size)
-                buffer->size = std::max(dsize(1024), neededSize);
-            else
-                buffer->size *= 2;
+            HuffDecodeEntry &entry = decodeTable[index];
+            zap(entry);
+
+            duint consumed = 0;
+            while (entry.count < DECODE_MAX_SYMBOLS)
+            {
+                const HuffNode *node = huffRoot;
+                duint bit = consumed;
+                while (!node->isLeaf() && bit < DECODE_TABLE_BITS)
+                {
+                    node = (index & (1u << bit++)) ? node->right : node->left;
+                }
+                if (!node->isLeaf())
+                {
+                    // The rest of the bits don't make up a whole code.
+                    if (!entry.count) entry.node = node;
+                    break;
+                }
+                entry.symbols[entry.count] = node->value;
+                entry.endBit [entry.count] = dbyte(bit);
+                entry.count++;
+                consumed = bit;
+            }
         }
-        buffer->data = reinterpret_cast<dbyte *>(realloc(buffer->data, buffer->size));
     }
 
     /**
@@ -355,146 +394,107 @@ struct Huffman
         }
     }
 
-    /**
-     * Free the buffer.
-     */
-    void Huff_DestroyBuffer(HuffBuffer *buffer)
-    {
-        free(buffer->data);
-        zapPtr(buffer);
-    }
-
-    dbyte *encode(const dbyte *data, dsize size, dsize *encodedSize) const
+    Block encode(const dbyte *data, dsize size) const
     {
-        HuffBuffer huffEnc;
-        dsize i;
-        duint code;
-        int remaining, fits;
-        dbyte *out, bit;
-
-        zap(huffEnc);
-
-        // The encoded message is never twice the original size
-        // (longest codes are currently 11 bits).
-        Huff_ResizeBuffer(&huffEnc, 2 * size);
+        // Enough room for the longest codes, plus one word of slack.
+        Block encoded((3 + size * maxCodeLength + 7) / 8 + 4);
+        dbyte *out = encoded.data();
+        dbyte *const start = out;
 
         // First three bits of the encoded data contain the number of bits (-1)
-        // in the last dbyte of the encoded data. It's written when we have
+        // in the last byte of the encoded data. It's written when we have
         // finished the encoding.
-        bit = 3;
-
-        // Clear the first dbyte of the result.
-        out = huffEnc.data;
-        *out = 0;
+        duint64 acc = 0;
+        duint accBits = 3;
 
-        for (i = 0; i < size; ++i)
+        for (const dbyte *in = data, *end = data + size; in != end; ++in)
         {
-            remaining = huffCodes[data[i]].length;
-            code = huffCodes[data[i]].code;
+            const HuffCode &hc = huffCodes[*in];
+            acc |= duint64(hc.code) << accBits;
+            accBits += hc.length;
 
-            while (remaining > 0)
+            // Write out full words.
+            if (accBits >= 32)
             {
-                fits = 8 - bit;
-                if (fits > remaining)
-                    fits = remaining;
-
-                // Write the bits that fit the current dbyte.
-                *out |= code << bit;
-                code >>= fits;
-                remaining -= fits;
-
-                // Advance the bit position.
-                bit += fits;
-                if (bit == 8)
-                {
-                    bit = 0;
-                    *++out = 0;
-                }
+                out[0] = dbyte(acc);
+                out[1] = dbyte(acc >> 8);
+                out[2] = dbyte(acc >> 16);
+                out[3] = dbyte(acc >> 24);
+                out += 4;
+                acc >>= 32;
+                accBits -= 32;
             }
         }
 
-        // If the last dbyte is empty, back up.
-        if (bit == 0)
+        // Write out the remaining bits. An empty message still has the header.
+        const dsize totalBits = dsize(out - start) * 8 + accBits;
+        const dsize totalBytes = (totalBits + 7) / 8;
+        for (; out - start < dint(totalBytes); acc >>= 8)
         {
-            out--;
-            bit = 8;
+            *out++ = dbyte(acc);
         }
 
-        if (encodedSize)
-            *encodedSize = out - huffEnc.data + 1;
+        // The number of valid bits - 1 in the last byte.
+        start[0] |= dbyte(totalBits - (totalBytes - 1) * 8 - 1);
 
-        // The number of valid bits - 1 in the last dbyte.
-        huffEnc.data[0] |= bit - 1;
-
-        return huffEnc.data;
+        encoded.resize(totalBytes);
+        return encoded;
     }
 
-    dbyte *decode(const dbyte *data, dsize size, dsize *decodedSize) const
+    Block decode(const dbyte *data, dsize size) const
     {
-        HuffBuffer huffDec;
-        HuffNode *node;
-        dsize outBytes = 0;
-        const dbyte *in = data;
-        const dbyte *lastIn = in + size - 1;
-        dbyte bit = 3, lastByteBits;
+        if (!data || size == 0) return Block();
 
-        if (!data || size == 0) return nullptr;
+        // The first three bits contain the number of valid bits in the last byte.
+        const dsize endBit = (size - 1) * 8 + (*data & 7) + 1;
+        if (endBit <= 3) return Block();
 
-        zap(huffDec);
-        Huff_ResizeBuffer(&huffDec, 256);
+        // Each code is at least minCodeLength bits long.
+        Block decoded((endBit - 3) / minCodeLength + DECODE_MAX_SYMBOLS);
+        dbyte *out = decoded.data();
+        dbyte *const start = out;
 
-        // The first three bits contain the number of valid bits in
-        // the last dbyte.
-        lastByteBits = (*in & 7) + 1;
-
-        // Start from the root node.
-        node = huffRoot;
-
-        while (in < lastIn || bit < lastByteBits)
+        dsize pos = 3;
+        while (pos < endBit)
         {
-            // Go left or right?
-            if (*in & (1 << bit))
-            {
-                node = node->right;
-            }
-            else
-            {
-                node = node->left;
-            }
+            const duint64 window = Huff_PeekBits(data, size, pos);
+            const HuffDecodeEntry &entry = decodeTable[window & ((1u << DECODE_TABLE_BITS) - 1)];
 
-            // Did we arrive at a leaf?
-            DE_ASSERT(node);
-            if (!node->left && !node->right)
+            if (entry.count)
             {
-                // This node represents a value.
-                huffDec.data[outBytes++] = node->value;
-
-                // Should we allocate more memory?
-                if (outBytes == huffDec.size)
+                if (pos + entry.endBit[entry.count - 1] <= endBit)
                 {
-                    Huff_ResizeBuffer(&huffDec, 2 * huffDec.size);
+                    // There is always room for DECODE_MAX_SYMBOLS more.
+                    std::memcpy(out, entry.symbols, DECODE_MAX_SYMBOLS);
+                    out += entry.count;
+                    pos += entry.endBit[entry.count - 1];
+                    continue;
                 }
-
-                // Back to the root.
-                node = huffRoot;
+                // Near the end; a partial code at the end is ignored.
+                for (int k = 0; k < entry.count && pos + entry.endBit[k] <= endBit; ++k)
+                {
+                    *out++ = entry.symbols[k];
+                }
+                break;
             }
 
-            // Advance bit position.
-            if (++bit == 8)
+            // A long code: continue down the tree one bit at a time.
+            const HuffNode *node = entry.node;
+            dsize bit = pos + DECODE_TABLE_BITS;
+            duint64 bits = window >> DECODE_TABLE_BITS;
+            while (!node->isLeaf() && bit < endBit)
             {
-                bit = 0;
-                ++in;
-
-                // Out of buffer?
-                if (in > lastIn)
-                    break;
+                node = (bits & 1) ? node->right : node->left;
+                bits >>= 1;
+                ++bit;
             }
+            if (!node->isLeaf()) break; // Ran out of input.
+            *out++ = node->value;
+            pos = bit;
         }
-        if (decodedSize)
-        {
-            *decodedSize = outBytes;
-        }
-        return huffDec.data;
+
+        decoded.resize(dsize(out - start));
+        return decoded;
     }
 };
 
@@ -504,28 +504,12 @@ static internal::Huffman huff;
 
 Block codec::huffmanEncode(const Block &data)
 {
-    Block result;
-    dsize size = 0;
-    dbyte *coded = huff.encode(data.data(), data.size(), &size);
-    if (coded)
-    {
-        result.copyFrom(ByteRefArray(coded, size), 0, size);
-        free(coded);
-    }
-    return result;
+    return huff.encode(data.data(), data.size());
 }
 
 Block codec::huffmanDecode(const Block &codedData)
 {
-    Block result;
-    dsize size = 0;
-    dbyte *decoded = huff.decode(codedData.data(), codedData.size(), &size);
-    if (decoded)
-    {
-        result.copyFrom(ByteRefArray(decoded, size), 0, size);
-        free(decoded);
-    }
-    return result;
+    return huff.decode(codedData.data(), codedData.size());
 }
 
 } // namespace de
@@ -29,12 +29,14 @@
 #include "de/logbuffer.h"
 #include "de/metadatabank.h"
 #include "de/reader.h"
+#include "de/taskpool.h"
 #include "de/writer.h"
 #include "de/zeroed.h"
 
 // Interpretations:
 #include "de/archivefolder.h"
 
+#include <atomic>
 #include <cstring>
 #include <zlib.h>
 
@@ -61,6 +63,12 @@ namespace internal {
 // Deflate minimum compression. Worse than this will be stored uncompressed.
 #define REQUIRED_DEFLATE_PERCENTAGE .98
 
+// Amount of uncompressed data compressed before the results are written out.
+#define DEFLATE_BATCH_SIZE          (64 * 1024 * 1024)
+
+// Entries are compressed in parallel if a batch has at least this much data.
+#define PARALLEL_DEFLATE_THRESHOLD  (256 * 1024)
+
 // File header flags.
 #define ZFH_ENCRYPTED           0x1
 #define ZFH_COMPRESSION_OPTS    0x6
@@ -435,6 +443,182 @@ DE_PIMPL(ZipArchive)
         writer << duint32(SIG_END_OF_CENTRAL_DIR) << zipSummary;
     }
 
+    /**
+     * Determines if the data of an entry must be compressed when the archive is
+     * written, i.e., the existing compressed data cannot be reused.
+     */
+    bool needsDeflate(const ZipEntry &entry) const
+    {
+        return !((entry.dataInArchive || self().source()) && !entry.maybeChanged);
+    }
+
+    /**
+     * Compresses the entries in the range [@a begin, @a end). Entries are
+     * compressed in parallel on the task pool if there is enough data.
+     *
+     * @param entries     All entries of the archive.
+     * @param begin       First entry to compress.
+     * @param end         End of the range.
+     * @param deflated    Compressed data of each entry in the range. Left empty if
+     *                    the entry is not compressed.
+     * @param totalBytes  Total amount of uncompressed data in the range.
+     */
+    void deflateEntries(const List<ZipEntry *> &entries, dsize begin, dsize end,
+                        List<Block> &deflated, dsize totalBytes) const
+    {
+        std::atomic_bool failed{false};
+
+        auto deflateRange = [this, &entries, &deflated, &failed, begin]
+                (dsize first, dsize last)
+        {
+            for (dsize i = first; i < last; ++i)
+            {
+                ZipEntry &entry = *entries[i];
+                entry.update();
+                if (needsDeflate(entry))
+                {
+                    DE_ASSERT(entry.data != NULL);
+                    if (!deflateEntry(*entry.data, deflated[i - begin]))
+                    {
+                        failed = true;
+                    }
+                }
+            }
+        };
+
+        if (totalBytes < PARALLEL_DEFLATE_THRESHOLD)
+        {
+            deflateRange(begin, end);
+        }
+        else
+        {
+            // Each entry is compressed by its own task.
+            TaskPool::parallelFor(begin, end, deflateRange, 1);
+        }
+
+        if (failed)
+        {
+            /// @throw DeflateError  zlib error: could not initialize deflate operation.
+            throw DeflateError("ZipArchive::operator >>", "Deflate init failed");
+        }
+    }
+
+    /**
+     * Compresses data using raw deflate.
+     *
+     * @param data      Data to compress.
+     * @param archived  Compressed data. Left empty if compression does not make
+     *                  the data sufficiently smaller.
+     *
+     * @return @c false, if zlib could not be initialized.
+     */
+    static bool deflateEntry(const IByteArray &data, Block &archived)
+    {
+        archived.resize(Block::Size(REQUIRED_DEFLATE_PERCENTAGE * data.size()));
+
+        z_stream stream;
+        zap(stream);
+        stream.next_in = const_cast<IByteArray::Byte *>(data.data());
+        stream.avail_in = data.size();
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.next_out = const_cast<IByteArray::Byte *>(archived.data());
+        stream.avail_out = archived.size();
+
+        /*
+         * The deflation is done in raw mode. From zlib documentation:
+         *
+         * "windowBits can also be –8..–15 for raw deflate. In this case,
+         * -windowBits determines the window size. deflate() will then
+         * generate raw deflate data with no zlib header or trailer, and
+         * will not compute an adler32 check value."
+         */
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                        -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            archived.clear();
+            return false;
+        }
+
+        if (deflate(&stream, Z_FINISH) == Z_STREAM_END)
+        {
+            // Compression was ok.
+            archived.resize(stream.total_out);
+        }
+        else
+        {
+            // We won't compress.
+            archived.clear();
+        }
+
+        // Clean up.
+        deflateEnd(&stream);
+        return true;
+    }
+
+    /**
+     * Writes the local header and the data of an entry.
+     *
+     * @param writer    Destination.
+     * @param entry     Entry to write. Its offsets, compression, and size in the
+     *                  archive are updated.
+     * @param deflated  Compressed data of the entry (from deflateEntries()).
+     */
+    void writeEntry(Writer &writer, ZipEntry &entry, const Block &deflated) const
+    {
+        const String fullPath = entry.path();
+
+        // This is where the local file header is located.
+        entry.localHeaderOffset = writer.offset();
+
+        LocalFileHeader header;
+        header.signature = SIG_LOCAL_FILE_HEADER;
+        header.requiredVersion = 20;
+        header.compression = entry.compression;
+        Date at(entry.modifiedAt);
+        header.lastModTime = DOSTime(at.hours(), at.minutes(), at.seconds());
+        header.lastModDate = DOSDate(at.year() - 1980, at.month(), at.dayOfMonth());
+        header.crc32 = entry.crc32;
+        header.compressedSize = entry.sizeInArchive;
+        header.size = entry.size;
+        header.fileNameSize = fullPath.size();
+
+        // Can we use the data already in the source archive?
+        if (!needsDeflate(entry))
+        {
+            // Yes, we can.
+            writer << header << FixedByteArray(fullPath.toLatin1());
+            IByteArray::Offset newOffset = writer.offset();
+            if (entry.dataInArchive)
+            {
+                writer << FixedByteArray(*entry.dataInArchive);
+            }
+            else
+            {
+                // Re-use the data in the source.
+                writer << FixedByteArray(*self().source(), entry.offset, entry.sizeInArchive);
+            }
+            // Written to new location.
+            entry.offset = newOffset;
+        }
+        else if (!deflated.isEmpty())
+        {
+            header.compression = entry.compression = DEFLATED;
+            header.compressedSize = entry.sizeInArchive = deflated.size();
+            writer << header << FixedByteArray(fullPath.toLatin1());
+            entry.offset = writer.offset();
+            writer << FixedByteArray(deflated);
+        }
+        else
+        {
+            header.compression = entry.compression = NO_COMPRESSION;
+            header.compressedSize = entry.sizeInArchive = entry.data->size();
+            writer << header << FixedByteArray(fullPath.toLatin1());
+            entry.offset = writer.offset();
+            writer << FixedByteArray(*entry.data);
+        }
+    }
+
     /**
      * Writes a new central directory for a new ZIP archive as it will be written by
      * ZipArchive.
@@ -643,103 +827,39 @@ void ZipArchive::operator >> (Writer &to) const
      */
     Writer writer(to, littleEndianByteOrder);
 
-    // First write the local headers and entry contents.
+    List<ZipEntry *> entries;
     for (PathTreeIterator<Index> iter(index().leafNodes()); iter.hasNext(); )
     {
-        // We will be updating relevant members of the entry.
-        ZipEntry &entry = iter.next();
-        entry.update();
-
-        const String fullPath = entry.path();
-
-        // This is where the local file header is located.
-        entry.localHeaderOffset = writer.offset();
-
-        LocalFileHeader header;
-        header.signature = SIG_LOCAL_FILE_HEADER;
-        header.requiredVersion = 20;
-        header.compression = entry.compression;
-        Date at(entry.modifiedAt);
-        header.lastModTime = DOSTime(at.hours(), at.minutes(), at.seconds());
-        header.lastModDate = DOSDate(at.year() - 1980, at.month(), at.dayOfMonth());
-        header.crc32 = entry.crc32;
-        header.compressedSize = entry.sizeInArchive;
-        header.size = entry.size;
-        header.fileNameSize = fullPath.size();
+        entries << &iter.next();
+    }
 
-        // Can we use the data already in the source archive?
-        if ((entry.dataInArchive || source()) && !entry.maybeChanged)
+    // Entries are compressed in batches and each batch is written out before the
+    // next one is compressed. This way only one batch of compressed data needs to
+    // be kept in memory at a time.
+    List<Block> deflated;
+    for (dsize batchStart = 0; batchStart < entries.size(); )
+    {
+        dsize batchEnd   = batchStart;
+        dsize batchBytes = 0;
+        while (batchEnd < entries.size() && batchBytes < DEFLATE_BATCH_SIZE)
         {
-            // Yes, we can.
-            writer << header << FixedByteArray(fullPath.toLatin1());
-            IByteArray::Offset newOffset = writer.offset();
-            if (entry.dataInArchive)
+            const ZipEntry &entry = *entries[batchEnd++];
+            if (d->needsDeflate(entry))
             {
-                writer << FixedByteArray(*entry.dataInArchive);
-            }
-            else
-            {
-                // Re-use the data in the source.
-                writer << FixedByteArray(*source(), entry.offset, entry.sizeInArchive);
+                batchBytes += entry.data->size();
             }
-            // Written to new location.
-            entry.offset = newOffset;
         }
-        else
-        {
-            DE_ASSERT(entry.data != NULL);
-
-            // Let's try and compress.
-            Block archived(Block::Size(REQUIRED_DEFLATE_PERCENTAGE * entry.data->size()));
-
-            z_stream stream;
-            zap(stream);
-            stream.next_in = const_cast<IByteArray::Byte *>(entry.data->data());
-            stream.avail_in = entry.data->size();
-            stream.zalloc = Z_NULL;
-            stream.zfree = Z_NULL;
-            stream.next_out = const_cast<IByteArray::Byte *>(archived.data());
-            stream.avail_out = archived.size();
-
-            /*
-             * The deflation is done in raw mode. From zlib documentation:
-             *
-             * "windowBits can also be –8..–15 for raw deflate. In this case,
-             * -windowBits determines the window size. deflate() will then
-             * generate raw deflate data with no zlib header or trailer, and
-             * will not compute an adler32 check value."
-             */
-            if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
-                            -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
-            {
-                /// @throw DeflateError  zlib error: could not initialize deflate operation.
-                throw DeflateError("ZipArchive::operator >>", "Deflate init failed");
-            }
 
-            int result = deflate(&stream, Z_FINISH);
-            if (result == Z_STREAM_END)
-            {
-                // Compression was ok.
-                header.compression = entry.compression = DEFLATED;
-                header.compressedSize = entry.sizeInArchive = stream.total_out;
-                writer << header << FixedByteArray(fullPath.toLatin1());
-                entry.offset = writer.offset();
-                writer << FixedByteArray(archived, 0, entry.sizeInArchive);
-            }
-            else
-            {
-                // We won't compress.
-                header.compression = entry.compression = NO_COMPRESSION;
-                header.compressedSize = entry.sizeInArchive = entry.data->size();
-                writer << header << FixedByteArray(fullPath.toLatin1());
-                entry.offset = writer.offset();
-                writer << FixedByteArray(*entry.data);
-            }
+        deflated = List<Block>(batchEnd - batchStart);
+        d->deflateEntries(entries, batchStart, batchEnd, deflated, batchBytes);
 
-            // Clean up.
-            deflateEnd(&stream);
+        for (dsize i = batchStart; i < batchEnd; ++i)
+        {
+            d->writeEntry(writer, *entries[i], deflated[i - batchStart]);
         }
+        batchStart = batchEnd;
     }
+    deflated.clear();
 
     d->writeCentralDirectory(writer);
 
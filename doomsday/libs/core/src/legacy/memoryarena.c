@@ -0,0 +1,552 @@
+/**
+ * @file memoryarena.c
+ * Thread-local arenas for the memory zone.
+ *
+ * Each thread is assigned one of a fixed number of arenas the first time it
+ * allocates from the zone while arenas are enabled. Threads beyond the arena
+ * count share arenas, which is safe because every arena has its own lock; in
+ * practice the lock is uncontended, so threads do not serialize with each other
+ * like they do with the volumes' single zone mutex.
+ *
+ * An arena has one pool per purge tag. Small blocks are carved from 64 KB memory
+ * chunks owned by the pool and recycled through size-class freelists. Large blocks
+ * are allocated separately from the heap.
+ *
+ * The blocks of a pool are kept in two lists. The "plain" list holds anonymous
+ * small blocks carved from the pool's own chunks: these can be released en masse
+ * by dropping the chunks, without visiting the blocks at all. The "special" list
+ * holds everything that needs individual attention when freed: blocks with a
+ * user pointer to clear, large blocks, and blocks whose tag has been changed from
+ * the one they were allocated with. Z_FreeTags() therefore only touches the special
+ * blocks and the chunks of a pool.
+ *
+ * Purgable blocks are never freed by a rover like in the volumes. Instead, each
+ * arena frees its oldest purgable blocks when their total size exceeds a limit.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "de/legacy/memory.h"
+#include "de/legacy/concurrency.h"
+#include "de/c_wrapper.h"
+#include "../src/legacy/memoryzone_private.h"
+
+#ifndef DE_FAKE_MEMORY_ZONE
+
+#if defined (_MSC_VER)
+#  define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#  define ARENA_THREAD_LOCAL __thread
+#endif
+
+#define ARENA_COUNT             32
+#define ARENA_CHUNK_SIZE        0x10000     // 64 KB
+#define ARENA_MAX_SPARE_CHUNKS  64
+#define ARENA_PURGABLE_LIMIT    0x2000000   // 32 MB
+
+#define ALIGNED(x) (((x) + sizeof(void *) - 1)&(~(sizeof(void *) - 1)))
+
+#define NUM_SIZE_CLASSES    14
+#define MAX_SMALL_SIZE      2048
+#define SIZE_CLASS_STEP     16
+
+static const size_t sizeClasses[NUM_SIZE_CLASSES] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048
+};
+
+typedef struct zonechunk_s {
+    struct zonechunk_s *next;
+    size_t _pad; // Keeps the blocks aligned.
+} zonechunk_t;
+
+typedef struct zonepool_s {
+    memblock_t plain;       ///< Sentinel: anonymous small blocks of this pool's chunks.
+    memblock_t special;     ///< Sentinel: blocks that must be freed individually.
+    size_t plainBytes;
+    memblock_t *freeList[NUM_SIZE_CLASSES];
+    zonechunk_t *chunks;
+    byte *bumpPos;
+    byte *bumpEnd;
+    int lentOut;            ///< Small blocks of this pool currently using another tag.
+} zonepool_t;
+
+typedef struct memarena_s {
+    mutex_t mutex;
+    zonepool_t *pools[PU_PURGELEVEL + 1];
+    zonechunk_t *spareChunks;
+    int spareCount;
+    size_t allocatedBytes;
+    size_t purgableBytes;
+} memarena_t;
+
+static memarena_t arenas[ARENA_COUNT];
+static mutex_t assignMutex;
+static int nextArena;
+static byte classForSize[MAX_SMALL_SIZE / SIZE_CLASS_STEP + 1];
+static ARENA_THREAD_LOCAL memarena_t *threadArena;
+
+static __inline int poolIndex(int tag)
+{
+    return tag < 0? 0 : tag > PU_PURGELEVEL? PU_PURGELEVEL : tag;
+}
+
+static __inline int sizeClassOf(size_t size)
+{
+    if (size > MAX_SMALL_SIZE) return -1;
+    return classForSize[(size + SIZE_CLASS_STEP - 1) / SIZE_CLASS_STEP];
+}
+
+static __inline void *blockArea(memblock_t *block)
+{
+    return (byte *) block + sizeof(memblock_t);
+}
+
+static __inline void initSentinel(memblock_t *sentinel)
+{
+    sentinel->next = sentinel->prev = sentinel;
+}
+
+static __inline dd_bool isPlainBlock(const zonepool_t *pool, const memblock_t *block)
+{
+    return block->sizeClass >= 0 && block->home == pool &&
+           block->user == MEMBLOCK_USER_ANONYMOUS;
+}
+
+static void linkBlock(zonepool_t *pool, memblock_t *block)
+{
+    memblock_t *list = &pool->special;
+    if (isPlainBlock(pool, block))
+    {
+        list = &pool->plain;
+        pool->plainBytes += block->size;
+    }
+    // Append to the end: the lists are in allocation order.
+    block->next = list;
+    block->prev = list->prev;
+    list->prev->next = block;
+    list->prev = block;
+}
+
+static void unlinkBlock(zonepool_t *pool, memblock_t *block)
+{
+    if (isPlainBlock(pool, block))
+    {
+        pool->plainBytes -= block->size;
+    }
+    block->prev->next = block->next;
+    block->next->prev = block->prev;
+    block->next = block->prev = NULL;
+}
+
+static memarena_t *currentArena(void)
+{
+    if (!threadArena)
+    {
+        Sys_Lock(assignMutex);
+        threadArena = &arenas[nextArena++ % ARENA_COUNT];
+        Sys_Unlock(assignMutex);
+    }
+    return threadArena;
+}
+
+static zonepool_t *getPool(memarena_t *arena, int tag)
+{
+    const int idx = poolIndex(tag);
+    if (!arena->pools[idx])
+    {
+        zonepool_t *pool = M_Calloc(sizeof(zonepool_t));
+        initSentinel(&pool->plain);
+        initSentinel(&pool->special);
+        arena->pools[idx] = pool;
+    }
+    return arena->pools[idx];
+}
+
+static zonechunk_t *newChunk(memarena_t *arena)
+{
+    zonechunk_t *chunk = arena->spareChunks;
+    if (chunk)
+    {
+        arena->spareChunks = chunk->next;
+        arena->spareCount--;
+    }
+    else
+    {
+        chunk = M_Malloc(ARENA_CHUNK_SIZE);
+    }
+    chunk->next = NULL;
+    return chunk;
+}
+
+static void recycleChunks(memarena_t *arena, zonechunk_t *chunk)
+{
+    while (chunk)
+    {
+        zonechunk_t *next = chunk->next;
+        if (arena->spareCount < ARENA_MAX_SPARE_CHUNKS)
+        {
+            chunk->next = arena->spareChunks;
+            arena->spareChunks = chunk;
+            arena->spareCount++;
+        }
+        else
+        {
+            M_Free(chunk);
+        }
+        chunk = next;
+    }
+}
+
+static memblock_t *carveBlock(memarena_t *arena, zonepool_t *pool, int sizeClass)
+{
+    const size_t need = sizeof(memblock_t) + sizeClasses[sizeClass];
+    memblock_t *block;
+
+    if (!pool->bumpPos || pool->bumpPos + need > pool->bumpEnd)
+    {
+        // The rest of the current chunk is left unused.
+        zonechunk_t *chunk = newChunk(arena);
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+        pool->bumpPos = (byte *) chunk + sizeof(zonechunk_t);
+        pool->bumpEnd = (byte *) chunk + ARENA_CHUNK_SIZE;
+    }
+    block = (memblock_t *) pool->bumpPos;
+    pool->bumpPos += need;
+    return block;
+}
+
+/**
+ * Frees one block. The arena must be locked.
+ */
+static void releaseBlock(memarena_t *arena, memblock_t *block)
+{
+    zonepool_t *pool = arena->pools[poolIndex(block->tag)];
+
+    if (block->user > (void **) 0x100) // Smaller values are not pointers.
+        *block->user = 0; // Clear the user's mark.
+
+    unlinkBlock(pool, block);
+    arena->allocatedBytes -= block->size;
+    if (block->tag >= PU_PURGELEVEL)
+    {
+        arena->purgableBytes -= block->size;
+    }
+
+    block->user = NULL;
+    block->tag = 0;
+    block->id = 0;
+
+    if (block->sizeClass < 0)
+    {
+        M_Free(block);
+        return;
+    }
+    if (block->home != pool)
+    {
+        block->home->lentOut--;
+    }
+    // Back to the freelist of the pool whose memory the block occupies.
+    block->next = block->home->freeList[block->sizeClass];
+    block->home->freeList[block->sizeClass] = block;
+}
+
+/**
+ * Frees all blocks in a pool. The arena must be locked.
+ */
+static void releasePool(memarena_t *arena, zonepool_t *pool)
+{
+    int i;
+
+    // These need individual attention.
+    while (pool->special.next != &pool->special)
+    {
+        releaseBlock(arena, pool->special.next);
+    }
+
+    if (pool->lentOut > 0)
+    {
+        // Some of the chunks' blocks are still in use with another tag, so the
+        // chunks must be kept.
+        while (pool->plain.next != &pool->plain)
+        {
+            releaseBlock(arena, pool->plain.next);
+        }
+        return;
+    }
+
+    // Everything remaining lives in the pool's own chunks.
+    arena->allocatedBytes -= pool->plainBytes;
+    pool->plainBytes = 0;
+    initSentinel(&pool->plain);
+    for (i = 0; i < NUM_SIZE_CLASSES; ++i)
+    {
+        pool->freeList[i] = NULL;
+    }
+    recycleChunks(arena, pool->chunks);
+    pool->chunks  = NULL;
+    pool->bumpPos = NULL;
+    pool->bumpEnd = NULL;
+}
+
+/**
+ * Frees the oldest purgable blocks of the arena until their total size is below
+ * the limit. The arena must be locked.
+ */
+static void purgeOldest(memarena_t *arena)
+{
+    zonepool_t *pool = arena->pools[PU_PURGELEVEL];
+    if (!pool) return;
+
+    while (arena->purgableBytes > ARENA_PURGABLE_LIMIT / 2 &&
+           pool->special.next != &pool->special)
+    {
+        releaseBlock(arena, pool->special.next);
+    }
+}
+
+void ZArena_Init(void)
+{
+    int i;
+
+    memset(arenas, 0, sizeof(arenas));
+    for (i = 0; i < ARENA_COUNT; ++i)
+    {
+        arenas[i].mutex = Sys_CreateMutex("ZONE_ARENA_MUTEX");
+    }
+    assignMutex = Sys_CreateMutex("ZONE_ARENA_ASSIGN_MUTEX");
+
+    for (i = 0; i <= MAX_SMALL_SIZE / SIZE_CLASS_STEP; ++i)
+    {
+        const size_t size = (size_t) i * SIZE_CLASS_STEP;
+        int sc = 0;
+        while (sizeClasses[sc] < size) sc++;
+        classForSize[i] = (byte) sc;
+    }
+}
+
+void ZArena_Shutdown(void)
+{
+    int i, k;
+
+    for (i = 0; i < ARENA_COUNT; ++i)
+    {
+        memarena_t *arena = &arenas[i];
+
+        for (k = 0; k <= PU_PURGELEVEL; ++k)
+        {
+            zonepool_t *pool = arena->pools[k];
+            if (!pool) continue;
+
+            // Large blocks are separately allocated.
+            while (pool->special.next != &pool->special)
+            {
+                memblock_t *block = pool->special.next;
+                unlinkBlock(pool, block);
+                if (block->sizeClass < 0) M_Free(block);
+            }
+        }
+        for (k = 0; k <= PU_PURGELEVEL; ++k)
+        {
+            zonepool_t *pool = arena->pools[k];
+            if (!pool) continue;
+
+            while (pool->chunks)
+            {
+                zonechunk_t *next = pool->chunks->next;
+                M_Free(pool->chunks);
+                pool->chunks = next;
+            }
+            M_Free(pool);
+            arena->pools[k] = NULL;
+        }
+        while (arena->spareChunks)
+        {
+            zonechunk_t *next = arena->spareChunks->next;
+            M_Free(arena->spareChunks);
+            arena->spareChunks = next;
+        }
+        Sys_DestroyMutex(arena->mutex);
+    }
+    memset(arenas, 0, sizeof(arenas));
+
+    Sys_DestroyMutex(assignMutex);
+    assignMutex = 0;
+}
+
+void *ZArena_Malloc(size_t size, int tag, void *user)
+{
+    memarena_t *arena = currentArena();
+    zonepool_t *pool;
+    memblock_t *block;
+    int sizeClass;
+
+    size = ALIGNED(size);
+    sizeClass = sizeClassOf(size);
+
+    Sys_Lock(arena->mutex);
+
+    pool = getPool(arena, tag);
+    if (sizeClass >= 0)
+    {
+        if ((block = pool->freeList[sizeClass]) != NULL)
+        {
+            pool->freeList[sizeClass] = block->next;
+        }
+        else
+        {
+            block = carveBlock(arena, pool, sizeClass);
+        }
+        block->size = sizeof(memblock_t) + sizeClasses[sizeClass];
+    }
+    else
+    {
+        block = M_Malloc(sizeof(memblock_t) + size);
+        block->size = sizeof(memblock_t) + size;
+    }
+
+    block->sizeClass = sizeClass;
+    block->arena     = arena;
+    block->home      = pool;
+    block->volume    = NULL;
+    block->seqFirst  = block->seqLast = NULL;
+    block->tag       = tag;
+    block->id        = DE_ZONEID;
+
+    if (user)
+    {
+        block->user = user; // mark as an in use block
+        *(void **) user = blockArea(block);
+    }
+    else
+    {
+        // An owner is required for purgable blocks.
+        DE_ASSERT(tag < PU_PURGELEVEL);
+
+        block->user = MEMBLOCK_USER_ANONYMOUS; // mark as in use, but unowned
+    }
+
+    linkBlock(pool, block);
+    arena->allocatedBytes += block->size;
+
+    if (tag >= PU_PURGELEVEL)
+    {
+        arena->purgableBytes += block->size;
+        if (arena->purgableBytes > ARENA_PURGABLE_LIMIT)
+        {
+            purgeOldest(arena);
+        }
+    }
+
+    Sys_Unlock(arena->mutex);
+    return blockArea(block);
+}
+
+void ZArena_Free(memblock_t *block)
+{
+    memarena_t *arena = block->arena;
+
+    Sys_Lock(arena->mutex);
+    releaseBlock(arena, block);
+    Sys_Unlock(arena->mutex);
+}
+
+void ZArena_FreeTags(int lowTag, int highTag)
+{
+    int i, tag;
+
+    lowTag  = poolIndex(lowTag);
+    highTag = poolIndex(highTag);
+
+    for (i = 0; i < ARENA_COUNT; ++i)
+    {
+        memarena_t *arena = &arenas[i];
+
+        Sys_Lock(arena->mutex);
+        for (tag = lowTag; tag <= highTag; ++tag)
+        {
+            if (arena->pools[tag])
+            {
+                releasePool(arena, arena->pools[tag]);
+            }
+        }
+        Sys_Unlock(arena->mutex);
+    }
+}
+
+void ZArena_ChangeTag(memblock_t *block, int tag)
+{
+    memarena_t *arena = block->arena;
+    zonepool_t *oldPool, *newPool;
+
+    Sys_Lock(arena->mutex);
+
+    oldPool = arena->pools[poolIndex(block->tag)];
+    newPool = getPool(arena, tag);
+
+    unlinkBlock(oldPool, block);
+    if (block->sizeClass >= 0)
+    {
+        if (oldPool == block->home) block->home->lentOut++;
+        if (newPool == block->home) block->home->lentOut--;
+    }
+    if (block->tag >= PU_PURGELEVEL) arena->purgableBytes -= block->size;
+    if (tag >= PU_PURGELEVEL)        arena->purgableBytes += block->size;
+    block->tag = tag;
+    linkBlock(newPool, block);
+
+    Sys_Unlock(arena->mutex);
+}
+
+void ZArena_ChangeUser(memblock_t *block, void *newUser)
+{
+    memarena_t *arena = block->arena;
+    zonepool_t *pool;
+
+    Sys_Lock(arena->mutex);
+
+    // The block may need to move between the plain and special lists.
+    pool = arena->pools[poolIndex(block->tag)];
+    unlinkBlock(pool, block);
+    block->user = newUser;
+    linkBlock(pool, block);
+
+    Sys_Unlock(arena->mutex);
+}
+
+dd_bool ZArena_IsValid(const memarena_t *arena)
+{
+    return arena >= arenas && arena < arenas + ARENA_COUNT;
+}
+
+size_t ZArena_AllocatedMemory(void)
+{
+    size_t total = 0;
+    int i;
+
+    for (i = 0; i < ARENA_COUNT; ++i)
+    {
+        Sys_Lock(arenas[i].mutex);
+        total += arenas[i].allocatedBytes;
+        Sys_Unlock(arenas[i].mutex);
+    }
+    return total;
+}
+
+#endif // !DE_FAKE_MEMORY_ZONE
@@ -66,9 +66,6 @@
 
 #define ALIGNED(x) (((x) + sizeof(void *) - 1)&(~(sizeof(void *) - 1)))
 
-/// Special user pointer for blocks that are in use but have no single owner.
-#define MEMBLOCK_USER_ANONYMOUS    ((void *) 2)
-
 // Used for block allocation of memory from the zone.
 typedef struct zblockset_block_s {
     /// Maximum number of elements.
@@ -89,6 +86,9 @@ static memvolume_t *volumeLast;
 
 static mutex_t zoneMutex = 0;
 
+/// New allocations are made from the thread-local arenas (see memoryarena.c).
+static volatile dd_bool zoneArenas = false;
+
 static size_t Z_AllocatedMemory(void);
 static size_t allocatedMemoryInVolume(memvolume_t *volume);
 
@@ -160,6 +160,7 @@ static memvolume_t *createVolume(size_t volumeSize)
     block->prev = block->next = &vol->zone->blockList;
     block->user = NULL;         // free block
     block->seqFirst = block->seqLast = NULL;
+    block->arena = NULL;
     block->size = vol->zone->size - sizeof(memzone_t);
 
     unlockZone();
@@ -181,6 +182,15 @@ int Z_Init(void)
 {
     zoneMutex = Sys_CreateMutex("ZONE_MUTEX");
 
+#ifndef DE_FAKE_MEMORY_ZONE
+    ZArena_Init();
+# ifdef DE_ZONE_ARENAS
+    zoneArenas = !CommandLine_Exists("-nozonearenas");
+# else
+    zoneArenas = CommandLine_Exists("-zonearenas");
+# endif
+#endif
+
     // Create the first volume.
     createVolume(MEMORY_VOLUME_SIZE);
     return true;
@@ -215,6 +225,11 @@ void Z_Shutdown(void)
     App_Log(DE2_LOG_NOTE,
             "Z_Shutdown: Used %i volumes, total %u bytes.", numVolumes, totalMemory);
 
+#ifndef DE_FAKE_MEMORY_ZONE
+    ZArena_Shutdown();
+#endif
+    zoneArenas = false;
+
     Sys_DestroyMutex(zoneMutex);
     zoneMutex = 0;
 }
@@ -348,9 +363,38 @@ static void freeBlock(void *ptr, memblock_t **tracked)
 
 void Z_Free(void *ptr)
 {
+#ifndef DE_FAKE_MEMORY_ZONE
+    if (ptr && Z_GetBlock(ptr)->arena)
+    {
+        memblock_t *block = Z_GetBlock(ptr);
+        if (block->id != DE_ZONEID)
+        {
+            DE_ASSERT(block->id == DE_ZONEID);
+            App_Log(DE2_LOG_WARNING,
+                    "Attempted to free pointer without ZONEID.");
+            return;
+        }
+        ZArena_Free(block);
+        return;
+    }
+#endif
     freeBlock(ptr, 0);
 }
 
+void Z_EnableArenas(dd_bool enable)
+{
+#ifndef DE_FAKE_MEMORY_ZONE
+    zoneArenas = enable;
+#else
+    DE_UNUSED(enable);
+#endif
+}
+
+dd_bool Z_ArenasEnabled(void)
+{
+    return zoneArenas;
+}
+
 static __inline dd_bool isFreeBlock(memblock_t *block)
 {
     return !block->user;
@@ -434,6 +478,7 @@ static void splitFreeBlock(memblock_t *block, size_t size)
     newBlock->next = block->next;
     newBlock->next->prev = newBlock;
     newBlock->seqFirst = newBlock->seqLast = NULL;
+    newBlock->arena = NULL;
 #ifdef DE_FAKE_MEMORY_ZONE
     newBlock->area = 0;
     newBlock->areaSize = 0;
@@ -458,6 +503,13 @@ void *Z_Malloc(size_t size, int tag, void *user)
         return NULL;
     }
 
+#ifndef DE_FAKE_MEMORY_ZONE
+    if (zoneArenas)
+    {
+        return ZArena_Malloc(size, tag, user);
+    }
+#endif
+
     lockZone();
 
     // Align to pointer size.
@@ -634,6 +686,7 @@ void *Z_Malloc(size_t size, int tag, void *user)
         volume->allocatedBytes += iter->size;
 
         iter->volume = volume;
+        iter->arena = NULL;
         iter->id = DE_ZONEID;
 
         unlockZone();
@@ -650,8 +703,10 @@ void *Z_Realloc(void *ptr, size_t n, int mallocTag)
 {
     int     tag = ptr ? Z_GetTag(ptr) : mallocTag;
     void   *p;
+    // Arena allocations do not need the zone lock.
+    const dd_bool locked = !zoneArenas;
 
-    lockZone();
+    if (locked) lockZone();
 
     n = ALIGNED(n);
     p = Z_Malloc(n, tag, 0);    // User always 0;
@@ -671,7 +726,7 @@ void *Z_Realloc(void *ptr, size_t n, int mallocTag)
         Z_Free(ptr);
     }
 
-    unlockZone();
+    if (locked) unlockZone();
     return p;
 }
 
@@ -704,6 +759,10 @@ void Z_FreeTags(int lowTag, int highTag)
         }
     }
 
+#ifndef DE_FAKE_MEMORY_ZONE
+    ZArena_FreeTags(lowTag, highTag);
+#endif
+
     // Now that there's plenty of new free space, let's keep the static
     // rover near the beginning of the volume.
     rewindStaticRovers();
@@ -816,6 +875,23 @@ void Z_CheckHeap(void)
 
 void Z_ChangeTag2(void *ptr, int tag)
 {
+#ifndef DE_FAKE_MEMORY_ZONE
+    memblock_t *arenaBlock = Z_GetBlock(ptr);
+    if (arenaBlock->arena)
+    {
+        DE_ASSERT(arenaBlock->id == DE_ZONEID);
+        if (tag >= PU_PURGELEVEL && PTR2INT(arenaBlock->user) < 0x100)
+        {
+            App_Log(DE2_LOG_ERROR,
+                "Z_ChangeTag: An owner is required for purgable blocks.");
+        }
+        else
+        {
+            ZArena_ChangeTag(arenaBlock, tag);
+        }
+        return;
+    }
+#endif
     lockZone();
     {
         memblock_t *block = Z_GetBlock(ptr);
@@ -837,6 +913,14 @@ void Z_ChangeTag2(void *ptr, int tag)
 
 void Z_ChangeUser(void *ptr, void *newUser)
 {
+#ifndef DE_FAKE_MEMORY_ZONE
+    if (Z_GetBlock(ptr)->arena)
+    {
+        DE_ASSERT(Z_GetBlock(ptr)->id == DE_ZONEID);
+        ZArena_ChangeUser(Z_GetBlock(ptr), newUser);
+        return;
+    }
+#endif
     lockZone();
     {
         memblock_t *block = Z_GetBlock(ptr);
@@ -880,6 +964,12 @@ dd_bool Z_Contains(void *ptr)
         // Could be in the zone, but does not look like an allocated block.
         return false;
     }
+#ifndef DE_FAKE_MEMORY_ZONE
+    if (block->arena)
+    {
+        return ZArena_IsValid(block->arena);
+    }
+#endif
     // Check which volume is it.
     for (volume = volumeRoot; volume; volume = volume->next)
     {
@@ -905,8 +995,10 @@ void *Z_Recalloc(void *ptr, size_t n, int callocTag)
     memblock_t     *block;
     void           *p;
     size_t          bsize;
+    // Arena allocations do not need the zone lock.
+    const dd_bool   locked = !zoneArenas;
 
-    lockZone();
+    if (locked) lockZone();
 
     n = ALIGNED(n);
 
@@ -936,7 +1028,7 @@ void *Z_Recalloc(void *ptr, size_t n, int callocTag)
         p = Z_Calloc(n, callocTag, NULL);
     }
 
-    unlockZone();
+    if (locked) unlockZone();
 
     return p;
 }
@@ -1046,6 +1138,12 @@ void Z_PrintStatus(void)
     App_Log(DE2_LOG_DEBUG,
             "Memory zone status: %u volumes, %u bytes allocated, %u bytes free (%f%% in use)",
             Z_VolumeCount(), (uint)allocated, (uint)wasted, (float)allocated/(float)(allocated+wasted)*100.f);
+
+#ifndef DE_FAKE_MEMORY_ZONE
+    App_Log(DE2_LOG_DEBUG,
+            "Memory zone arenas: %s, %u bytes allocated",
+            zoneArenas? "enabled" : "disabled", (uint) ZArena_AllocatedMemory());
+#endif
 }
 
 void Garbage_Trash(void *ptr)
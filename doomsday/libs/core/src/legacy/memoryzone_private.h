@@ -50,6 +50,12 @@ void Z_Shutdown(void);
 
 size_t Z_FreeMemory(void);
 
+/// Special user pointer for blocks that are in use but have no single owner.
+#define MEMBLOCK_USER_ANONYMOUS    ((void *) 2)
+
+struct memarena_s;
+struct zonepool_s;
+
 typedef struct memblock_s {
     size_t          size; // Including header and possibly tiny fragments.
     void **         user; // NULL if a free block.
@@ -58,6 +64,9 @@ typedef struct memblock_s {
     struct memvolume_s *volume; // Volume this block belongs to.
     struct memblock_s *next, *prev;
     struct memblock_s *seqLast, *seqFirst;
+    struct memarena_s *arena; // Arena the block belongs to (NULL if in a volume).
+    struct zonepool_s *home; // Arena pool whose memory the block occupies.
+    int             sizeClass; // Arena size class, or -1 for a separately allocated block.
 #ifdef DE_FAKE_MEMORY_ZONE
     void *          area; // The real memory area.
     size_t          areaSize; // Size of the allocated memory area.
@@ -105,6 +114,24 @@ struct zblockset_s {
     struct zblockset_block_s *_blocks;
 };
 
+/**
+ * Thread-local arenas. When arenas are enabled, new allocations are made from the
+ * arena of the calling thread instead of the memory volumes. Small blocks come from
+ * size-class freelists and each purge tag has its own pool of memory chunks, so that
+ * Z_FreeTags() can release a pool by dropping its chunks instead of freeing the
+ * blocks one by one. Each arena has its own lock, which is normally only taken by
+ * the thread that owns the arena.
+ */
+void    ZArena_Init(void);
+void    ZArena_Shutdown(void);
+void *  ZArena_Malloc(size_t size, int tag, void *user);
+void    ZArena_Free(memblock_t *block);
+void    ZArena_FreeTags(int lowTag, int highTag);
+void    ZArena_ChangeTag(memblock_t *block, int tag);
+void    ZArena_ChangeUser(memblock_t *block, void *newUser);
+dd_bool ZArena_IsValid(const struct memarena_s *arena);
+size_t  ZArena_AllocatedMemory(void);
+
 #ifdef DE_FAKE_MEMORY_ZONE
 memblock_t *Z_GetBlock(void *ptr);
 #else
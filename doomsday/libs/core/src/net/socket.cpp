@@ -44,7 +44,8 @@
  *
  * @par 128&ndash;4095 bytes
  * Medium-sized messages are compressed either using a fast zlib deflate level,
- * or Huffman codes if it yields better compression.
+ * or Huffman codes if it yields better compression. Deflate is not attempted if
+ * the Huffman codes alone achieve good enough compression.
  * If the deflated message size exceeds 4095 bytes, the message is switched to
  * the large format (see below). Message structure:
  * - 1 byte: 0x80 | (payload size & 0x7f)
@@ -104,6 +105,11 @@ static const int MAX_SIZE_LARGE  = DE_SOCKET_MAX_PAYLOAD_SIZE;
 /// the Huffman coded payload is used (unless it doesn't fit in a medium-sized packet).
 static const int MAX_HUFFMAN_INPUT_SIZE = 4096; // bytes
 
+/// If the Huffman coded payload is at most this fraction of the original size, it is
+/// used as is without trying deflate. Level 1 deflate rarely does much better than
+/// this on messages short enough to be Huffman coded.
+static const float HUFFMAN_GOOD_ENOUGH_RATIO = .5f;
+
 #define TRMF_CONTINUE           0x80
 #define TRMF_DEFLATED           0x40
 #define TRMF_SIZE_MASK          0x7f
@@ -243,7 +249,9 @@ DE_PIMPL_NOREF(Socket)
         if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
         {
             huffData = codec::huffmanEncode(payload);
-            if (int(huffData.size()) <= MAX_SIZE_SMALL)
+            if (int(huffData.size()) <= MAX_SIZE_SMALL ||
+                (int(huffData.size()) <= MAX_SIZE_MEDIUM &&
+                 huffData.size() <= HUFFMAN_GOOD_ENOUGH_RATIO * payload.size()))
             {
                 // We'll use this.
                 header.isHuffmanCoded = true;
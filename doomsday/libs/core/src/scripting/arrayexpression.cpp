@@ -61,6 +61,15 @@ void ArrayExpression::push(Evaluator &evaluator, Value *scope) const
     }
 }
 
+void ArrayExpression::compile()
+{
+    // The array itself is not compiled, only its elements.
+    for (Expression *arg : _arguments)
+    {
+        arg->compile();
+    }
+}
+
 const Expression &ArrayExpression::at(dint pos) const
 {
     return *_arguments.at(pos);
@@ -101,6 +101,11 @@ void AssignStatement::execute(Context &context) const
     context.proceed();
 }
 
+void AssignStatement::compile()
+{
+    _args.compile();
+}
+
 void AssignStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Assign) << duint8(_indexCount) << _args;
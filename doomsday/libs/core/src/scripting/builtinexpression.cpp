@@ -53,6 +53,11 @@ void BuiltInExpression::push(Evaluator &evaluator, Value *scope) const
     _arg->push(evaluator);
 }
 
+void BuiltInExpression::compile()
+{
+    if (_arg) _arg->compile();
+}
+
 Value *BuiltInExpression::evaluate(Evaluator &evaluator) const
 {
     std::unique_ptr<Value> value(evaluator.popResult());
@@ -0,0 +1,577 @@
+/** @file bytecode.cpp  Compiled form of script expressions.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/scripting/bytecode.h"
+#include "de/scripting/constantexpression.h"
+#include "de/scripting/evaluator.h"
+#include "de/scripting/nameexpression.h"
+#include "de/scripting/operatorexpression.h"
+#include "de/scripting/process.h"
+#include "de/numbervalue.h"
+#include "de/math.h"
+
+namespace de {
+
+DE_PIMPL_NOREF(Bytecode)
+{
+    /// Maximum number of registers an expression may use. Deeper expressions
+    /// are left uncompiled.
+    static constexpr int MAX_REGISTERS = 16;
+
+    enum Op : dbyte {
+        LoadNumber,     ///< reg = numbers[arg]
+        LoadConstant,   ///< reg = duplicate of constants[arg]
+        LoadName,       ///< reg = value of the variable names[arg]
+        Member,         ///< reg = value of the member names[arg] of reg (reg becomes the scope)
+        Plus,           ///< reg = +reg
+        Negate,         ///< reg = -reg
+        Not,            ///< reg = reg is false
+        Truth,          ///< reg = reg is true
+        BitNot,         ///< reg = ~reg
+        Add,            ///< reg = reg + regs[arg]
+        Subtract,       ///< reg = reg - regs[arg]
+        Multiply,       ///< reg = reg * regs[arg]
+        Divide,         ///< reg = reg / regs[arg]
+        Modulo,         ///< reg = reg % regs[arg]
+        BitAnd,         ///< reg = reg & regs[arg]
+        BitOr,          ///< reg = reg | regs[arg]
+        BitXor,         ///< reg = reg ^ regs[arg]
+        Equal,          ///< reg = reg == regs[arg]
+        NotEqual,       ///< reg = reg != regs[arg]
+        Less,           ///< reg = reg < regs[arg]
+        Greater,        ///< reg = reg > regs[arg]
+        LessEqual,      ///< reg = reg <= regs[arg]
+        GreaterEqual,   ///< reg = reg >= regs[arg]
+        In,             ///< reg = reg in regs[arg]
+        Index,          ///< reg = reg[regs[arg]]
+        Jump,           ///< continue at instruction arg
+        JumpIfFalse,    ///< continue at instruction arg if reg is false
+        JumpIfTrue,     ///< continue at instruction arg if reg is true
+    };
+
+    struct Instruction {
+        Op      op;
+        dbyte   reg; ///< Target register, also the left operand.
+        duint16 arg; ///< Right operand register, table index, or jump target.
+    };
+
+    struct Number {
+        Value::Number value;
+        NumberValue::SemanticHints hints;
+    };
+
+    struct Name {
+        String identifier;
+        bool   localOnly;
+    };
+
+    /**
+     * Register of the machine. A register holds either a plain number (unboxed)
+     * or a Value.
+     */
+    struct Register {
+        Value::Number              number = 0;
+        NumberValue::SemanticHints hints  = NumberValue::Generic;
+        Value *                    value  = nullptr; // owned; null if holding a number
+        Value *                    scope  = nullptr; // owned
+
+        ~Register() { clear(); }
+
+        inline bool isNumber() const { return !value; }
+
+        bool isTrue() const { return value ? value->isTrue() : !fequal(number, 0.0); }
+
+        void clear()
+        {
+            delete value;
+            delete scope;
+            value = nullptr;
+            scope = nullptr;
+        }
+
+        void dropScope()
+        {
+            delete scope;
+            scope = nullptr;
+        }
+
+        void setNumber(Value::Number num, NumberValue::SemanticHints semantic)
+        {
+            clear();
+            number = num;
+            hints  = semantic;
+        }
+
+        void setBoolean(bool b)
+        {
+            setNumber(b ? NumberValue::True : NumberValue::False, NumberValue::Boolean);
+        }
+
+        void setValue(Value *v /*taken*/)
+        {
+            clear();
+            value = v;
+        }
+
+        /// Loads the value of a variable. Plain numbers are unboxed; other values
+        /// are only referenced, like NameExpression does.
+        void load(const Value &v)
+        {
+            if (const auto *num = maybeAs<NumberValue>(v))
+            {
+                setNumber(num->asNumber(), num->semanticHints());
+            }
+            else
+            {
+                setValue(v.duplicateAsReference());
+            }
+        }
+
+        /// Returns the held value, boxing a number into a NumberValue if needed.
+        Value &boxed()
+        {
+            if (!value) value = new NumberValue(number, hints);
+            return *value;
+        }
+    };
+
+    /**
+     * Read-only view of a register as a Value. A number is wrapped into a
+     * temporary NumberValue instead of being boxed on the heap.
+     */
+    struct Operand {
+        const NumberValue temp;
+        const Value &     value;
+
+        Operand(const Register &reg)
+            : temp(reg.number, reg.hints)
+            , value(reg.value ? *reg.value : temp)
+        {}
+    };
+
+    List<Instruction> code;
+    List<Number>      numbers;
+    List<Value *>     constants; // owned
+    List<Name>        names;
+
+    ~Impl()
+    {
+        deleteAll(constants);
+    }
+
+    static bool isPlainName(const NameExpression &name)
+    {
+        // Only names in the usual namespace context that evaluate by value.
+        const StringList &seq = name.identifierSequence();
+        return seq.size() == 2 && seq.front().isEmpty() &&
+               !(name.flags() & ~duint32(Expression::ByValue | Expression::LocalOnly));
+    }
+
+    dsize add(Op op, int reg, dsize arg = 0)
+    {
+        code << Instruction{op, dbyte(reg), duint16(arg)};
+        return code.size() - 1;
+    }
+
+    void addNumber(int reg, Value::Number value, NumberValue::SemanticHints hints)
+    {
+        numbers << Number{value, hints};
+        add(LoadNumber, reg, numbers.size() - 1);
+    }
+
+    dsize addName(const NameExpression &name)
+    {
+        names << Name{name.identifier(), name.flags().testFlag(Expression::LocalOnly)};
+        return names.size() - 1;
+    }
+
+    void patchJump(dsize at)
+    {
+        code[at].arg = duint16(code.size());
+    }
+
+    bool emitBinary(Op op, const OperatorExpression &expr, int reg)
+    {
+        if (!expr.leftOperand() || !expr.rightOperand()) return false;
+        if (!emit(*expr.leftOperand(), reg) || !emit(*expr.rightOperand(), reg + 1))
+        {
+            return false;
+        }
+        add(op, reg, reg + 1);
+        return true;
+    }
+
+    bool emitUnary(Op op, const OperatorExpression &expr, int reg)
+    {
+        if (expr.leftOperand() || !emit(*expr.rightOperand(), reg)) return false;
+        add(op, reg);
+        return true;
+    }
+
+    bool emitLogical(bool isAnd, const OperatorExpression &expr, int reg)
+    {
+        if (!emit(*expr.leftOperand(), reg)) return false;
+        const dsize shortCircuit = add(isAnd ? JumpIfFalse : JumpIfTrue, reg);
+        if (!emit(*expr.rightOperand(), reg)) return false;
+        add(Truth, reg);
+        const dsize skip = add(Jump, reg);
+        patchJump(shortCircuit);
+        addNumber(reg, isAnd ? NumberValue::False : NumberValue::True, NumberValue::Boolean);
+        patchJump(skip);
+        return true;
+    }
+
+    bool emitOperator(const OperatorExpression &expr, int reg)
+    {
+        switch (expr.op())
+        {
+        case PLUS:
+            return expr.leftOperand() ? emitBinary(Add, expr, reg) : emitUnary(Plus, expr, reg);
+
+        case MINUS:
+            return expr.leftOperand() ? emitBinary(Subtract, expr, reg) : emitUnary(Negate, expr, reg);
+
+        case MULTIPLY:      return emitBinary(Multiply,     expr, reg);
+        case DIVIDE:        return emitBinary(Divide,       expr, reg);
+        case MODULO:        return emitBinary(Modulo,       expr, reg);
+        case BITWISE_AND:   return emitBinary(BitAnd,       expr, reg);
+        case BITWISE_OR:    return emitBinary(BitOr,        expr, reg);
+        case BITWISE_XOR:   return emitBinary(BitXor,       expr, reg);
+        case EQUAL:         return emitBinary(Equal,        expr, reg);
+        case NOT_EQUAL:     return emitBinary(NotEqual,     expr, reg);
+        case LESS:          return emitBinary(Less,         expr, reg);
+        case GREATER:       return emitBinary(Greater,      expr, reg);
+        case LEQUAL:        return emitBinary(LessEqual,    expr, reg);
+        case GEQUAL:        return emitBinary(GreaterEqual, expr, reg);
+        case IN:            return emitBinary(In,           expr, reg);
+        case NOT:           return emitUnary (Not,          expr, reg);
+        case BITWISE_NOT:   return emitUnary (BitNot,       expr, reg);
+
+        case INDEX:
+            // Records indexed by reference are left to the tree interpreter.
+            if (expr.flags().testFlag(Expression::ByReference)) return false;
+            return emitBinary(Index, expr, reg);
+
+        case AND:
+        case OR:
+            return emitLogical(expr.op() == AND, expr, reg);
+
+        case MEMBER:
+        {
+            const auto *member = maybeAs<NameExpression>(expr.rightOperand());
+            if (!member || !isPlainName(*member) || !emit(*expr.leftOperand(), reg))
+            {
+                return false;
+            }
+            add(Member, reg, addName(*member));
+            return true;
+        }
+
+        default:
+            // Calls, assignments, slices, etc.
+            return false;
+        }
+    }
+
+    bool emit(const Expression &expr, int reg)
+    {
+        if (reg >= MAX_REGISTERS || code.size() >= 0xffff) return false;
+
+        if (const auto *constant = maybeAs<ConstantExpression>(expr))
+        {
+            if (const auto *num = maybeAs<NumberValue>(constant->value()))
+            {
+                addNumber(reg, num->asNumber(), num->semanticHints());
+            }
+            else
+            {
+                constants << constant->value().duplicate();
+                add(LoadConstant, reg, constants.size() - 1);
+            }
+            return true;
+        }
+        if (const auto *name = maybeAs<NameExpression>(expr))
+        {
+            if (!isPlainName(*name)) return false;
+            add(LoadName, reg, addName(*name));
+            return true;
+        }
+        if (const auto *op = maybeAs<OperatorExpression>(expr))
+        {
+            return emitOperator(*op, reg);
+        }
+        return false;
+    }
+
+    static Variable &findVariable(Evaluator &evaluator, const Name &name)
+    {
+        Variable *found = nullptr;
+        if (Record *ns = evaluator.names())
+        {
+            // A specific namespace has been defined.
+            found = NameExpression::findInRecord(name.identifier, *ns, !name.localOnly);
+        }
+        else
+        {
+            // Look in the namespaces of the process's call stack, without
+            // collecting them into a list first.
+            evaluator.process().forNamespaces([&found, &name] (const Evaluator::Namespace &ns) {
+                found = NameExpression::findInRecord(name.identifier, *ns.names, !name.localOnly);
+                return (found || name.localOnly ? LoopAbort : LoopContinue);
+            });
+        }
+        if (!found)
+        {
+            throw NameExpression::NotFoundError("NameExpression::evaluate",
+                                                "Identifier '" + name.identifier +
+                                                "' does not exist");
+        }
+        return *found;
+    }
+
+    static int compare(const Register &a, const Register &b)
+    {
+        if (a.isNumber() && b.isNumber())
+        {
+            if (fequal(a.number, b.number)) return 0;
+            return cmp(a.number, b.number);
+        }
+        return Operand(a).value.compare(Operand(b).value);
+    }
+
+    void arithmetic(Op op, Register &left, Register &right) const
+    {
+        if (left.isNumber() && right.isNumber())
+        {
+            // Operate directly on the unboxed numbers. The semantic hints of the
+            // left side are kept, like NumberValue does.
+            switch (op)
+            {
+            case Add:      left.number += right.number; break;
+            case Subtract: left.number -= right.number; break;
+            case Multiply: left.number *= right.number; break;
+            case Divide:   left.number /= right.number; break;
+            default:       left.number = int(left.number) % int(right.number); break;
+            }
+        }
+        else
+        {
+            Value &leftValue = left.boxed();
+            const Operand rightValue(right);
+            switch (op)
+            {
+            case Add:      leftValue.sum(rightValue.value);      break;
+            case Subtract: leftValue.subtract(rightValue.value); break;
+            case Multiply: leftValue.multiply(rightValue.value); break;
+            case Divide:   leftValue.divide(rightValue.value);   break;
+            default:       leftValue.modulo(rightValue.value);   break;
+            }
+        }
+    }
+
+    static duint32 bits(const Register &reg)
+    {
+        return duint32(Operand(reg).value.asUInt());
+    }
+
+    Value *execute(Evaluator &evaluator, Value *&resultScope) const
+    {
+        Register regs[MAX_REGISTERS];
+
+        const Instruction *instructions = code.data();
+        const dsize count = code.size();
+
+        for (dsize pc = 0; pc < count; ++pc)
+        {
+            const Instruction &ins = instructions[pc];
+            Register &reg = regs[ins.reg];
+
+            switch (ins.op)
+            {
+            case LoadNumber:
+                reg.setNumber(numbers[ins.arg].value, numbers[ins.arg].hints);
+                break;
+
+            case LoadConstant:
+                reg.setValue(constants[ins.arg]->duplicate());
+                break;
+
+            case LoadName:
+                reg.load(findVariable(evaluator, names[ins.arg]).value());
+                break;
+
+            case Member:
+            {
+                Value &left = reg.boxed();
+                Record *ns = left.memberScope();
+                if (!ns)
+                {
+                    throw OperatorExpression::ScopeError("OperatorExpression::evaluate",
+                        "Left side of " + operatorToText(MEMBER) + " does not have members [" +
+                                                         DE_TYPE_NAME(left) + "]");
+                }
+                const Name &name = names[ins.arg];
+                Variable *var = NameExpression::findInRecord(name.identifier, *ns, !name.localOnly);
+                if (!var)
+                {
+                    throw NameExpression::NotFoundError("NameExpression::evaluate",
+                                                        "Identifier '" + name.identifier +
+                                                        "' does not exist");
+                }
+                // The left side becomes the scope of the member.
+                Value *scope = reg.value;
+                reg.value = nullptr;
+                reg.load(var->value());
+                reg.scope = scope;
+                break;
+            }
+
+            case Plus:
+                reg.dropScope();
+                break;
+
+            case Negate:
+                if (reg.isNumber()) reg.number = -reg.number; else reg.value->negate();
+                reg.dropScope();
+                break;
+
+            case Not:
+                reg.setBoolean(reg.value ? reg.value->isFalse() : fequal(reg.number, 0.0));
+                break;
+
+            case Truth:
+                reg.setBoolean(reg.isTrue());
+                break;
+
+            case BitNot:
+                reg.setNumber(~dint32(bits(reg)), NumberValue::Int);
+                break;
+
+            case Add:
+            case Subtract:
+            case Multiply:
+            case Divide:
+            case Modulo:
+                arithmetic(ins.op, reg, regs[ins.arg]);
+                reg.dropScope();
+                regs[ins.arg].clear();
+                break;
+
+            case BitAnd:
+            case BitOr:
+            case BitXor:
+            {
+                const duint32 a = bits(reg);
+                const duint32 b = bits(regs[ins.arg]);
+                reg.setNumber(dint32(ins.op == BitAnd ? a & b : ins.op == BitOr ? a | b : a ^ b),
+                              NumberValue::Int);
+                regs[ins.arg].clear();
+                break;
+            }
+
+            case Equal:
+            case NotEqual:
+            case Less:
+            case Greater:
+            case LessEqual:
+            case GreaterEqual:
+            {
+                const int c = compare(reg, regs[ins.arg]);
+                reg.setBoolean(ins.op == Equal        ? c == 0 :
+                               ins.op == NotEqual     ? c != 0 :
+                               ins.op == Less         ? c <  0 :
+                               ins.op == Greater      ? c >  0 :
+                               ins.op == LessEqual    ? c <= 0 : c >= 0);
+                regs[ins.arg].clear();
+                break;
+            }
+
+            case In:
+            {
+                const bool found = Operand(regs[ins.arg]).value.contains(Operand(reg).value);
+                reg.setBoolean(found);
+                regs[ins.arg].clear();
+                break;
+            }
+
+            case Index:
+            {
+                Value *element = Operand(reg).value.duplicateElement(Operand(regs[ins.arg]).value);
+                reg.setValue(element);
+                regs[ins.arg].clear();
+                break;
+            }
+
+            case Jump:
+                pc = ins.arg - 1;
+                break;
+
+            case JumpIfFalse:
+                if (!reg.isTrue()) pc = ins.arg - 1;
+                break;
+
+            case JumpIfTrue:
+                if (reg.isTrue()) pc = ins.arg - 1;
+                break;
+            }
+        }
+
+        // The result is in the first register.
+        Register &result = regs[0];
+        resultScope  = result.scope;
+        result.scope = nullptr;
+        if (result.isNumber())
+        {
+            return new NumberValue(result.number, result.hints);
+        }
+        Value *value = result.value;
+        result.value = nullptr;
+        return value;
+    }
+};
+
+Bytecode::Bytecode() : d(new Impl)
+{}
+
+Bytecode::~Bytecode()
+{}
+
+Value *Bytecode::execute(Evaluator &evaluator, Value *&scope) const
+{
+    return d->execute(evaluator, scope);
+}
+
+dsize Bytecode::size() const
+{
+    return d->code.size();
+}
+
+Bytecode *Bytecode::compile(const Expression &expression)
+{
+    // A lone constant is already as fast as it gets.
+    if (is<ConstantExpression>(expression)) return nullptr;
+
+    std::unique_ptr<Bytecode> code(new Bytecode);
+    if (!code->d->emit(expression, 0))
+    {
+        return nullptr;
+    }
+    return code.release();
+}
+
+} // namespace de
@@ -78,6 +78,12 @@ void CatchStatement::executeCatch(Context &context, const Error &err) const
     context.start(_compound.firstStatement(), next());
 }
 
+void CatchStatement::compile()
+{
+    if (_args) _args->compile();
+    _compound.compile();
+}
+
 void CatchStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Catch) << duint8(flags) << *_args << _compound;
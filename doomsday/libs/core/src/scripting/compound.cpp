@@ -41,6 +41,14 @@ void Compound::clear()
     _statements.clear();
 }
 
+void Compound::compile()
+{
+    for (Statement *statement : _statements)
+    {
+        statement->compile();
+    }
+}
+
 const Statement *Compound::firstStatement() const
 {
     if (_statements.empty())
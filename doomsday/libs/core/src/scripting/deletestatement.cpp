@@ -58,6 +58,11 @@ void DeleteStatement::execute(Context &context) const
     context.proceed();
 }
 
+void DeleteStatement::compile()
+{
+    _targets->compile();
+}
+
 void DeleteStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Delete) << *_targets;
@@ -66,6 +66,16 @@ void DictionaryExpression::push(Evaluator &evaluator, Value *scope) const
     }
 }
 
+void DictionaryExpression::compile()
+{
+    // The dictionary itself is not compiled, only its keys and values.
+    for (const ExpressionPair &pair : _arguments)
+    {
+        pair.first->compile();
+        pair.second->compile();
+    }
+}
+
 Value *DictionaryExpression::evaluate(Evaluator &evaluator) const
 {
     std::unique_ptr<DictionaryValue> dict(new DictionaryValue);
@@ -18,6 +18,7 @@
  */
 
 #include "de/scripting/evaluator.h"
+#include "de/scripting/bytecode.h"
 #include "de/scripting/expression.h"
 #include "de/scripting/context.h"
 #include "de/scripting/process.h"
@@ -33,10 +34,17 @@ DE_PIMPL(Evaluator)
     struct ScopedExpression {
         const Expression *expression;
         Value *           scope; // owned
+        const Bytecode *  bytecode;
 
         ScopedExpression(const Expression *e = nullptr, Value *s = nullptr)
             : expression(e)
             , scope(s)
+            , bytecode(nullptr)
+        {}
+        ScopedExpression(const Bytecode &code)
+            : expression(nullptr)
+            , scope(nullptr)
+            , bytecode(&code)
         {}
         Record *names() const
         {
@@ -157,7 +165,16 @@ DE_PIMPL(Evaluator)
             names = top.names();
             /*qDebug() << "Evaluator: Evaluating latest scoped expression" << top.expression
                      << "in" << (top.scope? names->asText() : "null scope");*/
-            pushResult(top.expression->evaluate(self()), top.scope);
+            if (top.bytecode)
+            {
+                Value *resultScope = nullptr;
+                Value *value = top.bytecode->execute(self(), resultScope);
+                pushResult(value, resultScope);
+            }
+            else
+            {
+                pushResult(top.expression->evaluate(self()), top.scope);
+            }
         }
 
         // During function call evaluation the process's context changes. We should
@@ -248,6 +265,11 @@ void Evaluator::push(const Expression *expression, Value *scope)
     d->expressions.push_back(Impl::ScopedExpression(expression, scope));
 }
 
+void Evaluator::push(const Bytecode &code)
+{
+    d->expressions.push_back(Impl::ScopedExpression(code));
+}
+
 void Evaluator::pushResult(Value *value)
 {
     d->pushResult(value);
@@ -21,6 +21,7 @@
 #include "de/scripting/evaluator.h"
 #include "de/scripting/arrayexpression.h"
 #include "de/scripting/builtinexpression.h"
+#include "de/scripting/bytecode.h"
 #include "de/scripting/constantexpression.h"
 #include "de/scripting/dictionaryexpression.h"
 #include "de/scripting/nameexpression.h"
@@ -38,7 +39,24 @@ Expression::~Expression()
 
 void Expression::push(Evaluator &evaluator, Value *scope) const
 {
-    evaluator.push(this, scope);
+    if (_bytecode && !scope)
+    {
+        evaluator.push(*_bytecode);
+    }
+    else
+    {
+        evaluator.push(this, scope);
+    }
+}
+
+void Expression::compile()
+{
+    _bytecode.reset(Bytecode::compile(*this));
+}
+
+const Bytecode *Expression::bytecode() const
+{
+    return _bytecode.get();
 }
 
 Expression *Expression::constructFrom(Reader &reader)
@@ -108,4 +126,7 @@ void Expression::operator << (Reader &from)
     duint16 f;
     from >> f;
     _flags = Flags(f);
+
+    // Any previously compiled code is obsolete.
+    _bytecode.reset();
 }
@@ -41,6 +41,11 @@ void ExpressionStatement::execute(Context &context) const
     context.proceed();
 }
 
+void ExpressionStatement::compile()
+{
+    _expression->compile();
+}
+
 void ExpressionStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Expression) << *_expression;
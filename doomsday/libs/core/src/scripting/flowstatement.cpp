@@ -93,6 +93,11 @@ void FlowStatement::execute(Context &context) const
     }
 }
 
+void FlowStatement::compile()
+{
+    if (_arg) _arg->compile();
+}
+
 void FlowStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Flow);
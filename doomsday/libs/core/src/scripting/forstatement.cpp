@@ -67,6 +67,13 @@ void ForStatement::execute(Context &context) const
     }
 }
 
+void ForStatement::compile()
+{
+    _iterator->compile();
+    _iteration->compile();
+    _compound.compile();
+}
+
 void ForStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::For) << *_iterator << *_iteration << _compound;
@@ -83,6 +83,13 @@ void FunctionStatement::execute(Context &context) const
     context.proceed();
 }
 
+void FunctionStatement::compile()
+{
+    _identifier->compile();
+    _defaults.compile();
+    _function->compound().compile();
+}
+
 void FunctionStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Function) << *_identifier << *_function << _defaults;
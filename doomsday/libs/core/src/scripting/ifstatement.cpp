@@ -78,6 +78,16 @@ void IfStatement::execute(Context &context) const
     }
 }
 
+void IfStatement::compile()
+{
+    for (const Branch &branch : _branches)
+    {
+        branch.condition->compile();
+        branch.compound->compile();
+    }
+    _elseCompound.compile();
+}
+
 void IfStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::If);
@@ -44,29 +44,7 @@ DE_PIMPL_NOREF(NameExpression)
                            Record *&      foundIn,
                            bool           lookInClass = true) const
     {
-        if (where.hasMember(name))
-        {
-            // The name exists in this namespace. Even though the lookup was done as
-            // const, the caller expects non-const return values.
-            foundIn = const_cast<Record *>(&where);
-            return const_cast<Variable *>(&where[name]);
-        }
-        if (lookInClass && where.hasMember(Record::VAR_SUPER))
-        {
-            // The namespace is derived from another record. Let's look into each
-            // super-record in turn. Check in reverse order; the superclass added last
-            // overrides earlier ones.
-            const ArrayValue &supers = where.geta(Record::VAR_SUPER);
-            for (int i = int(supers.size() - 1); i >= 0; --i)
-            {
-                if (Variable *found = findInRecord(
-                        name, supers.at(i).as<RecordValue>().dereference(), foundIn))
-                {
-                    return found;
-                }
-            }
-        }
-        return 0;
+        return NameExpression::findInRecord(name, where, lookInClass, &foundIn);
     }
 
     Variable *findInNamespaces(const String & name,
@@ -128,6 +106,39 @@ const String &NameExpression::identifier() const
     return d->identifierSequence.back();
 }
 
+const StringList &NameExpression::identifierSequence() const
+{
+    return d->identifierSequence;
+}
+
+Variable *NameExpression::findInRecord(const String &name, const Record &where,
+                                       bool lookInClass, Record **foundIn)
+{
+    if (const Variable *variable = where.tryFind(name))
+    {
+        // The name exists in this namespace. Even though the lookup was done as
+        // const, the caller expects non-const return values.
+        if (foundIn) *foundIn = const_cast<Record *>(&where);
+        return const_cast<Variable *>(variable);
+    }
+    if (lookInClass && where.hasMember(Record::VAR_SUPER))
+    {
+        // The namespace is derived from another record. Let's look into each
+        // super-record in turn. Check in reverse order; the superclass added last
+        // overrides earlier ones.
+        const ArrayValue &supers = where.geta(Record::VAR_SUPER);
+        for (int i = int(supers.size() - 1); i >= 0; --i)
+        {
+            if (Variable *found = findInRecord(
+                    name, supers.at(i).as<RecordValue>().dereference(), true, foundIn))
+            {
+                return found;
+            }
+        }
+    }
+    return nullptr;
+}
+
 Value *NameExpression::evaluate(Evaluator &evaluator) const
 {
     //LOG_AS("NameExpression::evaluate");
@@ -66,7 +66,14 @@ OperatorExpression::~OperatorExpression()
 
 void OperatorExpression::push(Evaluator &evaluator, Value *scope) const
 {
-    Expression::push(evaluator);
+    if (bytecode() && !scope)
+    {
+        // The compiled code evaluates the entire expression at once.
+        evaluator.push(*bytecode());
+        return;
+    }
+
+    evaluator.push(this);
 
     if (_op == MEMBER)
     {
@@ -96,6 +103,17 @@ void OperatorExpression::push(Evaluator &evaluator, Value *scope) const
     }
 }
 
+void OperatorExpression::compile()
+{
+    Expression::compile();
+    if (!bytecode())
+    {
+        // Perhaps the operands can be compiled on their own.
+        if (_leftOperand)  _leftOperand->compile();
+        if (_rightOperand) _rightOperand->compile();
+    }
+}
+
 Value *OperatorExpression::newBooleanValue(bool isTrue)
 {
     return new NumberValue(isTrue? NumberValue::True : NumberValue::False,
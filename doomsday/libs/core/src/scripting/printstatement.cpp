@@ -65,6 +65,11 @@ void PrintStatement::execute(Context &context) const
     context.proceed();
 }
 
+void PrintStatement::compile()
+{
+    if (_arg) _arg->compile();
+}
+
 void PrintStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Print) << *_arg;
@@ -411,7 +411,15 @@ void Process::call(const Function &function, const ArrayValue &arguments, Value
 void Process::namespaces(Namespaces &spaces) const
 {
     spaces.clear();
+    forNamespaces([&spaces] (const Evaluator::Namespace &ns)
+    {
+        spaces.push_back(ns);
+        return LoopContinue;
+    });
+}
 
+LoopResult Process::forNamespaces(const std::function<LoopResult (const Evaluator::Namespace &)> &func) const
+{
     bool gotFunction = false;
 
     DE_FOR_EACH_CONST_REVERSE(Impl::ContextStack, i, d->stack)
@@ -424,13 +432,17 @@ void Process::namespaces(Namespaces &spaces) const
             if (gotFunction) continue;
             gotFunction = true;
         }
-        spaces.push_back({&context.names(), unsigned(context.type())});
+        if (auto result = func({&context.names(), unsigned(context.type())}))
+        {
+            return result;
+        }
         if (context.type() == Context::GlobalNamespace)
         {
             // This shadows everything below.
             break;
         }
     }
+    return LoopContinue;
 }
 
 Record &Process::globals()
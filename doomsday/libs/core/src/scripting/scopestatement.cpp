@@ -73,6 +73,13 @@ void ScopeStatement::execute(Context &context) const
     context.process().pushContext(scope);
 }
 
+void ScopeStatement::compile()
+{
+    d->identifier->compile();
+    d->superRecords->compile();
+    d->compound.compile();
+}
+
 void ScopeStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Scope) << *d->identifier << *d->superRecords << d->compound;
@@ -72,5 +72,10 @@ Compound &Script::compound()
     return d->compound;
 }
 
+void Script::compile()
+{
+    d->compound.compile();
+}
+
 } // namespace de
 
@@ -40,6 +40,9 @@ Statement::Statement() : _next(nullptr), _lineNumber(0)
 Statement::~Statement()
 {}
 
+void Statement::compile()
+{}
+
 Statement *Statement::constructFrom(Reader &reader)
 {
     SerialId id;
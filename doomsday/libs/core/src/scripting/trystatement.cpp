@@ -29,6 +29,11 @@ void TryStatement::execute(Context &context) const
     context.start(_compound.firstStatement(), next());
 }
 
+void TryStatement::compile()
+{
+    _compound.compile();
+}
+
 void TryStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::Try) << _compound;
@@ -47,6 +47,12 @@ void WhileStatement::execute(Context &context) const
     }
 }
 
+void WhileStatement::compile()
+{
+    _loopCondition->compile();
+    _compound.compile();
+}
+
 void WhileStatement::operator >> (Writer &to) const
 {
     to << dbyte(SerialId::While) << *_loopCondition << _compound;
@@ -19,6 +19,7 @@
 
 #include "de/rootwidget.h"
 #include "de/constantrule.h"
+#include "de/rulegraph.h"
 #include "de/rulerectangle.h"
 #include "de/math.h"
 
@@ -27,18 +28,29 @@ namespace de {
 DE_PIMPL_NOREF(RootWidget)
 {
     RuleRectangle *viewRect;
+    ConstantRule *viewRight;
+    ConstantRule *viewBottom;
     SafeWidgetPtr<Widget> focus;
+    std::unique_ptr<RuleGraph> ruleGraph;
 
     Impl() : focus(0)
     {
+        // The view size is changed by modifying the constants, so that the rules
+        // depending on the view stay the same.
+        viewRight  = new ConstantRule(0);
+        viewBottom = new ConstantRule(0);
+
         viewRect = new RuleRectangle;
         viewRect->setLeftTop    (Const(0), Const(0))
-                 .setRightBottom(Const(0), Const(0));
+                 .setRightBottom(*viewRight, *viewBottom);
     }
 
     ~Impl()
     {
+        ruleGraph.reset();
         delete viewRect;
+        releaseRef(viewRight);
+        releaseRef(viewBottom);
     }
 
     Size viewSize() const
@@ -101,8 +113,8 @@ void RootWidget::setViewSize(const Size &size)
     DE_GUARD(this);
 #endif
 
-    d->viewRect->setInput(Rule::Right,  Constu(size.x));
-    d->viewRect->setInput(Rule::Bottom, Constu(size.y));
+    d->viewRight ->set(float(size.x));
+    d->viewBottom->set(float(size.y));
 
     notifyTree(&Widget::viewResized);
 }
@@ -141,6 +153,46 @@ Widget *RootWidget::focus() const
     return d->focus;
 }
 
+void RootWidget::setRuleGraphEnabled(bool enabled)
+{
+    if (enabled && !d->ruleGraph)
+    {
+        d->ruleGraph.reset(new RuleGraph);
+    }
+    else if (!enabled)
+    {
+        d->ruleGraph.reset();
+    }
+}
+
+bool RootWidget::isRuleGraphEnabled() const
+{
+    return bool(d->ruleGraph);
+}
+
+const RuleGraph *RootWidget::ruleGraph() const
+{
+    return d->ruleGraph.get();
+}
+
+void RootWidget::updateRuleGraph()
+{
+    if (!d->ruleGraph) return;
+
+    if (!d->ruleGraph->isCompiled())
+    {
+        // Rules have been added or changed since the graph was compiled.
+        List<const RuleRectangle *> rects;
+        rects << d->viewRect;
+        collectRuleRectangles(rects);
+        d->ruleGraph->compile(rects);
+    }
+    d->ruleGraph->update();
+}
+
+void RootWidget::collectRuleRectangles(List<const RuleRectangle *> &) const
+{}
+
 void RootWidget::initialize()
 {
 #if defined (DE_MOBILE)
@@ -154,6 +206,7 @@ void RootWidget::update()
 #if defined (DE_MOBILE)
     DE_GUARD(this);
 #endif
+    updateRuleGraph();
     notifyTree(&Widget::update);
 }
 
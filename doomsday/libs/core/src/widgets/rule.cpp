@@ -18,6 +18,7 @@
  */
 
 #include "de/rule.h"
+#include "de/rulegraph.h"
 #include "de/math.h"
 
 namespace de {
@@ -28,8 +29,16 @@ float Rule::value() const
 {
     if (!(_flags & Valid))
     {
-        // Force an update.
-        const_cast<Rule *>(this)->update();
+        if (_graph)
+        {
+            // Update all the invalid rules of the graph in one pass.
+            _graph->update();
+        }
+        if (!(_flags & Valid))
+        {
+            // Force an update.
+            const_cast<Rule *>(this)->update();
+        }
     }
 
     // It must be valid now, after the update.
@@ -56,6 +65,10 @@ void Rule::ruleInvalidated()
 
 void Rule::dependsOn(const Rule &dependency)
 {
+    // The compiled graph no longer matches the rules.
+    if (_graph) _graph->structureChanged();
+    if (dependency._graph) dependency._graph->structureChanged();
+
     DE_ASSERT(!_dependencies.contains(&dependency));
     _dependencies.insert(holdRef(&dependency));
 
@@ -69,6 +82,9 @@ void Rule::dependsOn(const Rule *dependencyOrNull)
 
 void Rule::independentOf(const Rule &dependency)
 {
+    if (_graph) _graph->structureChanged();
+    if (dependency._graph) dependency._graph->structureChanged();
+
     dependency.audienceForRuleInvalidation -= this;
 
     DE_ASSERT(_dependencies.contains(&dependency));
@@ -85,6 +101,13 @@ void Rule::invalidate()
 {
     if (isValid())
     {
+        if (_graph)
+        {
+            // The graph invalidates the dependent rules.
+            _graph->invalidate(_slot);
+            return;
+        }
+
         _flags &= ~Valid;
 
         // Also set the global flag.
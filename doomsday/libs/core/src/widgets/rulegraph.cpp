@@ -0,0 +1,490 @@
+/** @file rulegraph.cpp  Compiled graph of layout rules.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/rulegraph.h"
+#include "de/indirectrule.h"
+#include "de/operatorrule.h"
+#include "de/rulerectangle.h"
+#include "de/math.h"
+
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace de {
+
+DE_PIMPL_NOREF(RuleGraph)
+{
+    /// How the value of a rule in the graph is determined.
+    struct Instruction
+    {
+        enum Kind : duint8 {
+            Opaque,   ///< Not compiled: the rule updates itself.
+            Source,   ///< No dependencies: the rule is updated by the graph.
+            Indirect, ///< Value of the first operand.
+            Operator, ///< Operator applied to the operands.
+        };
+
+        Kind   kind     = Opaque;
+        duint8 op       = 0;     ///< OperatorRule::Operator.
+        bool   notifies = false; ///< Has dependents outside the graph.
+        dint32 operand[3] { -1, -1, -1 }; ///< Left, right, condition (-1: none).
+    };
+
+    std::vector<Rule *>      nodes;  ///< In dependency order (ref'd).
+    std::vector<Instruction> code;
+    std::vector<float>       values; ///< Current values of the compiled rules.
+    std::vector<duint64>     dirty;  ///< One bit per rule.
+    duint32 dirtyBegin = 0;
+    duint32 dirtyEnd   = 0;
+
+    /// Compiled dependents of each rule: dependents[dependentBegin[i]...dependentBegin[i+1]].
+    std::vector<duint32> dependentBegin;
+    std::vector<duint32> dependents;
+
+    dsize   compiledCount = 0;
+    duint64 evaluations   = 0;
+    bool    compiled      = false;
+    bool    evaluating    = false;
+    bool    notifying     = false;
+    std::vector<duint32> propagation;
+    std::vector<duint32> notifyQueue;
+
+    ~Impl()
+    {
+        release();
+    }
+
+    /**
+     * Detaches the compiled rules from the graph. The rules remain in the state the
+     * graph left them: dirty rules are invalid and update themselves when needed.
+     */
+    void detach()
+    {
+        if (!compiled) return;
+        compiled = false;
+        for (duint32 i = 0; i < nodes.size(); ++i)
+        {
+            if (code[i].kind != Instruction::Opaque)
+            {
+                nodes[i]->_graph = nullptr;
+            }
+        }
+    }
+
+    void release()
+    {
+        detach();
+        // Releasing may delete rules, so the arrays are cleared first.
+        const auto held = std::move(nodes);
+        nodes.clear();
+        code.clear();
+        values.clear();
+        dirty.clear();
+        dependentBegin.clear();
+        dependents.clear();
+        dirtyBegin = dirtyEnd = 0;
+        compiledCount = 0;
+        evaluations = 0;
+        for (Rule *rule : held)
+        {
+            rule->release();
+        }
+    }
+
+    /**
+     * Collects the rules in dependency order, starting from @a root.
+     *
+     * @return @c false, if the rules have circular dependencies.
+     */
+    bool collect(const Rule &root, std::unordered_map<const Rule *, dint32> &slots)
+    {
+        struct Visit {
+            const Rule *rule;
+            int next; ///< Next dependency to visit.
+        };
+        std::vector<Visit> stack;
+
+        if (slots.find(&root) != slots.end()) return true;
+        slots[&root] = -1; // Being visited.
+        stack.push_back(Visit{&root, 0});
+
+        while (!stack.empty())
+        {
+            const Rule *rule = stack.back().rule;
+            const auto &deps = rule->_dependencies;
+            if (stack.back().next < deps.size())
+            {
+                const Rule *dep = deps.begin()[stack.back().next++];
+                const auto found = slots.find(dep);
+                if (found == slots.end())
+                {
+                    slots[dep] = -1;
+                    stack.push_back(Visit{dep, 0});
+                }
+                else if (found->second < 0)
+                {
+                    return false; // Circular.
+                }
+            }
+            else
+            {
+                // All dependencies have been placed before this rule.
+                slots[rule] = dint32(nodes.size());
+                nodes.push_back(const_cast<Rule *>(rule));
+                stack.pop_back();
+            }
+        }
+        return true;
+    }
+
+    void compileInstructions(const std::unordered_map<const Rule *, dint32> &slots)
+    {
+        auto slotOf = [&slots] (const Rule *rule) -> dint32 {
+            return rule? slots.find(rule)->second : -1;
+        };
+
+        code.resize(nodes.size());
+        for (duint32 i = 0; i < nodes.size(); ++i)
+        {
+            const Rule *rule = nodes[i];
+            Instruction &ins = code[i];
+
+            if (rule->_graph)
+            {
+                // Already evaluated by another graph (e.g., a shared constant).
+                continue;
+            }
+            // Subclasses may update differently, so only the exact types are compiled.
+            if (typeid(*rule) == typeid(OperatorRule))
+            {
+                const auto *opRule = static_cast<const OperatorRule *>(rule);
+                ins.kind       = Instruction::Operator;
+                ins.op         = duint8(opRule->op());
+                ins.operand[0] = slotOf(opRule->_leftOperand);
+                ins.operand[1] = slotOf(opRule->_rightOperand);
+                ins.operand[2] = slotOf(opRule->_condition);
+            }
+            else if (typeid(*rule) == typeid(IndirectRule))
+            {
+                const auto *indRule = static_cast<const IndirectRule *>(rule);
+                ins.kind       = Instruction::Indirect;
+                ins.operand[0] = (indRule->hasSource()? slotOf(&indRule->source()) : -1);
+            }
+            else if (rule->_dependencies.isEmpty())
+            {
+                // Constants, animations, etc. can only change by being invalidated.
+                ins.kind = Instruction::Source;
+            }
+        }
+    }
+
+    void linkDependents(const std::unordered_map<const Rule *, dint32> &slots)
+    {
+        const duint32 count = duint32(nodes.size());
+        dependentBegin.assign(count + 1, 0);
+
+        // Count the compiled dependents of each rule.
+        for (duint32 i = 0; i < count; ++i)
+        {
+            if (code[i].kind == Instruction::Opaque) continue;
+            for (const Rule *dep : nodes[i]->_dependencies)
+            {
+                dependentBegin[slots.find(dep)->second + 1]++;
+            }
+        }
+        for (duint32 i = 0; i < count; ++i)
+        {
+            Instruction &ins = code[i];
+            if (ins.kind != Instruction::Opaque)
+            {
+                // Everyone observing the rule is a dependent; the ones that are not
+                // compiled need to be notified when the rule is invalidated.
+                ins.notifies = (nodes[i]->audienceForRuleInvalidation.size() >
+                                dsize(dependentBegin[i + 1]));
+            }
+            dependentBegin[i + 1] += dependentBegin[i];
+        }
+
+        dependents.resize(dependentBegin[count]);
+        std::vector<duint32> filled(dependentBegin.begin(), dependentBegin.end() - 1);
+        for (duint32 i = 0; i < count; ++i)
+        {
+            if (code[i].kind == Instruction::Opaque) continue;
+            for (const Rule *dep : nodes[i]->_dependencies)
+            {
+                dependents[filled[slots.find(dep)->second]++] = i;
+            }
+        }
+    }
+
+    inline bool isDirty(duint32 slot) const
+    {
+        return (dirty[slot >> 6] & (duint64(1) << (slot & 63))) != 0;
+    }
+
+    inline void setDirty(duint32 slot)
+    {
+        dirty[slot >> 6] |= duint64(1) << (slot & 63);
+        dirtyBegin = de::min(dirtyBegin, slot);
+        dirtyEnd   = de::max(dirtyEnd,   slot + 1);
+    }
+
+    /**
+     * Marks a rule and all its compiled dependents dirty and invalid. Rules that have
+     * dependents outside the graph are queued for notification.
+     */
+    void propagate(duint32 slot)
+    {
+        propagation.push_back(slot);
+        while (!propagation.empty())
+        {
+            const duint32 i = propagation.back();
+            propagation.pop_back();
+            if (isDirty(i)) continue;
+
+            setDirty(i);
+            nodes[i]->_flags &= ~Rule::Valid;
+            if (code[i].notifies)
+            {
+                notifyQueue.push_back(i);
+            }
+            for (duint32 k = dependentBegin[i]; k < dependentBegin[i + 1]; ++k)
+            {
+                if (!isDirty(dependents[k])) propagation.push_back(dependents[k]);
+            }
+        }
+    }
+
+    inline float operandValue(dint32 slot) const
+    {
+        if (slot < 0) return 0;
+        if (code[slot].kind == Instruction::Opaque)
+        {
+            return nodes[slot]->value();
+        }
+        return values[slot];
+    }
+
+    float evaluate(duint32 slot)
+    {
+        const Instruction &ins = code[slot];
+        if (ins.kind == Instruction::Source)
+        {
+            Rule *rule = nodes[slot];
+            rule->update();
+            return rule->_value;
+        }
+        if (ins.kind == Instruction::Indirect)
+        {
+            return operandValue(ins.operand[0]);
+        }
+
+        float leftValue  = 0;
+        float rightValue = 0;
+        if (ins.op == OperatorRule::Select)
+        {
+            // Only evaluate the selected operand.
+            if (operandValue(ins.operand[2]) < 0)
+            {
+                leftValue = operandValue(ins.operand[0]);
+            }
+            else
+            {
+                return operandValue(ins.operand[1]);
+            }
+        }
+        else
+        {
+            leftValue  = operandValue(ins.operand[0]);
+            rightValue = operandValue(ins.operand[1]);
+        }
+
+        switch (OperatorRule::Operator(ins.op))
+        {
+        case OperatorRule::Equals:   return leftValue;
+        case OperatorRule::Negate:   return -leftValue;
+        case OperatorRule::Half:     return leftValue / 2;
+        case OperatorRule::Double:   return leftValue * 2;
+        case OperatorRule::Sum:      return leftValue + rightValue;
+        case OperatorRule::Subtract: return leftValue - rightValue;
+        case OperatorRule::Multiply: return leftValue * rightValue;
+        case OperatorRule::Divide:   return leftValue / rightValue;
+        case OperatorRule::Maximum:  return de::max(leftValue, rightValue);
+        case OperatorRule::Minimum:  return de::min(leftValue, rightValue);
+        case OperatorRule::Floor:    return de::floor(leftValue);
+        case OperatorRule::Select:   return leftValue;
+        }
+        return leftValue;
+    }
+
+    /**
+     * Evaluates the dirty rules in one pass over the dirty range. Rules that are
+     * invalidated during the pass (by non-compiled rules being updated) are picked up
+     * by another pass.
+     */
+    void evaluateDirty()
+    {
+        while (compiled && dirtyBegin < dirtyEnd)
+        {
+            const duint32 end = dirtyEnd;
+            duint32 i = dirtyBegin;
+            dirtyBegin = duint32(nodes.size());
+            dirtyEnd   = 0;
+
+            while (i < end && compiled)
+            {
+                duint64 &word = dirty[i >> 6];
+                if (!word)
+                {
+                    i = (i | 63) + 1; // Skip the whole word.
+                    continue;
+                }
+                const duint64 bit = duint64(1) << (i & 63);
+                if (word & bit)
+                {
+                    word &= ~bit;
+                    const float v = evaluate(i);
+                    values[i] = v;
+                    nodes[i]->setValue(v);
+                    evaluations++;
+                }
+                ++i;
+            }
+        }
+    }
+};
+
+RuleGraph::RuleGraph()
+    : d(new Impl)
+{}
+
+RuleGraph::~RuleGraph()
+{}
+
+bool RuleGraph::compile(const List<const RuleRectangle *> &rects)
+{
+    d->release();
+
+    std::unordered_map<const Rule *, dint32> slots;
+    for (const RuleRectangle *rect : rects)
+    {
+        const Rule *outputs[] = {
+            &rect->left(), &rect->top(), &rect->right(), &rect->bottom(),
+            &rect->width(), &rect->height()
+        };
+        for (const Rule *output : outputs)
+        {
+            if (!d->collect(*output, slots))
+            {
+                d->nodes.clear();
+                return false;
+            }
+        }
+    }
+
+    d->compileInstructions(slots);
+    d->linkDependents(slots);
+
+    const duint32 count = duint32(d->nodes.size());
+    d->values.assign(count, 0.f);
+    d->dirty.assign((count + 63) / 64, 0);
+    d->dirtyBegin = count;
+    d->dirtyEnd   = 0;
+    for (duint32 i = 0; i < count; ++i)
+    {
+        Rule *rule = holdRef(d->nodes[i]);
+        if (d->code[i].kind != Impl::Instruction::Opaque)
+        {
+            rule->_graph = this;
+            rule->_slot  = i;
+            rule->_flags &= ~Rule::Valid;
+            d->setDirty(i);
+            d->compiledCount++;
+        }
+    }
+    d->compiled = true;
+
+    // Initial values.
+    update();
+    d->evaluations = 0;
+    return true;
+}
+
+void RuleGraph::clear()
+{
+    d->release();
+}
+
+bool RuleGraph::isCompiled() const
+{
+    return d->compiled;
+}
+
+void RuleGraph::update()
+{
+    if (!d->compiled || d->evaluating) return;
+
+    d->evaluating = true;
+    d->evaluateDirty();
+    d->evaluating = false;
+}
+
+dsize RuleGraph::size() const
+{
+    return d->nodes.size();
+}
+
+dsize RuleGraph::compiledCount() const
+{
+    return d->compiledCount;
+}
+
+duint64 RuleGraph::evaluationCount() const
+{
+    return d->evaluations;
+}
+
+void RuleGraph::invalidate(duint32 slot)
+{
+    DE_ASSERT(d->compiled);
+
+    d->propagate(slot);
+    Rule::_invalidRulesExist = true;
+
+    if (d->notifying) return; // Already notifying; the queue will be processed.
+
+    d->notifying = true;
+    while (!d->notifyQueue.empty())
+    {
+        Rule *rule = d->nodes[d->notifyQueue.back()];
+        d->notifyQueue.pop_back();
+        DE_FOR_OBSERVERS(i, rule->audienceForRuleInvalidation)
+        {
+            i->ruleInvalidated();
+        }
+    }
+    d->notifying = false;
+}
+
+void RuleGraph::structureChanged()
+{
+    d->detach();
+}
+
+} // namespace de
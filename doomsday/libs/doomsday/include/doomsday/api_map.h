@@ -337,6 +337,15 @@ LIBDOOMSDAY_PUBLIC void            Mobj_Link(struct mobj_s *mobj, int flags);
  */
 LIBDOOMSDAY_PUBLIC void            Mobj_Unlink(struct mobj_s *mobj);
 
+/**
+ * Notifies the engine that the game has changed properties of a mobj without
+ * linking, unlinking or changing its state (e.g., health or Z movement). The server
+ * only compares the changed mobjs when generating frame deltas.
+ *
+ * @param mobj   Mobj instance.
+ */
+LIBDOOMSDAY_PUBLIC void            Mobj_MarkChanged(struct mobj_s *mobj);
+
 /**
  * The callback function will be called once for each line that crosses
  * trough the object. This means all the lines will be two-sided.
@@ -372,6 +381,12 @@ LIBDOOMSDAY_PUBLIC void            Polyobj_Link(struct polyobj_s *po);
  */
 LIBDOOMSDAY_PUBLIC void            Polyobj_Unlink(struct polyobj_s *po);
 
+/**
+ * Notifies the engine that the game has changed the movement properties of
+ * @a polyobj (destination, speed, etc.) without moving or rotating it.
+ */
+LIBDOOMSDAY_PUBLIC void            Polyobj_MarkChanged(struct polyobj_s *po);
+
 /**
  * Returns a pointer to the first Line in the polyobj.
  */
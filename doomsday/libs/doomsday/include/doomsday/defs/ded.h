@@ -21,6 +21,7 @@
 #define LIBDOOMSDAY_DEFINITION_DATABASE_H
 
 #include <vector>
+#include <de/keymap.h>
 #include <de/libcore.h>
 #include <de/record.h>
 #include <de/string.h>
@@ -28,6 +29,7 @@
 #include "../uri.h"
 
 #include "dedtypes.h"
+#include "dedindex.h"
 #include "dedregister.h"
 
 // Version 6 does not require semicolons.
@@ -124,6 +126,14 @@ struct LIBDOOMSDAY_PUBLIC ded_s
     // Composite fonts.
     DEDArray<ded_compositefont_t> compositeFonts;
 
+    // Identifier lookups for the definition arrays. The indices must be invalidated
+    // if the identifiers of existing definitions are changed.
+    DEDIndex spriteIndex;
+    DEDIndex soundIndex;
+    DEDIndex soundNameIndex;
+    DEDIndex textIndex;
+    DEDIndex valueIndex;
+
 public:
     /**
      * Constructor initializes everything to zero.
@@ -209,6 +219,12 @@ public:
      */
     de::String findEpisode(const de::String &mapId) const;
 
+    /**
+     * Returns the number of lookups made in each definition category since the
+     * definitions were last cleared.
+     */
+    de::KeyMap<de::String, de::duint64> lookupCounts() const;
+
 protected:
     void release();
 
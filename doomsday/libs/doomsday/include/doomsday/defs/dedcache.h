@@ -0,0 +1,112 @@
+/** @file dedcache.h  Binary cache of the definition database.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_DEDCACHE_H
+#define LIBDOOMSDAY_DEDCACHE_H
+
+#include "../libdoomsday.h"
+#include "ded.h"
+
+#include <de/block.h>
+#include <de/nativepath.h>
+#include <de/string.h>
+
+/**
+ * Stores a fully read definition database in a binary file, so that subsequent
+ * launches with the same inputs can skip parsing the definition files.
+ *
+ * The cache is identified by a key that must cover everything that affects the
+ * contents of the database apart from the definition files themselves: the build,
+ * the loaded game, the loaded files and packages, etc. The cache does not know what
+ * the key contains.
+ *
+ * The definition files are tracked separately, because files can include other
+ * files and the full set is known only after parsing. While recording (see
+ * beginRecording()), every file read with Def_ReadProcessDED() is noted. The size,
+ * modification time and MD5 hash of these files are stored in the cache, and the
+ * cache is only used if none of them have changed. If only the modification time of
+ * a file has changed, the file is compared by its hash.
+ *
+ * The cache file is memory-mapped for reading. Definition structs that are plain
+ * data are stored as raw bytes, so the file is only valid for the build that wrote
+ * it.
+ */
+class LIBDOOMSDAY_PUBLIC DEDCache
+{
+public:
+    /// Outcome of load().
+    enum Result {
+        Loaded,         ///< Definitions were read from the cache.
+        Missing,        ///< There is no cache file.
+        KeyMismatch,    ///< The cache has been written with different inputs.
+        SourcesChanged, ///< One or more definition files have changed.
+        Invalid         ///< The cache file is corrupt or incompatible.
+    };
+
+public:
+    /**
+     * @param filePath  Native path of the cache file.
+     */
+    DEDCache(const de::NativePath &filePath);
+
+    /**
+     * Reads the definitions from the cache.
+     *
+     * @param defs        Definition database. Must be empty. If the cache cannot be
+     *                    used, @a defs is left empty.
+     * @param key         Key of the current inputs.
+     * @param modelPaths  Model search paths that the definitions added (with
+     *                    "ModelPath") are returned here.
+     *
+     * @return Outcome. The definitions were read only if this is Loaded.
+     */
+    Result load(ded_t &defs, const de::Block &key, de::StringList &modelPaths);
+
+    /**
+     * Starts noting the definition files read with Def_ReadProcessDED(). The
+     * recording stops in save() or when the cache is deleted.
+     */
+    void beginRecording();
+
+    /**
+     * Writes the definitions to the cache. The definition files noted since
+     * beginRecording() are stored as the sources of the definitions.
+     *
+     * @param defs        Definition database.
+     * @param key         Key of the current inputs.
+     * @param modelPaths  Model search paths that the definitions added.
+     *
+     * @return @c true if the cache was written.
+     */
+    bool save(const ded_t &defs, const de::Block &key, const de::StringList &modelPaths);
+
+    /**
+     * Removes the cache file.
+     */
+    void clear();
+
+    /**
+     * Returns a short description of a load() result, for log messages.
+     */
+    static const char *resultText(Result result);
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LIBDOOMSDAY_DEDCACHE_H
@@ -25,9 +25,18 @@
 #include "../libdoomsday.h"
 #include "ded.h"
 #include <de/string.h>
+#include <functional>
 
 LIBDOOMSDAY_PUBLIC void Def_ReadProcessDED(ded_t *defs, const de::String& path);
 
+/**
+ * Sets a function to be called with the path of each definition file that is read
+ * with Def_ReadProcessDED(), including the files included by other definition files.
+ *
+ * @param observer  Observer function, or @c nullptr to stop observing.
+ */
+LIBDOOMSDAY_PUBLIC void Def_SetReadObserver(const std::function<void (const de::String &path)> &observer);
+
 /**
  * Reads definitions from the given lump.
  */
@@ -0,0 +1,87 @@
+/** @file dedindex.h  Identifier index for definition arrays.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_DEDINDEX_H
+#define LIBDOOMSDAY_DEDINDEX_H
+
+#include "../libdoomsday.h"
+#include <functional>
+
+/**
+ * Case-insensitive hash index of the identifiers of the definitions in a DEDArray.
+ *
+ * The definitions in a DEDArray are plain structs whose identifiers are filled in
+ * after the definition has been appended, so the index is updated lazily: each
+ * lookup first indexes the definitions that have been appended since the previous
+ * lookup. If the identifier of an already indexed definition is modified (e.g., a
+ * DeHackEd patch renames a sprite), invalidate() must be called.
+ *
+ * Candidates found via the hash are always compared with the current identifier, so
+ * a stale index can only miss a definition, never return the wrong one.
+ *
+ * The index also counts the number of lookups made, for profiling which definition
+ * categories are looked up most often.
+ */
+class LIBDOOMSDAY_PUBLIC DEDIndex
+{
+public:
+    /// Which definition is found when several have the same identifier.
+    enum Precedence {
+        FirstDefined,   ///< The one with the lowest index.
+        LatestDefined   ///< The one with the highest index (allows patching).
+    };
+
+    /// Returns the identifier of the definition at an index. May return @c nullptr.
+    typedef std::function<const char *(int index)> KeyFunc;
+
+public:
+    DEDIndex(Precedence precedence, const KeyFunc &keyAt);
+
+    /**
+     * Forgets all indexed definitions. Called when the definition array is cleared.
+     * The lookup count is reset, too.
+     */
+    void clear();
+
+    /**
+     * Marks the index out of date, so that it is rebuilt on the next lookup. Called
+     * when the identifiers of existing definitions have been changed.
+     */
+    void invalidate();
+
+    /**
+     * Finds a definition.
+     *
+     * @param id     Identifier to look for (case insensitive). Empty identifiers are
+     *               never found.
+     * @param count  Current number of definitions in the array.
+     *
+     * @return Index of the definition, or -1 if not found.
+     */
+    int find(const char *id, int count) const;
+
+    /**
+     * Returns the number of times find() has been called since the index was cleared.
+     */
+    de::duint64 lookupCount() const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LIBDOOMSDAY_DEDINDEX_H
@@ -114,6 +114,12 @@ public:
      */
     const de::DictionaryValue &lookup(const de::String &key) const;
 
+    /**
+     * Returns the number of lookups made with has(), tryFind() and find() since the
+     * register was last cleared.
+     */
+    de::duint64 lookupCount() const;
+
 private:
     DE_PRIVATE(d)
 };
@@ -1,4 +1,7 @@
 /** @file dedtypes.h  Definition types and structures (DED v1).
+ *
+ * The structs are stored as raw bytes in the definition cache. When their members
+ * change, update dedCacheLayout() in dedcache.cpp.
  *
  * @authors Copyright © 2003-2017 Jaakko Keränen <jaakko.keranen@iki.fi>
  * @authors Copyright © 2006-2015 Daniel Swanson <danij@dengine.net>
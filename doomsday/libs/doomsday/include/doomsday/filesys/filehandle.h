@@ -112,6 +112,26 @@ public:
      */
     FileHandle &rewind();
 
+    /**
+     * Provides read-only access to a section of the file without copying it. A native
+     * file is memory-mapped on first use; a buffered lump is accessed in its buffer.
+     * The mapping is copy-on-write so the file on disk is never modified, even if the
+     * returned data is written to. The stream position is not affected.
+     *
+     * @param offset  Offset from the beginning of the file.
+     * @param length  Length of the section in bytes.
+     *
+     * @return  Pointer to the start of the section, valid until the handle is closed;
+     * otherwise @c nullptr if direct access is not available, in which case the data
+     * should be read() instead.
+     */
+    const uint8_t *view(size_t offset, size_t length);
+
+    /**
+     * Returns the total number of bytes accessed via view() instead of being copied.
+     */
+    static de::duint64 viewedByteCount();
+
 public:
     /**
      * Create a new handle on the File @a file.
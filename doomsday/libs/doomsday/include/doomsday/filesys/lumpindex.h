@@ -221,6 +221,30 @@ public:
      */
     lumpnum_t findLast(const Path &path) const;
 
+    /**
+     * Returns @c true iff the index contains one or more lumps named @a name
+     * (case insensitive; only the last segment of a lump's path is considered).
+     */
+    bool containsName(const CString &name) const;
+
+    /**
+     * Returns the index of the @em first loaded lump named @a name, or @c -1 if
+     * not found. Unlike findFirst() the name is not parsed into a Path, so the
+     * lookup does not allocate.
+     *
+     * @see findLastByName()
+     */
+    lumpnum_t findFirstByName(const CString &name) const;
+
+    /**
+     * Returns the index of the @em last loaded lump named @a name, or @c -1 if
+     * not found. Unlike findLast() the name is not parsed into a Path, so the
+     * lookup does not allocate.
+     *
+     * @see findFirstByName()
+     */
+    lumpnum_t findLastByName(const CString &name) const;
+
     /**
      * Lookup a file at specific offset in the index.
      *
@@ -261,7 +285,7 @@ public:
     /**
      * Append a lump to the index.
      *
-     * @post Lump name hashes may be invalidated (will be rebuilt upon next search).
+     * @post The lump is added to the name hash (if one has been built).
      *
      * @param lump  Lump to be being added.
      */
@@ -39,6 +39,23 @@ class LIBDOOMSDAY_PUBLIC Blockmap
 public:
     typedef de::Vec2ui Cell;
 
+    /**
+     * How the elements linked into each cell are stored.
+     */
+    enum CellStorage
+    {
+        /// Cells are allocated on demand in a quadtree and each cell stores its elements
+        /// in a linked ring of nodes. Suitable for sparsely populated, static contents.
+        RingStorage,
+
+        /// Each cell stores its elements in a contiguous array, and an element-to-slot
+        /// index makes unlinking O(1). Suitable for contents that are relinked often,
+        /// such as map-objects. Linking, unlinking and iteration behave exactly like
+        /// RingStorage: an element may be linked more than once into the same cell, and
+        /// elements are visited in the same order.
+        FlatStorage
+    };
+
     /**
      * POD structure for representing an inclusive-exclusive rectangular range
      * of cells.
@@ -58,8 +75,9 @@ public:
     /**
      * @param bounds    Map space boundary.
      * @param cellSize  Width and height of a cell in map space units.
+     * @param storage   Storage backend for the cells' elements.
      */
-    Blockmap(const AABoxd &bounds, de::duint cellSize = 128);
+    Blockmap(const AABoxd &bounds, de::duint cellSize = 128, CellStorage storage = RingStorage);
 
     virtual ~Blockmap();
 
@@ -93,6 +111,11 @@ public:
      */
     inline bool isNull() const { return (width() * height()) == 0; }
 
+    /**
+     * Returns the storage backend of the cells.
+     */
+    CellStorage cellStorage() const;
+
     /**
      * Returns the size of a cell (width and height) in map space units.
      */
@@ -154,7 +177,7 @@ public:
 
     /**
      * Iterate through all objects in all cells which intercept the given map
-     * space, axis-aligned bounding @a box.
+     * space, axis-aligned bounding @a box. Cells are visited in row order.
      */
     de::LoopResult forAllInBox(const AABoxd &box, std::function<de::LoopResult (void *object)> func) const;
 
@@ -27,6 +27,7 @@
 
 #include <de/set.h>
 #include <de/observers.h>
+#include <de/string.h>
 #include <de/vector.h>
 
 namespace world {
@@ -71,6 +72,36 @@ public:
      */
     void setSplitCostFactor(int newFactor);
 
+    /**
+     * Enable or disable the parallel build (enabled by default). When enabled, the
+     * partitions of independent subspaces are evaluated concurrently. The resulting
+     * tree is identical to the one produced by a serial build.
+     */
+    void setParallelBuild(bool enabled);
+
+    /**
+     * Enable the persistent partition cache. The sequence of partition choices made
+     * during a build is saved in @a folderPath (in the app file system), keyed by a
+     * hash of the source line geometry and the split cost factor. When a matching
+     * record is found on a later build, the (expensive) partition cost evaluation is
+     * skipped and the recorded choices are replayed instead, producing an identical
+     * tree. Stale or corrupt records are detected, discarded and rewritten.
+     *
+     * @param folderPath  Cache folder path. Use an empty string to disable caching.
+     */
+    void setCachePath(const de::String &folderPath);
+
+    struct CacheCounts
+    {
+        int hits;
+        int misses;
+    };
+
+    /**
+     * Returns the number of partition cache hits and misses since startup.
+     */
+    static CacheCounts cacheCounts();
+
     /**
      * Build a new BspTree for the given geometry.
      *
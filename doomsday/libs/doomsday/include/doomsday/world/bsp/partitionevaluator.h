@@ -40,11 +40,26 @@ public:
     /**
      * Find the best line segment to use as the next partition.
      *
-     * @param node  Block tree node containing the remaining line segments.
+     * @param node           Block tree node containing the remaining line segments.
+     * @param chosenOrdinal  If not @c nullptr, the ordinal of the chosen line in the
+     *                       candidate enumeration order is written here (@c -1 if
+     *                       no suitable partition was found).
      *
      * @return  The chosen partition line.
      */
-    LineSegmentSide *choose(LineSegmentBlockTreeNode &node);
+    LineSegmentSide *choose(LineSegmentBlockTreeNode &node, int *chosenOrdinal = nullptr);
+
+    /**
+     * Locate a partition candidate by its ordinal in the (deterministic) candidate
+     * enumeration order, without evaluating any costs. Used for replaying a known
+     * sequence of choices.
+     *
+     * @param node     Block tree node containing the remaining line segments.
+     * @param ordinal  Ordinal of the candidate, as returned by choose().
+     *
+     * @return  The candidate line; otherwise @c nullptr if @a ordinal is out of range.
+     */
+    LineSegmentSide *candidate(LineSegmentBlockTreeNode &node, int ordinal);
 
 private:
     DE_PRIVATE(d)
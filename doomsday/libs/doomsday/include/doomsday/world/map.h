@@ -45,6 +45,7 @@ class IThinkerMapping;
 class Line;
 class LineBlockmap;
 class LineSide;
+class MapElement;
 class Sky;
 class Subsector;
 class Surface;
@@ -91,6 +92,18 @@ public:
     /// Notified when the map is about to be deleted.
     DE_AUDIENCE(Deletion, void mapBeingDeleted(const Map &map))
 
+    /// Notified when a property of a map element is written via the DMU API (i.e.,
+    /// by the playsim). @a element is the element that was ultimately written to.
+    DE_AUDIENCE(ElementPropertyChange, void mapElementPropertyChanged(MapElement &element, int property))
+
+    /// Notified when a map-object has been (un)linked or its state has changed, or the
+    /// game has reported a change to it (see notifyMobjChanged()).
+    DE_AUDIENCE(MobjChange, void mapMobjChanged(const struct mobj_s &mob))
+
+    /// Notified when a polyobj has moved or rotated, or the game has reported a change
+    /// to it (see notifyPolyobjChanged()).
+    DE_AUDIENCE(PolyobjChange, void mapPolyobjChanged(const struct polyobj_s &polyobj))
+
 public:
     /**
      * @param manifest  Resource manifest for the map (Can be set later, @ref setDef).
@@ -304,6 +317,13 @@ public:
      */
     virtual int unlink(struct mobj_s &mob);
 
+    /**
+     * Notifies the MobjChange audience about a change to a map-object.
+     *
+     * @param mob  Map-object that has changed.
+     */
+    void notifyMobjChanged(const struct mobj_s &mob);
+
 //- Vertices --------------------------------------------------------------------------------------
 
     /**
@@ -354,6 +374,13 @@ public:
      */
     void link(Polyobj &polyobj);
 
+    /**
+     * Notifies the PolyobjChange audience about a change to a polyobj.
+     *
+     * @param polyobj  Poly-object that has changed.
+     */
+    void notifyPolyobjChanged(const Polyobj &polyobj);
+
     /**
      * Unlink the specified @a polyobj from any internal data structures for bookkeeping
      * purposes. Should be called BEFORE Polyobj rotation and/or translation to extract
@@ -1188,6 +1188,7 @@ public:
                     {
                         const ded_sprid_t &origSprite = origSpriteNames[offset];
                         strncpy(sprite->id, origSprite.id, DED_STRINGID_LEN + 1);
+                        ded->spriteIndex.invalidate();
                         LOG_DEBUG("Sprite #%i id => \"%s\" (#%i)") << sprNum << sprite->id << offset;
                     }
                 }
@@ -1812,6 +1813,7 @@ public:
             if (String(defs->sprites[i].id).compareWithoutCase(origName) == 0)
             {
                 strcpy(defs->sprites[i].id, newName);
+                defs->spriteIndex.invalidate();
                 LOG_DEBUG("Sprite #%d \"%s\" => \"%s\"")
                     << i << origName << newName;
 
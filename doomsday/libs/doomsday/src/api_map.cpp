@@ -480,6 +480,14 @@ static void setProperty(world::MapElement *elem, world::DmuArgs &args)
     // Write the property value(s).
     /// @throws MapElement::WritePropertyError  If the requested property is not writable.
     elem->setProperty(args);
+
+    if(world::Map *map = elem->mapPtr())
+    {
+        DE_FOR_OBSERVERS(i, map->audienceForElementPropertyChange())
+        {
+            i->mapElementPropertyChanged(*elem, args.prop);
+        }
+    }
 }
 
 static void getProperty(const world::MapElement *elem, world::DmuArgs &args)
@@ -1256,13 +1264,23 @@ uint P_CountMapObjs(int entityId)
 void Mobj_Link(mobj_t *mobj, int flags)
 {
     if(!mobj || !world::World::get().hasMap()) return; // Huh?
-    world::World::get().map().link(*mobj, flags);
+    world::Map &map = world::World::get().map();
+    map.link(*mobj, flags);
+    map.notifyMobjChanged(*mobj);
 }
 
 void Mobj_Unlink(mobj_t *mobj)
 {
     if(!mobj || !Mobj_IsLinked(*mobj)) return;
-    Mobj_Map(*mobj).unlink(*mobj);
+    world::Map &map = Mobj_Map(*mobj);
+    map.unlink(*mobj);
+    map.notifyMobjChanged(*mobj);
+}
+
+void Mobj_MarkChanged(mobj_t *mobj)
+{
+    if(!mobj || !world::World::get().hasMap()) return;
+    Mobj_Map(*mobj).notifyMobjChanged(*mobj);
 }
 
 int Mobj_TouchedLinesIterator(mobj_t *mob, int (*callback) (world::Line *, void *), void *context)
@@ -1518,6 +1536,12 @@ dd_bool Polyobj_Rotate(Polyobj *po, angle_t angle)
     return po->rotate(angle);
 }
 
+void Polyobj_MarkChanged(Polyobj *po)
+{
+    if(!po) return;
+    po->map().notifyPolyobjChanged(*po);
+}
+
 world_Line *Polyobj_FirstLine(Polyobj *po)
 {
     if(!po) return 0;
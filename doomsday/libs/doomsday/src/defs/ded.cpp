@@ -68,6 +68,11 @@ ded_s::ded_s()
     , mapInfos   (names.addSubrecord("mapInfos"))
     , finales    (names.addSubrecord("finales"))
     , decorations(names.addSubrecord("decorations"))
+    , spriteIndex   (DEDIndex::FirstDefined,  [this] (int i) { return sprites[i].id; })
+    , soundIndex    (DEDIndex::FirstDefined,  [this] (int i) { return sounds[i].id; })
+    , soundNameIndex(DEDIndex::FirstDefined,  [this] (int i) { return sounds[i].name; })
+    , textIndex     (DEDIndex::LatestDefined, [this] (int i) { return text[i].id; })
+    , valueIndex    (DEDIndex::LatestDefined, [this] (int i) { return values[i].id; })
 {
     decorations.addLookupKey("texture");
     episodes.addLookupKey(defn::Definition::VAR_ID);
@@ -204,6 +209,12 @@ void ded_s::release()
     lineTypes.clear();
     ptcGens.clear();
     finales.clear();
+
+    spriteIndex.clear();
+    soundIndex.clear();
+    soundNameIndex.clear();
+    textIndex.clear();
+    valueIndex.clear();
 }
 
 /*
@@ -529,15 +540,7 @@ int ded_s::getSoundNum(const String &id) const
 
 int ded_s::getSoundNum(const char *id) const
 {
-    int idx = -1;
-    if (id && id[0] && sounds.size())
-    {
-        int i = 0;
-        do {
-            if (!iCmpStrCase(sounds[i].id, id)) idx = i;
-        } while (idx == -1 && ++i < sounds.size());
-    }
-    return idx;
+    return soundIndex.find(id, sounds.size());
 }
 
 int ded_s::getSoundNumForName(const char *name) const
@@ -545,11 +548,8 @@ int ded_s::getSoundNumForName(const char *name) const
     if (!name || !name[0])
         return -1;
 
-    for (int i = 0; i < sounds.size(); ++i)
-        if (!iCmpStrCase(sounds[i].name, name))
-            return i;
-
-    return 0;
+    const int idx = soundNameIndex.find(name, sounds.size());
+    return idx >= 0? idx : 0;
 }
 
 int ded_s::getSpriteNum(const String &id) const
@@ -559,15 +559,7 @@ int ded_s::getSpriteNum(const String &id) const
 
 int ded_s::getSpriteNum(const char *id) const
 {
-    if (id && id[0])
-    {
-        for (dint i = 0; i < sprites.size(); ++i)
-        {
-            if (!iCmpStrCase(sprites[i].id, id))
-                return i;
-        }
-    }
-    return -1;  // Not found.
+    return spriteIndex.find(id, sprites.size());
 }
 
 int ded_s::getMusicNum(const char *id) const
@@ -591,16 +583,8 @@ int ded_s::getMusicNum(const char *id) const
 
 int ded_s::getValueNum(const char *id) const
 {
-    if (id && id[0])
-    {
-        // Read backwards to allow patching.
-        for (dint i = values.size() - 1; i >= 0; i--)
-        {
-            if (!iCmpStrCase(values[i].id, id))
-                return i;
-        }
-    }
-    return -1;  // Not found.
+    // The latest definition is found to allow patching.
+    return valueIndex.find(id, values.size());
 }
 
 int ded_s::getValueNum(const String &id) const
@@ -610,15 +594,9 @@ int ded_s::getValueNum(const String &id) const
 
 ded_value_t *ded_s::getValueById(const char *id) const
 {
-    if (!id || !id[0]) return nullptr;
-
-    // Read backwards to allow patching.
-    for (dint i = values.size() - 1; i >= 0; i--)
-    {
-        if (!iCmpStrCase(values[i].id, id))
-            return &values[i];
-    }
-    return nullptr;
+    const int idx = getValueNum(id);
+    if (idx < 0) return nullptr;
+    return &values[idx];
 }
 ded_value_t *ded_s::getValueById(const String &id) const
 {
@@ -694,15 +672,30 @@ String ded_s::findEpisode(const String &mapId) const
 
 int ded_s::getTextNum(const char *id) const
 {
-    if (id && id[0])
-    {
-        // Search in reverse insertion order to allow patching.
-        for (int i = text.size() - 1; i >= 0; i--)
-        {
-            if (!iCmpStrCase(text[i].id, id)) return i;
-        }
-    }
-    return -1; // Not found.
+    // The latest definition is found to allow patching.
+    return textIndex.find(id, text.size());
+}
+
+KeyMap<String, duint64> ded_s::lookupCounts() const
+{
+    KeyMap<String, duint64> counts;
+    counts.insert("decorations", decorations.lookupCount());
+    counts.insert("episodes",    episodes.lookupCount());
+    counts.insert("finales",     finales.lookupCount());
+    counts.insert("flags",       flags.lookupCount());
+    counts.insert("mapInfos",    mapInfos.lookupCount());
+    counts.insert("materials",   materials.lookupCount());
+    counts.insert("models",      models.lookupCount());
+    counts.insert("musics",      musics.lookupCount());
+    counts.insert("skies",       skies.lookupCount());
+    counts.insert("soundNames",  soundNameIndex.lookupCount());
+    counts.insert("sounds",      soundIndex.lookupCount());
+    counts.insert("sprites",     spriteIndex.lookupCount());
+    counts.insert("states",      states.lookupCount());
+    counts.insert("text",        textIndex.lookupCount());
+    counts.insert("things",      things.lookupCount());
+    counts.insert("values",      valueIndex.lookupCount());
+    return counts;
 }
 
 static ded_t *s_defs = nullptr;
@@ -0,0 +1,862 @@
+/** @file dedcache.cpp  Binary cache of the definition database.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/defs/dedcache.h"
+#include "doomsday/defs/dedfile.h"
+#include "doomsday/filesys/fs_main.h"
+
+#include <de/legacy/memory.h>
+#include <de/app.h>
+#include <de/byterefarray.h>
+#include <de/folder.h>
+#include <de/log.h>
+#include <de/reader.h>
+#include <de/set.h>
+#include <de/writer.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sys/stat.h>
+#ifdef WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#  include <io.h>
+#else
+#  include <sys/mman.h>
+#endif
+
+using namespace de;
+using namespace res;
+
+/*
+ * The cache file consists of:
+ * - magic, version, struct layout signature, key (Block)
+ * - sources: count, and for each: path, size, modification time (seconds), MD5 hash
+ * - model search paths (StringList)
+ * - the ded_t scalar members
+ * - each DEDRegister: count, and the serialized Record of each definition
+ * - each DEDArray: count, the elements as raw bytes, and the data referenced by the
+ *   pointers of each element (URIs, strings, nested arrays)
+ */
+static const duint32 DEDCACHE_MAGIC   = 0x43444544; // "DEDC"
+static const duint32 DEDCACHE_VERSION = 1;
+
+DE_ERROR(DEDCacheError);
+
+/**
+ * Signature of the layout of the definition structs that are stored as raw bytes:
+ * the size of each struct and the offset and size of each of its members. Members
+ * added to these structs must be added here, too.
+ */
+static duint32 dedCacheLayout()
+{
+#define DEDCACHE_STRUCT(Type)         dsize(sizeof(Type))
+#define DEDCACHE_FIELD(Type, Member)  dsize(offsetof(Type, Member)), dsize(sizeof(Type::Member))
+
+    const dsize layout[] = {
+        sizeof(void *),
+        sizeof(DEDArray<ded_uri_t>),
+
+        DEDCACHE_STRUCT(ded_count_t),
+        DEDCACHE_FIELD(ded_count_t, num), DEDCACHE_FIELD(ded_count_t, max),
+
+        DEDCACHE_STRUCT(ded_uri_t),
+        DEDCACHE_FIELD(ded_uri_t, uri),
+
+        DEDCACHE_STRUCT(ded_embsound_t),
+        DEDCACHE_FIELD(ded_embsound_t, name), DEDCACHE_FIELD(ded_embsound_t, id),
+        DEDCACHE_FIELD(ded_embsound_t, volume),
+
+        DEDCACHE_STRUCT(ded_ptcstage_t),
+        DEDCACHE_FIELD(ded_ptcstage_t, type), DEDCACHE_FIELD(ded_ptcstage_t, tics),
+        DEDCACHE_FIELD(ded_ptcstage_t, variance), DEDCACHE_FIELD(ded_ptcstage_t, color),
+        DEDCACHE_FIELD(ded_ptcstage_t, radius),
+        DEDCACHE_FIELD(ded_ptcstage_t, radiusVariance),
+        DEDCACHE_FIELD(ded_ptcstage_t, flags), DEDCACHE_FIELD(ded_ptcstage_t, bounce),
+        DEDCACHE_FIELD(ded_ptcstage_t, resistance), DEDCACHE_FIELD(ded_ptcstage_t, gravity),
+        DEDCACHE_FIELD(ded_ptcstage_t, vectorForce), DEDCACHE_FIELD(ded_ptcstage_t, spin),
+        DEDCACHE_FIELD(ded_ptcstage_t, spinResistance),
+        DEDCACHE_FIELD(ded_ptcstage_t, model), DEDCACHE_FIELD(ded_ptcstage_t, frameName),
+        DEDCACHE_FIELD(ded_ptcstage_t, endFrameName), DEDCACHE_FIELD(ded_ptcstage_t, frame),
+        DEDCACHE_FIELD(ded_ptcstage_t, endFrame), DEDCACHE_FIELD(ded_ptcstage_t, sound),
+        DEDCACHE_FIELD(ded_ptcstage_t, hitSound),
+
+        DEDCACHE_STRUCT(ded_sprid_t),
+        DEDCACHE_FIELD(ded_sprid_t, id),
+
+        DEDCACHE_STRUCT(ded_light_t),
+        DEDCACHE_FIELD(ded_light_t, state), DEDCACHE_FIELD(ded_light_t, uniqueMapID),
+        DEDCACHE_FIELD(ded_light_t, offset), DEDCACHE_FIELD(ded_light_t, size),
+        DEDCACHE_FIELD(ded_light_t, color), DEDCACHE_FIELD(ded_light_t, lightLevel),
+        DEDCACHE_FIELD(ded_light_t, flags), DEDCACHE_FIELD(ded_light_t, up),
+        DEDCACHE_FIELD(ded_light_t, down), DEDCACHE_FIELD(ded_light_t, sides),
+        DEDCACHE_FIELD(ded_light_t, flare), DEDCACHE_FIELD(ded_light_t, haloRadius),
+
+        DEDCACHE_STRUCT(ded_sound_t),
+        DEDCACHE_FIELD(ded_sound_t, id), DEDCACHE_FIELD(ded_sound_t, name),
+        DEDCACHE_FIELD(ded_sound_t, lumpName), DEDCACHE_FIELD(ded_sound_t, ext),
+        DEDCACHE_FIELD(ded_sound_t, link), DEDCACHE_FIELD(ded_sound_t, linkPitch),
+        DEDCACHE_FIELD(ded_sound_t, linkVolume), DEDCACHE_FIELD(ded_sound_t, priority),
+        DEDCACHE_FIELD(ded_sound_t, channels), DEDCACHE_FIELD(ded_sound_t, group),
+        DEDCACHE_FIELD(ded_sound_t, flags),
+
+        DEDCACHE_STRUCT(ded_text_t),
+        DEDCACHE_FIELD(ded_text_t, id), DEDCACHE_FIELD(ded_text_t, text),
+
+        DEDCACHE_STRUCT(ded_tenviron_t),
+        DEDCACHE_FIELD(ded_tenviron_t, id), DEDCACHE_FIELD(ded_tenviron_t, materials),
+
+        DEDCACHE_STRUCT(ded_value_t),
+        DEDCACHE_FIELD(ded_value_t, id), DEDCACHE_FIELD(ded_value_t, text),
+
+        DEDCACHE_STRUCT(ded_linetype_t),
+        DEDCACHE_FIELD(ded_linetype_t, id), DEDCACHE_FIELD(ded_linetype_t, comment),
+        DEDCACHE_FIELD(ded_linetype_t, flags), DEDCACHE_FIELD(ded_linetype_t, lineClass),
+        DEDCACHE_FIELD(ded_linetype_t, actType), DEDCACHE_FIELD(ded_linetype_t, actCount),
+        DEDCACHE_FIELD(ded_linetype_t, actTime), DEDCACHE_FIELD(ded_linetype_t, actTag),
+        DEDCACHE_FIELD(ded_linetype_t, aparm), DEDCACHE_FIELD(ded_linetype_t, aparm9),
+        DEDCACHE_FIELD(ded_linetype_t, tickerStart),
+        DEDCACHE_FIELD(ded_linetype_t, tickerEnd),
+        DEDCACHE_FIELD(ded_linetype_t, tickerInterval),
+        DEDCACHE_FIELD(ded_linetype_t, actSound),
+        DEDCACHE_FIELD(ded_linetype_t, deactSound), DEDCACHE_FIELD(ded_linetype_t, evChain),
+        DEDCACHE_FIELD(ded_linetype_t, actChain),
+        DEDCACHE_FIELD(ded_linetype_t, deactChain),
+        DEDCACHE_FIELD(ded_linetype_t, actLineType),
+        DEDCACHE_FIELD(ded_linetype_t, deactLineType),
+        DEDCACHE_FIELD(ded_linetype_t, wallSection),
+        DEDCACHE_FIELD(ded_linetype_t, actMaterial),
+        DEDCACHE_FIELD(ded_linetype_t, deactMaterial),
+        DEDCACHE_FIELD(ded_linetype_t, actMsg), DEDCACHE_FIELD(ded_linetype_t, deactMsg),
+        DEDCACHE_FIELD(ded_linetype_t, materialMoveAngle),
+        DEDCACHE_FIELD(ded_linetype_t, materialMoveSpeed),
+        DEDCACHE_FIELD(ded_linetype_t, iparm), DEDCACHE_FIELD(ded_linetype_t, iparmStr),
+        DEDCACHE_FIELD(ded_linetype_t, fparm), DEDCACHE_FIELD(ded_linetype_t, sparm),
+
+        DEDCACHE_STRUCT(ded_sectortype_t),
+        DEDCACHE_FIELD(ded_sectortype_t, id), DEDCACHE_FIELD(ded_sectortype_t, comment),
+        DEDCACHE_FIELD(ded_sectortype_t, flags), DEDCACHE_FIELD(ded_sectortype_t, actTag),
+        DEDCACHE_FIELD(ded_sectortype_t, chain),
+        DEDCACHE_FIELD(ded_sectortype_t, chainFlags),
+        DEDCACHE_FIELD(ded_sectortype_t, start), DEDCACHE_FIELD(ded_sectortype_t, end),
+        DEDCACHE_FIELD(ded_sectortype_t, interval), DEDCACHE_FIELD(ded_sectortype_t, count),
+        DEDCACHE_FIELD(ded_sectortype_t, ambientSound),
+        DEDCACHE_FIELD(ded_sectortype_t, soundInterval),
+        DEDCACHE_FIELD(ded_sectortype_t, materialMoveAngle),
+        DEDCACHE_FIELD(ded_sectortype_t, materialMoveSpeed),
+        DEDCACHE_FIELD(ded_sectortype_t, windAngle),
+        DEDCACHE_FIELD(ded_sectortype_t, windSpeed),
+        DEDCACHE_FIELD(ded_sectortype_t, verticalWind),
+        DEDCACHE_FIELD(ded_sectortype_t, gravity),
+        DEDCACHE_FIELD(ded_sectortype_t, friction),
+        DEDCACHE_FIELD(ded_sectortype_t, lightFunc),
+        DEDCACHE_FIELD(ded_sectortype_t, lightInterval),
+        DEDCACHE_FIELD(ded_sectortype_t, colFunc),
+        DEDCACHE_FIELD(ded_sectortype_t, colInterval),
+        DEDCACHE_FIELD(ded_sectortype_t, floorFunc),
+        DEDCACHE_FIELD(ded_sectortype_t, floorMul),
+        DEDCACHE_FIELD(ded_sectortype_t, floorOff),
+        DEDCACHE_FIELD(ded_sectortype_t, floorInterval),
+        DEDCACHE_FIELD(ded_sectortype_t, ceilFunc),
+        DEDCACHE_FIELD(ded_sectortype_t, ceilMul),
+        DEDCACHE_FIELD(ded_sectortype_t, ceilOff),
+        DEDCACHE_FIELD(ded_sectortype_t, ceilInterval),
+
+        DEDCACHE_STRUCT(ded_detail_stage_t),
+        DEDCACHE_FIELD(ded_detail_stage_t, tics),
+        DEDCACHE_FIELD(ded_detail_stage_t, variance),
+        DEDCACHE_FIELD(ded_detail_stage_t, texture),
+        DEDCACHE_FIELD(ded_detail_stage_t, scale),
+        DEDCACHE_FIELD(ded_detail_stage_t, strength),
+        DEDCACHE_FIELD(ded_detail_stage_t, maxDistance),
+
+        DEDCACHE_STRUCT(ded_detailtexture_t),
+        DEDCACHE_FIELD(ded_detailtexture_t, material1),
+        DEDCACHE_FIELD(ded_detailtexture_t, material2),
+        DEDCACHE_FIELD(ded_detailtexture_t, flags),
+        DEDCACHE_FIELD(ded_detailtexture_t, stage),
+
+        DEDCACHE_STRUCT(ded_ptcgen_t),
+        DEDCACHE_FIELD(ded_ptcgen_t, stateNext), DEDCACHE_FIELD(ded_ptcgen_t, state),
+        DEDCACHE_FIELD(ded_ptcgen_t, material), DEDCACHE_FIELD(ded_ptcgen_t, type),
+        DEDCACHE_FIELD(ded_ptcgen_t, type2), DEDCACHE_FIELD(ded_ptcgen_t, typeNum),
+        DEDCACHE_FIELD(ded_ptcgen_t, type2Num), DEDCACHE_FIELD(ded_ptcgen_t, damage),
+        DEDCACHE_FIELD(ded_ptcgen_t, damageNum), DEDCACHE_FIELD(ded_ptcgen_t, map),
+        DEDCACHE_FIELD(ded_ptcgen_t, flags), DEDCACHE_FIELD(ded_ptcgen_t, speed),
+        DEDCACHE_FIELD(ded_ptcgen_t, speedVariance), DEDCACHE_FIELD(ded_ptcgen_t, vector),
+        DEDCACHE_FIELD(ded_ptcgen_t, vectorVariance),
+        DEDCACHE_FIELD(ded_ptcgen_t, initVectorVariance),
+        DEDCACHE_FIELD(ded_ptcgen_t, center), DEDCACHE_FIELD(ded_ptcgen_t, subModel),
+        DEDCACHE_FIELD(ded_ptcgen_t, spawnRadius),
+        DEDCACHE_FIELD(ded_ptcgen_t, spawnRadiusMin), DEDCACHE_FIELD(ded_ptcgen_t, maxDist),
+        DEDCACHE_FIELD(ded_ptcgen_t, spawnAge), DEDCACHE_FIELD(ded_ptcgen_t, maxAge),
+        DEDCACHE_FIELD(ded_ptcgen_t, particles), DEDCACHE_FIELD(ded_ptcgen_t, spawnRate),
+        DEDCACHE_FIELD(ded_ptcgen_t, spawnRateVariance),
+        DEDCACHE_FIELD(ded_ptcgen_t, preSim), DEDCACHE_FIELD(ded_ptcgen_t, altStart),
+        DEDCACHE_FIELD(ded_ptcgen_t, altStartVariance), DEDCACHE_FIELD(ded_ptcgen_t, force),
+        DEDCACHE_FIELD(ded_ptcgen_t, forceRadius), DEDCACHE_FIELD(ded_ptcgen_t, forceAxis),
+        DEDCACHE_FIELD(ded_ptcgen_t, forceOrigin), DEDCACHE_FIELD(ded_ptcgen_t, stages),
+
+        DEDCACHE_STRUCT(ded_shine_stage_t),
+        DEDCACHE_FIELD(ded_shine_stage_t, tics),
+        DEDCACHE_FIELD(ded_shine_stage_t, variance),
+        DEDCACHE_FIELD(ded_shine_stage_t, texture),
+        DEDCACHE_FIELD(ded_shine_stage_t, maskTexture),
+        DEDCACHE_FIELD(ded_shine_stage_t, blendMode),
+        DEDCACHE_FIELD(ded_shine_stage_t, shininess),
+        DEDCACHE_FIELD(ded_shine_stage_t, minColor),
+        DEDCACHE_FIELD(ded_shine_stage_t, maskWidth),
+        DEDCACHE_FIELD(ded_shine_stage_t, maskHeight),
+
+        DEDCACHE_STRUCT(ded_reflection_t),
+        DEDCACHE_FIELD(ded_reflection_t, material), DEDCACHE_FIELD(ded_reflection_t, flags),
+        DEDCACHE_FIELD(ded_reflection_t, stage),
+
+        DEDCACHE_STRUCT(ded_group_member_t),
+        DEDCACHE_FIELD(ded_group_member_t, material),
+        DEDCACHE_FIELD(ded_group_member_t, tics),
+        DEDCACHE_FIELD(ded_group_member_t, randomTics),
+
+        DEDCACHE_STRUCT(ded_group_t),
+        DEDCACHE_FIELD(ded_group_t, flags), DEDCACHE_FIELD(ded_group_t, members),
+
+        DEDCACHE_STRUCT(ded_compositefont_mappedcharacter_t),
+        DEDCACHE_FIELD(ded_compositefont_mappedcharacter_t, ch),
+        DEDCACHE_FIELD(ded_compositefont_mappedcharacter_t, path),
+
+        DEDCACHE_STRUCT(ded_compositefont_t),
+        DEDCACHE_FIELD(ded_compositefont_t, uri),
+        DEDCACHE_FIELD(ded_compositefont_t, charMap),
+    };
+
+#undef DEDCACHE_FIELD
+#undef DEDCACHE_STRUCT
+
+    duint32 hash = 2166136261u;
+    for (dsize value : layout)
+    {
+        hash = (hash ^ duint32(value)) * 16777619u;
+    }
+    return hash;
+}
+
+//---------------------------------------------------------------------------------------
+
+struct DEDCacheSource
+{
+    String path;
+    dint64 size = 0;
+    dint64 modifiedAt = 0; ///< Seconds since the epoch.
+    Block hash;
+};
+
+/**
+ * Determines the size and modification time of a definition file, looking it up the
+ * same way as Def_ReadProcessDED().
+ */
+static bool dedSourceStatus(const String &path, dint64 &size, dint64 &modifiedAt)
+{
+    if (const File *file = App::rootFolder().tryLocate<File const>(path))
+    {
+        size       = dint64(file->size());
+        modifiedAt = dint64(file->status().modifiedAt.toTime_t());
+        return true;
+    }
+    try
+    {
+        const String fullPath = (NativePath::workPath() / NativePath(path).expand()).withSeparators('/');
+        std::unique_ptr<FileHandle> hndl(&App_FileSystem().openFile(fullPath, "rb"));
+        File1 &file = hndl->file();
+        size       = dint64(file.size());
+        modifiedAt = dint64(file.lastModified());
+        App_FileSystem().releaseFile(file);
+        return true;
+    }
+    catch (const FS1::NotFoundError &)
+    {}
+    return false;
+}
+
+/**
+ * Calculates the MD5 hash of the contents of a definition file.
+ */
+static bool dedSourceHash(const String &path, Block &hash)
+{
+    Block content;
+    if (const File *file = App::rootFolder().tryLocate<File const>(path))
+    {
+        *file >> content;
+        hash = content.md5Hash();
+        return true;
+    }
+    try
+    {
+        const String fullPath = (NativePath::workPath() / NativePath(path).expand()).withSeparators('/');
+        std::unique_ptr<FileHandle> hndl(&App_FileSystem().openFile(fullPath, "rb"));
+        content.resize(hndl->length());
+        hndl->read(content.data(), content.size());
+        App_FileSystem().releaseFile(hndl->file());
+        hash = content.md5Hash();
+        return true;
+    }
+    catch (const FS1::NotFoundError &)
+    {}
+    return false;
+}
+
+static bool dedSourceIsCurrent(const DEDCacheSource &source)
+{
+    dint64 size, modifiedAt;
+    if (!dedSourceStatus(source.path, size, modifiedAt)) return false;
+    if (size != source.size) return false;
+    if (modifiedAt == source.modifiedAt) return true;
+
+    // The file has been touched; compare the contents.
+    Block hash;
+    return dedSourceHash(source.path, hash) && hash == source.hash;
+}
+
+//---------------------------------------------------------------------------------------
+
+static void writeCachedUri(Writer &to, const res::Uri *uri)
+{
+    to << duint8(uri? 1 : 0);
+    if (uri) to << *uri;
+}
+
+static void readCachedUri(Reader &from, res::Uri *&uri)
+{
+    duint8 present;
+    from >> present;
+    if (present)
+    {
+        std::unique_ptr<res::Uri> read(new res::Uri);
+        from >> *read;
+        uri = read.release();
+    }
+}
+
+static void writeCachedString(Writer &to, const char *str)
+{
+    to << duint8(str? 1 : 0);
+    if (str) to << Block(str, std::strlen(str));
+}
+
+static void readCachedString(Reader &from, char *&str)
+{
+    duint8 present;
+    from >> present;
+    if (present)
+    {
+        Block text;
+        from >> text;
+        str = static_cast<char *>(M_Malloc(text.size() + 1));
+        std::memcpy(str, text.data(), text.size());
+        str[text.size()] = 0;
+    }
+}
+
+template <typename PODType>
+static void resetCachedArray(DEDArray<PODType> &array)
+{
+    array.elements = nullptr;
+    array.count    = ded_count_t();
+}
+
+/**
+ * Writes the elements of @a array as raw bytes. @a writePointers writes the data that
+ * the pointers of an element refer to.
+ */
+template <typename PODType, typename WriteFunc>
+static void writeCachedArray(Writer &to, const DEDArray<PODType> &array, WriteFunc writePointers)
+{
+    to << dint32(array.size());
+    if (array.isEmpty()) return;
+
+    to.writeBytes(ByteRefArray(array.elements, sizeof(PODType) * dsize(array.size())));
+    for (int i = 0; i < array.size(); ++i)
+    {
+        writePointers(to, array[i]);
+    }
+}
+
+/**
+ * Reads elements written with writeCachedArray(). @a readPointers must first set all
+ * the pointers of the element to null (they are invalid after the raw bytes have been
+ * read) and then read the data they refer to. If reading fails, the element is
+ * released along with the rest of the array.
+ */
+template <typename PODType, typename ReadFunc>
+static void readCachedArray(Reader &from, DEDArray<PODType> &array, ReadFunc readPointers)
+{
+    dint32 count;
+    from >> count;
+    if (count < 0 || dsize(count) * sizeof(PODType) > from.remainingSize())
+    {
+        throw DEDCacheError("readCachedArray", "Invalid number of elements");
+    }
+    for (dint32 i = 0; i < count; ++i)
+    {
+        PODType *elem = array.append();
+        ByteRefArray raw(elem, sizeof(PODType));
+        try
+        {
+            from.readBytesFixedSize(raw);
+        }
+        catch (...)
+        {
+            std::memset(elem, 0, sizeof(PODType));
+            throw;
+        }
+        readPointers(from, *elem);
+    }
+}
+
+static void writeCachedRegister(Writer &to, const DEDRegister &reg)
+{
+    to << dint32(reg.size());
+    for (int i = 0; i < reg.size(); ++i)
+    {
+        to << reg[i];
+    }
+}
+
+static void readCachedRegister(Reader &from, DEDRegister &reg)
+{
+    dint32 count;
+    from >> count;
+    if (count < 0 || dsize(count) > from.remainingSize())
+    {
+        throw DEDCacheError("readCachedRegister", "Invalid number of definitions");
+    }
+    for (dint32 i = 0; i < count; ++i)
+    {
+        // Adding the members to the definition updates the lookups of the register.
+        from >> reg.append();
+    }
+}
+
+static void writeCachedDefs(Writer &to, const ded_t &defs)
+{
+    to << dint32(defs.version) << dint32(defs.modelFlags) << defs.modelScale << defs.modelOffset;
+
+    writeCachedRegister(to, defs.flags);
+    writeCachedRegister(to, defs.episodes);
+    writeCachedRegister(to, defs.things);
+    writeCachedRegister(to, defs.states);
+    writeCachedRegister(to, defs.materials);
+    writeCachedRegister(to, defs.models);
+    writeCachedRegister(to, defs.skies);
+    writeCachedRegister(to, defs.musics);
+    writeCachedRegister(to, defs.mapInfos);
+    writeCachedRegister(to, defs.finales);
+    writeCachedRegister(to, defs.decorations);
+
+    writeCachedArray(to, defs.sprites, [] (Writer &, const ded_sprid_t &) {});
+    writeCachedArray(to, defs.lights, [] (Writer &to, const ded_light_t &def) {
+        writeCachedUri(to, def.up);
+        writeCachedUri(to, def.down);
+        writeCachedUri(to, def.sides);
+        writeCachedUri(to, def.flare);
+    });
+    writeCachedArray(to, defs.sounds, [] (Writer &to, const ded_sound_t &def) {
+        writeCachedUri(to, def.ext);
+    });
+    writeCachedArray(to, defs.text, [] (Writer &to, const ded_text_t &def) {
+        writeCachedString(to, def.text);
+    });
+    writeCachedArray(to, defs.textureEnv, [] (Writer &to, const ded_tenviron_t &def) {
+        writeCachedArray(to, def.materials, [] (Writer &to, const ded_uri_t &mat) {
+            writeCachedUri(to, mat.uri);
+        });
+    });
+    writeCachedArray(to, defs.values, [] (Writer &to, const ded_value_t &def) {
+        writeCachedString(to, def.id);
+        writeCachedString(to, def.text);
+    });
+    writeCachedArray(to, defs.details, [] (Writer &to, const ded_detailtexture_t &def) {
+        writeCachedUri(to, def.material1);
+        writeCachedUri(to, def.material2);
+        writeCachedUri(to, def.stage.texture);
+    });
+    writeCachedArray(to, defs.ptcGens, [] (Writer &to, const ded_ptcgen_t &def) {
+        writeCachedUri(to, def.material);
+        writeCachedUri(to, def.map);
+        writeCachedArray(to, def.stages, [] (Writer &, const ded_ptcstage_t &) {});
+    });
+    writeCachedArray(to, defs.reflections, [] (Writer &to, const ded_reflection_t &def) {
+        writeCachedUri(to, def.material);
+        writeCachedUri(to, def.stage.texture);
+        writeCachedUri(to, def.stage.maskTexture);
+    });
+    writeCachedArray(to, defs.groups, [] (Writer &to, const ded_group_t &def) {
+        writeCachedArray(to, def.members, [] (Writer &to, const ded_group_member_t &member) {
+            writeCachedUri(to, member.material);
+        });
+    });
+    writeCachedArray(to, defs.lineTypes, [] (Writer &to, const ded_linetype_t &def) {
+        writeCachedUri(to, def.actMaterial);
+        writeCachedUri(to, def.deactMaterial);
+    });
+    writeCachedArray(to, defs.sectorTypes, [] (Writer &, const ded_sectortype_t &) {});
+    writeCachedArray(to, defs.compositeFonts, [] (Writer &to, const ded_compositefont_t &def) {
+        writeCachedUri(to, def.uri);
+        writeCachedArray(to, def.charMap, [] (Writer &to, const ded_compositefont_mappedcharacter_t &ch) {
+            writeCachedUri(to, ch.path);
+        });
+    });
+}
+
+static void readCachedDefs(Reader &from, ded_t &defs)
+{
+    dint32 version, modelFlags;
+    from >> version >> modelFlags >> defs.modelScale >> defs.modelOffset;
+    defs.version    = version;
+    defs.modelFlags = modelFlags;
+
+    readCachedRegister(from, defs.flags);
+    readCachedRegister(from, defs.episodes);
+    readCachedRegister(from, defs.things);
+    readCachedRegister(from, defs.states);
+    readCachedRegister(from, defs.materials);
+    readCachedRegister(from, defs.models);
+    readCachedRegister(from, defs.skies);
+    readCachedRegister(from, defs.musics);
+    readCachedRegister(from, defs.mapInfos);
+    readCachedRegister(from, defs.finales);
+    readCachedRegister(from, defs.decorations);
+
+    readCachedArray(from, defs.sprites, [] (Reader &, ded_sprid_t &) {});
+    readCachedArray(from, defs.lights, [] (Reader &from, ded_light_t &def) {
+        def.up = def.down = def.sides = def.flare = nullptr;
+        readCachedUri(from, def.up);
+        readCachedUri(from, def.down);
+        readCachedUri(from, def.sides);
+        readCachedUri(from, def.flare);
+    });
+    readCachedArray(from, defs.sounds, [] (Reader &from, ded_sound_t &def) {
+        def.ext = nullptr;
+        readCachedUri(from, def.ext);
+    });
+    readCachedArray(from, defs.text, [] (Reader &from, ded_text_t &def) {
+        def.text = nullptr;
+        readCachedString(from, def.text);
+    });
+    readCachedArray(from, defs.textureEnv, [] (Reader &from, ded_tenviron_t &def) {
+        resetCachedArray(def.materials);
+        readCachedArray(from, def.materials, [] (Reader &from, ded_uri_t &mat) {
+            mat.uri = nullptr;
+            readCachedUri(from, mat.uri);
+        });
+    });
+    readCachedArray(from, defs.values, [] (Reader &from, ded_value_t &def) {
+        def.id = def.text = nullptr;
+        readCachedString(from, def.id);
+        readCachedString(from, def.text);
+    });
+    readCachedArray(from, defs.details, [] (Reader &from, ded_detailtexture_t &def) {
+        def.material1 = def.material2 = def.stage.texture = nullptr;
+        readCachedUri(from, def.material1);
+        readCachedUri(from, def.material2);
+        readCachedUri(from, def.stage.texture);
+    });
+    readCachedArray(from, defs.ptcGens, [] (Reader &from, ded_ptcgen_t &def) {
+        def.stateNext = nullptr;
+        def.material = def.map = nullptr;
+        resetCachedArray(def.stages);
+        readCachedUri(from, def.material);
+        readCachedUri(from, def.map);
+        readCachedArray(from, def.stages, [] (Reader &, ded_ptcstage_t &) {});
+    });
+    readCachedArray(from, defs.reflections, [] (Reader &from, ded_reflection_t &def) {
+        def.material = def.stage.texture = def.stage.maskTexture = nullptr;
+        readCachedUri(from, def.material);
+        readCachedUri(from, def.stage.texture);
+        readCachedUri(from, def.stage.maskTexture);
+    });
+    readCachedArray(from, defs.groups, [] (Reader &from, ded_group_t &def) {
+        resetCachedArray(def.members);
+        readCachedArray(from, def.members, [] (Reader &from, ded_group_member_t &member) {
+            member.material = nullptr;
+            readCachedUri(from, member.material);
+        });
+    });
+    readCachedArray(from, defs.lineTypes, [] (Reader &from, ded_linetype_t &def) {
+        def.actMaterial = def.deactMaterial = nullptr;
+        readCachedUri(from, def.actMaterial);
+        readCachedUri(from, def.deactMaterial);
+    });
+    readCachedArray(from, defs.sectorTypes, [] (Reader &, ded_sectortype_t &) {});
+    readCachedArray(from, defs.compositeFonts, [] (Reader &from, ded_compositefont_t &def) {
+        def.uri = nullptr;
+        resetCachedArray(def.charMap);
+        readCachedUri(from, def.uri);
+        readCachedArray(from, def.charMap, [] (Reader &from, ded_compositefont_mappedcharacter_t &ch) {
+            ch.path = nullptr;
+            readCachedUri(from, ch.path);
+        });
+    });
+}
+
+//---------------------------------------------------------------------------------------
+
+/**
+ * Read-only memory mapping of an entire native file.
+ */
+struct DEDCacheMapping
+{
+    const duint8 *data = nullptr;
+    dsize size = 0;
+
+    ~DEDCacheMapping()
+    {
+        if (!data) return;
+#ifdef WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<duint8 *>(data), size);
+#endif
+    }
+
+    bool map(const NativePath &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+
+#ifdef WIN32
+        HANDLE fileHandle = HANDLE(_get_osfhandle(_fileno(file)));
+        LARGE_INTEGER fileSize;
+        if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize) &&
+            fileSize.QuadPart > 0)
+        {
+            if (HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr))
+            {
+                // The view keeps the mapping object alive.
+                data = reinterpret_cast<const duint8 *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                size = dsize(fileSize.QuadPart);
+                CloseHandle(mapping);
+            }
+        }
+#else
+        struct stat st;
+        const int fd = fileno(file);
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *ptr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                data = reinterpret_cast<const duint8 *>(ptr);
+                size = dsize(st.st_size);
+            }
+        }
+#endif
+        std::fclose(file);
+        if (!data) size = 0;
+        return data != nullptr;
+    }
+};
+
+DE_PIMPL_NOREF(DEDCache)
+{
+    NativePath filePath;
+    bool recording = false;
+    StringList recorded;
+
+    ~Impl()
+    {
+        stopRecording();
+    }
+
+    void stopRecording()
+    {
+        if (recording)
+        {
+            Def_SetReadObserver(nullptr);
+            recording = false;
+        }
+    }
+
+    /**
+     * Determines the current status of the files that were read while recording.
+     */
+    List<DEDCacheSource> recordedSources() const
+    {
+        List<DEDCacheSource> sources;
+        Set<String> added;
+        for (const String &path : recorded)
+        {
+            if (added.contains(path)) continue;
+            added.insert(path);
+
+            DEDCacheSource src;
+            src.path = path;
+            if (!dedSourceStatus(path, src.size, src.modifiedAt) || !dedSourceHash(path, src.hash))
+            {
+                throw DEDCacheError("DEDCache::recordedSources", "\"" + path + "\" cannot be read");
+            }
+            sources << src;
+        }
+        return sources;
+    }
+};
+
+DEDCache::DEDCache(const NativePath &filePath)
+    : d(new Impl)
+{
+    d->filePath = filePath;
+}
+
+DEDCache::Result DEDCache::load(ded_t &defs, const Block &key, StringList &modelPaths)
+{
+    LOG_AS("DEDCache");
+
+    DEDCacheMapping mapping;
+    if (!mapping.map(d->filePath))
+    {
+        return Missing;
+    }
+
+    const ByteRefArray bytes(mapping.data, mapping.size);
+    Reader reader(bytes);
+    try
+    {
+        duint32 magic, version, layout;
+        Block cachedKey;
+        reader >> magic >> version >> layout;
+        if (magic != DEDCACHE_MAGIC || version != DEDCACHE_VERSION || layout != dedCacheLayout())
+        {
+            return Invalid;
+        }
+        reader >> cachedKey;
+        if (cachedKey != key)
+        {
+            return KeyMismatch;
+        }
+
+        duint32 sourceCount;
+        reader >> sourceCount;
+        for (duint32 i = 0; i < sourceCount; ++i)
+        {
+            DEDCacheSource src;
+            reader >> src.path >> src.size >> src.modifiedAt >> src.hash;
+            if (!dedSourceIsCurrent(src))
+            {
+                LOG_RES_VERBOSE("\"%s\" has changed") << NativePath(src.path).pretty();
+                return SourcesChanged;
+            }
+        }
+
+        modelPaths.clear();
+        reader.readElements(modelPaths);
+        readCachedDefs(reader, defs);
+        return Loaded;
+    }
+    catch (const Error &er)
+    {
+        LOG_RES_WARNING("Cached definitions in \"%s\" are invalid: %s")
+            << d->filePath.pretty() << er.asText();
+        defs.clear();
+        return Invalid;
+    }
+}
+
+void DEDCache::beginRecording()
+{
+    d->recorded.clear();
+    d->recording = true;
+    Def_SetReadObserver([this] (const String &path)
+    {
+        d->recorded << path;
+    });
+}
+
+bool DEDCache::save(const ded_t &defs, const Block &key, const StringList &modelPaths)
+{
+    LOG_AS("DEDCache");
+
+    d->stopRecording();
+    try
+    {
+        const List<DEDCacheSource> sources = d->recordedSources();
+
+        Block data;
+        Writer writer(data);
+        writer << DEDCACHE_MAGIC << DEDCACHE_VERSION << dedCacheLayout() << key;
+        writer << duint32(sources.size());
+        for (const DEDCacheSource &src : sources)
+        {
+            writer << src.path << src.size << src.modifiedAt << src.hash;
+        }
+        writer.writeElements(modelPaths);
+        writeCachedDefs(writer, defs);
+
+        // Write to a temporary file first so that a partially written cache is never read.
+        d->filePath.fileNamePath().create();
+        const NativePath tempPath = d->filePath + ".tmp";
+        std::FILE *file = std::fopen(tempPath.c_str(), "wb");
+        if (!file)
+        {
+            throw DEDCacheError("DEDCache::save", "Failed to create " + tempPath.pretty());
+        }
+        bool ok = (std::fwrite(data.data(), 1, data.size(), file) == data.size());
+        ok = (std::fclose(file) == 0) && ok;
+        if (ok)
+        {
+#ifdef WIN32
+            d->filePath.remove(); // rename() does not replace an existing file.
+#endif
+            ok = (std::rename(tempPath.c_str(), d->filePath.c_str()) == 0);
+        }
+        if (!ok)
+        {
+            tempPath.remove();
+            throw DEDCacheError("DEDCache::save", "Failed to write " + d->filePath.pretty());
+        }
+
+        LOG_RES_VERBOSE("Saved %i definition sources (%.1f KB) to \"%s\"")
+            << sources.size() << data.size() / 1024.0 << d->filePath.pretty();
+        return true;
+    }
+    catch (const Error &er)
+    {
+        LOG_RES_WARNING("Definitions could not be cached: %s") << er.asText();
+        clear();
+        return false;
+    }
+}
+
+void DEDCache::clear()
+{
+    d->filePath.remove();
+}
+
+const char *DEDCache::resultText(Result result) // static
+{
+    switch (result)
+    {
+    case Loaded:         return "loaded";
+    case Missing:        return "not found";
+    case KeyMismatch:    return "inputs changed";
+    case SourcesChanged: return "definition files changed";
+    case Invalid:        return "invalid";
+    }
+    return "";
+}
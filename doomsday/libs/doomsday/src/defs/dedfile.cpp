@@ -33,6 +33,7 @@ using namespace de;
 using namespace res;
 
 static char dedReadError[512];
+static std::function<void (const String &)> dedReadObserver;
 
 void DED_SetError(const String &message)
 {
@@ -55,6 +56,7 @@ void Def_ReadProcessDED(ded_t *defs, const String& sourcePath)
          {
              App_FatalError("Def_ReadProcessDED: %s\n", dedReadError);
          }
+         if (dedReadObserver) dedReadObserver(sourcePath);
         return; // Done!
     }
     catch (...)
@@ -81,6 +83,12 @@ void Def_ReadProcessDED(ded_t *defs, const String& sourcePath)
     {
         App_FatalError("Def_ReadProcessDED: %s\n", dedReadError);
     }
+    if (dedReadObserver) dedReadObserver(sourcePath);
+}
+
+void Def_SetReadObserver(const std::function<void (const String &)> &observer)
+{
+    dedReadObserver = observer;
 }
 
 int DED_ReadLump(ded_t *ded, lumpnum_t lumpNum)
@@ -0,0 +1,139 @@
+/** @file dedindex.cpp  Identifier index for definition arrays.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/defs/dedindex.h"
+
+#include <de/string.h>
+#include <unordered_map>
+
+using namespace de;
+
+/**
+ * Case-insensitive FNV-1a hash of an identifier. Only ASCII letters are folded,
+ * and other non-ASCII bytes are left out of the hash so that identifiers that
+ * compare equal always have the same hash.
+ */
+static duint32 dedIdentifierHash(const char *id)
+{
+    duint32 hash = 2166136261u;
+    for (const char *c = id; *c; ++c)
+    {
+        int ch = static_cast<unsigned char>(*c);
+        if (ch >= 0x80) continue;
+        if (ch >= 'A' && ch <= 'Z') ch += 'a' - 'A';
+        hash = (hash ^ duint32(ch)) * 16777619u;
+    }
+    return hash;
+}
+
+DE_PIMPL_NOREF(DEDIndex)
+{
+    Precedence precedence;
+    KeyFunc keyAt;
+
+    /// Hash of the identifier => index of the definition. There is one entry for
+    /// each distinct identifier.
+    std::unordered_multimap<duint32, int> lut;
+    int indexedCount = 0;
+    duint64 lookups = 0;
+
+    Impl(Precedence precedence, const KeyFunc &keyAt)
+        : precedence(precedence)
+        , keyAt(keyAt)
+    {}
+
+    const char *key(int index) const
+    {
+        const char *id = keyAt(index);
+        return id? id : "";
+    }
+
+    void add(int index)
+    {
+        const char *id = key(index);
+        if (!id[0]) return;
+
+        const duint32 hash = dedIdentifierHash(id);
+        const auto range = lut.equal_range(hash);
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (!iCmpStrCase(key(i->second), id))
+            {
+                // Same identifier as an earlier definition.
+                if (precedence == LatestDefined) i->second = index;
+                return;
+            }
+        }
+        lut.emplace(hash, index);
+    }
+
+    void update(int count)
+    {
+        if (count < indexedCount)
+        {
+            // Definitions have been removed.
+            lut.clear();
+            indexedCount = 0;
+        }
+        for (; indexedCount < count; ++indexedCount)
+        {
+            add(indexedCount);
+        }
+    }
+};
+
+DEDIndex::DEDIndex(Precedence precedence, const KeyFunc &keyAt)
+    : d(new Impl(precedence, keyAt))
+{}
+
+void DEDIndex::clear()
+{
+    d->lut.clear();
+    d->indexedCount = 0;
+    d->lookups = 0;
+}
+
+void DEDIndex::invalidate()
+{
+    d->lut.clear();
+    d->indexedCount = 0;
+}
+
+int DEDIndex::find(const char *id, int count) const
+{
+    d->lookups++;
+
+    if (!id || !id[0]) return -1;
+
+    d->update(count);
+
+    const auto range = d->lut.equal_range(dedIdentifierHash(id));
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        if (!iCmpStrCase(d->key(i->second), id))
+        {
+            return i->second;
+        }
+    }
+    return -1; // Not found.
+}
+
+duint64 DEDIndex::lookupCount() const
+{
+    return d->lookups;
+}
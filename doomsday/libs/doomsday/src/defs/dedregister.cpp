@@ -46,6 +46,7 @@ DE_PIMPL(DEDRegister)
     typedef KeyMap<String, Key> Keys;
     Keys keys;
     KeyMap<Variable *, Record *> parents;
+    mutable duint64 lookups = 0;
 
     Impl(Public *i, Record &rec) : Base(i), names(&rec)
     {
@@ -67,6 +68,7 @@ DE_PIMPL(DEDRegister)
         // As a side-effect, the lookups will be cleared, too, as the members of
         // each definition record are deleted.
         order().clear();
+        lookups = 0;
 
 #ifdef DE_DEBUG
         DE_ASSERT(parents.isEmpty());
@@ -109,6 +111,8 @@ DE_PIMPL(DEDRegister)
     Type lookupOperation(const String &key, String value,
                          std::function<Type (const DictionaryValue &, String)> operation) const
     {
+        lookups++;
+
         auto foundKey = keys.find(key);
         if (foundKey == keys.end()) return Type{0};
 
@@ -362,6 +366,11 @@ const Record &DEDRegister::find(const String &key, const String &value) const
     return *rec;
 }
 
+duint64 DEDRegister::lookupCount() const
+{
+    return d->lookups;
+}
+
 const DictionaryValue &DEDRegister::lookup(const String &key) const
 {
     if (!d->keys.contains(key))
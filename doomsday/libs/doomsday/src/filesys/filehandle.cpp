@@ -24,9 +24,18 @@
 
 #include "doomsday/filesys/file.h"
 
+#include <atomic>
 #include <cctype>
 #include <ctime>
 #include <sys/stat.h>
+#ifdef WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#  include <io.h>
+#else
+#  include <sys/mman.h>
+#endif
 
 #include <de/legacy/memory.h>
 #include <de/legacy/memoryblockset.h>
@@ -59,14 +68,75 @@ DE_PIMPL_NOREF(FileHandle)
     uint8_t *data;
     uint8_t *pos;
 
+    uint8_t *mapped = nullptr; ///< Memory-mapped contents of the native file.
+    size_t mappedSize = 0;
+    bool mapFailed = false;
+
     Impl() : file(0), list(0), baseOffset(0), hndl(0), size(0), data(0), pos(0)
     {
         flags.eof  = false;
         flags.open = false;
         flags.reference = false;
     }
+
+    /**
+     * Map the entire native file into memory (copy-on-write).
+     */
+    bool mapNativeFile()
+    {
+        if (mapped) return true;
+        if (!hndl || mapFailed) return false;
+
+#ifdef WIN32
+        HANDLE fileHandle = HANDLE(_get_osfhandle(_fileno(hndl)));
+        LARGE_INTEGER fileSize;
+        if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize) &&
+            fileSize.QuadPart > 0)
+        {
+            if (HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr))
+            {
+                // The view keeps the mapping object alive.
+                mapped = reinterpret_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+                mappedSize = size_t(fileSize.QuadPart);
+                CloseHandle(mapping);
+            }
+        }
+#else
+        struct stat st;
+        const int fd = fileno(hndl);
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *ptr = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                mapped = reinterpret_cast<uint8_t *>(ptr);
+                mappedSize = size_t(st.st_size);
+            }
+        }
+#endif
+        if (!mapped)
+        {
+            mappedSize = 0;
+            mapFailed  = true;
+        }
+        return mapped != nullptr;
+    }
+
+    void unmapNativeFile()
+    {
+        if (!mapped) return;
+#ifdef WIN32
+        UnmapViewOfFile(mapped);
+#else
+        munmap(mapped, mappedSize);
+#endif
+        mapped = nullptr;
+        mappedSize = 0;
+    }
 };
 
+static std::atomic<duint64> viewedBytes{0};
+
 static void errorIfNotValid(const FileHandle &file, const char * /*callerName*/)
 {
     DE_ASSERT(file.isValid());
@@ -91,6 +161,7 @@ FileHandle::~FileHandle()
 FileHandle &FileHandle::close()
 {
     if (!d->flags.open) return *this;
+    d->unmapNativeFile();
     if (d->hndl)
     {
         fclose(d->hndl); d->hndl = 0;
@@ -275,6 +346,36 @@ FileHandle &FileHandle::rewind()
     return *this;
 }
 
+const uint8_t *FileHandle::view(size_t offset, size_t length)
+{
+    errorIfNotValid(*this, "FileHandle::view");
+    if (d->flags.reference)
+    {
+        return d->file->handle().view(offset, length);
+    }
+
+    const uint8_t *ptr = nullptr;
+    if (d->hndl)
+    {
+        if (d->mapNativeFile() && d->baseOffset + offset + length <= d->mappedSize)
+        {
+            ptr = d->mapped + d->baseOffset + offset;
+        }
+    }
+    else if (d->data && offset + length <= d->size)
+    {
+        ptr = d->data + offset;
+    }
+
+    if (ptr) viewedBytes += length;
+    return ptr;
+}
+
+duint64 FileHandle::viewedByteCount() // static
+{
+    return viewedBytes;
+}
+
 FileHandle *FileHandle::fromFile(File1 &file) // static
 {
     FileHandle *hndl = new FileHandle();
@@ -720,7 +720,11 @@ lumpnum_t FS1::lumpNumForName(String name)
         name += ".lmp";
     }
 
-    // Perform the search.
+    // Perform the search. Plain lump names need not be parsed into a Path.
+    if (!name.contains('/'))
+    {
+        return d->primaryIndex.findLastByName(name);
+    }
     return d->primaryIndex.findLast(Path(name));
 }
 
@@ -319,10 +319,30 @@ dsize LumpIndex::Id1MapRecognizer::elementSizeForDataType(Format mapFormat, Data
     }
 }
 
-static uint32_t segmentHash(const CString &segment)
+/**
+ * Case-insensitive hash of a lump name (FNV-1a). Plain ASCII names are folded
+ * in place so that lookups by name do not need to allocate.
+ */
+static duint32 nameHash(const CString &name)
 {
-    static const uint32_t hashRange = 0xffffffff;
-    return de::crc32(segment.lower()) % hashRange;
+    duint32 hash = 0x811c9dc5;
+    for (const char *c = name.ptr(), *end = name.endPtr(); c != end; ++c)
+    {
+        const duint8 ch = duint8(*c);
+        if (ch >= 0x80)
+        {
+            // Multibyte characters need proper case folding.
+            const String low = name.lower();
+            hash = 0x811c9dc5;
+            for (const char *k = low.c_str(), *kEnd = k + low.size(); k != kEnd; ++k)
+            {
+                hash = (hash ^ duint8(*k)) * 0x01000193;
+            }
+            return hash;
+        }
+        hash = (hash ^ duint8(ch >= 'A' && ch <= 'Z'? ch + ('a' - 'A') : ch)) * 0x01000193;
+    }
+    return hash;
 }
 
 DE_PIMPL(LumpIndex)
@@ -330,16 +350,62 @@ DE_PIMPL(LumpIndex)
     bool pathsAreUnique;
 
     Lumps lumps;
+    List<duint32> nameHashes; ///< Name hash of each lump, computed when catalogued.
     bool needPruneDuplicateLumps;
 
-    /// Stores indexes into records forming a chain of PathTree::Node fragment
-    /// hashes. For ultra-fast lookup by path.
-    struct PathHashRecord
+    /**
+     * Open-addressed (linear probing) table of lump indices keyed by name hash.
+     * Appended lumps are inserted incrementally; the table is only rebuilt when
+     * lumps are pruned as that changes the indices.
+     */
+    struct NameIndex
     {
-        lumpnum_t head, nextInLoadOrder;
+        struct Slot
+        {
+            duint32 hash;
+            lumpnum_t lump; ///< @c -1 if the slot is unused.
+        };
+        List<Slot> slots;
+        duint32 mask  = 0;
+        int     count = 0;
+
+        NameIndex(int expectedCount)
+        {
+            duint32 capacity = 16;
+            while (capacity < duint32(expectedCount) * 2) capacity <<= 1;
+            slots.resize(capacity, Slot{0, -1});
+            mask = capacity - 1;
+        }
+
+        void insert(duint32 hash, lumpnum_t lump)
+        {
+            // Keep the load factor at most 50% so probe sequences remain short.
+            if (duint32(count + 1) * 2 > slots.size())
+            {
+                NameIndex grown(int(slots.size()));
+                for (const Slot &slot : slots)
+                {
+                    if (slot.lump >= 0) grown.insert(slot.hash, slot.lump);
+                }
+                std::swap(*this, grown);
+            }
+            duint32 pos = hash & mask;
+            while (slots[pos].lump >= 0) pos = (pos + 1) & mask;
+            slots[pos] = Slot{hash, lump};
+            count += 1;
+        }
+
+        /// Calls @a func with each lump index whose name hash equals @a hash.
+        template <typename Func>
+        void forAll(duint32 hash, Func func) const
+        {
+            for (duint32 pos = hash & mask; slots[pos].lump >= 0; pos = (pos + 1) & mask)
+            {
+                if (slots[pos].hash == hash) func(slots[pos].lump);
+            }
+        }
     };
-    typedef List<PathHashRecord> PathHash;
-    std::unique_ptr<PathHash> lumpsByPath;
+    std::unique_ptr<NameIndex> lumpsByName;
 
     Impl(Public *i)
         : Base(i)
@@ -349,34 +415,36 @@ DE_PIMPL(LumpIndex)
 
     ~Impl() { self().clear(); }
 
-    void buildLumpsByPathIfNeeded()
+    void buildLumpsByNameIfNeeded()
     {
-        if (lumpsByPath) return;
+        if (lumpsByName) return;
 
-        const int numElements = lumps.size();
-        lumpsByPath.reset(new PathHash(numElements));
-
-        // Clear the chains.
-        DE_FOR_EACH(PathHash, i, *lumpsByPath)
-        {
-            i->head = -1;
-        }
-
-        // Prepend nodes to each chain, in first-to-last load order, so that
-        // the last lump with a given name appears first in the chain.
+        const int numElements = lumps.sizei();
+        lumpsByName.reset(new NameIndex(numElements));
         for (int i = 0; i < numElements; ++i)
         {
-            const File1 &lump          = *(lumps[i]);
-            const PathTree::Node &node = lump.directoryNode();
-            ushort k = segmentHash(node.name()) % (unsigned)numElements;
-
-            (*lumpsByPath)[i].nextInLoadOrder = (*lumpsByPath)[k].head;
-            (*lumpsByPath)[k].head = i;
+            lumpsByName->insert(nameHashes[i], i);
         }
 
         LOG_RES_XVERBOSE("Rebuilt hashMap for LumpIndex %p", thisPublic);
     }
 
+    /// Returns the matching lump with the lowest (@a latest = false) or highest
+    /// index, or @c -1 if not found.
+    template <typename Pred>
+    lumpnum_t find(duint32 hash, bool latest, Pred matches)
+    {
+        pruneDuplicatesIfNeeded();
+        buildLumpsByNameIfNeeded();
+
+        lumpnum_t result = -1;
+        lumpsByName->forAll(hash, [this, latest, &matches, &result] (lumpnum_t idx) {
+            if (result >= 0 && (latest? idx < result : idx > result)) return;
+            if (matches(*lumps[idx])) result = idx;
+        });
+        return result;
+    }
+
     /**
      * @param pruneFlags  Passed by reference to avoid deep copy on value-write.
      * @param file        Flag only those lumps contained by this file.
@@ -454,31 +522,27 @@ DE_PIMPL(LumpIndex)
         if (numFlaggedForPrune)
         {
             // We'll need to rebuild the hash after this.
-            lumpsByPath.reset();
+            lumpsByName.reset();
 
             dsize numRecords = lumps.size();
             if (numRecords == numFlaggedForPrune)
             {
                 lumps.clear();
+                nameHashes.clear();
             }
             else
             {
-                // Do this one lump at a time, respecting the possibly-sorted order.
-                for (dsize i = 0, newIdx = 0; i < numRecords; ++i)
+                // Compact the remaining lumps, respecting the possibly-sorted order.
+                dsize newIdx = 0;
+                for (dsize i = 0; i < numRecords; ++i)
                 {
-                    if (!flaggedLumps.testBit(i))
-                    {
-                        ++newIdx;
-                        continue;
-                    }
-
-                    // Move the info for the lump to be pruned to the end.
-                    lumps.push_back(lumps.takeAt(newIdx));
+                    if (flaggedLumps.testBit(i)) continue;
+                    lumps[newIdx]      = lumps[i];
+                    nameHashes[newIdx] = nameHashes[i];
+                    ++newIdx;
                 }
-
-                // Erase the pruned lumps from the end of the list.
-                dsize firstPruned = lumps.size() - numFlaggedForPrune;
-                lumps.erase(lumps.begin() + firstPruned, lumps.end());
+                lumps.resize(newIdx);
+                nameHashes.resize(newIdx);
             }
         }
         return int(numFlaggedForPrune);
@@ -572,18 +636,29 @@ bool LumpIndex::pruneLump(File1 &lump)
     d->pruneDuplicatesIfNeeded();
 
     // Prune this lump.
-    if (!d->lumps.removeOne(&lump)) return false;
+    const int idx = d->lumps.indexOf(&lump);
+    if (idx < 0) return false;
+    d->lumps.removeAt(idx);
+    d->nameHashes.removeAt(idx);
 
-    // We'll need to rebuild the path hash chains.
-    d->lumpsByPath.reset();
+    // We'll need to rebuild the name hash.
+    d->lumpsByName.reset();
 
     return true;
 }
 
 void LumpIndex::catalogLump(File1 &lump)
 {
+    const duint32 hash = nameHash(lump.directoryNode().name());
+
     d->lumps.push_back(&lump);
-    d->lumpsByPath.reset();    // We'll need to rebuild the path hash chains.
+    d->nameHashes.push_back(hash);
+
+    // Appending does not change existing indices so the name hash can be kept.
+    if (d->lumpsByName)
+    {
+        d->lumpsByName->insert(hash, d->lumps.sizei() - 1);
+    }
 
     if (d->pathsAreUnique)
     {
@@ -595,7 +670,8 @@ void LumpIndex::catalogLump(File1 &lump)
 void LumpIndex::clear()
 {
     d->lumps.clear();
-    d->lumpsByPath.reset();
+    d->nameHashes.clear();
+    d->lumpsByName.reset();
     d->needPruneDuplicateLumps = false;
 }
 
@@ -618,6 +694,11 @@ bool LumpIndex::contains(const Path &path) const
     return findFirst(path) >= 0;
 }
 
+bool LumpIndex::containsName(const CString &name) const
+{
+    return findFirstByName(name) >= 0;
+}
+
 int LumpIndex::findAll(const Path &path, FoundIndices &found) const
 {
     LOG_AS("LumpIndex::findAll");
@@ -627,23 +708,18 @@ int LumpIndex::findAll(const Path &path, FoundIndices &found) const
     if (path.isEmpty() || d->lumps.empty()) return 0;
 
     d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
+    d->buildLumpsByNameIfNeeded();
 
     // Perform the search.
-    DE_ASSERT(d->lumpsByPath);
-    auto hash = ushort(segmentHash(path.lastSegment()) % d->lumpsByPath->size());
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-        idx = (*d->lumpsByPath)[idx].nextInLoadOrder)
-    {
-        const File1 &lump          = *d->lumps[idx];
-        const PathTree::Node &node = lump.directoryNode();
-
-        if (!node.comparePath(path, 0))
+    d->lumpsByName->forAll(nameHash(path.lastSegment()), [this, &path, &found] (lumpnum_t idx) {
+        if (!d->lumps[idx]->directoryNode().comparePath(path, 0))
         {
-            found.push_front(idx);
+            found.push_back(idx);
         }
-    }
+    });
 
+    // Probing does not visit the lumps in load order.
+    found.sort();
     return int(found.size());
 }
 
@@ -651,52 +727,36 @@ lumpnum_t LumpIndex::findLast(const Path &path) const
 {
     if (path.isEmpty() || d->lumps.empty()) return -1;
 
-    d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
-
-    // Perform the search.
-    DE_ASSERT(d->lumpsByPath);
-    ushort hash = ushort(segmentHash(path.lastSegment()) % d->lumpsByPath->size());
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-        idx = (*d->lumpsByPath)[idx].nextInLoadOrder)
-    {
-        const File1 &lump          = *d->lumps[idx];
-        const PathTree::Node &node = lump.directoryNode();
-
-        if (!node.comparePath(path, 0))
-        {
-            return idx; // This is the lump we are looking for.
-        }
-    }
-
-    return -1; // Not found.
+    return d->find(nameHash(path.lastSegment()), true, [&path] (const File1 &lump) {
+        return !lump.directoryNode().comparePath(path, 0);
+    });
 }
 
 lumpnum_t LumpIndex::findFirst(const Path &path) const
 {
     if (path.isEmpty() || d->lumps.empty()) return -1;
 
-    d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
+    return d->find(nameHash(path.lastSegment()), false, [&path] (const File1 &lump) {
+        return !lump.directoryNode().comparePath(path, 0);
+    });
+}
 
-    lumpnum_t earliest = -1; // Not found.
+lumpnum_t LumpIndex::findLastByName(const CString &name) const
+{
+    if (name.isEmpty() || d->lumps.empty()) return -1;
 
-    // Perform the search.
-    DE_ASSERT(d->lumpsByPath);
-    auto hash = ushort(segmentHash(path.lastSegment()) % d->lumpsByPath->size());
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-         idx     = (*d->lumpsByPath)[idx].nextInLoadOrder)
-    {
-        const File1 &lump          = *d->lumps[idx];
-        const PathTree::Node &node = lump.directoryNode();
+    return d->find(nameHash(name), true, [&name] (const File1 &lump) {
+        return !CString(lump.directoryNode().name()).compare(name, CaseInsensitive);
+    });
+}
 
-        if (!node.comparePath(path, 0))
-        {
-            earliest = idx; // This is now the first lump loaded.
-        }
-    }
+lumpnum_t LumpIndex::findFirstByName(const CString &name) const
+{
+    if (name.isEmpty() || d->lumps.empty()) return -1;
 
-    return earliest;
+    return d->find(nameHash(name), false, [&name] (const File1 &lump) {
+        return !CString(lump.directoryNode().name()).compare(name, CaseInsensitive);
+    });
 }
 
 Uri LumpIndex::composeResourceUrn(lumpnum_t lumpNum) // static
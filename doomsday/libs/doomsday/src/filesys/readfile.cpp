@@ -99,10 +99,11 @@ AutoStr *M_ReadFileIntoString(const ddstring_t *path, dd_bool *isCustom)
     {
         const char *lumpName       = Str_Text(path) + 6;
         const LumpIndex &lumpIndex = App_FileSystem().nameIndex();
-        if (!lumpIndex.contains(String(lumpName) + ".lmp"))
+        const lumpnum_t lumpNum    = lumpIndex.findLastByName(String(lumpName) + ".lmp");
+        if (lumpNum < 0)
             return 0;
 
-        File1 &lump = lumpIndex[lumpIndex.findLast(String(lumpName) + ".lmp")];
+        File1 &lump = lumpIndex[lumpNum];
         if (isCustom)
         {
             /// @todo Custom status for contained files is not inherited from the container?
@@ -273,6 +273,16 @@ const uint8_t *Wad::cacheLump(int lumpIndex)
     const uint8_t *data = d->dataCache->data(lumpIndex);
     if (data) return data;
 
+    // WAD lumps are never compressed, so the data can be accessed directly in
+    // the container (when memory-mapped) without making a copy.
+    if (lumpFile.info().size > 0)
+    {
+        if (const uint8_t *view = handle_->view(lumpFile.info().baseOffset, lumpFile.info().size))
+        {
+            return view;
+        }
+    }
+
     uint8_t *region = (uint8_t *) Z_Malloc(lumpFile.info().size, PU_APPSTATIC, 0);
     if (!region)
         throw Error("Wad::cacheLump",
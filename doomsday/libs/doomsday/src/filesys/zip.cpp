@@ -338,6 +338,18 @@ DE_PIMPL(Zip)
 
         if (lumpInfo.isCompressed())
         {
+            // Inflate directly from the container, if it is memory-mapped.
+            if (const uint8_t *compressedView =
+                    self().handle_->view(lumpInfo.baseOffset, lumpInfo.compressedSize))
+            {
+                if (!uncompressRaw(const_cast<uint8_t *>(compressedView), lumpInfo.compressedSize,
+                                   buffer, lumpInfo.size))
+                {
+                    return 0; // Inflate failed.
+                }
+                return lumpInfo.size;
+            }
+
             bool result;
             uint8_t *compressedData = (uint8_t *) M_Malloc(lumpInfo.compressedSize);
             if (!compressedData)
@@ -583,6 +595,16 @@ const uint8_t *Zip::cacheLump(int lumpIndex)
     const uint8_t *data = d->dataCache->data(lumpIndex);
     if (data) return data;
 
+    // Stored (uncompressed) entries can be accessed directly in the container
+    // (when memory-mapped) without making a copy.
+    if (!lumpFile.info().isCompressed() && lumpFile.info().size > 0)
+    {
+        if (const uint8_t *view = handle_->view(lumpFile.info().baseOffset, lumpFile.info().size))
+        {
+            return view;
+        }
+    }
+
     uint8_t *region = (uint8_t *) Z_Malloc(lumpFile.info().size, PU_APPSTATIC, 0);
     if (!region) throw Error("Zip::cacheLump", stringf("Failed on allocation of %zu bytes for cache copy of lump #%i",
                                                        lumpFile.info().size, lumpIndex));
@@ -20,12 +20,15 @@
 
 #include "doomsday/res/colorpalette.h"
 
+#include <de/guard.h>
 #include <de/log.h>
 #include <de/range.h>
 #include <de/keymap.h>
 #include <de/legacy/reader.h>
 #include <de/legacy/mathutil.h>
 
+#include <atomic>
+
 using namespace de;
 
 #define RGB18(r, g, b)      ((r)+((g)<<6)+((b)<<12))
@@ -160,7 +163,7 @@ ColorTable ColorTableReader::read(String format, int colorCount,
     return colors;
 }
 
-DE_PIMPL(ColorPalette)
+DE_PIMPL(ColorPalette), public Lockable
 {
     typedef Vec3ub Color;
     typedef List<Color> ColorTable;
@@ -169,10 +172,11 @@ DE_PIMPL(ColorPalette)
     typedef KeyMap<String, Translation> Translations;
     Translations translations;
 
-    /// 18-bit to 8-bit, nearest color translation table.
+    /// 18-bit to 8-bit, nearest color translation table. Built only when needed;
+    /// the build is guarded so that textures can be prepared in worker threads.
     typedef List<int> XLat18To8;
     std::unique_ptr<XLat18To8> xlat18To8;
-    bool need18To8Update = false;  // Table built only when needed.
+    std::atomic_bool xlat18To8Ready{false};
 
     Id id;
 
@@ -199,13 +203,11 @@ DE_PIMPL(ColorPalette)
         }
     }
 
-    /// @note A time-consuming operation.
+    /// @note A time-consuming operation. Caller must hold the lock.
     void prepareNearestLUT()
     {
 #define COLORS18BIT 262144
 
-        need18To8Update = false;
-
         if (!xlat18To8)
         {
             xlat18To8.reset(new XLat18To8(COLORS18BIT));
@@ -233,6 +235,7 @@ DE_PIMPL(ColorPalette)
 
             (*xlat18To8)[RGB18(r, g, b)] = nearest;
         }
+        xlat18To8Ready = true;
 
 #undef COLORS18BIT
     }
@@ -263,11 +266,15 @@ ColorPalette &ColorPalette::replaceColorTable(const ColorTable &colorTable)
 
     const int colorCountBefore = colorCount();
 
-    // We may need a new 18 => 8 bit xlat table.
-    d->need18To8Update = true;
+    {
+        DE_GUARD(d);
 
-    // Replace the whole color table.
-    d->colors = colorTable;
+        // We may need a new 18 => 8 bit xlat table.
+        d->xlat18To8Ready = false;
+
+        // Replace the whole color table.
+        d->colors = colorTable;
+    }
 
     // Notify interested parties.
     d->notifyColorTableChanged();
@@ -312,9 +319,13 @@ int ColorPalette::nearestIndex(const Vec3ub &rgb) const
     if (d->colors.isEmpty()) return -1;
 
     // Ensure we've prepared the 18 to 8 table.
-    if (d->need18To8Update || !d->xlat18To8)
+    if (!d->xlat18To8Ready)
     {
-        d->prepareNearestLUT();
+        DE_GUARD(d);
+        if (!d->xlat18To8Ready)
+        {
+            d->prepareNearestLUT();
+        }
     }
 
     return (*d->xlat18To8)[RGB18(rgb.x >> 2, rgb.y >> 2, rgb.z >> 2)];
@@ -535,7 +535,7 @@ DE_PIMPL(Textures)
         //self().textures().textureScheme("Flats").clear();
 
         const LumpIndex &index = App_FileSystem().nameIndex();
-        lumpnum_t firstFlatMarkerLumpNum = index.findFirst(Path("F_START.lmp"));
+        lumpnum_t firstFlatMarkerLumpNum = index.findFirstByName("F_START.lmp");
         if (firstFlatMarkerLumpNum >= 0)
         {
             lumpnum_t lumpNum;
@@ -21,6 +21,7 @@
 
 #include "doomsday/world/blockmap.h"
 
+#include <de/list.h>
 #include <de/vector.h>
 #include <de/legacy/memoryzone.h>
 #include <de/legacy/vector1.h>
@@ -131,6 +132,147 @@ private:
     }
 };
 
+/**
+ * Elements of a cell in the flat cell storage. Like the nodes of a CellData ring, the
+ * slots are never removed: unlinking leaves a hole that is reused by the next link.
+ * This keeps the iteration order identical to the ring storage.
+ */
+struct FlatCell
+{
+    List<void *> slots;     ///< Linked elements; @c nullptr for unused slots.
+    duint32      count = 0; ///< Total number of linked elements.
+    duint32      firstFree = 0;
+
+    duint32 link(void *elem)
+    {
+        const duint32 slot = firstFree;
+        if (slot == slots.size())
+        {
+            slots.push_back(elem);
+        }
+        else
+        {
+            slots[slot] = elem;
+        }
+        count++;
+        // Find the next unused slot.
+        for (++firstFree; firstFree < slots.size() && slots[firstFree]; ++firstFree)
+        {}
+        return slot;
+    }
+
+    void unlink(duint32 slot)
+    {
+        DE_ASSERT(slots[slot] != nullptr);
+        slots[slot] = nullptr;
+        count--;
+        firstFree = de::min(firstFree, slot);
+    }
+
+    void clear()
+    {
+        slots.clear();
+        count     = 0;
+        firstFree = 0;
+    }
+};
+
+/**
+ * Open-addressed index from (cell, element) pairs to the first slot of the element in
+ * the cell's slot array. Used by the flat cell storage for O(1) unlinking.
+ */
+class SlotIndex
+{
+public:
+    struct Entry
+    {
+        void *  elem;  ///< @c nullptr if the entry is unused.
+        duint32 cell;
+        duint32 slot;  ///< First slot where the element is linked in the cell.
+        duint32 count; ///< Number of times the element is linked in the cell.
+    };
+
+    SlotIndex() { clear(); }
+
+    void clear()
+    {
+        _entries = List<Entry>(16, Entry{nullptr, 0, 0, 0});
+        _count   = 0;
+    }
+
+    Entry *find(duint32 cell, const void *elem)
+    {
+        for (dsize i = home(cell, elem); _entries[i].elem; i = (i + 1) & mask())
+        {
+            if (_entries[i].elem == elem && _entries[i].cell == cell)
+            {
+                return &_entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(duint32 cell, void *elem, duint32 slot)
+    {
+        if ((_count + 1) * 10 > _entries.size() * 7)
+        {
+            rehash(_entries.size() * 2);
+        }
+        dsize i = home(cell, elem);
+        while (_entries[i].elem) i = (i + 1) & mask();
+        _entries[i] = Entry{elem, cell, slot, 1};
+        _count++;
+    }
+
+    void remove(Entry *entry)
+    {
+        dsize i = dsize(entry - _entries.data());
+
+        // Backward shift deletion keeps the probe sequences intact.
+        _entries[i].elem = nullptr;
+        _count--;
+        for (dsize j = (i + 1) & mask(); _entries[j].elem; j = (j + 1) & mask())
+        {
+            const dsize k = home(_entries[j].cell, _entries[j].elem);
+            const bool movable = (j > i ? (k <= i || k > j) : (k <= i && k > j));
+            if (movable)
+            {
+                _entries[i]      = _entries[j];
+                _entries[j].elem = nullptr;
+                i = j;
+            }
+        }
+    }
+
+private:
+    inline dsize mask() const { return _entries.size() - 1; }
+
+    inline dsize home(duint32 cell, const void *elem) const
+    {
+        duint64 h = duint64(reinterpret_cast<uintptr_t>(elem)) ^ (duint64(cell) << 32);
+        h *= 0x9e3779b97f4a7c15ull;
+        return dsize(h >> 32) & mask();
+    }
+
+    void rehash(dsize newSize)
+    {
+        List<Entry> old = std::move(_entries);
+        _entries = List<Entry>(newSize, Entry{nullptr, 0, 0, 0});
+        _count   = 0;
+        for (const Entry &e : old)
+        {
+            if (!e.elem) continue;
+            dsize i = home(e.cell, e.elem);
+            while (_entries[i].elem) i = (i + 1) & mask();
+            _entries[i] = e;
+            _count++;
+        }
+    }
+
+    List<Entry> _entries;
+    dsize       _count;
+};
+
 DE_PIMPL(Blockmap)
 {
     /**
@@ -195,18 +337,30 @@ DE_PIMPL(Blockmap)
     AABoxd bounds;    ///< Map space units.
     duint cellSize;   ///< Map space units.
     Cell dimensions;  ///< Dimensions of the indexed space, in cells.
+    CellStorage storage;
 
-    Nodes nodes;      ///< Quadtree nodes. The first being the root.
+    Nodes nodes;      ///< Quadtree nodes. The first being the root (RingStorage).
 
-    Impl(Public *i, const AABoxd &bounds, duint cellSize)
+    List<FlatCell> flatCells;     ///< Elements of each cell, in row order (FlatStorage).
+    SlotIndex flatSlots;          ///< Slot of each element in its cell (FlatStorage).
+
+    Impl(Public *i, const AABoxd &bounds, duint cellSize, CellStorage storage)
         : Base(i)
         , bounds    (bounds)
         , cellSize  (cellSize)
         , dimensions(Vec2ui(de::ceil((bounds.maxX - bounds.minX) / cellSize),
                             de::ceil((bounds.maxY - bounds.minY) / cellSize)))
+        , storage   (storage)
     {
-        // Quadtree must subdivide the space equally into 1x1 unit cells.
-        newNode(Cell(0, 0), ceilPow2(de::max(dimensions.x, dimensions.y)));
+        if (storage == FlatStorage)
+        {
+            flatCells.resize(dsize(dimensions.x) * dimensions.y);
+        }
+        else
+        {
+            // Quadtree must subdivide the space equally into 1x1 unit cells.
+            newNode(Cell(0, 0), ceilPow2(de::max(dimensions.x, dimensions.y)));
+        }
     }
 
     inline dint toCellIndex(duint cellX, duint cellY)
@@ -381,10 +535,94 @@ DE_PIMPL(Blockmap)
         }
         return nullptr;
     }
+
+    /**
+     * Returns the elements of the identified cell (FlatStorage), or @c nullptr if the
+     * cell is outside the blockmap.
+     */
+    FlatCell *flatCell(const Cell &cell)
+    {
+        if (cell.x >= dimensions.x || cell.y >= dimensions.y)
+        {
+            return nullptr;
+        }
+        return &flatCells[toCellIndex(cell.x, cell.y)];
+    }
+
+    /**
+     * Links @a elem into a cell (FlatStorage). As with CellData::link(), an element
+     * can be linked more than once into the same cell.
+     */
+    bool flatLink(const Cell &cell, void *elem)
+    {
+        auto *elems = flatCell(cell);
+        if (!elems) return false; // Outside the blockmap?
+
+        const auto cellIndex = duint32(toCellIndex(cell.x, cell.y));
+        const duint32 slot = elems->link(elem);
+        if (auto *entry = flatSlots.find(cellIndex, elem))
+        {
+            entry->count++;
+            entry->slot = de::min(entry->slot, slot);
+        }
+        else
+        {
+            flatSlots.insert(cellIndex, elem, slot);
+        }
+        return true;
+    }
+
+    /**
+     * Unlinks the first occurrence of @a elem from a cell (FlatStorage).
+     */
+    bool flatUnlink(const Cell &cell, void *elem)
+    {
+        auto *elems = flatCell(cell);
+        if (!elems) return false;
+
+        const auto cellIndex = duint32(toCellIndex(cell.x, cell.y));
+        auto *entry = flatSlots.find(cellIndex, elem);
+        if (!entry) return false;
+
+        elems->unlink(entry->slot);
+        if (--entry->count > 0)
+        {
+            // Linked more than once; find the next occurrence.
+            duint32 next = entry->slot + 1;
+            while (elems->slots[next] != elem) ++next;
+            entry->slot = next;
+        }
+        else
+        {
+            flatSlots.remove(entry);
+        }
+        return true;
+    }
+
+    /**
+     * Iterates the elements of a cell (FlatStorage) in the same order as the nodes
+     * of a CellData ring, with the same behavior if the callback links or unlinks
+     * elements in the cell.
+     */
+    LoopResult flatForAll(const FlatCell &elems,
+                          const std::function<LoopResult (void *object)> &func) const
+    {
+        for (dsize i = 0; i < elems.slots.size(); ++i)
+        {
+            // Like the ring iteration, the following slot is checked before the callback.
+            const bool isLast = (i + 1 == elems.slots.size());
+            if (void *elem = elems.slots[i])
+            {
+                if (auto result = func(elem)) return result;
+            }
+            if (isLast) break;
+        }
+        return LoopContinue;
+    }
 };
 
-Blockmap::Blockmap(const AABoxd &bounds, duint cellSize)
-    : d(new Impl(this, bounds, cellSize))
+Blockmap::Blockmap(const AABoxd &bounds, duint cellSize, CellStorage storage)
+    : d(new Impl(this, bounds, cellSize, storage))
 {}
 
 Blockmap::~Blockmap()
@@ -405,6 +643,11 @@ const BlockmapCell &Blockmap::dimensions() const
     return d->dimensions;
 }
 
+Blockmap::CellStorage Blockmap::cellStorage() const
+{
+    return d->storage;
+}
+
 duint Blockmap::cellSize() const
 {
     return d->cellSize;
@@ -436,6 +679,10 @@ bool Blockmap::link(const Cell &cell, void *elem)
 {
     if(!elem) return false; // Huh?
 
+    if(d->storage == FlatStorage)
+    {
+        return d->flatLink(cell, elem);
+    }
     if(auto *cellData = d->cellData(cell, true /*can create*/))
     {
         return cellData->link(elem);
@@ -456,7 +703,14 @@ bool Blockmap::link(const AABoxd &region, void *elem)
     for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
     for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
     {
-        if(auto *cellData = d->cellData(cell, true))
+        if(d->storage == FlatStorage)
+        {
+            if(d->flatLink(cell, elem))
+            {
+                didLink = true;
+            }
+        }
+        else if(auto *cellData = d->cellData(cell, true))
         {
             if(cellData->link(elem))
             {
@@ -472,6 +726,10 @@ bool Blockmap::unlink(const Cell &cell, void *elem)
 {
     if(!elem) return false; // Huh?
 
+    if(d->storage == FlatStorage)
+    {
+        return d->flatUnlink(cell, elem);
+    }
     if(auto *cellData = d->cellData(cell))
     {
         return cellData->unlink(elem);
@@ -492,7 +750,14 @@ bool Blockmap::unlink(const AABoxd &region, void *elem)
     for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
     for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
     {
-        if(auto *cellData = d->cellData(cell))
+        if(d->storage == FlatStorage)
+        {
+            if(d->flatUnlink(cell, elem))
+            {
+                didUnlink = true;
+            }
+        }
+        else if(auto *cellData = d->cellData(cell))
         {
             if(cellData->unlink(elem))
             {
@@ -506,6 +771,15 @@ bool Blockmap::unlink(const AABoxd &region, void *elem)
 
 void Blockmap::unlinkAll()
 {
+    if (d->storage == FlatStorage)
+    {
+        for (auto &elems : d->flatCells)
+        {
+            elems.clear();
+        }
+        d->flatSlots.clear();
+        return;
+    }
     for (const auto &node : d->nodes)
     {
         // Only leafs with user data.
@@ -520,6 +794,11 @@ void Blockmap::unlinkAll()
 
 dint Blockmap::cellElementCount(const Cell &cell) const
 {
+    if(d->storage == FlatStorage)
+    {
+        const auto *elems = d->flatCell(cell);
+        return elems? dint(elems->count) : 0;
+    }
     if(auto *cellData = d->cellData(cell))
     {
         return cellData->elemCount;
@@ -529,6 +808,14 @@ dint Blockmap::cellElementCount(const Cell &cell) const
 
 LoopResult Blockmap::forAllInCell(const Cell &cell, std::function<LoopResult (void *object)> func) const
 {
+    if(d->storage == FlatStorage)
+    {
+        if(const auto *elems = d->flatCell(cell))
+        {
+            return d->flatForAll(*elems, func);
+        }
+        return LoopContinue;
+    }
     if(auto *cellData = d->cellData(cell))
     {
         RingNode *node = cellData->ringNodes;
@@ -550,6 +837,23 @@ LoopResult Blockmap::forAllInBox(const AABoxd &box, std::function<LoopResult (vo
     CellBlock cellBlock = toCellBlock(box);
     d->clipBlock(cellBlock);
 
+    if(d->storage == FlatStorage)
+    {
+        // Walk each row of the block through the contiguous cell array.
+        const duint maxX = de::min(cellBlock.max.x, d->dimensions.x);
+        const duint maxY = de::min(cellBlock.max.y, d->dimensions.y);
+        for(duint y = cellBlock.min.y; y < maxY; ++y)
+        {
+            const auto *row = &d->flatCells[d->toCellIndex(0, y)];
+            for(duint x = cellBlock.min.x; x < maxX; ++x)
+            {
+                if(!row[x].count) continue;
+                if(auto result = d->flatForAll(row[x], func)) return result;
+            }
+        }
+        return LoopContinue;
+    }
+
     Cell cell;
     for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
     for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
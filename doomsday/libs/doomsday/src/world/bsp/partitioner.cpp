@@ -39,9 +39,17 @@
 
 #include <de/legacy/vector1.h>
 
+#include <de/filesystem.h>
+#include <de/folder.h>
 #include <de/hash.h>
 #include <de/logbuffer.h>
+#include <de/math.h>
+#include <de/reader.h>
+#include <de/taskpool.h>
+#include <de/writer.h>
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 using namespace de;
 
@@ -55,6 +63,18 @@ using LineSegmentSides = List<LineSegmentSide *>;
 using SubspaceProxys   = std::list<ConvexSubspaceProxy>;
 using EdgeTipSetMap    = Hash<Vertex *, EdgeTips>;
 
+/// Identifies a partition cache record. Increment the version whenever the partition
+/// selection or the cache record format changes.
+static const duint32 PARTITION_CACHE_MAGIC   = 0x50425344; // "DSBP"
+static const duint32 PARTITION_CACHE_VERSION = 1;
+
+/// Minimum number of line segments in a subtree for evaluating its partition
+/// concurrently with the sibling subtree.
+static const int SPECULATION_MIN_SEGMENTS = 128;
+
+static std::atomic_int partitionCacheHits  { 0 };
+static std::atomic_int partitionCacheMisses{ 0 };
+
 DE_PIMPL(Partitioner)
 {
     int splitCostFactor = 7; ///< Cost of splitting a line segment.
@@ -72,6 +92,42 @@ DE_PIMPL(Partitioner)
     BspTree *bspRoot = nullptr; ///< The BSP tree under construction.
     HPlane   hplane;            ///< Current space half-plane (partitioner state).
 
+    /**
+     * Partition choice made at a single step of the build, in build order. Used for
+     * recording and replaying builds via the persistent cache.
+     */
+    struct PartitionChoice
+    {
+        dint32 ordinal = -1; ///< Ordinal in the candidate enumeration; @c -1 for a leaf.
+        dint32 line    = -1; ///< Map line index of the chosen candidate (validation).
+        dint32 side    = 0;  ///< Line side of the chosen candidate (validation).
+    };
+    using PartitionChoices = List<PartitionChoice>;
+
+    String           cachePath;       ///< Partition cache folder (empty: disabled).
+    PartitionChoices choices;         ///< Choices made during the current build.
+    PartitionChoices replayChoices;   ///< Choices loaded from the cache.
+    dsize            replayPos = 0;
+    bool             replaying = false;
+
+    /**
+     * Partition choice for a subtree, evaluated concurrently while the sibling
+     * subtree is being built. The result is only used if nothing in the subtree
+     * changed in the meantime, so the built tree is identical to a serial build.
+     */
+    struct Speculation
+    {
+        LineSegmentBlockTreeNode *root;
+        LineSegmentSide *chosen = nullptr;
+        int ordinal = -1;
+        bool stale = false;
+        TaskPool pool;
+
+        Speculation(LineSegmentBlockTreeNode &root) : root(&root) {}
+    };
+    bool parallelBuild = true;
+    List<Speculation *> speculations; ///< Pending, in build order.
+
     struct LineSegmentBlockTree
     {
         LineSegmentBlockTreeNode *rootNode;
@@ -103,6 +159,57 @@ DE_PIMPL(Partitioner)
     Impl(Public *i) : Base(i) {}
     ~Impl() { clear(); }
 
+    /**
+     * Begin evaluating the partition for the block tree at @a node in the background.
+     *
+     * @return  The started speculation; otherwise @c nullptr if @a node is not worth
+     * evaluating separately.
+     */
+    Speculation *speculate(LineSegmentBlockTreeNode &node)
+    {
+        if(!parallelBuild || replaying) return nullptr;
+        if(node.userData()->totalCount() < SPECULATION_MIN_SEGMENTS) return nullptr;
+
+        auto *spec = new Speculation(node);
+        const int costFactor = splitCostFactor;
+        spec->pool.start([spec, costFactor] ()
+        {
+            spec->chosen = PartitionEvaluator(costFactor).choose(*spec->root, &spec->ordinal);
+        },
+        TaskPool::MediumPriority);
+        speculations << spec;
+        return spec;
+    }
+
+    /**
+     * Called before the line segments linked in @a node are modified. Pending
+     * speculations on the same block tree are waited for and discarded.
+     */
+    void invalidateSpeculations(const LineSegmentBlockTreeNode *node)
+    {
+        if(speculations.isEmpty() || !node) return;
+
+        while(node->parentPtr()) node = node->parentPtr();
+        for(Speculation *spec : speculations)
+        {
+            if(spec->root == node && !spec->stale)
+            {
+                spec->pool.waitForDone();
+                spec->stale = true;
+            }
+        }
+    }
+
+    void clearSpeculations()
+    {
+        for(Speculation *spec : speculations)
+        {
+            spec->pool.waitForDone();
+        }
+        deleteAll(speculations);
+        speculations.clear();
+    }
+
     static int clearBspElementWorker(BspTree &subtree, void *)
     {
         delete subtree.userData();
@@ -121,6 +228,8 @@ DE_PIMPL(Partitioner)
     {
         //clearBspTree();
 
+        clearSpeculations();
+
         lines.clear();
         mesh = nullptr;
         deleteAll(lineSegments);
@@ -468,6 +577,10 @@ DE_PIMPL(Partitioner)
         case Intersects: {
             // Calculate the intersection point and split this line segment.
             Vec2d point = intersectPartition(seg, fromDist, toDist);
+
+            // The twin may be in a block tree that is being evaluated concurrently.
+            invalidateSpeculations(reinterpret_cast<LineSegmentBlockTreeNode *>(seg.back().blockTreeNodePtr()));
+
             LineSegmentSide &newFrontRight = splitLineSegment(seg, point);
 
             // Ensure the new back left segment is inserted into the same block as
@@ -839,9 +952,174 @@ DE_PIMPL(Partitioner)
         return bounds;
     }
 
-    LineSegmentSide *choosePartition(LineSegmentBlockTreeNode &candidateSet)
+    LineSegmentSide *recordChoice(LineSegmentSide *chosen, int ordinal)
+    {
+        PartitionChoice choice;
+        choice.ordinal = ordinal;
+        if(chosen)
+        {
+            choice.line = chosen->mapLine().indexInMap();
+            choice.side = chosen->lineSideId();
+        }
+        choices << choice;
+        return chosen;
+    }
+
+    /**
+     * @param candidateSet  Block tree with the remaining line segments.
+     * @param speculated    Concurrently evaluated choice for @a candidateSet, if any.
+     *                      Ownership is given.
+     */
+    LineSegmentSide *choosePartition(LineSegmentBlockTreeNode &candidateSet,
+                                     Speculation *speculated = nullptr)
+    {
+        if(speculated)
+        {
+            speculations.removeOne(speculated);
+            speculated->pool.waitForDone();
+            std::unique_ptr<Speculation> spec(speculated);
+            if(!spec->stale)
+            {
+                return recordChoice(spec->chosen, spec->ordinal);
+            }
+        }
+
+        PartitionEvaluator evaluator(splitCostFactor);
+
+        if(replaying)
+        {
+            if(replayPos < replayChoices.size())
+            {
+                const PartitionChoice &rec = replayChoices.at(replayPos);
+                LineSegmentSide *chosen = evaluator.candidate(candidateSet, rec.ordinal);
+                if(rec.ordinal < 0 ||
+                   (chosen && chosen->mapLine().indexInMap() == rec.line &&
+                    chosen->lineSideId() == rec.side))
+                {
+                    replayPos++;
+                    choices << rec;
+                    return chosen;
+                }
+            }
+
+            // The record does not match this geometry; evaluate the rest normally.
+            LOG_MAP_WARNING("Cached BSP partition #%i does not match the map geometry; "
+                            "rebuilding") << replayPos;
+            replaying = false;
+        }
+
+        int ordinal = -1;
+        LineSegmentSide *chosen = evaluator.choose(candidateSet, &ordinal);
+        return recordChoice(chosen, ordinal);
+    }
+
+    /**
+     * Compose the partition cache key for the current set of lines. All the inputs of
+     * the partitioner that affect the choice of partitions are included.
+     */
+    Block cacheKey() const
+    {
+        Block input;
+        Writer writer(input);
+        writer << PARTITION_CACHE_VERSION << dint32(splitCostFactor) << duint32(lines.count());
+        for(const Line *line : lines)
+        {
+            const Sector *frontSec = line->front().sectorPtr();
+            const Sector *backSec  = line->back().sectorPtr();
+            if(!backSec && line->_bspWindowSector)
+            {
+                backSec = line->_bspWindowSector;
+            }
+            writer << dint32(line->indexInMap())
+                   << line->from().origin().x << line->from().origin().y
+                   << line->to().origin().x   << line->to().origin().y
+                   << dint32(frontSec? frontSec->indexInMap() : -1)
+                   << dint32(backSec?  backSec->indexInMap()  : -1);
+        }
+        return input.md5Hash();
+    }
+
+    String cacheFilePath(const Block &key) const
+    {
+        return cachePath / key.asHexadecimalText() + ".bspcache";
+    }
+
+    /**
+     * Attempt to load the recorded partition choices for @a key. Records with a
+     * mismatching header or checksum are ignored.
+     *
+     * @return  @c true if a usable record was found.
+     */
+    bool loadCachedChoices(const Block &key)
+    {
+        replayChoices.clear();
+        try
+        {
+            const File *file = FS::tryLocate<const File>(cacheFilePath(key));
+            if(!file) return false;
+
+            // The records are small; read the whole file in one go.
+            Block data;
+            *file >> data;
+            if(data.size() < 4) return false;
+
+            const Block payload = data.left(data.size() - 4);
+            duint32 checksum;
+            Reader(data, littleEndianByteOrder, data.size() - 4) >> checksum;
+            if(checksum != crc32(payload))
+            {
+                LOG_MAP_WARNING("BSP cache \"%s\" is corrupt") << file->description();
+                return false;
+            }
+
+            Reader reader(payload);
+            duint32 magic, version, count;
+            Block storedKey;
+            reader >> magic >> version >> storedKey >> count;
+            if(magic != PARTITION_CACHE_MAGIC || version != PARTITION_CACHE_VERSION ||
+               storedKey != key)
+            {
+                return false;
+            }
+            for(duint32 i = 0; i < count; ++i)
+            {
+                PartitionChoice choice;
+                reader >> choice.ordinal >> choice.line >> choice.side;
+                replayChoices << choice;
+            }
+            return true;
+        }
+        catch(const Error &er)
+        {
+            LOG_MAP_WARNING("Failed to read BSP cache: %s") << er.asText();
+        }
+        replayChoices.clear();
+        return false;
+    }
+
+    void saveCachedChoices(const Block &key)
     {
-        return PartitionEvaluator(splitCostFactor).choose(candidateSet);
+        try
+        {
+            Block payload;
+            Writer writer(payload);
+            writer << PARTITION_CACHE_MAGIC << PARTITION_CACHE_VERSION << key
+                   << duint32(choices.size());
+            for(const PartitionChoice &choice : choices)
+            {
+                writer << choice.ordinal << choice.line << choice.side;
+            }
+            writer << crc32(payload);
+
+            const String path = cacheFilePath(key);
+            File &file = FS::get().makeFolder(path.fileNamePath()).replaceFile(path.fileName());
+            file << payload;
+            file.flush();
+        }
+        catch(const Error &er)
+        {
+            LOG_MAP_WARNING("Failed to write BSP cache: %s") << er.asText();
+        }
     }
 
     /**
@@ -859,12 +1137,16 @@ DE_PIMPL(Partitioner)
      * If the line segments on the right side are convex create another leaf
      * else put the line segments into the right list.
      *
-     * @param node  Tree node for the block containing the line segments to
-     *              be partitioned.
+     * The left subspace's partition is evaluated concurrently while the right
+     * subspace is being built (see speculate()).
+     *
+     * @param node        Tree node for the block containing the line segments to
+     *                    be partitioned.
+     * @param speculated  Concurrently evaluated partition for @a node, if any.
      *
      * @return  Newly created BSP subtree; otherwise @c nullptr (degenerate).
      */
-    BspTree *partitionSpace(LineSegmentBlockTreeNode &node)
+    BspTree *partitionSpace(LineSegmentBlockTreeNode &node, Speculation *speculated = nullptr)
     {
         LOG_AS("Partitioner::partitionSpace");
 
@@ -873,7 +1155,7 @@ DE_PIMPL(Partitioner)
         BspTree *leftBspTree   = nullptr;
 
         // Pick a line segment to use as the next partition plane.
-        if(LineSegmentSide *partSeg = choosePartition(node))
+        if(LineSegmentSide *partSeg = choosePartition(node, speculated))
         {
             // Reconfigure the half-plane for the next round of partitioning.
             hplane.configure(*partSeg);
@@ -911,9 +1193,11 @@ DE_PIMPL(Partitioner)
             //AABoxd rightBounds = segmentBounds(rightTree);
             //AABoxd leftBounds  = segmentBounds(leftTree);
 
-            // Recurse on each suspace, first the right space then left.
+            // Recurse on each suspace, first the right space then left. Meanwhile,
+            // the partition for the left space is evaluated in the background.
+            Speculation *leftSpeculation = speculate(leftTree);
             rightBspTree = partitionSpace(rightTree);
-            leftBspTree  = partitionSpace(leftTree);
+            leftBspTree  = partitionSpace(leftTree, leftSpeculation);
 
             // Collapse degenerates upward.
             if(!rightBspTree || !leftBspTree)
@@ -1107,6 +1391,21 @@ void Partitioner::setSplitCostFactor(int newFactor)
     d->splitCostFactor = newFactor;
 }
 
+void Partitioner::setParallelBuild(bool enabled)
+{
+    d->parallelBuild = enabled;
+}
+
+void Partitioner::setCachePath(const String &folderPath)
+{
+    d->cachePath = folderPath;
+}
+
+Partitioner::CacheCounts Partitioner::cacheCounts()
+{
+    return CacheCounts{ partitionCacheHits, partitionCacheMisses };
+}
+
 static AABox blockmapBounds(const AABoxd &mapBounds)
 {
     AABox mapBoundsi;
@@ -1164,8 +1463,33 @@ BspTree *Partitioner::makeBspTree(const Set<Line *> &lines, mesh::Mesh &mesh)
 
     d->createInitialLineSegments(blockTree);
 
+    // Replay the recorded partition choices, if available.
+    Block cacheKey;
+    d->choices.clear();
+    d->replayPos    = 0;
+    if(!d->cachePath.isEmpty())
+    {
+        cacheKey     = d->cacheKey();
+        d->replaying = d->loadCachedChoices(cacheKey);
+    }
+
     d->bspRoot = d->partitionSpace(blockTree);
 
+    if(!d->cachePath.isEmpty())
+    {
+        if(d->replaying && d->replayPos == d->replayChoices.size())
+        {
+            partitionCacheHits++;
+        }
+        else
+        {
+            partitionCacheMisses++;
+            d->saveCachedChoices(cacheKey);
+        }
+        d->replaying = false;
+        d->replayChoices.clear();
+    }
+
     // At this point we know that *something* useful was built.
     d->splitOverlappingSegments();
     d->buildSubspaceGeometries();
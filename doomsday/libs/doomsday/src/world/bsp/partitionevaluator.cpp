@@ -23,11 +23,11 @@
 
 #include "doomsday/world/bsp/partitionevaluator.h"
 #include "doomsday/world/bsp/partitioner.h"
-#include "doomsday/world/world.h" // validCount
+#include "doomsday/world/line.h"
 
 #include <de/log.h>
+#include <de/set.h>
 #include <de/string.h>
-#include <de/task.h>
 #include <de/taskpool.h>
 
 namespace world {
@@ -37,6 +37,9 @@ using namespace de;
 
 namespace internal
 {
+    /// Number of partition candidates evaluated per concurrent batch.
+    static const dsize CANDIDATE_BATCH_SIZE = 16;
+
     struct PartitionCost
     {
         int total     = 0;
@@ -188,23 +191,20 @@ DE_PIMPL_NOREF(PartitionEvaluator)
         PartitionCandidate(LineSegmentSide &partition) : line(&partition)
         {}
     };
-    typedef List<PartitionCandidate *> Candidates;
+    typedef List<PartitionCandidate> Candidates;
     Candidates candidates;
 
-    PartitionCandidate *nextCandidate()
-    {
-        DE_ASSERT(costTaskPool.isDone());
-        if (candidates.isEmpty()) return nullptr;
-        return candidates.takeFirst();
-    }
-
-    class CostTask : public Task
+    /**
+     * Cost evaluation of a single partition candidate. Candidates are evaluated
+     * concurrently in batches (see evaluateCandidates()).
+     */
+    class CostEvaluation
     {
     public:
         Impl &evaluator;
         PartitionCandidate &candidate;
 
-        CostTask(Impl &evaluator, PartitionCandidate &candidate)
+        CostEvaluation(Impl &evaluator, PartitionCandidate &candidate)
             : evaluator(evaluator), candidate(candidate)
         {}
 
@@ -215,7 +215,7 @@ DE_PIMPL_NOREF(PartitionEvaluator)
          * determined) then @var partition is zeroed. Otherwise the candidate is
          * suitable and @var cost contains valid costing metrics.
          */
-        void runTask()
+        void run()
         {
             LineSegmentSide **partition = &candidate.line;
             PartitionCost &cost         = candidate.cost;
@@ -379,18 +379,88 @@ DE_PIMPL_NOREF(PartitionEvaluator)
             }
         }
     };
-    TaskPool costTaskPool;
 
     /**
-     * @param line  Partition line to evaluate.
+     * Iterate the partition candidates of the current block tree in a deterministic
+     * order: a pre-order traversal of the tree (right first), and only the first map
+     * line segment of each map line.
+     */
+    template <typename Func>
+    void forAllCandidates(Func func)
+    {
+        // Lines whose segments have already been enumerated. This is a local set
+        // (rather than Line::validCount) so that block trees can be evaluated
+        // concurrently.
+        Set<const Line *> tested;
+
+        // Iterative pre-order traversal.
+        const LineSegmentBlockTreeNode *cur  = rootNode;
+        const LineSegmentBlockTreeNode *prev = nullptr;
+        while(cur)
+        {
+            while(cur)
+            {
+                const LineSegmentBlock &segs = *cur->userData();
+
+                // Test each line segment as a potential partition candidate.
+                for(LineSegmentSide *candidate : segs.all())
+                {
+                    // Only map line segments are suitable candidates.
+                    if(!candidate->hasMapSide())
+                        continue;
+
+                    // Optimization: Only the first line segment produced from a
+                    // given line is tested per round of partition costing because
+                    // they are all collinear.
+                    if(!tested.insert(&candidate->mapLine()).second)
+                        continue; // Skip this.
+
+                    if(func(*candidate)) return;
+                }
+
+                if(prev == cur->parentPtr())
+                {
+                    // Descending - right first, then left.
+                    prev = cur;
+                    if(cur->hasRight()) cur = cur->rightPtr();
+                    else                cur = cur->leftPtr();
+                }
+                else if(prev == cur->rightPtr())
+                {
+                    // Last moved up the right branch - descend the left.
+                    prev = cur;
+                    cur = cur->leftPtr();
+                }
+                else if(prev == cur->leftPtr())
+                {
+                    // Last moved up the left branch - continue upward.
+                    prev = cur;
+                    cur = cur->parentPtr();
+                }
+            }
+
+            if(prev)
+            {
+                // No left child - back up.
+                cur = prev->parentPtr();
+            }
+        }
+    }
+
+    /**
+     * Evaluate the costs of all the collected candidates. The candidates are divided
+     * into batches that are processed concurrently; small sets are evaluated in the
+     * calling thread.
      */
-    void beginPartitionCosting(LineSegmentSide *line)
+    void evaluateCandidates()
     {
-        DE_ASSERT(line && line->hasMapSide());
-        // Run a new partition cost task.
-        PartitionCandidate *newCandidate = new PartitionCandidate(*line);
-        candidates << newCandidate;
-        costTaskPool.start(new CostTask(*this, *newCandidate));
+        TaskPool::parallelFor(0, candidates.size(), [this] (dsize begin, dsize end)
+        {
+            for(dsize i = begin; i < end; ++i)
+            {
+                CostEvaluation(*this, candidates[i]).run();
+            }
+        }, CANDIDATE_BATCH_SIZE, TaskPool::HighPriority);
     }
 };
 
@@ -399,104 +469,67 @@ PartitionEvaluator::PartitionEvaluator(int splitCostFactor) : d(new Impl)
     d->splitCostFactor = splitCostFactor;
 }
 
-LineSegmentSide *PartitionEvaluator::choose(LineSegmentBlockTreeNode &node)
+LineSegmentSide *PartitionEvaluator::choose(LineSegmentBlockTreeNode &node, int *chosenOrdinal)
 {
     LOG_AS("PartitionEvaluator");
 
     d->rootNode = &node;
+    d->candidates.clear();
+    d->forAllCandidates([this] (LineSegmentSide &candidate)
+    {
+        DE_ASSERT(candidate.hasMapSide());
+        d->candidates << Impl::PartitionCandidate(candidate);
+        return LoopContinue;
+    });
 
-    // Increment valid count so we can avoid testing the line segments
-    // produced from a single line more than once per round of partition
-    // selection.
-    World::validCount++;
+    // Determine candidate suitability and cost.
+    d->evaluateCandidates();
 
-    // Iterative pre-order traversal.
-    const LineSegmentBlockTreeNode *cur  = d->rootNode;
-    const LineSegmentBlockTreeNode *prev = nullptr;
-    while(cur)
+    // Pick the best candidate. Ties go to the earliest candidate so that the choice
+    // does not depend on the order of evaluation.
+    LineSegmentSide *best = nullptr;
+    int bestOrdinal = -1;
+    PartitionCost bestCost;
+    for(int ordinal = 0; ordinal < d->candidates.sizei(); ++ordinal)
     {
-        while(cur)
-        {
-            const LineSegmentBlock &segs = *cur->userData();
-
-            // Test each line segment as a potential partition candidate.
-            for(LineSegmentSide *candidate : segs.all())
-            {
-                //LOG_DEBUG("%sline segment %p sector:%d %s -> %s")
-                //        << (candidate->hasMapLineSide()? "" : "mini-") << candidate
-                //        << (candidate->sector? candidate->sector->indexInMap() : -1)
-                //        << candidate->fromOrigin().asText()
-                //        << candidate->toOrigin().asText();
-
-                // Only map line segments are suitable candidates.
-                if(!candidate->hasMapSide())
-                    continue;
-
-                // Optimization: Only the first line segment produced from a
-                // given line is tested per round of partition costing because
-                // they are all collinear.
-                if(candidate->mapLine().validCount() == World::validCount)
-                    continue; // Skip this.
-
-                // Don't consider further segments of the candidate.
-                candidate->mapLine().setValidCount(World::validCount);
-
-                // Determine candidate suitability and cost.
-                d->beginPartitionCosting(candidate);
-            }
+        const Impl::PartitionCandidate &candidate = d->candidates.at(ordinal);
 
-            if(prev == cur->parentPtr())
-            {
-                // Descending - right first, then left.
-                prev = cur;
-                if(cur->hasRight()) cur = cur->rightPtr();
-                else                cur = cur->leftPtr();
-            }
-            else if(prev == cur->rightPtr())
-            {
-                // Last moved up the right branch - descend the left.
-                prev = cur;
-                cur = cur->leftPtr();
-            }
-            else if(prev == cur->leftPtr())
-            {
-                // Last moved up the left branch - continue upward.
-                prev = cur;
-                cur = cur->parentPtr();
-            }
-        }
+        //LOG_DEBUG("%p: %s") << candidate.line << candidate.cost.asText();
 
-        if(prev)
+        if(candidate.line && (!best || candidate.cost < bestCost))
         {
-            // No left child - back up.
-            cur = prev->parentPtr();
+            // We have a new better choice.
+            best        = candidate.line;
+            bestCost    = candidate.cost;
+            bestOrdinal = ordinal;
         }
     }
+    d->candidates.clear();
 
-    LineSegmentSide *best = nullptr;
-    if(!d->candidates.isEmpty())
-    {
-        d->costTaskPool.waitForDone();
-        PartitionCost bestCost;
-        while(Impl::PartitionCandidate *candidate = d->nextCandidate())
-        {
-            //LOG_DEBUG("%p: %s") << candidate->line << candidate->cost.asText();
-
-            if(candidate->line && (!best || candidate->cost < bestCost))
-            {
-                // We have a new better choice.
-                best     = candidate->line;
-                bestCost = candidate->cost;
-            }
+    //LOG_DEBUG("best %p score: %d.%02d")
+    //        << best << bestCost.total / 100 << bestCost.total % 100;
 
-            delete candidate;
-        }
+    if(chosenOrdinal) *chosenOrdinal = bestOrdinal;
+    return best;
+}
 
-        //LOG_DEBUG("best %p score: %d.%02d")
-        //        << best << bestCost.total / 100 << bestCost.total % 100;
-    }
+LineSegmentSide *PartitionEvaluator::candidate(LineSegmentBlockTreeNode &node, int ordinal)
+{
+    if(ordinal < 0) return nullptr;
 
-    return best;
+    d->rootNode = &node;
+    LineSegmentSide *found = nullptr;
+    int index = 0;
+    d->forAllCandidates([&] (LineSegmentSide &candidate)
+    {
+        if(index++ == ordinal)
+        {
+            found = &candidate;
+            return LoopAbort;
+        }
+        return LoopContinue;
+    });
+    return found;
 }
 
 }  // namespace bsp
@@ -52,6 +52,7 @@ using namespace de;
 namespace world {
 
 static int bspSplitFactor = 7;  // cvar
+static byte bspCache = 1;       // cvar
 
 /*
  * Additional data for all dummy elements.
@@ -469,6 +470,10 @@ DE_PIMPL(Map)
             // Configure a space partitioner.
             world::bsp::Partitioner partitioner(bspSplitFactor);
             partitioner.audienceForUnclosedSectorFound += this;
+            if (bspCache)
+            {
+                partitioner.setCachePath("/home/cache/bsp");
+            }
 
             // Build a new BSP tree.
             bsp.tree = partitioner.makeBspTree(linesToBuildFor, mesh);
@@ -479,6 +484,13 @@ DE_PIMPL(Map)
                 << partitioner.segmentCount()
                 << partitioner.vertexCount();
 
+            if (bspCache)
+            {
+                const auto counts = world::bsp::Partitioner::cacheCounts();
+                LOGDEV_MAP_VERBOSE("BSP cache: %i hits, %i misses")
+                    << counts.hits << counts.misses;
+            }
+
             // Attribute an index to any new vertexes.
             for (int i = nextVertexOrd; i < mesh.vertexCount(); ++i)
             {
@@ -708,9 +720,11 @@ DE_PIMPL(Map)
     {
         // Setup the blockmap area to enclose the whole map, plus a margin
         // (margin is needed for a map that fits entirely inside one blockmap cell).
+        // Mobjs are relinked whenever they move, so use flat cell storage.
         mobjBlockmap.reset(
             new Blockmap(AABoxd(bounds.minX - margin, bounds.minY - margin,
-                                bounds.maxX + margin, bounds.maxY + margin)));
+                                bounds.maxX + margin, bounds.maxY + margin),
+                         128, Blockmap::FlatStorage));
 
         LOG_MAP_VERBOSE("Mobj blockmap dimensions:")
             << mobjBlockmap->dimensions().asText();
@@ -810,7 +824,8 @@ DE_PIMPL(Map)
         // (margin is needed for a map that fits entirely inside one blockmap cell).
         polyobjBlockmap.reset(
             new Blockmap(AABoxd(bounds.minX - margin, bounds.minY - margin,
-                                bounds.maxX + margin, bounds.maxY + margin)));
+                                bounds.maxX + margin, bounds.maxY + margin),
+                         128, Blockmap::FlatStorage));
 
         LOG_MAP_VERBOSE("Polyobj blockmap dimensions:")
             << polyobjBlockmap->dimensions().asText();
@@ -1187,11 +1202,17 @@ DE_PIMPL(Map)
     DE_PIMPL_AUDIENCE(OneWayWindowFound)
     DE_PIMPL_AUDIENCE(UnclosedSectorFound)
     DE_PIMPL_AUDIENCE(Deletion)
+    DE_PIMPL_AUDIENCE(ElementPropertyChange)
+    DE_PIMPL_AUDIENCE(MobjChange)
+    DE_PIMPL_AUDIENCE(PolyobjChange)
 };
 
 DE_AUDIENCE_METHOD(Map, OneWayWindowFound)
 DE_AUDIENCE_METHOD(Map, UnclosedSectorFound)
 DE_AUDIENCE_METHOD(Map, Deletion)
+DE_AUDIENCE_METHOD(Map, ElementPropertyChange)
+DE_AUDIENCE_METHOD(Map, MobjChange)
+DE_AUDIENCE_METHOD(Map, PolyobjChange)
 
 Map::Map(res::MapManifest *manifest) : d(new Impl(this))
 {
@@ -1879,6 +1900,11 @@ void Map::link(mobj_t &mob, int flags)
     }
 }
 
+void Map::notifyMobjChanged(const mobj_t &mob)
+{
+    DE_NOTIFY(MobjChange, i) i->mapMobjChanged(mob);
+}
+
 void Map::unlink(Polyobj &polyobj)
 {
     d->polyobjBlockmap->unlink(polyobj.bounds, &polyobj);
@@ -1889,6 +1915,11 @@ void Map::link(Polyobj &polyobj)
     d->polyobjBlockmap->link(polyobj.bounds, &polyobj);
 }
 
+void Map::notifyPolyobjChanged(const Polyobj &polyobj)
+{
+    DE_NOTIFY(PolyobjChange, i) i->mapPolyobjChanged(polyobj);
+}
+
 int Map::polyobjCount() const
 {
     return d->polyobjs.count();
@@ -2591,6 +2622,7 @@ void Map::consoleRegister() // static
     Sector::consoleRegister();
 
     C_VAR_INT("bsp-factor", &bspSplitFactor, CVF_NO_MAX, 0, 0);
+    C_VAR_BYTE("bsp-cache", &bspCache, 0, 0, 1);
 
     C_CMD("inspectmap", "", InspectMap);
 }
@@ -122,6 +122,11 @@ void Mobj_SetState(mobj_t *mob, int statenum)
     {
         data->stateChanged(oldState);
     }
+
+    if (world::World::get().hasMap())
+    {
+        Mobj_Map(*mob).notifyMobjChanged(*mob);
+    }
 }
 
 void P_MobjRecycle(mobj_t* mo)
@@ -346,6 +346,8 @@ bool Polyobj::move(const Vec2d &delta)
         return false;
     }
 
+    map().notifyPolyobjChanged(*this);
+
 #if 0
     // Various parties may be interested in this change; signal it.
     notifyGeometryChanged(*this);
@@ -426,6 +428,7 @@ bool Polyobj::rotate(angle_t delta)
     }
 
     updateSurfaceTangents();
+    map().notifyPolyobjChanged(*this);
 
 #if 0
     // Various parties may be interested in this change; signal it.
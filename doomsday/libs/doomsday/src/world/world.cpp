@@ -34,6 +34,7 @@
 #include "doomsday/defs/mapinfo.h"
 #include "doomsday/res/mapmanifests.h"
 #include "doomsday/res/resources.h"
+#include "doomsday/filesys/filehandle.h"
 #include "doomsday/filesys/lumpindex.h"
 #include "doomsday/doomsdayapp.h"
 #include "doomsday/busymode.h"
@@ -143,12 +144,17 @@ DE_PIMPL(World)
     {
         LOG_AS("ClientServerWorld::loadMap");
 
+        const duint64 viewedBefore = res::FileHandle::viewedByteCount();
+
         // Try a JIT conversion with the help of a plugin.
         auto *map = convertMap(mapManifest, reporter);
         if (!map)
         {
             LOG_WARNING("Failed conversion of \"%s\".") << mapManifest.composeUri().path();
         }
+
+        LOG_RES_VERBOSE("%i bytes of map data accessed without copying")
+            << res::FileHandle::viewedByteCount() - viewedBefore;
         return map;
     }
     /**
@@ -194,6 +194,14 @@ public:  // Saved session management -------------------------------------------
      */
     void save(const de::String &saveName, const de::String &userDescription);
 
+    /**
+     * Determines whether a save is still being written to disk. Saving returns once the
+     * game package has been serialized in memory; writing the package to disk, and
+     * copying it to the user's save slot, is completed in the background. Saving is not
+     * possible again until then (see isSavingPossible()).
+     */
+    bool isSaving() const;
+
     /**
      * Load the game state from the @em user saved session specified.
      *
@@ -23,9 +23,13 @@
 #include <de/app.h>
 #include <de/commandline.h>
 #include <de/arrayvalue.h>
+#include <de/directoryfeed.h>
+#include <de/loop.h>
+#include <de/nativefile.h>
 #include <de/numbervalue.h>
 #include <de/recordvalue.h>
 #include <de/packageloader.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/textvalue.h>
 #include <de/ziparchive.h>
@@ -108,6 +112,7 @@ static GameSession theSession;
 
 DE_PIMPL(GameSession)
 , public GameStateFolder::IMapStateReaderFactory
+, DE_OBSERVES(TaskPool, Done)
 {
     String episodeId;
     GameRules rules;
@@ -118,8 +123,32 @@ DE_PIMPL(GameSession)
 
     acs::System acscriptSys;  ///< The One acs::System instance.
 
+    /**
+     * Internal save being written to disk in the background. The background task only
+     * accesses the serialized bytes and its own native file; the internal save package
+     * on disk must not be accessed until the write has finished.
+     */
+    struct PendingSave
+    {
+        GameStateFolder *saved;
+        GameStateMetadata metadata;
+        String userSavePath;  ///< Copy of the internal save is made here (if not empty).
+        NativePath nativePath; ///< Where the package is written.
+        Block data;           ///< Serialized package.
+        String error;         ///< Set by the background task if writing fails.
+    };
+    std::unique_ptr<PendingSave> pendingSave;
+    TaskPool saveTasks;
+
     Impl(Public *i) : Base(i)
-    {}
+    {
+        saveTasks.audienceForDone() += this;
+    }
+
+    ~Impl()
+    {
+        saveTasks.waitForDone();
+    }
 
     inline String userSavePath(const String &fileName)
     {
@@ -129,6 +158,8 @@ DE_PIMPL(GameSession)
 
     void cleanupInternalSave()
     {
+        waitForPendingSave();
+
         // Ensure the internal save folder exists.
         App::fileSystem().makeFolder(internalSavePath().fileNamePath());
 
@@ -262,13 +293,17 @@ DE_PIMPL(GameSession)
      * Update/create a new GameStateFolder at the specified @a path from the current
      * game state.
      */
-    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata)
+    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata,
+                                           const String &userSavePath = {})
     {
         DE_ASSERT(self().hasBegun());
 
         LOG_AS("GameSession");
         LOG_RES_VERBOSE("Serializing to \"%s\"...") << path;
 
+        // The previous save must be written before the package can be changed again.
+        waitForPendingSave();
+
         // Does the .save already exist?
         auto *saved = App::rootFolder().tryLocate<GameStateFolder>(path);
         if (saved)
@@ -307,12 +342,128 @@ DE_PIMPL(GameSession)
         //DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
         //self().setThinkerMapping(nullptr);
 
+        if (userSavePath)
+        {
+            // The serialized state is now in memory. Compressing the package and writing
+            // it to disk may take a while, so do it in the background.
+            beginBackgroundWrite(*saved, metadata, userSavePath);
+            return *saved;
+        }
+
         saved->flush();  // No need to populate; FS2 Files already in sync with source data.
         saved->cacheMetadata(metadata);  // Avoid immediately reopening the .save package.
 
         return *saved;
     }
 
+    void beginBackgroundWrite(GameStateFolder &saved, const GameStateMetadata &metadata,
+                              const String &userSavePath)
+    {
+        DE_ASSERT(!pendingSave);
+        pendingSave.reset(new PendingSave{&saved, metadata, userSavePath, {}, {}, {}});
+        PendingSave *pending = pendingSave.get();
+
+        const auto *source = maybeAs<NativeFile>(saved.source());
+        if (!source)
+        {
+            // Not a native file; write it right away.
+            saved.flush();
+            finishPendingSave();
+            return;
+        }
+
+        // Serializing updates the archive entries, so it is done here in the main
+        // thread. The entries are compressed in parallel by the task pool.
+        saved.archive().cache();
+        de::Writer(pending->data) << saved.archive();
+        pending->nativePath = source->nativePath();
+
+        // Writing the bytes to disk may take a while, so do it in the background.
+        saveTasks.start([pending] ()
+        {
+            try
+            {
+                std::unique_ptr<NativeFile> out(NativeFile::newStandalone(pending->nativePath));
+                out->setMode(File::Write);
+                out->clear();
+                *out << pending->data;
+                out->flush();
+                pending->data.clear();
+            }
+            catch (const Error &er)
+            {
+                pending->error = er.asText();
+            }
+        });
+    }
+
+    void taskPoolDone(TaskPool &) override
+    {
+        // Called in the background thread.
+        Loop::mainCall([this] () { finishPendingSave(); });
+    }
+
+    /**
+     * Completes the pending save once it has been written to disk. A newer pending
+     * save that is still being written is left alone.
+     */
+    void finishPendingSave()
+    {
+        if (!pendingSave || !saveTasks.isDone()) return;
+
+        std::unique_ptr<PendingSave> pending(pendingSave.release());
+
+        LOG_AS("GameSession");
+        if (pending->error)
+        {
+            LOG_RES_WARNING("Error saving game session to '%s':\n")
+                    << pending->userSavePath << pending->error;
+            P_SetMessage(&players[CONSOLEPLAYER], "Failed to save game!");
+            return;
+        }
+
+        if (!pending->nativePath.isEmpty())
+        {
+            // The package was written behind the file's back: reopen it and update
+            // its status.
+            auto &source = pending->saved->source()->as<NativeFile>();
+            source.setMode(source.mode());
+            source.setStatus(DirectoryFeed::fileStatus(pending->nativePath));
+        }
+
+        pending->saved->cacheMetadata(pending->metadata);  // Avoid immediately reopening the .save package.
+
+        try
+        {
+            // Copy the internal saved session to the destination slot.
+            AbstractSession::copySaved(pending->userSavePath, pending->saved->path());
+
+            P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
+
+            // Notify the engine that the game was saved.
+            /// @todo After the engine has the primary responsibility of saving the game,
+            /// this notification is unnecessary.
+            Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+        }
+        catch (const Error &er)
+        {
+            LOG_RES_WARNING("Error saving game session to '%s':\n")
+                    << pending->userSavePath << er.asText();
+            P_SetMessage(&players[CONSOLEPLAYER], "Failed to save game!");
+        }
+    }
+
+    /**
+     * Blocks until the pending save (if any) has been written to disk and completed.
+     */
+    void waitForPendingSave()
+    {
+        if (!pendingSave) return;
+
+        saveTasks.waitForDone();
+        finishPendingSave();
+    }
+
 #if __JDOOM__ || __JDOOM64__
     /**
      * @todo fixme: (Kludge) Assumes the original mobj info tic timing values have
@@ -507,6 +658,8 @@ DE_PIMPL(GameSession)
 
     void loadSaved(const String &savePath)
     {
+        waitForPendingSave();
+
         ::briefDisabled = true;
 
         G_StopDemo();
@@ -912,6 +1065,7 @@ bool GameSession::isSavingPossible()
     if (IS_CLIENT || Get(DD_PLAYBACK)) return false;
 
     if (!hasBegun()) return false;
+    if (isSaving()) return false; // Previous save is still being written.
     if (GS_MAP != G_GameState()) return false;
 
     /// @todo fixme: What about splitscreen!
@@ -1054,6 +1208,7 @@ void GameSession::end()
         G_ResetViewEffects();
     }
 
+    d->waitForPendingSave();
     AbstractSession::removeSaved(internalSavePath());
 
     setInProgress(false);
@@ -1187,6 +1342,9 @@ void GameSession::leaveMap(const res::Uri &nextMapUri, uint nextMapEntryPoint)
     // If there are any InFine scripts running, they must be stopped.
     FI_StackClear();
 
+    // Progress is saved to the internal save package.
+    d->waitForPendingSave();
+
 #if __JHEXEN__
     // Take a copy of the player objects (they will be cleared in the process
     // of calling @ref P_SetupMap() and we need to restore them after).
@@ -1355,21 +1513,14 @@ void GameSession::save(const String &saveName, const String &userDescription)
         GameStateMetadata metadata = d->metadata();
         metadata.set("userDescription", chooseSaveDescription(savePath, userDescription));
 
-        // Update the existing internal .save package.
-        d->updateGameStateFolder(internalSavePath(), metadata);
+        // Update the existing internal .save package. It is written to disk and copied
+        // to the destination slot in the background.
+        d->updateGameStateFolder(internalSavePath(), metadata, savePath);
 
         // In networked games the server tells the clients to save also.
         NetSv_SaveGame(metadata.getui("sessionId"));
 
-        // Copy the internal saved session to the destination slot.
-        AbstractSession::copySaved(savePath, internalSavePath());
-
-        P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
-
-        // Notify the engine that the game was saved.
-        /// @todo After the engine has the primary responsibility of saving the game,
-        /// this notification is unnecessary.
-        Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+        P_SetMessage(&players[CONSOLEPLAYER], "Saving game...");
     }
     catch (const Error &er)
     {
@@ -1387,14 +1538,21 @@ void GameSession::load(const String &saveName)
     P_SetMessage(&players[CONSOLEPLAYER], "Game loaded");
 }
 
+bool GameSession::isSaving() const
+{
+    return bool(d->pendingSave);
+}
+
 void GameSession::copySaved(const String &destName, const String &sourceName)
 {
+    d->waitForPendingSave();
     AbstractSession::copySaved(d->userSavePath(destName), d->userSavePath(sourceName));
     LOG_MSG("Copied savegame \"%s\" to \"%s\"") << sourceName << destName;
 }
 
 void GameSession::removeSaved(const String &saveName)
 {
+    d->waitForPendingSave();
     AbstractSession::removeSaved(d->userSavePath(saveName));
 }
 
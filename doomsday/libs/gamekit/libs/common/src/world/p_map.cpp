@@ -2718,6 +2718,9 @@ static int PIT_ChangeSector(mobj_t *thing, void *context)
         return false;
     }
 
+    // Moving planes change the mobj without relinking it.
+    Mobj_MarkChanged(thing);
+
     // Update the Z position of the mobj and determine whether it physically
     // fits in the opening between floor and ceiling.
     if (!P_MobjIsCamera(thing))
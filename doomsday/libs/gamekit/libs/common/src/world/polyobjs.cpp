@@ -79,6 +79,7 @@ static void PO_SetDestination(Polyobj *po, coord_t dist, uint fineAngle, float s
     po->dest[VX] = po->origin[VX] + dist * FIX2FLT(finecosine[fineAngle]);
     po->dest[VY] = po->origin[VY] + dist * FIX2FLT(finesine[fineAngle]);
     po->speed    = speed;
+    Polyobj_MarkChanged(po);
 }
 
 static void PODoor_UpdateDestination(polydoor_t *pd)
@@ -179,6 +180,7 @@ dd_bool EV_RotatePoly(Line *line, byte *args, int direction, dd_bool overRide)
     pe->intSpeed = (args[1] * direction * (ANGLE_90 / 64)) >> 3;
     po->specialData = pe;
     po->angleSpeed = pe->intSpeed;
+    Polyobj_MarkChanged(po);
     startSoundSequence(po);
 
     int mirror; // tag
@@ -218,6 +220,7 @@ dd_bool EV_RotatePoly(Line *line, byte *args, int direction, dd_bool overRide)
         direction = -direction;
         pe->intSpeed = (args[1] * direction * (ANGLE_90 / 64)) >> 3;
         po->angleSpeed = pe->intSpeed;
+        Polyobj_MarkChanged(po);
 
         po = Polyobj_ByTag(tag);
         if(po)
@@ -1110,6 +1110,9 @@ int P_DamageMobj2(mobj_t *target, mobj_t *inflictor, mobj_t *source,
 
     originalHealth = target->health;
 
+    // Health, flags and momentum may change without the mobj being relinked.
+    Mobj_MarkChanged(target);
+
     // The actual damage (== damageP * netMobDamageModifier for any
     // non-player mobj).
     damage = damageP;
@@ -1033,6 +1033,9 @@ int P_DamageMobj2(mobj_t *target, mobj_t *inflictor, mobj_t *source,
 
     originalHealth = target->health;
 
+    // Health, flags and momentum may change without the mobj being relinked.
+    Mobj_MarkChanged(target);
+
     if (!skipNetworkCheck)
     {
         // Clients can't harm anybody.
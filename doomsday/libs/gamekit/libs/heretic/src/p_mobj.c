@@ -235,6 +235,9 @@ void P_MobjMoveXY(mobj_t *mo)
     //player_t *player;
     dd_bool largeNegative;
 
+    // Momentum may change even if the mobj does not move.
+    Mobj_MarkChanged(mo);
+
     // $democam: cameramen have their own movement code
     if(P_CameraXYMovement(mo))
         return;
@@ -371,6 +374,9 @@ void P_MobjMoveZ(mobj_t *mo)
     coord_t dist;
     coord_t delta;
 
+    // Z movement does not relink the mobj.
+    Mobj_MarkChanged(mo);
+
     // $democam: cameramen get special z movement
     if(P_CameraZMovement(mo))
         return;
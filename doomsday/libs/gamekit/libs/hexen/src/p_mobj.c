@@ -274,6 +274,9 @@ void P_MobjMoveXY(mobj_t* mo)
     player_t* player;
     angle_t angle;
 
+    // Momentum may change even if the mobj does not move.
+    Mobj_MarkChanged(mo);
+
     // $democam: cameramen have their own movement code
     if(P_CameraXYMovement(mo))
         return;
@@ -614,6 +617,9 @@ void P_MobjMoveZ(mobj_t* mo)
 {
     coord_t gravity, dist, delta;
 
+    // Z movement does not relink the mobj.
+    Mobj_MarkChanged(mo);
+
     // $democam: cameramen get special z movement
     if(P_CameraZMovement(mo)) return;
 
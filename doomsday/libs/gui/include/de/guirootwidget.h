@@ -152,6 +152,11 @@ public:
 protected:
     virtual void loadCommonTextures();
 
+    /**
+     * Adds the rule rectangles of all GUI widgets in the tree.
+     */
+    void collectRuleRectangles(List<const RuleRectangle *> &rects) const override;
+
 private:
     DE_PRIVATE(d)
 };
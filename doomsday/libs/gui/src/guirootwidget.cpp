@@ -147,6 +147,9 @@ DE_PIMPL(GuiRootWidget)
         // The focus indicator exists outside the widget tree.
         focusIndicator = new FocusWidget;
         focusIndicator->setRoot(thisPublic);
+
+        // Layout rules can be evaluated as a compiled graph (experimental).
+        self().setRuleGraphEnabled(App::commandLine().has("-rulegraph"));
     }
 
     ~Impl()
@@ -366,6 +369,22 @@ void GuiRootWidget::loadCommonTextures()
     d->initBankContents();
 }
 
+void GuiRootWidget::collectRuleRectangles(List<const RuleRectangle *> &rects) const
+{
+    std::function<void (const Widget &)> collect = [&rects, &collect] (const Widget &widget)
+    {
+        for (const Widget *child : widget.children())
+        {
+            if (const GuiWidget *gui = maybeAs<GuiWidget>(child))
+            {
+                rects << &gui->rule();
+            }
+            collect(*child);
+        }
+    };
+    collect(*this);
+}
+
 const GuiWidget *GuiRootWidget::globalHitTest(const Vec2i &pos) const
 {
     const Widget::Children childs = children();
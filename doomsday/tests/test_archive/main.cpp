@@ -25,9 +25,97 @@
 #include <de/reader.h>
 #include <de/writer.h>
 #include <de/filesystem.h>
+#include <de/commandline.h>
+#include <de/elapsedtimer.h>
+#include <de/nativefile.h>
+#include <de/taskpool.h>
 
 using namespace de;
 
+/**
+ * Marks all entries in a folder of the archive as changed so that they will be
+ * compressed again when the archive is written.
+ *
+ * @return Total size of the entries in bytes.
+ */
+static dsize touchEntries(Archive &arch, const Path &folder = Path())
+{
+    dsize bytes = 0;
+    Archive::Names names;
+    arch.listFiles(names, folder);
+    for (const String &name : names)
+    {
+        bytes += arch.entryBlock(folder / name).size();
+    }
+    names.clear();
+    arch.listFolders(names, folder);
+    for (const String &name : names)
+    {
+        bytes += touchEntries(arch, folder / name);
+    }
+    return bytes;
+}
+
+/**
+ * Measures how long it takes to recompress and write out a ZIP archive. The
+ * archive given with the "-repack" option is used, or a generated one.
+ */
+static void benchmarkRepack()
+{
+    const CommandLine &cmdLine = App::commandLine();
+
+    std::unique_ptr<NativeFile> sourceFile;
+    std::unique_ptr<ZipArchive> arch;
+    if (auto arg = cmdLine.check("-repack", 1))
+    {
+        sourceFile.reset(NativeFile::newStandalone(NativePath(arg.params.at(0))));
+        arch.reset(new ZipArchive(*sourceFile));
+    }
+    else
+    {
+        // 64 entries of semi-compressible data.
+        arch.reset(new ZipArchive);
+        duint32 seed = 1;
+        for (int i = 0; i < 64; ++i)
+        {
+            Block data(1024 * 1024);
+            for (dsize k = 0; k < data.size(); ++k)
+            {
+                seed = seed * 1103515245 + 12345;
+                data.data()[k] = dbyte('a' + (seed >> 16) % 16);
+            }
+            arch->add(Path(Stringf("data/entry%02i.lmp", i)), data);
+        }
+    }
+
+    const dsize totalBytes = touchEntries(*arch);
+    arch->cache();
+
+    const NativePath outPath = App::app().nativeHomePath() / "repacked.zip";
+    std::unique_ptr<NativeFile> outFile(NativeFile::newStandalone(outPath));
+    outFile->setMode(File::Write);
+    outFile->clear();
+
+    ElapsedTimer timer;
+    Writer(*outFile) << *arch;
+    outFile->flush();
+    const ddouble seconds = timer.elapsedSeconds();
+
+    LOG_MSG("Repacked %.1f MB into %.1f MB in %.2f seconds (%.1f MB/s, %i workers)")
+            << totalBytes / 1.0e6
+            << outFile->size() / 1.0e6
+            << seconds
+            << totalBytes / 1.0e6 / seconds
+            << TaskPool::workerCount();
+
+    // Verify the result.
+    ZipArchive repacked(*outFile);
+    if (touchEntries(repacked) != totalBytes)
+    {
+        throw Error("benchmarkRepack", "Repacked archive has different contents");
+    }
+}
+
 int main(int argc, char **argv)
 {
     init_Foundation();
@@ -135,6 +223,8 @@ int main(int argc, char **argv)
 
         FS::copySerialized(updated.path(), "home/copied.zip");
         LOG_MSG("Normal copy: ") << App::rootFolder().locate<File const>("home/copied.zip").description();
+
+        benchmarkRepack();
     }
     catch (const Error &err)
     {
@@ -0,0 +1,245 @@
+/**
+ * @file main.cpp
+ *
+ * Blockmap microbenchmark: ring vs. flat cell storage. @ingroup tests
+ *
+ * Replays a trace of map-object link/unlink operations against both blockmap
+ * storage backends, and checks that both visit the same objects in the same
+ * order. The trace can be given as a text file where each line is
+ * "L x y id" (link object @em id at map point x,y), "U x y id" (unlink) or
+ * "B minX minY maxX maxY" (iterate a box). Without a trace file, a trace of
+ * objects wandering around a large map is generated.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/elapsedtimer.h>
+#include <de/liblegacy.h>
+#include <de/legacy/memoryzone.h>
+#include <doomsday/world/blockmap.h>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace de;
+using namespace world;
+
+struct Op
+{
+    char   type; // 'L', 'U' or 'B'
+    Vec2d  pos;
+    Vec2d  max;
+    dint   id;
+};
+
+static const ddouble MAP_SIZE = 16384;
+
+static std::vector<Op> generateTrace(int objectCount, int steps)
+{
+    std::vector<Op> ops;
+    std::vector<Vec2d> pos(objectCount);
+    duint32 rnd = 1;
+    auto random = [&rnd]() { rnd = rnd * 1664525u + 1013904223u; return (rnd >> 8) / ddouble(1 << 24); };
+
+    for (int i = 0; i < objectCount; ++i)
+    {
+        pos[i] = Vec2d(random(), random()) * MAP_SIZE;
+        ops.push_back(Op{'L', pos[i], Vec2d(), i});
+    }
+    for (int s = 0; s < steps; ++s)
+    {
+        const int i = int(random() * objectCount);
+        ops.push_back(Op{'U', pos[i], Vec2d(), i});
+        pos[i] += Vec2d(random() - .5, random() - .5) * 64;
+        pos[i] = pos[i].max(Vec2d(0, 0)).min(Vec2d(MAP_SIZE - 1, MAP_SIZE - 1));
+        ops.push_back(Op{'L', pos[i], Vec2d(), i});
+        if (s % 4 == 0)
+        {
+            // Movement checks look for nearby objects.
+            ops.push_back(Op{'B', pos[i] - Vec2d(128, 128), pos[i] + Vec2d(128, 128), i});
+        }
+    }
+    for (int i = 0; i < objectCount; ++i)
+    {
+        ops.push_back(Op{'U', pos[i], Vec2d(), i});
+    }
+    return ops;
+}
+
+static std::vector<Op> loadTrace(const char *path)
+{
+    std::vector<Op> ops;
+    std::ifstream in(path);
+    char type;
+    while (in >> type)
+    {
+        Op op{type, Vec2d(), Vec2d(), 0};
+        if (type == 'B')
+        {
+            in >> op.pos.x >> op.pos.y >> op.max.x >> op.max.y;
+        }
+        else
+        {
+            in >> op.pos.x >> op.pos.y >> op.id;
+        }
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+/**
+ * Result of replaying a trace. The visit order is summarized as a hash of the
+ * visited objects.
+ */
+struct Visits
+{
+    dsize   count = 0;
+    duint64 orderHash = 0;
+
+    void visit(const void *obj, const void *base)
+    {
+        count++;
+        note(duint64(static_cast<const char *>(obj) - static_cast<const char *>(base)));
+    }
+
+    void note(duint64 value)
+    {
+        orderHash = orderHash * 1099511628211ull + value;
+    }
+
+    bool operator == (const Visits &other) const
+    {
+        return count == other.count && orderHash == other.orderHash;
+    }
+};
+
+static double replay(const std::vector<Op> &ops, Blockmap::CellStorage storage, Visits &visits)
+{
+    Blockmap bmap(AABoxd(-8, -8, MAP_SIZE + 8, MAP_SIZE + 8), 128, storage);
+    std::vector<char> objects(65536);
+
+    ElapsedTimer timer;
+    for (const Op &op : ops)
+    {
+        void *obj = &objects[dsize(op.id) % objects.size()];
+        switch (op.type)
+        {
+        case 'L': bmap.link  (bmap.toCell(op.pos), obj); break;
+        case 'U': bmap.unlink(bmap.toCell(op.pos), obj); break;
+        case 'B':
+            bmap.forAllInBox(AABoxd(op.pos.x, op.pos.y, op.max.x, op.max.y),
+                             [&visits, &objects] (void *found) {
+                visits.visit(found, objects.data());
+                return LoopContinue;
+            });
+            break;
+        }
+    }
+    const double elapsed = timer.elapsedSeconds();
+    Z_FreeTags(PU_MAP, PU_PURGELEVEL - 1);
+    return elapsed;
+}
+
+/**
+ * Links, unlinks and iterates a single cell in ways that depend on the details of
+ * the ring storage: the same object linked more than once, reuse of unlinked
+ * slots, and objects linked and unlinked during iteration.
+ */
+static Visits cellBehavior(Blockmap::CellStorage storage)
+{
+    Blockmap bmap(AABoxd(0, 0, 256, 256), 128, storage);
+    const Blockmap::Cell cell(0, 0);
+    char objects[16];
+    Visits visits;
+
+    duint32 rnd = 1;
+    auto random = [&rnd]() { rnd = rnd * 1664525u + 1013904223u; return rnd >> 8; };
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        void *obj = &objects[random() % 16];
+        switch (random() % 4)
+        {
+        case 0:
+        case 1:
+            bmap.link(cell, obj);
+            break;
+
+        case 2:
+            visits.note(bmap.unlink(cell, obj)? 1 : 0);
+            break;
+
+        default:
+            bmap.forAllInCell(cell, [&] (void *elem) {
+                visits.visit(elem, objects);
+                const duint32 r = random();
+                if (r % 5 == 0) bmap.unlink(cell, &objects[r % 16]);
+                if (r % 5 == 1) bmap.link  (cell, &objects[r % 16]);
+                return LoopContinue;
+            });
+            break;
+        }
+        visits.note(duint64(bmap.cellElementCount(cell)));
+    }
+    Z_FreeTags(PU_MAP, PU_PURGELEVEL - 1);
+    return visits;
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int errors = 0;
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+        Libdeng_Init();
+
+        const std::vector<Op> ops = (argc > 1 ? loadTrace(argv[1]) : generateTrace(20000, 2000000));
+        std::cout << ops.size() << " operations" << std::endl;
+
+        Visits ringVisits, flatVisits;
+        const double ring = replay(ops, Blockmap::RingStorage, ringVisits);
+        const double flat = replay(ops, Blockmap::FlatStorage, flatVisits);
+
+        std::cout << "Ring storage: " << ring << " s (" << ringVisits.count << " visits)" << std::endl
+                  << "Flat storage: " << flat << " s (" << flatVisits.count << " visits)" << std::endl
+                  << "Speedup: " << ring / flat << "x" << std::endl;
+        if (!(ringVisits == flatVisits))
+        {
+            std::cout << "Trace visits differ between the storage backends" << std::endl;
+            errors++;
+        }
+        if (!(cellBehavior(Blockmap::RingStorage) == cellBehavior(Blockmap::FlatStorage)))
+        {
+            std::cout << "Cell behavior differs between the storage backends" << std::endl;
+            errors++;
+        }
+
+        Libdeng_Shutdown();
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return errors? 1 : 0;
+}
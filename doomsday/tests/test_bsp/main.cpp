@@ -0,0 +1,301 @@
+/**
+ * @file main.cpp
+ *
+ * BSP build benchmark: serial vs. parallel partitioning. @ingroup tests
+ *
+ * Reads the map geometry of every map in the given WAD files (e.g., the stock
+ * IWADs) and builds a BSP for each map both serially and with the parallel
+ * partitioner. The resulting trees are compared to verify that the output is
+ * identical.
+ *
+ * Usage: test_bsp doom.wad doom2.wad heretic.wad hexen.wad ...
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/block.h>
+#include <de/elapsedtimer.h>
+#include <de/writer.h>
+#include <doomsday/mesh/mesh.h>
+#include <doomsday/world/bsp/partitioner.h>
+#include <doomsday/world/bspleaf.h>
+#include <doomsday/world/bspnode.h>
+#include <doomsday/world/convexsubspace.h>
+#include <doomsday/world/factory.h>
+#include <doomsday/world/line.h>
+#include <doomsday/world/sector.h>
+#include <doomsday/world/vertex.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace de;
+using namespace world;
+
+struct Lump
+{
+    std::string name;
+    std::vector<char> data;
+};
+
+/// Geometry of one map, as read from the WAD lumps.
+struct MapGeometry
+{
+    std::string name;
+    std::vector<Vec2d> vertexes;
+    std::vector<int> sideSectors;  ///< Sector index of each sidedef.
+    struct LineDef { int v1, v2, front, back; };
+    std::vector<LineDef> lines;
+    int sectorCount = 0;
+};
+
+static inline int readShort(const std::vector<char> &data, dsize pos)
+{
+    return dint16(duint8(data[pos]) | (duint8(data[pos + 1]) << 8));
+}
+
+static inline int readUShort(const std::vector<char> &data, dsize pos)
+{
+    return duint16(duint8(data[pos]) | (duint8(data[pos + 1]) << 8));
+}
+
+static inline dint32 readLong(const char *data)
+{
+    return dint32(duint8(data[0]) | (duint8(data[1]) << 8) | (duint8(data[2]) << 16) |
+                  (duint32(duint8(data[3])) << 24));
+}
+
+static std::vector<Lump> readWad(const char *path)
+{
+    std::vector<Lump> lumps;
+    std::ifstream in(path, std::ios::binary);
+    char header[12];
+    if (!in.read(header, 12) || (std::strncmp(header, "IWAD", 4) && std::strncmp(header, "PWAD", 4)))
+    {
+        std::cerr << path << ": not a WAD file" << std::endl;
+        return lumps;
+    }
+    const int count = readLong(header + 4);
+    in.seekg(readLong(header + 8));
+    std::vector<char> dir(dsize(count) * 16);
+    in.read(dir.data(), dir.size());
+    for (int i = 0; i < count; ++i)
+    {
+        const char *entry = &dir[dsize(i) * 16];
+        Lump lump;
+        lump.name = std::string(entry + 8, strnlen(entry + 8, 8));
+        lump.data.resize(dsize(readLong(entry + 4)));
+        in.seekg(readLong(entry));
+        in.read(lump.data.data(), lump.data.size());
+        lumps.push_back(std::move(lump));
+    }
+    return lumps;
+}
+
+static std::vector<MapGeometry> findMaps(const std::vector<Lump> &lumps)
+{
+    std::vector<MapGeometry> maps;
+    for (dsize i = 0; i + 10 < lumps.size(); ++i)
+    {
+        if (lumps[i + 1].name != "THINGS" || lumps[i + 2].name != "LINEDEFS") continue;
+
+        auto find = [&] (const char *name) -> const std::vector<char> & {
+            for (dsize k = i + 1; k < lumps.size() && k < i + 12; ++k)
+            {
+                if (lumps[k].name == name) return lumps[k].data;
+            }
+            static const std::vector<char> empty;
+            return empty;
+        };
+        const bool hexen = !find("BEHAVIOR").empty();
+        const auto &linedefs = find("LINEDEFS");
+        const auto &sidedefs = find("SIDEDEFS");
+        const auto &vertexes = find("VERTEXES");
+
+        MapGeometry map;
+        map.name = lumps[i].name;
+        map.sectorCount = int(find("SECTORS").size() / 26);
+        for (dsize pos = 0; pos + 4 <= vertexes.size(); pos += 4)
+        {
+            map.vertexes.push_back(Vec2d(readShort(vertexes, pos), readShort(vertexes, pos + 2)));
+        }
+        for (dsize pos = 0; pos + 30 <= sidedefs.size(); pos += 30)
+        {
+            map.sideSectors.push_back(readUShort(sidedefs, pos + 28));
+        }
+        const dsize lineSize = (hexen ? 16 : 14);
+        for (dsize pos = 0; pos + lineSize <= linedefs.size(); pos += lineSize)
+        {
+            const dsize sides = pos + (hexen ? 12 : 10);
+            auto sector = [&map] (int side) {
+                return side >= 0 && side < int(map.sideSectors.size()) ? map.sideSectors[side] : -1;
+            };
+            map.lines.push_back(MapGeometry::LineDef{readUShort(linedefs, pos),
+                                                     readUShort(linedefs, pos + 2),
+                                                     sector(readUShort(linedefs, sides)),
+                                                     sector(readUShort(linedefs, sides + 2))});
+        }
+        maps.push_back(std::move(map));
+    }
+    return maps;
+}
+
+static int signatureWorker(BspTree &subtree, void *context)
+{
+    Writer &writer = *static_cast<Writer *>(context);
+    if (const BspElement *elem = subtree.userData())
+    {
+        if (const auto *node = maybeAs<BspNode>(elem))
+        {
+            writer << dchar('N') << node->origin.x << node->origin.y
+                   << node->direction.x << node->direction.y;
+        }
+        else
+        {
+            const auto &leaf = elem->as<BspLeaf>();
+            writer << dchar('L')
+                   << dint32(leaf.hasSubspace() ? leaf.subspace().poly().hedgeCount() : -1);
+        }
+    }
+    return 0; // Continue iteration.
+}
+
+static int deleteElementWorker(BspTree &subtree, void *)
+{
+    delete subtree.userData();
+    return 0; // Continue iteration.
+}
+
+/**
+ * Builds a BSP for the map and returns a signature of the result, comprising the
+ * tree structure and all the built vertexes.
+ */
+static Block buildBsp(const MapGeometry &geom, bool parallel, double &elapsed)
+{
+    mesh::Mesh mesh;
+    std::vector<std::unique_ptr<Sector>> sectors;
+    std::vector<std::unique_ptr<Line>> lines;
+    for (int i = 0; i < geom.sectorCount; ++i)
+    {
+        sectors.emplace_back(new Sector);
+        sectors.back()->setIndexInMap(i);
+    }
+    std::vector<Vertex *> vertexes;
+    for (const Vec2d &pos : geom.vertexes)
+    {
+        vertexes.push_back(mesh.newVertex(pos));
+    }
+    Set<Line *> lineSet;
+    auto sector = [&sectors] (int index) {
+        return index >= 0 && index < int(sectors.size()) ? sectors[index].get() : nullptr;
+    };
+    for (const auto &def : geom.lines)
+    {
+        if (def.v1 >= int(vertexes.size()) || def.v2 >= int(vertexes.size())) continue;
+        if (vertexes[def.v1]->origin() == vertexes[def.v2]->origin()) continue; // Zero length.
+        lines.emplace_back(new Line(*vertexes[def.v1], *vertexes[def.v2], 0,
+                                    sector(def.front), sector(def.back)));
+        lines.back()->setIndexInMap(int(lines.size()) - 1);
+        lineSet.insert(lines.back().get());
+    }
+
+    bsp::Partitioner partitioner;
+    partitioner.setParallelBuild(parallel);
+
+    ElapsedTimer timer;
+    BspTree *tree = partitioner.makeBspTree(lineSet, mesh);
+    elapsed = timer.elapsedSeconds();
+
+    Block signature;
+    Writer writer(signature);
+    if (tree)
+    {
+        tree->traversePreOrder(signatureWorker, &writer);
+        tree->traversePostOrder(deleteElementWorker);
+        delete tree;
+    }
+    for (const Vertex *vtx : mesh.vertices())
+    {
+        writer << vtx->origin().x << vtx->origin().y;
+    }
+    return signature.md5Hash();
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+
+        Factory::setVertexConstructor([] (mesh::Mesh &m, const Vec2d &p) {
+            return new Vertex(m, p);
+        });
+        Factory::setLineSideConstructor([] (Line &ln, Sector *s) {
+            return new LineSide(ln, s);
+        });
+        Factory::setLineSideSegmentConstructor([] (LineSide &ls, mesh::HEdge &he) {
+            return new LineSideSegment(ls, he);
+        });
+        Factory::setConvexSubspaceConstructor([] (mesh::Face &f, BspLeaf *bl) {
+            return new ConvexSubspace(f, bl);
+        });
+
+        if (argc < 2)
+        {
+            std::cout << "Usage: test_bsp (wad file)..." << std::endl;
+        }
+
+        double serialTotal = 0, parallelTotal = 0;
+        int mismatches = 0;
+        for (int i = 1; i < argc; ++i)
+        {
+            for (const MapGeometry &map : findMaps(readWad(argv[i])))
+            {
+                double serial, parallel;
+                const Block serialSig   = buildBsp(map, false, serial);
+                const Block parallelSig = buildBsp(map, true,  parallel);
+                const bool same = (serialSig == parallelSig);
+                if (!same) mismatches++;
+                serialTotal   += serial;
+                parallelTotal += parallel;
+
+                std::cout << map.name << ": " << map.lines.size() << " lines, serial "
+                          << serial << " s, parallel " << parallel << " s"
+                          << (same ? "" : " -- OUTPUT DIFFERS") << std::endl;
+            }
+        }
+
+        std::cout << "Total: serial " << serialTotal << " s, parallel " << parallelTotal
+                  << " s, speedup " << (parallelTotal > 0 ? serialTotal / parallelTotal : 0)
+                  << "x" << std::endl
+                  << mismatches << " maps with differing output" << std::endl;
+        DE_ASSERT(mismatches == 0);
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
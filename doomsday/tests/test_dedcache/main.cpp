@@ -0,0 +1,443 @@
+/**
+ * @file main.cpp
+ *
+ * Definition cache tests: parses a definition file that uses every category of
+ * definitions, saves the database to the cache, loads it back and compares the
+ * two databases. @ingroup tests
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <doomsday/defs/dedcache.h>
+#include <doomsday/defs/dedfile.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using namespace de;
+
+static int errors = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        std::cout << "FAILED: " << what << std::endl;
+        errors++;
+    }
+}
+
+/// Definitions of every category, with all the pointer members set.
+static const char *testDefinitions = R"(
+Header { Version = 6; Common model flags = "df_testa"; Default model scale = 1.5; }
+
+Flag { ID = "df_testa"; Value = 0x1; }
+Flag { ID = "statef_testa"; Value = 0x2; }
+Flag { ID = "lgf_testa"; Value = 0x4; }
+Flag { ID = "sf_testa"; Value = 0x8; }
+Flag { ID = "dtf_testa"; Value = 0x10; }
+Flag { ID = "rff_testa"; Value = 0x20; }
+Flag { ID = "gnf_testa"; Value = 0x40; }
+Flag { ID = "pt_testa"; Value = 0x3; }
+Flag { ID = "ptf_testa"; Value = 0x80; }
+Flag { ID = "dcf_testa"; Value = 0x100; }
+Flag { ID = "tgf_testa"; Value = 0x200; }
+Flag { ID = "ltf_testa"; Value = 0x400; }
+Flag { ID = "stf_testa"; Value = 0x800; }
+
+Episode { ID = "E1"; Title = "Test episode"; Start Map = "E1M1"; }
+
+Thing {
+  ID = "TESTTHING"; DoomEd number = 3004; Spawn state = "TEST_S1";
+  Speed = 8; Radius = 20; Height = 56; Misc2 = 7;
+}
+
+State { ID = "TEST_S1"; Sprite = "TEST"; Frame = 1; Tics = 5; Flags = "statef_testa"; Next state = "TEST_S2"; }
+State { ID = "TEST_S2"; Sprite = "TEST"; Frame = 2; Tics = -1; Misc1 = 3; }
+
+Sprite { ID = "TEST"; }
+Sprite { ID = "TST2"; }
+
+Material {
+  ID = "Textures:TESTWALL"; Width = 64; Height = 128;
+  Layer { Stage { Texture = "Textures:TESTWALL"; Tics = 8; Rnd = 0.5; }; };
+}
+
+Model {
+  ID = "testmodel"; State = "TEST_S1"; Scale XYZ { 1 2 3 };
+  Md2 { File = "test.md2"; Frame = "idle"; };
+}
+
+Sky {
+  ID = "testsky"; Height = 0.75; Light color { 0.5 0.5 1 };
+  Layer 1 { Material = "Textures:SKY1"; Offset = 10; };
+}
+
+Music { ID = "testmus"; Name = "Test music"; Lump = "D_TEST"; CD track = 2; }
+
+Map Info { ID = "E1M1"; Title = "Test map"; Music = "testmus"; Sky = "testsky"; Gravity = 0.5; }
+
+Finale { ID = "testfinale"; After = "E1M1"; Script { text 0 0 "Hello"; wait 2; }; }
+
+Decoration {
+  Texture = "TESTWALL"; Flags = "dcf_testa";
+  Light { Offset { 16 32 }; Color { 1 0.5 0 }; Radius = 0.5; };
+}
+
+Light {
+  State = "TEST_S1"; Map = "E1M1"; Origin { 1 2 3 }; Size = 0.5; Color { 1 0 0 };
+  Flags = "lgf_testa"; Top map = "Up"; Bottom map = "Down"; Side map = "Side";
+  Flare map = "Flare"; Halo radius = 0.25;
+}
+Light { State = "TEST_S2"; Color { 0 1 0 }; }
+
+Sound {
+  ID = "testsnd"; Lump = "DSTEST"; Name = "Test sound"; Link = "othersnd";
+  Link pitch = 2; Priority = 64; Max channels = 2; Flags = "sf_testa"; Ext = "test.wav";
+}
+Sound { ID = "othersnd"; Lump = "DSOTHER"; }
+
+Text { ID = "TESTTEXT"; Text = "Hello\nworld"; }
+Text { ID = "EMPTYTEXT"; }
+
+Texture Environment {
+  ID = "Metal";
+  Texture { ID = "TESTWALL"; };
+  Flat { ID = "TESTFLAT"; };
+}
+
+Values {
+  Test {
+    First = "1";
+    Group { Second = "two"; };
+  };
+}
+
+Detail {
+  Texture = "TESTWALL"; Flat = "TESTFLAT"; Lump = "DTLROCK"; Flags = "dtf_testa";
+  Scale = 2; Strength = 0.5; Distance = 256;
+}
+
+Reflection {
+  Texture = "TESTWALL"; Flags = "rff_testa"; Shininess = 0.5; Min color { 0.1 0.2 0.3 };
+  Shiny map = "Shinemap"; Mask map = "Mask"; Mask width = 2; Mask height = 3;
+}
+
+Generator {
+  State = "TEST_S1"; Flat = "TESTFLAT"; Map = "E1M1"; Mobj = "TESTTHING";
+  Flags = "gnf_testa"; Particles = 10; Speed = 5; Vector { 0 0 1 }; Spawn rate = 2;
+  Stage {
+    Type = "pt_testa"; Flags = "ptf_testa"; Radius = 8; Tics = 4; Color { 1 1 1 1 };
+    Frame = "frame1"; Sound = "testsnd"; Volume = 0.5;
+  };
+  Stage { Type = "pt_testa"; Radius = 1.5; Tics = 41; Spin { 1 2 }; };
+}
+
+Group {
+  Flags = "tgf_testa";
+  Texture { ID = "TESTWALL"; Tics = 8; };
+  Texture { ID = "TESTWALL2"; Tics = 8; Random = 2; };
+}
+
+Line {
+  ID = 1000; Comment = "Test line"; Flags = "ltf_testa"; Count = 2; Time = 1.5;
+  Ap9 = "TESTTHING"; Act sound = "testsnd"; Act material = "Textures:TESTWALL";
+  Deact texture = "TESTWALL2"; Act message = "On"; Texmove speed = 3;
+}
+
+Sector {
+  ID = 2000; Comment = "Test sector"; Flags = "stf_testa"; Act tag = 5; Floor chain = 3;
+  Floor chain start time = 1; Ambient sound = "testsnd"; Wind angle = 90; Gravity = 0.5;
+  Light fn = "abcz"; Light fn min tics = 2;
+}
+
+Composite BitmapFont {
+  ID = "Game:TestFont";
+  65 { Texture = "FONTA65"; };
+  66 { Texture = "FONTA66"; };
+}
+)";
+
+static bool sameUri(const res::Uri *a, const res::Uri *b)
+{
+    if (!a || !b) return a == b;
+    return a->compose() == b->compose();
+}
+
+static bool sameString(const char *a, const char *b)
+{
+    if (!a || !b) return a == b;
+    return !std::strcmp(a, b);
+}
+
+/**
+ * Compares the elements of two arrays: the bytes of the elements with the pointers
+ * cleared by @a clearPointers, and the data referred to by the pointers with
+ * @a samePointers.
+ */
+template <typename PODType, typename ClearFunc, typename SameFunc>
+static bool sameArray(const DEDArray<PODType> &a, const DEDArray<PODType> &b,
+                      ClearFunc clearPointers, SameFunc samePointers)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i)
+    {
+        alignas(PODType) duint8 x[sizeof(PODType)];
+        alignas(PODType) duint8 y[sizeof(PODType)];
+        std::memcpy(x, &a[i], sizeof(PODType));
+        std::memcpy(y, &b[i], sizeof(PODType));
+        clearPointers(*reinterpret_cast<PODType *>(x));
+        clearPointers(*reinterpret_cast<PODType *>(y));
+        if (std::memcmp(x, y, sizeof(PODType)) || !samePointers(a[i], b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Clears a nested array for comparing the bytes of its owner.
+template <typename PODType>
+static void clearNested(DEDArray<PODType> &array)
+{
+    array.elements  = nullptr;
+    array.count.max = 0; // Depends on the allocation history.
+}
+
+template <typename PODType, typename ClearFunc, typename SameFunc>
+static void checkArray(const char *name, const DEDArray<PODType> &a, const DEDArray<PODType> &b,
+                       ClearFunc clearPointers, SameFunc samePointers)
+{
+    if (a.isEmpty())
+    {
+        std::cout << name << ": ";
+        check(false, "test definitions are parsed");
+    }
+    if (!sameArray(a, b, clearPointers, samePointers))
+    {
+        std::cout << name << ": ";
+        check(false, "array is loaded intact");
+    }
+}
+
+static void checkRegister(const char *name, const DEDRegister &a, const DEDRegister &b)
+{
+    bool same = (a.size() == b.size());
+    for (int i = 0; same && i < a.size(); ++i)
+    {
+        same = (a[i].asText() == b[i].asText());
+    }
+    if (a.size() == 0)
+    {
+        std::cout << name << ": ";
+        check(false, "test definitions are parsed");
+    }
+    if (!same)
+    {
+        std::cout << name << ": ";
+        check(false, "register is loaded intact");
+    }
+}
+
+static void compareDefs(const ded_t &a, const ded_t &b)
+{
+    check(a.version == b.version && a.modelFlags == b.modelFlags &&
+          a.modelScale == b.modelScale && a.modelOffset == b.modelOffset,
+          "header values are loaded intact");
+
+    checkRegister("flags",       a.flags,       b.flags);
+    checkRegister("episodes",    a.episodes,    b.episodes);
+    checkRegister("things",      a.things,      b.things);
+    checkRegister("states",      a.states,      b.states);
+    checkRegister("materials",   a.materials,   b.materials);
+    checkRegister("models",      a.models,      b.models);
+    checkRegister("skies",       a.skies,       b.skies);
+    checkRegister("musics",      a.musics,      b.musics);
+    checkRegister("mapInfos",    a.mapInfos,    b.mapInfos);
+    checkRegister("finales",     a.finales,     b.finales);
+    checkRegister("decorations", a.decorations, b.decorations);
+
+    // The lookups of the registers are rebuilt when loading.
+    check(b.getMobjNum("TESTTHING") == a.getMobjNum("TESTTHING"), "thing lookup works");
+    check(b.getStateNum("TEST_S2") == a.getStateNum("TEST_S2"), "state lookup works");
+    check(b.getMusicNum("testmus") == a.getMusicNum("testmus"), "music lookup works");
+
+    checkArray("sprites", a.sprites, b.sprites,
+               [] (ded_sprid_t &) {},
+               [] (const ded_sprid_t &, const ded_sprid_t &) { return true; });
+    checkArray("lights", a.lights, b.lights,
+               [] (ded_light_t &d) { d.up = d.down = d.sides = d.flare = nullptr; },
+               [] (const ded_light_t &x, const ded_light_t &y) {
+                   return sameUri(x.up, y.up) && sameUri(x.down, y.down) &&
+                          sameUri(x.sides, y.sides) && sameUri(x.flare, y.flare);
+               });
+    checkArray("sounds", a.sounds, b.sounds,
+               [] (ded_sound_t &d) { d.ext = nullptr; },
+               [] (const ded_sound_t &x, const ded_sound_t &y) { return sameUri(x.ext, y.ext); });
+    checkArray("text", a.text, b.text,
+               [] (ded_text_t &d) { d.text = nullptr; },
+               [] (const ded_text_t &x, const ded_text_t &y) { return sameString(x.text, y.text); });
+    checkArray("textureEnv", a.textureEnv, b.textureEnv,
+               [] (ded_tenviron_t &d) { clearNested(d.materials); },
+               [] (const ded_tenviron_t &x, const ded_tenviron_t &y) {
+                   return sameArray(x.materials, y.materials,
+                                    [] (ded_uri_t &d) { d.uri = nullptr; },
+                                    [] (const ded_uri_t &u, const ded_uri_t &v) {
+                                        return sameUri(u.uri, v.uri);
+                                    });
+               });
+    checkArray("values", a.values, b.values,
+               [] (ded_value_t &d) { d.id = d.text = nullptr; },
+               [] (const ded_value_t &x, const ded_value_t &y) {
+                   return sameString(x.id, y.id) && sameString(x.text, y.text);
+               });
+    checkArray("details", a.details, b.details,
+               [] (ded_detailtexture_t &d) { d.material1 = d.material2 = d.stage.texture = nullptr; },
+               [] (const ded_detailtexture_t &x, const ded_detailtexture_t &y) {
+                   return sameUri(x.material1, y.material1) && sameUri(x.material2, y.material2) &&
+                          sameUri(x.stage.texture, y.stage.texture);
+               });
+    checkArray("ptcGens", a.ptcGens, b.ptcGens,
+               [] (ded_ptcgen_t &d) {
+                   d.stateNext = nullptr;
+                   d.material = d.map = nullptr;
+                   clearNested(d.stages);
+               },
+               [] (const ded_ptcgen_t &x, const ded_ptcgen_t &y) {
+                   return sameUri(x.material, y.material) && sameUri(x.map, y.map) &&
+                          sameArray(x.stages, y.stages,
+                                    [] (ded_ptcstage_t &) {},
+                                    [] (const ded_ptcstage_t &, const ded_ptcstage_t &) {
+                                        return true;
+                                    });
+               });
+    checkArray("reflections", a.reflections, b.reflections,
+               [] (ded_reflection_t &d) {
+                   d.material = d.stage.texture = d.stage.maskTexture = nullptr;
+               },
+               [] (const ded_reflection_t &x, const ded_reflection_t &y) {
+                   return sameUri(x.material, y.material) &&
+                          sameUri(x.stage.texture, y.stage.texture) &&
+                          sameUri(x.stage.maskTexture, y.stage.maskTexture);
+               });
+    checkArray("groups", a.groups, b.groups,
+               [] (ded_group_t &d) { clearNested(d.members); },
+               [] (const ded_group_t &x, const ded_group_t &y) {
+                   return sameArray(x.members, y.members,
+                                    [] (ded_group_member_t &d) { d.material = nullptr; },
+                                    [] (const ded_group_member_t &u, const ded_group_member_t &v) {
+                                        return sameUri(u.material, v.material);
+                                    });
+               });
+    checkArray("lineTypes", a.lineTypes, b.lineTypes,
+               [] (ded_linetype_t &d) { d.actMaterial = d.deactMaterial = nullptr; },
+               [] (const ded_linetype_t &x, const ded_linetype_t &y) {
+                   return sameUri(x.actMaterial, y.actMaterial) &&
+                          sameUri(x.deactMaterial, y.deactMaterial);
+               });
+    checkArray("sectorTypes", a.sectorTypes, b.sectorTypes,
+               [] (ded_sectortype_t &) {},
+               [] (const ded_sectortype_t &, const ded_sectortype_t &) { return true; });
+    checkArray("compositeFonts", a.compositeFonts, b.compositeFonts,
+               [] (ded_compositefont_t &d) {
+                   d.uri = nullptr;
+                   clearNested(d.charMap);
+               },
+               [] (const ded_compositefont_t &x, const ded_compositefont_t &y) {
+                   return sameUri(x.uri, y.uri) &&
+                          sameArray(x.charMap, y.charMap,
+                                    [] (ded_compositefont_mappedcharacter_t &d) { d.path = nullptr; },
+                                    [] (const ded_compositefont_mappedcharacter_t &u,
+                                        const ded_compositefont_mappedcharacter_t &v) {
+                                        return sameUri(u.path, v.path);
+                                    });
+               });
+}
+
+static void testRoundTrip(const NativePath &cachePath)
+{
+    ded_t parsed;
+    check(DED_ReadData(&parsed, testDefinitions, "test_dedcache.ded", false) != 0,
+          "test definitions are valid");
+    if (errors) std::cout << DED_Error() << std::endl;
+
+    const Block key = Block("test key").md5Hash();
+    const StringList modelPaths({"models/a", "models/b"});
+
+    DEDCache cache(cachePath);
+    check(cache.save(parsed, key, modelPaths), "definitions are saved");
+
+    ded_t loaded;
+    StringList loadedPaths;
+    check(cache.load(loaded, key, loadedPaths) == DEDCache::Loaded, "definitions are loaded");
+    check(loadedPaths == modelPaths, "model paths are loaded intact");
+    compareDefs(parsed, loaded);
+    loaded.clear();
+
+    // The cache is not used with different inputs.
+    check(cache.load(loaded, Block("other key").md5Hash(), loadedPaths) == DEDCache::KeyMismatch,
+          "cache is not used with a different key");
+    check(loaded.things.size() == 0, "nothing is loaded with a different key");
+
+    // A truncated cache file is rejected without leaving partial definitions.
+    {
+        Block data;
+        if (std::FILE *file = std::fopen(cachePath.c_str(), "rb"))
+        {
+            data.resize(4096);
+            data.resize(std::fread(data.data(), 1, data.size(), file));
+            std::fclose(file);
+        }
+        if (std::FILE *file = std::fopen(cachePath.c_str(), "wb"))
+        {
+            std::fwrite(data.data(), 1, data.size() / 2, file);
+            std::fclose(file);
+        }
+    }
+    check(cache.load(loaded, key, loadedPaths) == DEDCache::Invalid, "truncated cache is invalid");
+    check(loaded.things.size() == 0 && loaded.lights.isEmpty(), "truncated cache loads nothing");
+    loaded.clear();
+
+    cache.clear();
+    check(cache.load(loaded, key, loadedPaths) == DEDCache::Missing, "cleared cache is missing");
+
+    parsed.clear();
+    loaded.clear();
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+
+        testRoundTrip(NativePath::workPath() / "test_dedcache.bin");
+
+        std::cout << errors << " errors" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
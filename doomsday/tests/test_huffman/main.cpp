@@ -0,0 +1,132 @@
+/**
+ * @file main.cpp
+ *
+ * Huffman codec benchmark. @ingroup tests
+ *
+ * Encodes and decodes a set of network packets, verifying that every packet
+ * survives the round trip, and reports the throughput of both directions.
+ *
+ * Usage: test_huffman [capture file]
+ *
+ * A capture file contains packets one after another, each preceded by its size
+ * as a 16-bit little-endian integer. Without a capture file, packets resembling
+ * server frames (mostly small delta values and zeros) are generated.
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/huffman.h>
+#include <de/elapsedtimer.h>
+#include <de/list.h>
+
+#include <fstream>
+#include <iostream>
+
+using namespace de;
+
+static List<Block> readCapture(const char *fileName)
+{
+    List<Block> packets;
+    std::ifstream in(fileName, std::ios::binary);
+    dbyte sizeBytes[2];
+    while (in.read(reinterpret_cast<char *>(sizeBytes), 2))
+    {
+        Block packet(sizeBytes[0] | (sizeBytes[1] << 8));
+        if (!in.read(reinterpret_cast<char *>(packet.data()), packet.size())) break;
+        packets << packet;
+    }
+    return packets;
+}
+
+static List<Block> generatePackets(int count)
+{
+    duint32 seed = 0x1234567;
+    auto random = [&seed] () {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 16;
+    };
+
+    List<Block> packets;
+    for (int i = 0; i < count; ++i)
+    {
+        Block packet(8 + random() % 120);
+        for (dsize k = 0; k < packet.size(); ++k)
+        {
+            const duint r = random() % 16;
+            packet.data()[k] = dbyte(r < 8 ? 0 : r < 13 ? random() % 16 : random());
+        }
+        packets << packet;
+    }
+    return packets;
+}
+
+int main(int argc, char **argv)
+{
+    int errors = 0;
+    init_Foundation();
+    try
+    {
+        const List<Block> packets = (argc > 1 ? readCapture(argv[1]) : generatePackets(20000));
+        const int rounds = 20;
+
+        dsize totalBytes = 0;
+        for (const Block &packet : packets) totalBytes += packet.size();
+
+        // Verify the round trip.
+        List<Block> coded;
+        dsize codedBytes = 0;
+        for (const Block &packet : packets)
+        {
+            coded << codec::huffmanEncode(packet);
+            codedBytes += coded.last().size();
+            if (codec::huffmanDecode(coded.last()) != packet) errors++;
+        }
+        std::cout << packets.size() << " packets, " << totalBytes << " bytes coded to "
+                  << codedBytes << " bytes (" << 100.0 * codedBytes / de::max(totalBytes, dsize(1))
+                  << "%)" << std::endl
+                  << errors << " round trip errors" << std::endl;
+
+        dsize sum = 0;
+        ElapsedTimer timer;
+        timer.start();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const Block &packet : packets) sum += codec::huffmanEncode(packet).size();
+        }
+        const double encodeTime = timer.elapsedSeconds();
+
+        timer.restart();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const Block &packet : coded) sum += codec::huffmanDecode(packet).size();
+        }
+        const double decodeTime = timer.elapsedSeconds();
+
+        const double megabytes = double(rounds) * totalBytes / 1.0e6;
+        std::cout << "Encode: " << megabytes / encodeTime << " MB/s" << std::endl
+                  << "Decode: " << megabytes / decodeTime << " MB/s" << std::endl
+                  << "(checksum " << sum << ")" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return errors? 1 : 0;
+}
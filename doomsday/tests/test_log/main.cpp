@@ -19,7 +19,9 @@
 
 #include <de/textapp.h>
 #include <de/log.h>
+#include <de/logbuffer.h>
 #include <de/logfilter.h>
+#include <de/taskpool.h>
 
 using namespace de;
 
@@ -58,6 +60,30 @@ int main(int argc, char **argv)
                 }
             }
         }
+
+        // Entries from several threads with asynchronous output.
+        {
+            app.logFilter().setMinLevel(LogEntry::Message);
+            LogBuffer &buf = LogBuffer::get();
+            buf.enableAsyncOutput(true, 256);
+
+            TaskPool pool;
+            for (int t = 0; t < 4; ++t)
+            {
+                pool.start([t] () {
+                    for (int i = 0; i < 500; ++i)
+                    {
+                        LOG_MSG("Async entry %i from producer %i") << i << t;
+                    }
+                });
+            }
+            pool.waitForDone();
+
+            // Stopping the writer thread drains the queue.
+            buf.enableAsyncOutput(false);
+            LOG_MSG("Asynchronous output finished; %i entries were dropped")
+                    << buf.droppedEntryCount();
+        }
     }
     catch (const Error &err)
     {
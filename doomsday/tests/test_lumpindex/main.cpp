@@ -0,0 +1,171 @@
+/**
+ * @file main.cpp
+ *
+ * LumpIndex lookup benchmark. @ingroup tests
+ *
+ * Catalogs a large number of synthetic lumps (some with duplicate names, as
+ * when PWADs override IWAD lumps) and measures the rate of lookups by Path and
+ * by plain name. The results are verified against a linear search.
+ *
+ * Usage: test_lumpindex [lump count]
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/elapsedtimer.h>
+#include <de/pathtree.h>
+#include <doomsday/filesys/fs_main.h>
+#include <doomsday/filesys/lumpindex.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace de;
+using namespace res;
+
+/**
+ * Lump without any data, owned by a PathTree node like the lumps of a WAD.
+ */
+class TestLump : public File1
+{
+public:
+    TestLump(PathTree::Node &node, const String &path)
+        : File1(nullptr, path, FileInfo()), _node(node)
+    {}
+
+    PathTree::Node &directoryNode() const override { return _node; }
+
+private:
+    PathTree::Node &_node;
+};
+
+static String lumpName(int i)
+{
+    // Every tenth name is shared with an earlier lump.
+    return Stringf("L%06X.lmp", (i % 10 == 9? i / 2 : i) * 0x9e3779b1u & 0xffffff);
+}
+
+static lumpnum_t linearFindLast(const LumpIndex &index, const String &name)
+{
+    for (int i = index.lastIndex(); i >= 0; --i)
+    {
+        if (!index[i].name().compareWithoutCase(name)) return i;
+    }
+    return -1;
+}
+
+static lumpnum_t linearFindFirst(const LumpIndex &index, const String &name)
+{
+    for (int i = 0; i < index.size(); ++i)
+    {
+        if (!index[i].name().compareWithoutCase(name)) return i;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+        F_Init(); // Lumps deregister themselves from the file system.
+
+        const int lumpCount = (argc > 1? std::atoi(argv[1]) : 20000);
+        const int rounds    = 20;
+
+        PathTree tree;
+        List<TestLump *> lumps;
+        StringList names;
+        for (int i = 0; i < lumpCount; ++i)
+        {
+            names << lumpName(i);
+            lumps << new TestLump(tree.insert(Path(names.last())), names.last());
+        }
+
+        // Catalog the lumps while looking them up, as happens during startup.
+        LumpIndex index;
+        ElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < lumpCount; ++i)
+        {
+            index.catalogLump(*lumps[i]);
+            index.findLastByName(names[i]);
+        }
+        std::cout << "Cataloged " << lumpCount << " lumps in " << timer.elapsedSeconds()
+                  << " s" << std::endl;
+
+        // Verify the results (with differently cased names).
+        int errors = 0;
+        for (int i = 0; i < lumpCount; i += 7)
+        {
+            const String query = names[i].upper();
+            const lumpnum_t last  = linearFindLast(index, query);
+            const lumpnum_t first = linearFindFirst(index, query);
+            LumpIndex::FoundIndices found;
+            index.findAll(Path(query), found);
+            if (index.findLast(Path(query))       != last  ||
+                index.findLastByName(query)       != last  ||
+                index.findFirst(Path(query))      != first ||
+                index.findFirstByName(query)      != first ||
+                found.front() != first || found.back() != last)
+            {
+                errors++;
+            }
+        }
+        if (index.containsName("NOSUCH.lmp")) errors++;
+        std::cout << errors << " lookup errors" << std::endl;
+        DE_ASSERT(errors == 0);
+
+        // Lookups of parsed paths.
+        List<Path> paths;
+        for (const String &name : names) paths << Path(name);
+        timer.restart();
+        duint64 sum = 0;
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const Path &path : paths) sum += duint64(index.findLast(path));
+        }
+        const double pathTime = timer.elapsedSeconds();
+
+        // Lookups of plain names.
+        timer.restart();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const String &name : names) sum += duint64(index.findLastByName(name));
+        }
+        const double nameTime = timer.elapsedSeconds();
+
+        const double lookups = double(rounds) * lumpCount;
+        std::cout << "findLast(Path):         " << lookups / pathTime << " lookups/s" << std::endl
+                  << "findLastByName(CString): " << lookups / nameTime << " lookups/s" << std::endl
+                  << "(checksum " << sum << ")" << std::endl;
+
+        index.clear();
+        deleteAll(lumps);
+        F_Shutdown();
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
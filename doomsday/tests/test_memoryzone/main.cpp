@@ -0,0 +1,120 @@
+/**
+ * @file main.cpp
+ *
+ * Memory zone stress benchmark: volume rover vs. thread-local arenas. @ingroup tests
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/elapsedtimer.h>
+#include <de/liblegacy.h>
+#include <de/legacy/memoryzone.h>
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace de;
+
+static const int ALLOCS_PER_THREAD = 200000;
+static const int LIVE_BLOCKS       = 4096;
+
+/**
+ * Allocates and frees blocks of mixed sizes and tags, similar to what happens
+ * during map setup and play.
+ */
+static void stress(int seed)
+{
+    std::vector<void *> live(LIVE_BLOCKS, nullptr);
+    duint32 rnd = duint32(seed) * 2654435761u + 1;
+
+    for (int i = 0; i < ALLOCS_PER_THREAD; ++i)
+    {
+        rnd = rnd * 1664525u + 1013904223u;
+        const int slot = int((rnd >> 8) % LIVE_BLOCKS);
+        if (live[slot])
+        {
+            Z_Free(live[slot]);
+            live[slot] = nullptr;
+        }
+        // Mostly small blocks with the occasional large one.
+        const size_t size = ((rnd >> 20) % 16 == 0? 4096 + (rnd % 8192) : 8 + (rnd % 256));
+        const int tag = ((rnd >> 4) % 4 == 0? PU_APPSTATIC : PU_MAP);
+        live[slot] = Z_Malloc(size, tag, nullptr);
+        std::memset(live[slot], 0, size);
+
+        if (i % 1000 == 0)
+        {
+            Z_ChangeTag2(live[slot], PU_MAPSTATIC);
+        }
+    }
+    for (void *ptr : live)
+    {
+        if (ptr && Z_GetTag(ptr) == PU_APPSTATIC) Z_Free(ptr);
+    }
+}
+
+static double run(bool arenas, int threadCount)
+{
+    Z_EnableArenas(arenas);
+
+    ElapsedTimer timer;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(stress, i);
+    }
+    for (auto &t : threads) t.join();
+
+    // Map-tagged blocks are released in bulk.
+    Z_FreeTags(PU_MAP, PU_PURGELEVEL - 1);
+
+    return timer.elapsedSeconds();
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+        Libdeng_Init();
+
+        const int maxThreads = de::max(1, int(std::thread::hardware_concurrency()));
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            const double rover = run(false, threads);
+            const double arena = run(true,  threads);
+            std::cout << threads << " thread(s): rover " << rover << " s, arenas " << arena
+                      << " s (" << rover / arena << "x)" << std::endl;
+        }
+        Z_CheckHeap();
+        Z_PrintStatus();
+
+        Libdeng_Shutdown();
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file main.cpp
+ *
+ * Particle simulation benchmark. @ingroup tests
+ *
+ * Moves the particles of a set of synthetic generators with the batched
+ * floating-point integration (see particlemotion.h), first in one thread and
+ * then with the generators distributed to worker threads, and compares the
+ * results and speed with the per-particle fixed-point movement that the
+ * generators used before. Each generator has a floor and a ceiling that the
+ * particles bounce from.
+ *
+ * Usage: test_particles [generators] [tics]
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/elapsedtimer.h>
+#include <de/taskpool.h>
+#include <de/legacy/fixedpoint.h>
+#include "world/particlemotion.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace de;
+
+static const float GRAVITY = 1;
+static const float FLOOR   = 0;
+static const float CEILING = 256;
+
+/// Allowed difference between the fixed-point and floating-point positions. The
+/// rounding errors of fixed point accumulate, so the difference grows with the
+/// distance travelled.
+static const float TOLERANCE          = 1;
+static const float RELATIVE_TOLERANCE = 0.01f;
+
+/// Portion of particles allowed to exceed the tolerance.
+static const double MAX_MISMATCH_RATIO = 0.001;
+
+/// Forces of a particle stage.
+struct Stage
+{
+    float gravity;
+    float force[3];
+    float resistance;
+    float bounce;
+    float radius;
+};
+
+/// A particle as the generators used to store it.
+struct ClassicParticle
+{
+    fixed_t origin[3];
+    fixed_t mov[3];
+};
+
+struct TestGenerator
+{
+    Stage stage;
+    int count;
+
+    std::vector<ClassicParticle> classic;
+
+    std::vector<float> storage;
+    ParticleMotion motion;
+
+    void init(std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> unit(0, 1);
+        std::uniform_real_distribution<float> spread(-1, 1);
+        std::uniform_int_distribution<int> counts(64, 448);
+
+        count = counts(rng);
+        stage.gravity    = unit(rng) * 0.5f;
+        stage.force[0]   = spread(rng) * 0.05f;
+        stage.force[1]   = spread(rng) * 0.05f;
+        stage.force[2]   = unit(rng) * 0.1f;
+        stage.resistance = unit(rng) * 0.1f;
+        stage.bounce     = unit(rng) * 0.8f;
+        stage.radius     = 1 + unit(rng) * 3;
+
+        classic.resize(count);
+        storage.assign(ParticleMotion::storageSize(count) / sizeof(float), 0.f);
+        motion.setStorage(storage.data(), count);
+
+        const float drag = FIX2FLT(FLT2FIX(1 - stage.resistance));
+        for (int i = 0; i < count; ++i)
+        {
+            const float pos[3] = { spread(rng) * 128, spread(rng) * 128, 16 + unit(rng) * 224 };
+            const float mov[3] = { spread(rng) * 4, spread(rng) * 4, spread(rng) * 4 };
+            for (int c = 0; c < 3; ++c)
+            {
+                classic[i].origin[c] = FLT2FIX(pos[c]);
+                classic[i].mov[c]    = FLT2FIX(mov[c]);
+                motion.pos[c][i]     = FIX2FLT(classic[i].origin[c]);
+                motion.mov[c][i]     = FIX2FLT(classic[i].mov[c]);
+            }
+            motion.setForces(i, stage.force, FIX2FLT(FLT2FIX(stage.gravity)), drag);
+        }
+    }
+
+    /**
+     * Moves the particles one at a time in fixed point, like the generators did.
+     */
+    void runClassic()
+    {
+        const fixed_t gravity    = FixedMul(FLT2FIX(GRAVITY), FLT2FIX(stage.gravity));
+        const fixed_t resistance = FLT2FIX(1 - stage.resistance);
+        const fixed_t bounce     = FLT2FIX(stage.bounce);
+        const fixed_t hardRadius = FLT2FIX(stage.radius) / 2;
+
+        for (ClassicParticle &pt : classic)
+        {
+            pt.mov[2] -= gravity;
+            for (int c = 0; c < 3; ++c)
+            {
+                pt.mov[c] += FLT2FIX(stage.force[c]);
+                pt.mov[c]  = FixedMul(pt.mov[c], resistance);
+            }
+
+            fixed_t z = pt.origin[2] + pt.mov[2];
+            bool zBounce = false;
+            if (z > FLT2FIX(CEILING) - hardRadius)
+            {
+                z = FLT2FIX(CEILING) - hardRadius;
+                zBounce = true;
+            }
+            if (z < FLT2FIX(FLOOR) + hardRadius)
+            {
+                z = FLT2FIX(FLOOR) + hardRadius;
+                zBounce = true;
+            }
+            if (zBounce)
+            {
+                pt.mov[2] = FixedMul(-pt.mov[2], bounce);
+            }
+            pt.origin[0] += pt.mov[0];
+            pt.origin[1] += pt.mov[1];
+            pt.origin[2] = z;
+        }
+    }
+
+    /**
+     * Integrates the particles in batches and then checks the collisions.
+     */
+    void runBatched()
+    {
+        integrateParticles(motion, ParticleMotion::paddedCount(count), GRAVITY);
+
+        const float hardRadius = FIX2FLT(FLT2FIX(stage.radius) / 2);
+        const float bounce     = FIX2FLT(FLT2FIX(stage.bounce));
+        for (int i = 0; i < count; ++i)
+        {
+            float z = motion.next[2][i];
+            bool zBounce = false;
+            if (z > CEILING - hardRadius)
+            {
+                z = CEILING - hardRadius;
+                zBounce = true;
+            }
+            if (z < FLOOR + hardRadius)
+            {
+                z = FLOOR + hardRadius;
+                zBounce = true;
+            }
+            if (zBounce)
+            {
+                motion.mov[2][i] = -motion.mov[2][i] * bounce;
+                if (std::fabs(motion.mov[2][i]) < PARTICLE_MIN_MOMENTUM)
+                {
+                    motion.mov[2][i] = 0;
+                }
+            }
+            motion.pos[0][i] = motion.next[0][i];
+            motion.pos[1][i] = motion.next[1][i];
+            motion.pos[2][i] = z;
+        }
+    }
+
+    int countMismatches() const
+    {
+        int mismatches = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const float expected = FIX2FLT(classic[i].origin[c]);
+                if (std::fabs(expected - motion.pos[c][i]) >
+                    TOLERANCE + RELATIVE_TOLERANCE * std::fabs(expected))
+                {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+        return mismatches;
+    }
+};
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int errors = 0;
+    try
+    {
+        const int numGens = (argc > 1? std::atoi(argv[1]) : 200);
+        const int tics    = (argc > 2? std::atoi(argv[2]) : 350);
+
+        std::mt19937 rng(1234);
+        std::vector<TestGenerator> gens(numGens);
+        int numParticles = 0;
+        for (TestGenerator &gen : gens)
+        {
+            gen.init(rng);
+            numParticles += gen.count;
+        }
+        std::cout << numGens << " generators, " << numParticles << " particles, "
+                  << tics << " tics" << std::endl;
+
+        ElapsedTimer timer;
+
+        // The reference: fixed point, one particle at a time.
+        timer.start();
+        for (int t = 0; t < tics; ++t)
+        {
+            for (TestGenerator &gen : gens) gen.runClassic();
+        }
+        const double classicSeconds = timer.elapsedSeconds();
+
+        // Batched, in the main thread. Half of the tics are run here...
+        const int serialTics = tics / 2;
+        timer.start();
+        for (int t = 0; t < serialTics; ++t)
+        {
+            for (TestGenerator &gen : gens) gen.runBatched();
+        }
+        const double serialSeconds = timer.elapsedSeconds() / serialTics;
+
+        // ...and the rest with the generators distributed to worker threads.
+        timer.start();
+        for (int t = serialTics; t < tics; ++t)
+        {
+            TaskPool::parallelFor(0, gens.size(), [&gens] (dsize begin, dsize end)
+            {
+                for (dsize i = begin; i < end; ++i) gens[i].runBatched();
+            }, 1);
+        }
+        const double parallelSeconds = timer.elapsedSeconds() / (tics - serialTics);
+
+        const double perTic = classicSeconds / tics;
+        std::cout << "classic:  " << perTic * 1.0e6 << " us/tic" << std::endl;
+        std::cout << "batched:  " << serialSeconds * 1.0e6 << " us/tic ("
+                  << perTic / serialSeconds << "x)" << std::endl;
+        std::cout << "parallel: " << parallelSeconds * 1.0e6 << " us/tic ("
+                  << perTic / parallelSeconds << "x, " << TaskPool::workerCount()
+                  << " workers)" << std::endl;
+
+        // Bounces amplify the rounding differences, so a few particles may end up
+        // on different paths.
+        int mismatches = 0;
+        for (const TestGenerator &gen : gens)
+        {
+            mismatches += gen.countMismatches();
+        }
+        std::cout << mismatches << " mismatches" << std::endl;
+        if (mismatches > numParticles * MAX_MISMATCH_RATIO)
+        {
+            errors++;
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file main.cpp
+ *
+ * Rule graph benchmark: resizes a large widget tree with individually updated
+ * rules and with a compiled RuleGraph, and checks that both produce the same
+ * layout. @ingroup tests
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/elapsedtimer.h>
+#include <de/rootwidget.h>
+#include <de/rules.h>
+
+#include <iostream>
+
+using namespace de;
+
+static const int WIDGET_COUNT = 5000;
+static const int RESIZE_COUNT = 200;
+static const int FAN_OUT      = 4;
+
+/**
+ * Widget that is laid out with a rule rectangle.
+ */
+class LayoutWidget : public Widget
+{
+public:
+    RuleRectangle rule;
+};
+
+/**
+ * Root widget with a tree of LayoutWidgets. The widgets are placed in columns
+ * inside their parents, similar to menus and dialogs.
+ */
+class LayoutRoot : public RootWidget
+{
+public:
+    LayoutRoot()
+    {
+        List<LayoutWidget *> widgets;
+        for (int i = 0; i < WIDGET_COUNT; ++i)
+        {
+            auto *w = new LayoutWidget;
+            if (i == 0)
+            {
+                w->rule.setRect(viewRule());
+                add(w);
+            }
+            else
+            {
+                LayoutWidget *parent = widgets[(i - 1) / FAN_OUT];
+                const RuleRectangle &p = parent->rule;
+                const int column = (i - 1) % FAN_OUT;
+                w->rule.setInput(Rule::Left,  p.left() + p.width() * column / FAN_OUT)
+                       .setInput(Rule::Top,   p.top() + Const(8))
+                       .setInput(Rule::Width, OperatorRule::maximum(p.width() / FAN_OUT - 2,
+                                                                    Const(1)))
+                       .setInput(Rule::Height, OperatorRule::select(p.height() - 16,
+                                                                    Const(10),
+                                                                    p.height() - Const(100)));
+                parent->add(w);
+            }
+            widgets << w;
+        }
+    }
+
+    /// Reads the full layout, like drawing the tree would.
+    double layoutSum() const
+    {
+        double sum = 0;
+        forAll([&sum] (const LayoutWidget &w)
+        {
+            sum += w.rule.left().value()  + w.rule.top().value()
+                 + w.rule.right().value() + w.rule.bottom().value();
+        });
+        return sum;
+    }
+
+protected:
+    void collectRuleRectangles(List<const RuleRectangle *> &rects) const override
+    {
+        forAll([&rects] (const LayoutWidget &w) { rects << &w.rule; });
+    }
+
+private:
+    void forAll(const std::function<void (const LayoutWidget &)> &func) const
+    {
+        std::function<void (const Widget &)> walk = [&func, &walk] (const Widget &widget)
+        {
+            for (const Widget *child : widget.children())
+            {
+                if (const auto *w = maybeAs<LayoutWidget>(child)) func(*w);
+                walk(*child);
+            }
+        };
+        walk(*this);
+    }
+};
+
+static Vec2ui viewSizeForFrame(int frame)
+{
+    return Vec2ui(800 + duint(frame) * 3, 600 + duint(frame % 7) * 20);
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int errors = 0;
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+
+        LayoutRoot classic;
+        LayoutRoot compiled;
+        compiled.setRuleGraphEnabled(true);
+        compiled.update();
+
+        const RuleGraph &graph = *compiled.ruleGraph();
+        std::cout << "Rules in graph: " << graph.size() << " (" << graph.compiledCount()
+                  << " compiled)" << std::endl;
+
+        double classicTime = 0;
+        double compiledTime = 0;
+        for (int frame = 0; frame < RESIZE_COUNT; ++frame)
+        {
+            const Vec2ui size = viewSizeForFrame(frame);
+            double classicSum;
+            double compiledSum;
+            {
+                ElapsedTimer timer;
+                classic.setViewSize(size);
+                classic.update();
+                classicSum = classic.layoutSum();
+                classicTime += timer.elapsedSeconds();
+            }
+            {
+                ElapsedTimer timer;
+                compiled.setViewSize(size);
+                compiled.update();
+                compiledSum = compiled.layoutSum();
+                compiledTime += timer.elapsedSeconds();
+            }
+            if (classicSum != compiledSum)
+            {
+                std::cout << "frame " << frame << ": layout mismatch (" << classicSum
+                          << " != " << compiledSum << ")" << std::endl;
+                errors++;
+            }
+        }
+        if (!graph.isCompiled())
+        {
+            // Resizing the view should not change the structure of the rules.
+            std::cout << "rule graph was discarded during resizing" << std::endl;
+            errors++;
+        }
+
+        std::cout << RESIZE_COUNT << " resizes: individual rules " << classicTime
+                  << " s, rule graph " << compiledTime << " s ("
+                  << classicTime / compiledTime << "x), " << graph.evaluationCount()
+                  << " evaluations" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
@@ -19,17 +19,108 @@
 
 #include <de/textapp.h>
 #include <de/logbuffer.h>
+#include <de/memorylogsink.h>
+#include <de/regexp.h>
 #include <de/filesystem.h>
 #include <de/scripting/script.h>
 #include <de/scripting/process.h>
+#include <de/scripting/scriptsystem.h>
 #include <de/escapeparser.h>
+#include <de/elapsedtimer.h>
 
 #include <iostream>
 
 using namespace de;
 
+/// Arithmetic and comparison heavy loop for comparing the tree interpreter
+/// against compiled expressions.
+static const char *benchmarkSource =
+    "record Obj\n"
+    "Obj.scale = 3\n"
+    "total = 0\n"
+    "i = 0\n"
+    "while i < 20000\n"
+    "    x = (i * Obj.scale + 7) % 1000\n"
+    "    if x > 500 and not x == 777\n"
+    "        total += x / 2 - 1\n"
+    "    elsif (x & 15) == 3 or x in [1, 2, 3]\n"
+    "        total -= 1\n"
+    "    end\n"
+    "    i += 1\n"
+    "end\n"
+    "total\n";
+
+static ddouble runBenchmark(bool compiled, String &result)
+{
+    Script script(benchmarkSource);
+    if (compiled) script.compile();
+    ElapsedTimer timer;
+    timer.start();
+    Process proc(script);
+    proc.execute();
+    result = proc.context().evaluator().result().asText();
+    return timer.elapsedSeconds();
+}
+
+/**
+ * Log sink that collects the messages printed by scripts.
+ */
+class ScriptOutputSink : public MemoryLogSink
+{
+public:
+    /// Returns the printed lines, with the parts that differ between runs (pointers
+    /// and the current time) removed.
+    StringList lines()
+    {
+        LogBuffer::get().flush();
+        StringList lines;
+        for (int i = 0; i < entryCount(); ++i)
+        {
+            if (entry(i).context() & LogEntry::Script)
+            {
+                lines << entry(i).asText(LogEntry::Simple)
+                             .removed(RegExp("0x[0-9a-fA-F]+"))
+                             .removed(RegExp("\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2}(\\.\\d+)?"));
+            }
+        }
+        clear();
+        return lines;
+    }
+};
+
+/**
+ * Runs the kitchen sink script with the tree interpreter or with compiled expressions.
+ *
+ * @return Final result value of the script.
+ */
+static String runKitchenSink(bool compiled, ScriptOutputSink &output, StringList &printed)
+{
+    const File &source = App::fileSystem().find("kitchen_sink.ds");
+
+    // The imported module is shared by both runs.
+    Record &sections = ScriptSystem::get().importModule("sections", source.path());
+    sections.set("secNum", 0.0);
+    sections.set("subSecNum", 0.0);
+
+    Script testScript(source);
+    if (compiled) testScript.compile();
+    Process proc(testScript);
+    LOG_MSG(compiled? "Executing with compiled expressions..." : "Script parsing is complete! Executing...");
+    LOG_MSG("------------------------------------------------------------------------------");
+
+    proc.execute();
+
+    LOG_MSG("------------------------------------------------------------------------------");
+    const String result = proc.context().evaluator().result().asText();
+    LOG_MSG("Final result value is: ") << result;
+
+    printed = output.lines();
+    return result;
+}
+
 int main(int argc, char **argv)
 {
+    int errors = 0;
     init_Foundation();
     using namespace std;
     try
@@ -38,30 +129,51 @@ int main(int argc, char **argv)
         app.initSubsystems();
         cout << FS::locate<const Folder>("/data").correspondingNativePath().toString() << endl;
 
-#if 1
-        Script testScript(app.fileSystem().find("kitchen_sink.ds"));
-#endif
-#if 0
-        Script testScript("def returnValue(a): return a\n"
-                          "returnValue(True) and returnValue(True)\n");
-#endif
-#if 0
-        Script testScript("print 'Dictionary:', {'a':'A', 'b':'B'} - 'a'\n");
-#endif
-        Process proc(testScript);
-        LOG_MSG("Script parsing is complete! Executing...");
-        LOG_MSG("------------------------------------------------------------------------------");
-
-        proc.execute();
+        // Both ways of executing must produce the same output and result.
+        ScriptOutputSink output;
+        LogBuffer::get().addSink(output);
+        {
+            StringList treePrinted, compiledPrinted;
+            const String treeResult     = runKitchenSink(false, output, treePrinted);
+            const String compiledResult = runKitchenSink(true,  output, compiledPrinted);
+            if (treeResult != compiledResult)
+            {
+                LOG_WARNING("Compiled result differs: %s != %s") << compiledResult << treeResult;
+                errors++;
+            }
+            for (dsize i = 0; i < de::max(treePrinted.size(), compiledPrinted.size()); ++i)
+            {
+                const String tree     = (i < treePrinted.size()?     treePrinted[i]     : "(none)");
+                const String compiled = (i < compiledPrinted.size()? compiledPrinted[i] : "(none)");
+                if (tree != compiled)
+                {
+                    LOG_WARNING("Compiled output differs at line %i: \"%s\" != \"%s\"")
+                        << i << compiled << tree;
+                    errors++;
+                    break;
+                }
+            }
+        }
+        LogBuffer::get().removeSink(output);
 
-        LOG_MSG("------------------------------------------------------------------------------");
-        LOG_MSG("Final result value is: ") << proc.context().evaluator().result().asText();
+        String treeResult, compiledResult;
+        const ddouble treeTime     = runBenchmark(false, treeResult);
+        const ddouble compiledTime = runBenchmark(true,  compiledResult);
+        LOG_MSG("Benchmark: tree %.3f s (result %s), compiled %.3f s (result %s)")
+                << treeTime << treeResult << compiledTime << compiledResult;
+        if (treeResult != compiledResult)
+        {
+            LOG_WARNING("Compiled benchmark result differs");
+            errors++;
+        }
+        LOG_MSG("%i errors") << errors;
     }
     catch (const Error &err)
     {
         err.warnPlainText();
+        errors++;
     }
     deinit_Foundation();
     debug("Exiting main()...");
-    return 0;
+    return errors? 1 : 0;
 }
@@ -0,0 +1,235 @@
+/**
+ * @file main.cpp
+ *
+ * Task pool scheduler tests: task counting, priorities, parallelFor ranges and
+ * waiting for nested tasks. @ingroup tests
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/textapp.h>
+#include <de/taskpool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace de;
+
+static std::atomic<int> errors{0};
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        std::cout << "FAILED: " << what << std::endl;
+        errors++;
+    }
+}
+
+/**
+ * Keeps all the workers of the shared pool busy until released, so that the
+ * calling thread can run the queued tasks by itself in a deterministic order.
+ */
+class WorkerGate
+{
+public:
+    WorkerGate()
+    {
+        for (int i = 0; i < TaskPool::workerCount(); ++i)
+        {
+            _pool.start([this]() {
+                std::unique_lock<std::mutex> lk(_mutex);
+                _arrived++;
+                _cond.notify_all();
+                _cond.wait(lk, [this]() { return _open; });
+            });
+        }
+        // Each worker can only be blocked in one gate task at a time.
+        std::unique_lock<std::mutex> lk(_mutex);
+        _cond.wait(lk, [this]() { return _arrived == TaskPool::workerCount(); });
+    }
+
+    ~WorkerGate()
+    {
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            _open = true;
+        }
+        _cond.notify_all();
+        _pool.waitForDone();
+    }
+
+private:
+    TaskPool                _pool;
+    std::mutex              _mutex;
+    std::condition_variable _cond;
+    int                     _arrived = 0;
+    bool                    _open    = false;
+};
+
+static void testCounting()
+{
+    std::atomic<int> count{0};
+    {
+        TaskPool pool;
+        for (int i = 0; i < 10000; ++i)
+        {
+            pool.start([&count]() { count++; }, TaskPool::Priority(i % 3));
+        }
+        pool.waitForDone();
+        check(pool.isDone(), "pool is done after waitForDone");
+    }
+    check(count == 10000, "all tasks run exactly once");
+}
+
+static void testPriorities()
+{
+    std::mutex mutex;
+    List<int>  order;
+    {
+        WorkerGate gate;
+        TaskPool pool;
+        for (int i = 0; i < 30; ++i)
+        {
+            const auto prio = TaskPool::Priority(i % 3);
+            pool.start([&mutex, &order, prio]() {
+                std::lock_guard<std::mutex> lk(mutex);
+                order << int(prio);
+            }, prio);
+        }
+        // The workers are blocked, so the tasks are run here, one at a time.
+        for (int i = 0; i < 30; ++i)
+        {
+            TaskPool::yield(0.0);
+        }
+        check(pool.isDone(), "yield runs queued tasks");
+
+        // Nothing is queued: must return without waiting for new tasks.
+        TaskPool::yield(0.0);
+    }
+    check(order.size() == 30, "all prioritized tasks run");
+    for (dsize i = 1; i < order.size(); ++i)
+    {
+        if (order[i] > order[i - 1])
+        {
+            check(false, "higher priority tasks run first");
+            break;
+        }
+    }
+}
+
+static void testParallelFor()
+{
+    const dsize sizes[]  = {0, 1, 7, 1000, 100003};
+    const dsize grains[] = {0, 1, 3, 64, 1000000};
+    for (dsize size : sizes)
+    {
+        for (dsize grain : grains)
+        {
+            std::vector<std::atomic<int>> hits(size + 20);
+            for (auto &h : hits) h = 0;
+            TaskPool::parallelFor(10, 10 + size, [&hits](dsize begin, dsize end) {
+                for (dsize i = begin; i < end; ++i) hits[i]++;
+            }, grain);
+            for (dsize i = 0; i < hits.size(); ++i)
+            {
+                const int expected = (i >= 10 && i < 10 + size ? 1 : 0);
+                if (hits[i] != expected)
+                {
+                    std::cout << "size " << size << " grain " << grain << " index " << i;
+                    check(false, "parallelFor covers the range exactly once");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void testNestedWait()
+{
+    // More outer tasks than workers: each waits for its own inner tasks, which the
+    // waiting workers must run themselves rather than block the pool.
+    std::atomic<int> count{0};
+    TaskPool outer;
+    const int outerCount = TaskPool::workerCount() * 2 + 1;
+    for (int i = 0; i < outerCount; ++i)
+    {
+        outer.start([&count]() {
+            TaskPool inner;
+            for (int j = 0; j < 50; ++j)
+            {
+                inner.start([&count]() { count++; });
+            }
+            inner.waitForDone();
+            check(inner.isDone(), "nested pool is done after waitForDone");
+
+            // Nested parallelFor from a worker thread.
+            std::atomic<int> sum{0};
+            TaskPool::parallelFor(0, 100, [&sum](dsize begin, dsize end) {
+                sum += int(end - begin);
+            }, 10);
+            check(sum == 100, "nested parallelFor covers the range");
+        }, TaskPool::HighPriority);
+    }
+    outer.waitForDone();
+    check(count == outerCount * 50, "all nested tasks run");
+}
+
+static void testStats()
+{
+    duint64 before = 0;
+    for (const auto &st : TaskPool::workerStats()) before += st.executed;
+    {
+        TaskPool pool;
+        for (int i = 0; i < 100; ++i) pool.start([]() {});
+        pool.waitForDone();
+    }
+    duint64 after = 0;
+    for (const auto &st : TaskPool::workerStats()) after += st.executed;
+    // The main thread does not run tasks in waitForDone(), so the workers ran them all.
+    check(after - before == 100, "worker stats count executed tasks");
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+
+        std::cout << TaskPool::workerCount() << " workers" << std::endl;
+
+        testCounting();
+        testPriorities();
+        testParallelFor();
+        testNestedWait();
+        testStats();
+
+        std::cout << errors << " errors" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
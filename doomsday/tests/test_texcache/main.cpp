@@ -0,0 +1,212 @@
+/**
+ * @file main.cpp
+ *
+ * Texture cache tests: inserting and finding items, persistence of the index,
+ * rejecting damaged items, and removing the least recently used items when the
+ * cache is full. @ingroup tests
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "resource/texturecache.h"
+
+#include <doomsday/console/exec.h>
+#include <doomsday/console/var.h>
+#include <de/textapp.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace de;
+
+static int errors = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        std::cout << "FAILED: " << what << std::endl;
+        errors++;
+    }
+}
+
+static const int ITEM_DIM = 256; ///< 256x256 RGBA: 256 KB per item.
+
+/// Pixels and parameters of a test item; @a seed makes the pixels unique.
+struct TestItem
+{
+    Block key;
+    std::vector<uint8_t> pixels;
+    texturecontent_t content;
+    image_t image;
+
+    TestItem(int seed)
+        : key(Stringf("item-%i", seed).toUtf8().md5Hash())
+        , pixels(ITEM_DIM * ITEM_DIM * 4)
+    {
+        for (dsize i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = uint8_t(i * 7 + seed * 13);
+        }
+        zap(content);
+        content.format      = DGL_RGBA;
+        content.pixels      = pixels.data();
+        content.width       = ITEM_DIM;
+        content.height      = ITEM_DIM;
+        content.minFilter   = GL_LINEAR_MIPMAP_LINEAR;
+        content.magFilter   = GL_NEAREST;
+        content.anisoFilter = 4;
+        content.wrap[0]     = GL_CLAMP_TO_EDGE;
+        content.wrap[1]     = GL_REPEAT;
+        content.grayMipmap  = 128;
+        content.flags       = TXCF_UPLOAD_READY | TXCF_MIPMAP;
+
+        image.size  = image_t::Size(ITEM_DIM / 2, ITEM_DIM / 4 + seed);
+        image.flags = IMGF_IS_MASKED;
+    }
+
+    /// Checks that @a found matches the inserted item.
+    bool matches(const TextureCache::MappedContent &found) const
+    {
+        const texturecontent_t &c = found.content();
+        return c.format == content.format && c.width == content.width &&
+               c.height == content.height && c.minFilter == content.minFilter &&
+               c.magFilter == content.magFilter && c.anisoFilter == content.anisoFilter &&
+               c.wrap[0] == content.wrap[0] && c.wrap[1] == content.wrap[1] &&
+               c.grayMipmap == content.grayMipmap && c.flags == content.flags &&
+               found.imageSize() == image.size && found.imageFlags() == image.flags &&
+               std::memcmp(c.pixels, pixels.data(), pixels.size()) == 0;
+    }
+};
+
+static bool isCached(TextureCache &cache, const TestItem &item)
+{
+    std::unique_ptr<TextureCache::MappedContent> found(cache.find(item.key));
+    return found && item.matches(*found);
+}
+
+static void testRoundTrip(const NativePath &location)
+{
+    const TestItem a(1), b(2);
+    {
+        TextureCache cache(location);
+        cache.clear();
+        check(!cache.find(a.key), "empty cache has no items");
+        cache.insert(a.key, a.content, a.image);
+        cache.insert(b.key, b.content, b.image);
+        // The destructor waits for the items to be written.
+    }
+    {
+        TextureCache cache(location);
+        check(isCached(cache, a), "first item is found intact");
+        check(isCached(cache, b), "second item is found intact");
+        check(cache.size() == 2 * (128 + dint64(a.pixels.size())), "index has the size of both items");
+        check(!cache.find(TestItem(3).key), "unknown key is not found");
+
+        // Replacing an item does not change the total.
+        cache.insert(a.key, a.content, a.image);
+    }
+    {
+        TextureCache cache(location);
+        check(isCached(cache, a), "replaced item is found intact");
+        check(cache.size() == 2 * (128 + dint64(a.pixels.size())), "replaced item is counted once");
+
+        // A damaged item is rejected and removed.
+        const NativePath itemPath = location / (b.key.asHexadecimalText() + ".dtex");
+        if (std::FILE *file = std::fopen(itemPath.c_str(), "wb"))
+        {
+            std::fputs("garbage", file);
+            std::fclose(file);
+        }
+        check(!cache.find(b.key), "damaged item is not found");
+        check(cache.size() == 128 + dint64(a.pixels.size()), "damaged item is removed from the index");
+
+        cache.clear();
+        check(cache.size() == 0, "cleared cache is empty");
+        check(!cache.find(a.key), "cleared cache has no items");
+    }
+}
+
+static void testEviction(const NativePath &location)
+{
+    // Four items do not fit in one megabyte.
+    Con_SetVariable("rend-tex-cache-size", 1);
+
+    const TestItem items[] = {TestItem(10), TestItem(11), TestItem(12), TestItem(13)};
+    {
+        TextureCache cache(location);
+        cache.clear();
+        for (int i = 0; i < 3; ++i)
+        {
+            cache.insert(items[i].key, items[i].content, items[i].image);
+        }
+    }
+    {
+        TextureCache cache(location);
+        // The first item becomes the most recently used one.
+        check(isCached(cache, items[0]), "used item is found before eviction");
+        cache.insert(items[3].key, items[3].content, items[3].image);
+    }
+    {
+        TextureCache cache(location);
+        check(cache.size() <= 1024 * 1024, "cache is within the maximum size");
+        check(isCached(cache, items[0]), "recently used item is kept");
+        check(isCached(cache, items[3]), "inserted item is kept");
+        // Items 1 and 2 were written in parallel, so either one may be the oldest.
+        const int kept = (isCached(cache, items[1])? 1 : 0) + (isCached(cache, items[2])? 1 : 0);
+        check(kept == 1, "least recently used item is removed");
+        cache.clear();
+    }
+
+    // Items larger than the cache are not added at all.
+    Con_SetVariable("rend-tex-cache-size", 0);
+    {
+        TextureCache cache(location);
+        cache.insert(items[0].key, items[0].content, items[0].image);
+    }
+    check(TextureCache(location).size() == 0, "items are not added to a zero-size cache");
+    Con_SetVariable("rend-tex-cache-size", 512);
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+
+        Con_InitDatabases();
+        TextureCache::consoleRegister();
+
+        const NativePath location = NativePath::workPath() / "test_texcache";
+        testRoundTrip(location);
+        testEviction(location);
+
+        std::cout << errors << " errors" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        errors++;
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file main.cpp
+ *
+ * Texture kernel benchmark. @ingroup tests
+ *
+ * Runs the texture processing kernels (see gl_texkernels.h) with each
+ * instruction set supported by the CPU and compares the output with the scalar
+ * reference implementation. The corpus is the flats and patches of a WAD file,
+ * if one is given, otherwise a set of synthetic images.
+ *
+ * Usage: test_texkernels [wad file] [rounds]
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/elapsedtimer.h>
+#include "gl/gl_texkernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace de;
+
+typedef std::vector<uint8_t> Bytes;
+
+struct Image
+{
+    int width;
+    int height;
+    Bytes rgba;
+};
+
+static int le16(const uint8_t *p) { return int16_t(p[0] | (p[1] << 8)); }
+static int le32(const uint8_t *p) { return int32_t(p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24)); }
+
+/**
+ * Decodes a picture in the column-based patch format.
+ *
+ * @return @c false, if the lump is not a valid patch.
+ */
+static bool decodePatch(const uint8_t *data, int size, const uint8_t *palette, Image &img)
+{
+    if (size < 8) return false;
+    img.width  = le16(data);
+    img.height = le16(data + 2);
+    if (img.width <= 0 || img.width > 4096 || img.height <= 0 || img.height > 4096) return false;
+    if (8 + 4 * img.width > size) return false;
+
+    img.rgba.assign(4 * img.width * img.height, 0);
+    for (int x = 0; x < img.width; ++x)
+    {
+        int pos = le32(data + 8 + 4 * x);
+        while (pos >= 0 && pos < size && data[pos] != 0xff)
+        {
+            if (pos + 3 > size) return false;
+            const int top = data[pos], length = data[pos + 1];
+            if (pos + 3 + length > size) return false;
+            for (int i = 0; i < length && top + i < img.height; ++i)
+            {
+                uint8_t *out = &img.rgba[4 * ((top + i) * img.width + x)];
+                std::memcpy(out, palette + 3 * data[pos + 3 + i], 3);
+                out[3] = 255;
+            }
+            pos += length + 4;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the flats and patches of a WAD file.
+ */
+static std::vector<Image> loadWad(const char *path)
+{
+    std::ifstream in(path, std::ios::binary);
+    const std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(file.data());
+    const int fileSize = int(file.size());
+
+    std::vector<Image> images;
+    if (fileSize < 12 || (file.compare(0, 4, "IWAD") && file.compare(0, 4, "PWAD")))
+    {
+        std::cout << path << " is not a WAD file" << std::endl;
+        return images;
+    }
+    const int numLumps = le32(data + 4), dirOffset = le32(data + 8);
+    if (numLumps < 0 || dirOffset < 0 || dirOffset + 16 * numLumps > fileSize) return images;
+
+    struct Lump { std::string name; int pos; int size; };
+    std::vector<Lump> lumps;
+    const uint8_t *palette = nullptr;
+    for (int i = 0; i < numLumps; ++i)
+    {
+        const uint8_t *entry = data + dirOffset + 16 * i;
+        Lump lump{std::string(reinterpret_cast<const char *>(entry + 8), 8), le32(entry), le32(entry + 4)};
+        lump.name = lump.name.c_str(); // Names shorter than 8 are zero-padded.
+        if (lump.pos < 0 || lump.size < 0 || lump.pos + lump.size > fileSize) continue;
+        if (lump.name == "PLAYPAL" && lump.size >= 768) palette = data + lump.pos;
+        lumps.push_back(lump);
+    }
+    if (!palette) return images;
+
+    bool inFlats = false, inPatches = false;
+    for (const Lump &lump : lumps)
+    {
+        const std::string &name = lump.name;
+        if (name == "F_START" || name == "FF_START") { inFlats = true; continue; }
+        if (name == "F_END"   || name == "FF_END")   { inFlats = false; continue; }
+        if (name == "P_START" || name == "PP_START") { inPatches = true; continue; }
+        if (name == "P_END"   || name == "PP_END")   { inPatches = false; continue; }
+
+        if (inFlats && lump.size == 64 * 64)
+        {
+            Image img{64, 64, Bytes(4 * 64 * 64)};
+            for (int i = 0; i < 64 * 64; ++i)
+            {
+                std::memcpy(&img.rgba[4 * i], palette + 3 * data[lump.pos + i], 3);
+                img.rgba[4 * i + 3] = 255;
+            }
+            images.push_back(img);
+        }
+        else if (inPatches)
+        {
+            Image img;
+            if (decodePatch(data + lump.pos, lump.size, palette, img)) images.push_back(img);
+        }
+    }
+    return images;
+}
+
+/**
+ * Generates images with gradients, noise, transparency, and keyed colors.
+ */
+static std::vector<Image> syntheticImages()
+{
+    std::vector<Image> images;
+    uint32_t seed = 1;
+    const int sizes[][2] = {{64, 64}, {64, 128}, {128, 128}, {256, 128}, {256, 256}, {37, 71}, {320, 200}};
+    for (int copy = 0; copy < 4; ++copy)
+    {
+        for (const auto &size : sizes)
+        {
+            Image img{size[0], size[1], Bytes(4 * size[0] * size[1])};
+            for (int y = 0; y < img.height; ++y)
+            {
+                for (int x = 0; x < img.width; ++x)
+                {
+                    seed = seed * 1664525 + 1013904223;
+                    uint8_t *pix = &img.rgba[4 * (y * img.width + x)];
+                    pix[0] = uint8_t(x * 255 / img.width + (seed >> 28));
+                    pix[1] = uint8_t(y * 255 / img.height);
+                    pix[2] = uint8_t(seed >> 24);
+                    pix[3] = ((seed >> 16) & 7)? 255 : 0;
+                    if (((seed >> 8) & 63) == 0)
+                    {
+                        // Keyed color.
+                        pix[0] = ((seed >> 14) & 1)? 255 : 0;
+                        pix[1] = 255 - pix[0];
+                        pix[2] = 255;
+                    }
+                }
+            }
+            images.push_back(img);
+        }
+    }
+    return images;
+}
+
+static void append(Bytes &out, const void *data, size_t size)
+{
+    out.insert(out.end(), static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + size);
+}
+
+/// Same steps as GL_DownMipmap32, repeated until the image is one pixel high or wide.
+static void mipmapChain(const Image &img, Bytes &out)
+{
+    Bytes buf = img.rgba;
+    int width = img.width, height = img.height;
+    while (width > 1 && height > 1)
+    {
+        const int outW = width >> 1, outH = height >> 1;
+        uint8_t *in = buf.data(), *dst = buf.data();
+        for (int y = 0; y < outH; ++y, in += (outW * 2 + width) * 4, dst += outW * 4)
+        {
+            TexKernel_DownMipmapRow(in, in + 4 * width, dst, outW, 4);
+        }
+        width = outW;
+        height = outH;
+    }
+    append(out, buf.data(), 4 * width * height);
+}
+
+/// Same steps as GL_ScaleBufferEx with unsigned bytes.
+static void scale(const Image &img, int widthOut, int heightOut, Bytes &out)
+{
+    const int widthIn = img.width, heightIn = img.height;
+    std::vector<float> tempIn(4 * widthIn * heightIn), tempOut(4 * widthOut * heightOut);
+    TexKernel_BytesToFloats(img.rgba.data(), tempIn.data(), long(tempIn.size()));
+
+    const float sx = (widthOut > 1? float(widthIn - 1) / float(widthOut - 1) : float(widthIn - 1));
+    const float sy = (heightOut > 1? float(heightIn - 1) / float(heightOut - 1) : float(heightIn - 1));
+    for (int i = 0; i < heightOut; ++i)
+    {
+        const int i0 = i * sy;
+        const int i1 = (i0 + 1 < heightIn? i0 + 1 : heightIn - 1);
+        const float *src0 = &tempIn[i0 * widthIn * 4];
+        const float *src1 = &tempIn[i1 * widthIn * 4];
+        float *dst = &tempOut[i * widthOut * 4];
+        if (sx < 1.0 && sy < 1.0)
+        {
+            TexKernel_MagnifyRow(src0, src1, i * sy - i0, dst, widthIn, widthOut, sx, 4);
+        }
+        else
+        {
+            TexKernel_MinifyRow(src0, i1 != i0? src1 : nullptr, dst, widthIn, widthOut, sx, 4);
+        }
+    }
+
+    const size_t start = out.size();
+    out.resize(start + tempOut.size());
+    TexKernel_FloatsToBytes(tempOut.data(), &out[start], long(tempOut.size()));
+}
+
+struct Kernel
+{
+    const char *name;
+    std::function<void (const Image &, Bytes &)> run;
+};
+
+static const Kernel kernels[] = {
+    { "DownMipmap", mipmapChain },
+    { "SumRGB", [](const Image &img, Bytes &out) {
+        long sums[3];
+        TexKernel_SumRGB(img.rgba.data(), img.width * img.height, 4, sums);
+        append(out, sums, sizeof(sums));
+    }},
+    { "MinMaxSum", [](const Image &img, Bytes &out) {
+        uint8_t min, max;
+        long sum;
+        TexKernel_MinMaxSum(img.rgba.data(), long(img.rgba.size()), &min, &max, &sum);
+        append(out, &min, 1);
+        append(out, &max, 1);
+        append(out, &sum, sizeof(sum));
+    }},
+    { "MaxMasked", [](const Image &img, Bytes &out) {
+        const long half = long(img.rgba.size() / 2);
+        const uint8_t max = TexKernel_Max(img.rgba.data(), img.rgba.data() + half, half);
+        append(out, &max, 1);
+    }},
+    { "ColorKey", [](const Image &img, Bytes &out) {
+        const size_t start = out.size();
+        append(out, img.rgba.data(), img.rgba.size());
+        TexKernel_ColorKey(&out[start], img.width * img.height);
+    }},
+    { "Sharpen", [](const Image &img, Bytes &out) {
+        const size_t start = out.size();
+        out.resize(start + img.rgba.size());
+        for (int y = 1; y < img.height - 1; ++y)
+        {
+            const int first = (1 + y * img.width) * 4;
+            TexKernel_SharpenRun(img.rgba.data() + first, &out[start + first], img.width - 2, 4,
+                                 img.width, .05f, .70710678f * .05f, 1 + 4 * .05f + 4 * .70710678f * .05f);
+        }
+    }},
+    { "ScaleUp", [](const Image &img, Bytes &out) {
+        scale(img, img.width * 2, img.height * 2, out);
+    }},
+    { "ScaleDown", [](const Image &img, Bytes &out) {
+        scale(img, (img.width + 1) / 2, (img.height + 1) / 2, out);
+    }},
+};
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int errors = 0;
+    try
+    {
+        const int rounds = (argc > 2? std::atoi(argv[2]) : 20);
+        std::vector<Image> images;
+        if (argc > 1) images = loadWad(argv[1]);
+        if (images.empty()) images = syntheticImages();
+
+        size_t corpusBytes = 0;
+        for (const Image &img : images) corpusBytes += img.rgba.size();
+        std::cout << images.size() << " images, " << corpusBytes / 1024 << " KB; best instruction set: "
+                  << TexKernel_ISAName(TexKernel_BestISA()) << std::endl;
+
+        for (const Kernel &kernel : kernels)
+        {
+            Bytes reference;
+            double scalarTime = 0;
+            for (int isa = TKI_SCALAR; isa < NUM_TEXKERNEL_ISAS; ++isa)
+            {
+                if (!TexKernel_SetISA(texkernelisa_t(isa))) continue;
+
+                Bytes output;
+                for (const Image &img : images) kernel.run(img, output);
+
+                ElapsedTimer timer;
+                timer.start();
+                for (int r = 0; r < rounds; ++r)
+                {
+                    Bytes scratch;
+                    for (const Image &img : images) kernel.run(img, scratch);
+                }
+                const double seconds = timer.elapsedSeconds();
+
+                bool exact = true;
+                if (isa == TKI_SCALAR)
+                {
+                    reference = output;
+                    scalarTime = seconds;
+                }
+                else if (output != reference)
+                {
+                    exact = false;
+                    errors++;
+                }
+                std::cout << kernel.name << " [" << TexKernel_ISAName(texkernelisa_t(isa)) << "]: "
+                          << double(corpusBytes) * rounds / seconds / 1.0e6 << " MB/s, "
+                          << scalarTime / seconds << "x"
+                          << (exact? "" : " -- OUTPUT DIFFERS FROM SCALAR") << std::endl;
+            }
+        }
+        TexKernel_SetISA(TexKernel_BestISA());
+        std::cout << errors << " mismatches" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file main.cpp
+ *
+ * Vissprite depth sort benchmark. @ingroup tests
+ *
+ * Sorts synthetic vissprite distance distributions with DepthSorter (see
+ * depthsort.h) and compares the order and speed with the classic selection
+ * sort that the renderer used before.
+ *
+ * Usage: test_vissort [rounds]
+ *
+ * @authors Copyright &copy; 2026 The Doomsday Engine Project
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/elapsedtimer.h>
+#include "render/depthsort.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace de;
+
+typedef std::vector<double> Distances;
+typedef std::vector<uint32_t> Order;
+
+/// The old sort could not handle more than this many vissprites.
+static const size_t CLASSIC_MAX = 8192;
+
+/**
+ * The classic Doom vissprite sort: the farthest remaining vissprite is repeatedly
+ * moved from the unsorted list to the end of the sorted list.
+ */
+static Order classicSort(const Distances &dists)
+{
+    const int count = int(dists.size());
+    std::vector<int> next(count + 1), prev(count + 1);
+    const int unsorted = count; // Sentinel.
+    for (int i = 0; i < count; ++i)
+    {
+        next[i] = i + 1;
+        prev[i] = (i > 0? i - 1 : unsorted);
+    }
+    next[unsorted] = (count > 0? 0 : unsorted);
+    prev[unsorted] = count - 1;
+
+    Order order;
+    int best = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        double bestdist = 0;
+        for (int ds = next[unsorted]; ds != unsorted; ds = next[ds])
+        {
+            if (dists[ds] >= bestdist)
+            {
+                bestdist = dists[ds];
+                best = ds;
+            }
+        }
+        prev[next[best]] = prev[best];
+        next[prev[best]] = next[best];
+        order.push_back(uint32_t(best));
+    }
+    return order;
+}
+
+struct Distribution
+{
+    const char *name;
+    std::function<Distances (size_t count, std::mt19937 &rng)> make;
+};
+
+static const Distribution distributions[] =
+{
+    { "uniform", [] (size_t count, std::mt19937 &rng)
+        {
+            std::uniform_real_distribution<double> dist(0, 4096);
+            Distances d(count);
+            for (double &v : d) v = dist(rng);
+            return d;
+        }
+    },
+    // Monsters standing in packs on a grid: many vissprites at equal distances.
+    { "crowd", [] (size_t count, std::mt19937 &rng)
+        {
+            std::uniform_int_distribution<int> pack(0, 15);
+            std::uniform_int_distribution<int> cell(0, 7);
+            Distances d(count);
+            for (double &v : d)
+            {
+                const double x = 256 + pack(rng) * 192 + cell(rng) * 24;
+                const double y = cell(rng) * 24;
+                v = std::sqrt(x * x + y * y);
+            }
+            return d;
+        }
+    },
+    // Particle clouds around a few generators.
+    { "particles", [] (size_t count, std::mt19937 &rng)
+        {
+            std::uniform_int_distribution<int> gen(0, 31);
+            std::normal_distribution<double> spread(0, 12);
+            Distances d(count);
+            for (double &v : d) v = std::abs(64 + gen(rng) * 100 + spread(rng));
+            return d;
+        }
+    },
+    { "sorted", [] (size_t count, std::mt19937 &)
+        {
+            Distances d(count);
+            for (size_t i = 0; i < count; ++i) d[i] = double(i) * 0.5;
+            return d;
+        }
+    },
+    { "reversed", [] (size_t count, std::mt19937 &)
+        {
+            Distances d(count);
+            for (size_t i = 0; i < count; ++i) d[i] = double(count - i) * 0.5;
+            return d;
+        }
+    },
+};
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int errors = 0;
+    try
+    {
+        const int rounds = (argc > 1? std::atoi(argv[1]) : 20);
+        const size_t sizes[] = { 16, 256, 2048, 8192, 65536 };
+
+        std::mt19937 rng(1234);
+        DepthSorter sorter;
+        for (const Distribution &distrib : distributions)
+        {
+            for (size_t count : sizes)
+            {
+                const Distances dists = distrib.make(count, rng);
+
+                // Time the sort as the renderer uses it, once per frame.
+                const uint32_t *sorted = nullptr;
+                ElapsedTimer timer;
+                timer.start();
+                for (int r = 0; r < rounds; ++r)
+                {
+                    sorter.clear();
+                    for (double v : dists) sorter.add(v);
+                    sorted = sorter.sortBackToFront();
+                }
+                const double seconds = timer.elapsedSeconds() / rounds;
+                const Order order(sorted, sorted + count);
+
+                std::cout << distrib.name << " x" << count << ": "
+                          << seconds * 1.0e6 << " us";
+
+                if (count <= CLASSIC_MAX)
+                {
+                    timer.start();
+                    const Order reference = classicSort(dists);
+                    const double classicSeconds = timer.elapsedSeconds();
+                    std::cout << ", classic " << classicSeconds * 1.0e6 << " us ("
+                              << classicSeconds / seconds << "x)";
+                    if (order != reference)
+                    {
+                        std::cout << " -- ORDER DIFFERS FROM CLASSIC";
+                        errors++;
+                    }
+                }
+                else
+                {
+                    // Check that the order is back to front.
+                    for (size_t i = 1; i < count; ++i)
+                    {
+                        if (dists[order[i - 1]] < dists[order[i]] ||
+                            (dists[order[i - 1]] == dists[order[i]] && order[i - 1] < order[i]))
+                        {
+                            std::cout << " -- NOT SORTED";
+                            errors++;
+                            break;
+                        }
+                    }
+                }
+                std::cout << std::endl;
+            }
+        }
+        std::cout << errors << " mismatches" << std::endl;
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    return errors? 1 : 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 The Doomsday Engine Project
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Prints a binary log written by BinaryLogSink (see the -binlog option).
+ *
+ * Usage: logtool [-level <name>] [-domain <name>[,<name>...]] [-nodev] <file>
+ */
+
+#include <de/binarylogsink.h>
+#include <de/block.h>
+#include <de/commandline.h>
+#include <de/monospacelogsinkformatter.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace de;
+
+static void printUsage()
+{
+    std::cout << "Usage: logtool [options] <file>" << std::endl
+              << "Options:" << std::endl
+              << "  -level <name>     Only print entries at this level or above (e.g., note)." << std::endl
+              << "  -domain <names>   Only print entries in these domains (comma-separated;" << std::endl
+              << "                    generic, resource, map, script, gl, audio, input, network)." << std::endl
+              << "  -nodev            Omit developer entries." << std::endl;
+}
+
+static duint32 parseDomains(const String &names)
+{
+    duint32 domains = 0;
+    for (const String &name : names.split(","))
+    {
+        if (!name.compareWithoutCase("generic"))
+        {
+            domains |= LogEntry::Generic;
+        }
+        else
+        {
+            domains |= LogEntry::textToContext(name) & LogEntry::DomainMask;
+        }
+    }
+    return domains;
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    int result = 0;
+    try
+    {
+        const CommandLine args(makeList(argc, argv));
+        if (args.count() < 2)
+        {
+            printUsage();
+            deinit_Foundation();
+            return 1;
+        }
+
+        LogEntry::Level minLevel = LogEntry::LowestLogLevel;
+        duint32 domains = LogEntry::AllDomains;
+        if (auto arg = args.check("-level", 1))
+        {
+            minLevel = LogEntry::textToLevel(arg.params.at(0));
+        }
+        if (auto arg = args.check("-domain", 1))
+        {
+            domains = parseDomains(arg.params.at(0));
+        }
+        const bool omitDev = args.has("-nodev");
+
+        const String fileName = args.at(args.count() - 1);
+        std::ifstream in(fileName.c_str(), std::ios::binary);
+        if (!in)
+        {
+            throw Error("logtool", "Cannot open " + fileName);
+        }
+        const std::string contents((std::istreambuf_iterator<char>(in)),
+                                   std::istreambuf_iterator<char>());
+        const Block data(contents.data(), contents.size());
+
+        BinaryLogSink::Decoder decoder(data);
+        MonospaceLogSinkFormatter formatter;
+        while (std::unique_ptr<LogEntry> entry{decoder.next()})
+        {
+            if (entry->level() < minLevel) continue;
+            if (!(entry->metadata() & domains)) continue;
+            if (omitDev && (entry->metadata() & LogEntry::Dev)) continue;
+
+            for (const String &line : formatter.logEntryToTextLines(*entry))
+            {
+                std::cout << line << "\n";
+            }
+        }
+        std::cout.flush();
+    }
+    catch (const Error &er)
+    {
+        er.warnPlainText();
+        result = 1;
+    }
+    deinit_Foundation();
+    return result;
+}